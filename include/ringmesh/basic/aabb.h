@@ -121,6 +121,30 @@ namespace RINGMesh
             bbox_intersect_recursive< EvalIntersection >(
                 box, ROOT_INDEX, 0, nb_bboxes(), action );
         }
+        /*
+         * @brief Computes the intersections between a given
+         * segment and the element boxes.
+         * @details Only the nodes crossed by the segment are visited, which
+         * is much more selective than using the bounding box of the segment
+         * when the segment is long and oblique.
+         * @param[in] p0 the first extremity of the segment
+         * @param[in] p1 the second extremity of the segment
+         * @param[in] action The functor to run when an element box is crossed
+         * by the segment
+         * @tparam EvalIntersection this functor should have an operator()
+         * defined like this:
+         * void operator()( index_t cur_box ) ;
+         * where cur_box is the element box index
+         */
+        template < class EvalIntersection >
+        void compute_segment_element_bbox_intersections(
+            const vecn< DIMENSION >& p0,
+            const vecn< DIMENSION >& p1,
+            EvalIntersection& action ) const
+        {
+            segment_intersect_recursive< EvalIntersection >(
+                p0, p1, ROOT_INDEX, 0, nb_bboxes(), action );
+        }
         /*
          * @brief Computes the self intersections of the element boxes.
          * @param[in] action The functor to run when two boxes intersect
@@ -213,6 +237,14 @@ namespace RINGMesh
             index_t element_end,
             ACTION& action ) const;
 
+        template < class ACTION >
+        void segment_intersect_recursive( const vecn< DIMENSION >& p0,
+            const vecn< DIMENSION >& p1,
+            index_t node_index,
+            index_t element_begin,
+            index_t element_end,
+            ACTION& action ) const;
+
         template < class ACTION >
         void self_intersect_recursive( index_t node_index1,
             index_t element_begin1,
@@ -414,6 +446,42 @@ namespace RINGMesh
             box, child_right, box_middle, element_end, action );
     }
 
+    template < index_t DIMENSION >
+    template < class ACTION >
+    void AABBTree< DIMENSION >::segment_intersect_recursive(
+        const vecn< DIMENSION >& p0,
+        const vecn< DIMENSION >& p1,
+        index_t node_index,
+        index_t element_begin,
+        index_t element_end,
+        ACTION& action ) const
+    {
+        ringmesh_assert( node_index < tree_.size() );
+        ringmesh_assert( element_begin != element_end );
+
+        // Prune sub-tree that is not crossed by the segment
+        if( !node( node_index ).segment_overlap( p0, p1 ) )
+        {
+            return;
+        }
+
+        // Leaf case
+        if( is_leaf( element_begin, element_end ) )
+        {
+            action( mapping_morton_[element_begin] );
+            return;
+        }
+
+        index_t box_middle, child_left, child_right;
+        get_recursive_iterators( node_index, element_begin, element_end,
+            box_middle, child_left, child_right );
+
+        segment_intersect_recursive< ACTION >(
+            p0, p1, child_left, element_begin, box_middle, action );
+        segment_intersect_recursive< ACTION >(
+            p0, p1, child_right, box_middle, element_end, action );
+    }
+
     template < index_t DIMENSION >
     template < class ACTION >
     void AABBTree< DIMENSION >::self_intersect_recursive( index_t node_index1,
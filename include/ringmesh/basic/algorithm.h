@@ -38,8 +38,12 @@
 #include <ringmesh/basic/common.h>
 
 #include <algorithm>
+#include <numeric>
+#include <thread>
 #include <vector>
 
+#include <ringmesh/basic/task_handler.h>
+
 /*!
  * @file ringmesh/algorithm.h
  * @brief Template function for basic operations on std container
@@ -97,35 +101,177 @@ namespace RINGMesh
         return find_sorted( in, value ) != NO_ID;
     }
 
+    /// Minimal number of entities sorted by each thread
+    static const index_t PARALLEL_SORT_MIN_CHUNK_SIZE = 16384;
+
+    /*!
+     * @brief Sorts the range [\p begin, \p end) using several threads.
+     * @details The range is split into one chunk per thread. The chunks are
+     * sorted in parallel with \p chunk_sort, then merged two by two.
+     * Merging is stable: the result is stable if \p chunk_sort is.
+     * Small ranges are directly sorted with \p chunk_sort.
+     */
+    template < typename ITERATOR, typename CMP, typename CHUNK_SORT >
+    void parallel_merge_sort( ITERATOR begin,
+        ITERATOR end,
+        const CMP& cmp,
+        const CHUNK_SORT& chunk_sort )
+    {
+        auto size = static_cast< index_t >( std::distance( begin, end ) );
+        index_t nb_threads{ std::max(
+            std::thread::hardware_concurrency(), index_t( 1 ) ) };
+        auto nb_chunks =
+            std::min( size / PARALLEL_SORT_MIN_CHUNK_SIZE, nb_threads );
+        if( nb_chunks < 2 )
+        {
+            chunk_sort( begin, end, cmp );
+            return;
+        }
+
+        std::vector< index_t > chunk_begins( nb_chunks + 1 );
+        for( auto c : range( nb_chunks + 1 ) )
+        {
+            chunk_begins[c] = static_cast< index_t >(
+                static_cast< std::size_t >( size ) * c / nb_chunks );
+        }
+        parallel_for( nb_chunks, [&]( index_t c ) {
+            chunk_sort(
+                begin + chunk_begins[c], begin + chunk_begins[c + 1], cmp );
+        } );
+        for( index_t width = 1; width < nb_chunks; width *= 2 )
+        {
+            auto nb_merges = ( nb_chunks + 2 * width - 1 ) / ( 2 * width );
+            parallel_for( nb_merges, [&]( index_t m ) {
+                auto first = 2 * width * m;
+                auto middle = std::min( first + width, nb_chunks );
+                auto last = std::min( first + 2 * width, nb_chunks );
+                if( middle < last )
+                {
+                    std::inplace_merge( begin + chunk_begins[first],
+                        begin + chunk_begins[middle],
+                        begin + chunk_begins[last], cmp );
+                }
+            } );
+        }
+    }
+
+    /*!
+     * @brief Sorts a container using several threads.
+     * @param[in,out] container the container to sort
+     * @param[in] cmp a comparator function
+     */
+    template < typename CONTAINER, typename CMP >
+    void parallel_sort( CONTAINER& container, const CMP& cmp )
+    {
+        using Iterator = decltype( container.begin() );
+        parallel_merge_sort( container.begin(), container.end(), cmp,
+            []( Iterator begin, Iterator end, const CMP& chunk_cmp ) {
+                std::sort( begin, end, chunk_cmp );
+            } );
+    }
+
+    /*!
+     * @brief Sorts a container using several threads.
+     * @param[in,out] container the container to sort
+     */
+    template < typename CONTAINER >
+    void parallel_sort( CONTAINER& container )
+    {
+        using Value = typename CONTAINER::value_type;
+        parallel_sort( container, std::less< Value >() );
+    }
+
+    /*!
+     * @brief Reorders a vector so that its i-th entity is the
+     * \p permutation[i]-th entity of the input vector.
+     */
+    template < typename T >
+    void apply_permutation(
+        std::vector< T >& values, const std::vector< index_t >& permutation )
+    {
+        ringmesh_assert( values.size() == permutation.size() );
+        std::vector< T > permuted_values;
+        permuted_values.reserve( values.size() );
+        for( auto i : permutation )
+        {
+            permuted_values.push_back( std::move( values[i] ) );
+        }
+        values.swap( permuted_values );
+    }
+
     /*!
-     * @brief Bubble sorting of input and output vectors according to values of
-     * input.
-     * @note Not efficient.
+     * @brief Sorts the input vector and reorders the output vector
+     * accordingly.
+     * @details The permutation sorting the input is computed with a stable
+     * sort, so equal inputs keep their relative order.
+     * @param[in,out] input the values to sort
+     * @param[in,out] output the values reordered as \p input,
+     * same size as \p input
      */
     template < typename T1, typename T2 >
     void indirect_sort( std::vector< T1 >& input, std::vector< T2 >& output )
     {
+        ringmesh_assert( input.size() == output.size() );
         if( input.size() < 2 )
         {
             return;
         }
-        for( auto it1 : range( input.size() - 1 ) )
+        std::vector< index_t > permutation( input.size() );
+        std::iota( permutation.begin(), permutation.end(), 0 );
+        std::stable_sort( permutation.begin(), permutation.end(),
+            [&input]( index_t lhs, index_t rhs ) {
+                return input[lhs] < input[rhs];
+            } );
+        apply_permutation( input, permutation );
+        apply_permutation( output, permutation );
+    }
+
+    /*!
+     * @brief Parallel version of indirect_sort
+     * @param[in,out] input the values to sort
+     * @param[in,out] output the values reordered as \p input,
+     * same size as \p input
+     */
+    template < typename T1, typename T2 >
+    void parallel_indirect_sort(
+        std::vector< T1 >& input, std::vector< T2 >& output )
+    {
+        ringmesh_assert( input.size() == output.size() );
+        if( input.size() < 2 )
         {
-            index_t ref_index = it1;
-            T1 ref_value = input[it1];
-            for( auto it2 : range( it1 + 1, input.size() ) )
-            {
-                index_t new_index = it2;
-                T1 new_value = input[it2];
-                if( ref_value > new_value )
-                {
-                    ref_value = new_value;
-                    ref_index = new_index;
-                }
-            }
-            std::iter_swap( input.begin() + it1, input.begin() + ref_index );
-            std::iter_swap( output.begin() + it1, output.begin() + ref_index );
+            return;
         }
+        std::vector< index_t > permutation( input.size() );
+        std::iota( permutation.begin(), permutation.end(), 0 );
+        auto cmp = [&input]( index_t lhs, index_t rhs ) {
+            return input[lhs] < input[rhs];
+        };
+        using Iterator = std::vector< index_t >::iterator;
+        using Cmp = decltype( cmp );
+        parallel_merge_sort( permutation.begin(), permutation.end(), cmp,
+            []( Iterator begin, Iterator end, const Cmp& chunk_cmp ) {
+                std::stable_sort( begin, end, chunk_cmp );
+            } );
+        apply_permutation( input, permutation );
+        apply_permutation( output, permutation );
+    }
+
+    /*!
+     * @brief Suppresses the duplicated entities of a container sorted
+     * according to \p cmp.
+     * @details Two consecutive entities are duplicated if neither is lower
+     * than the other.
+     */
+    template < typename CONTAINER, typename CMP >
+    void erase_sorted_duplicates( CONTAINER& container, const CMP& cmp )
+    {
+        using Value = typename CONTAINER::value_type;
+        container.erase(
+            std::unique( container.begin(), container.end(),
+                [&cmp]( const Value& lhs, const Value& rhs ) {
+                    return !cmp( lhs, rhs );
+                } ),
+            container.end() );
     }
 
     /*!
@@ -137,8 +283,7 @@ namespace RINGMesh
     void sort_unique( CONTAINER& container, const CMP& cmp )
     {
         std::sort( container.begin(), container.end(), cmp );
-        container.erase( std::unique( container.begin(), container.end(), cmp ),
-            container.end() );
+        erase_sorted_duplicates( container, cmp );
     }
 
     /*!
@@ -152,4 +297,30 @@ namespace RINGMesh
         container.erase( std::unique( container.begin(), container.end() ),
             container.end() );
     }
+
+    /*!
+     * @brief Sorts a container using several threads and suppresses all
+     * duplicated entities.
+     * @param[in,out] container the container to sort
+     * @param[in] cmp a comparator function
+     */
+    template < typename CONTAINER, typename CMP >
+    void parallel_sort_unique( CONTAINER& container, const CMP& cmp )
+    {
+        parallel_sort( container, cmp );
+        erase_sorted_duplicates( container, cmp );
+    }
+
+    /*!
+     * @brief Sorts a container using several threads and suppresses all
+     * duplicated entities.
+     * @param[in,out] container the container to sort
+     */
+    template < typename CONTAINER >
+    void parallel_sort_unique( CONTAINER& container )
+    {
+        parallel_sort( container );
+        container.erase( std::unique( container.begin(), container.end() ),
+            container.end() );
+    }
 } // namespace RINGMesh
@@ -80,6 +80,13 @@ namespace RINGMesh
 
         bool contains( const vecn< DIMENSION >& b ) const;
 
+        /*!
+         * @brief Tests if the segment [\p p0, \p p1] crosses the box
+         * @details Slab test clipping the segment parameter to [0,1].
+         */
+        bool segment_overlap(
+            const vecn< DIMENSION >& p0, const vecn< DIMENSION >& p1 ) const;
+
         /*!
          * Computes the squared distance of the query point \p p to
          * the center of the box
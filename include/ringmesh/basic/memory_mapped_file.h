@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#pragma once
+
+#include <ringmesh/basic/common.h>
+
+#include <ringmesh/basic/pimpl.h>
+
+/*!
+ * @file Memory mapping of a file
+ */
+
+namespace RINGMesh
+{
+    /*!
+     * @brief Maps a file, or a part of it, in memory.
+     * Pages are only read from the disk when they are accessed.
+     */
+    class basic_api MemoryMappedFile
+    {
+        ringmesh_disable_copy_and_move( MemoryMappedFile );
+
+    public:
+        enum struct Mode
+        {
+            /// The mapping can only be read
+            READ_ONLY,
+            /// The modifications of the mapping are written in the file,
+            /// which is created or extended if needed
+            READ_WRITE,
+            /// The modifications of the mapping are kept in memory,
+            /// the file is left unchanged
+            COPY_ON_WRITE
+        };
+
+        /*!
+         * @brief Maps a whole file for reading
+         */
+        explicit MemoryMappedFile( const std::string& filename );
+
+        /*!
+         * @brief Maps a range of bytes of a file
+         * @param[in] filename the file to map
+         * @param[in] mode the access to the mapping
+         * @param[in] offset the first byte of the range, it does not need
+         * to be aligned on a memory page
+         * @param[in] size the number of bytes of the range
+         */
+        MemoryMappedFile( const std::string& filename,
+            Mode mode,
+            std::size_t offset,
+            std::size_t size );
+
+        ~MemoryMappedFile();
+
+        const char* data() const;
+
+        /*!
+         * @pre The file is not mapped in Mode::READ_ONLY
+         */
+        char* mutable_data();
+
+        std::size_t size() const;
+
+        /*!
+         * @brief Changes the number of mapped bytes, the file is resized
+         * @pre The file is mapped in Mode::READ_WRITE
+         */
+        void resize( std::size_t size );
+
+    private:
+        IMPLEMENTATION_MEMBER( impl_ );
+    };
+} // namespace RINGMesh
@@ -84,6 +84,12 @@ namespace RINGMesh
                 {
                     task.wait();
                 }
+                // Rethrows the first exception thrown by a task, if any
+                for( auto& task : tasks_ )
+                {
+                    task.get();
+                }
+                tasks_.clear();
             }
         }
 
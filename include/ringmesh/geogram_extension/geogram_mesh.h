@@ -43,6 +43,7 @@
 #include <geogram/mesh/mesh_io.h>
 
 #include <ringmesh/geogram_extension/geogram_extension.h>
+#include <ringmesh/geogram_extension/geogram_mesh_serializer.h>
 
 #include <ringmesh/mesh/mesh_index.h>
 
@@ -74,6 +75,10 @@ public:                                                                        \
     {                                                                          \
         GEO::mesh_save( *mesh_, filename, GEO::MeshIOFlags() );                \
     }                                                                          \
+    void save_mesh( std::vector< char >& buffer ) const override               \
+    {                                                                          \
+        save_geogram_mesh( *mesh_, buffer );                                   \
+    }                                                                          \
     GEO::Mesh& geogram_mesh()                                                  \
     {                                                                          \
         return *mesh_;                                                         \
@@ -63,6 +63,10 @@ public:                                                                        \
         ioflags.set_attribute( GEO::MESH_ALL_ATTRIBUTES );                     \
         GEO::mesh_load( filename, *mesh_.mesh_, ioflags );                     \
     }                                                                          \
+    void load_mesh( const char* data, std::size_t size ) override              \
+    {                                                                          \
+        load_geogram_mesh( data, size, *mesh_.mesh_ );                         \
+    }                                                                          \
     void do_clear( bool keep_attributes, bool keep_memory ) override           \
     {                                                                          \
         mesh_.mesh_->clear( keep_attributes, keep_memory );                    \
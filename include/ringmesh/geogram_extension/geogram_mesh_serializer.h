@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#pragma once
+
+#include <ringmesh/geogram_extension/common.h>
+
+#include <vector>
+
+namespace GEO
+{
+    class Mesh;
+} // namespace GEO
+
+/*!
+ * @file Serialization of GEO::Mesh into memory buffers
+ */
+
+namespace RINGMesh
+{
+    /*!
+     * @brief Appends a GEO::Mesh (vertices, edges, facets, cells,
+     * adjacencies and all the attributes) at the end of a memory buffer
+     * @param[in] mesh the mesh to save
+     * @param[in,out] buffer the buffer to fill
+     */
+    void geogram_extension_api save_geogram_mesh(
+        const GEO::Mesh& mesh, std::vector< char >& buffer );
+
+    /*!
+     * @brief Loads a GEO::Mesh saved with save_geogram_mesh
+     * @param[in] data pointer to the beginning of the saved mesh
+     * @param[in] size number of bytes available from \p data
+     * @param[out] mesh the mesh to fill, it is cleared first
+     * @return the number of bytes read
+     */
+    std::size_t geogram_extension_api load_geogram_mesh(
+        const char* data, std::size_t size, GEO::Mesh& mesh );
+} // namespace RINGMesh
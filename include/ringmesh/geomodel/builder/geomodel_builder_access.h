@@ -60,6 +60,7 @@ namespace RINGMesh
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelGeologicalEntity );
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModel );
     FORWARD_DECLARATION_DIMENSION_CLASS( MeshBase );
+    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelMeshEntityLoader );
     FORWARD_DECLARATION_DIMENSION_STRUCT( EntityTypeManager );
 
     class GeologicalEntityType;
@@ -92,6 +93,7 @@ namespace RINGMesh
 
         const std::shared_ptr< MeshBase< DIMENSION > >& mesh() const
         {
+            gmme_.load_deferred_mesh();
             return gmme_.mesh_;
         }
 
@@ -161,9 +163,17 @@ namespace RINGMesh
 
         std::shared_ptr< MeshBase< DIMENSION > >& modifiable_mesh()
         {
+            gmme_.release_mesh_loader();
             return gmme_.mesh_;
         }
 
+        void set_mesh_loader(
+            std::shared_ptr< GeoModelMeshEntityLoader< DIMENSION > > loader,
+            index_t source )
+        {
+            gmme_.set_mesh_loader( std::move( loader ), source );
+        }
+
         void copy( const GeoModelMeshEntity< DIMENSION >& from )
         {
             gmme_.copy_mesh_entity( from );
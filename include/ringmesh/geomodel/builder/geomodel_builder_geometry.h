@@ -87,6 +87,22 @@ namespace RINGMesh
             gmme_access.change_mesh_data_structure( type );
         }
 
+        /*!
+         * @brief Defers the loading of a GeoModelMeshEntity mesh until it is
+         * accessed
+         * @param[in] id the GeoModelMeshEntity id to operate on
+         * @param[in] loader the loader of the entity mesh
+         * @param[in] source the source of the entity mesh in the \p loader
+         */
+        void defer_mesh_loading( const gmme_id& id,
+            std::shared_ptr< GeoModelMeshEntityLoader< DIMENSION > > loader,
+            index_t source )
+        {
+            GeoModelMeshEntityAccess< DIMENSION > gmme_access(
+                geomodel_access_.modifiable_mesh_entity( id ) );
+            gmme_access.set_mesh_loader( std::move( loader ), source );
+        }
+
         /*!
          * @brief Create a PointMeshBuilder for a given corner
          * @param[in] corner_id the corner index
@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <ringmesh/geomodel/core/common.h>
 
 namespace RINGMesh
@@ -45,10 +47,32 @@ namespace RINGMesh
 
 namespace RINGMesh
 {
+    /*!
+     * @brief Registry of the entity type names
+     * @details Each name is stored once and identified by its index, so that
+     * the entity types are copied and compared as integers. The name
+     * "No_entity_type" is registered first, its index is 0.
+     * The registry is shared by all the threads. Only the registration of
+     * a name locks it, the registered names are read without locking.
+     */
+    class geomodel_core_api EntityTypeRegistry
+    {
+    public:
+        /*!
+         * @return the index of the name, which is registered if needed
+         */
+        static index_t id( const std::string& name );
+
+        /*!
+         * @return the name of a registered index
+         */
+        static const std::string& name( index_t id );
+    };
+
     /*
      * @brief Abstract class defining a Geomodel Entity Type
-     * This class encapsulate a string which contains the name of the entity
-     * type
+     * This class encapsulate the index of the name of the entity type
+     * in the EntityTypeRegistry
      * It contains useful operator to compare and display the type
      * It is possible to do cast of an EntityType -> string
      */
@@ -57,45 +81,100 @@ namespace RINGMesh
     public:
         bool operator==( const EntityType& type2 ) const
         {
-            return type_ == type2.type_;
+            return id_ == type2.id_;
         }
         bool operator!=( const EntityType& type2 ) const
         {
-            return type_ != type2.type_;
+            return id_ != type2.id_;
         }
         friend std::ostream& operator<<(
             std::ostream& os, const EntityType& in )
         {
-            os << in.type_;
+            os << in.string();
             return os;
         }
+        /*!
+         * @brief Compares the type names, so that the containers sorted by
+         * type do not depend on the registration order
+         */
         bool operator<( const EntityType& rhs ) const
         {
-            return type_ < rhs.type_;
+            return id_ != rhs.id_ && string() < rhs.string();
         }
 
         const std::string& string() const
         {
-            return type_;
+            return EntityTypeRegistry::name( id_ );
+        }
+
+        /*!
+         * @return the index of the type name in the EntityTypeRegistry
+         */
+        index_t id() const
+        {
+            return id_;
         }
 
     private:
-        std::string type_{};
+        index_t id_{ 0 };
 
     protected:
-        explicit EntityType( std::string type ) : type_( std::move( type ) ) {}
-        EntityType() : EntityType( default_entity_type_string() ) {}
+        explicit EntityType( const std::string& type )
+            : id_( EntityTypeRegistry::id( type ) )
+        {
+        }
+        EntityType() = default;
+
+        void set_type( const std::string& type )
+        {
+            id_ = EntityTypeRegistry::id( type );
+        }
+    };
 
-        void set_type( std::string type )
+    /*!
+     * @brief Map from entity types to values, stored in an array indexed
+     * by the type ids so that a lookup is an array access
+     */
+    template < typename Type, typename T >
+    class EntityTypeMap
+    {
+    public:
+        /*!
+         * @brief Gets the value of a type, a default value is added if the
+         * type has none
+         */
+        T& operator[]( const Type& type )
         {
-            type_ = std::move( type );
+            if( type.id() >= values_.size() )
+            {
+                values_.resize( type.id() + 1 );
+            }
+            return values_[type.id()];
         }
 
-    private:
-        std::string default_entity_type_string()
+        const T& at( const Type& type ) const
         {
-            return "No_entity_type";
+            ringmesh_assert( type.id() < values_.size() );
+            return values_[type.id()];
         }
+
+        T& at( const Type& type )
+        {
+            ringmesh_assert( type.id() < values_.size() );
+            return values_[type.id()];
+        }
+
+        /*!
+         * @return the values of all the types, including default values
+         * of the types that were not set
+         */
+        const std::vector< T >& values() const
+        {
+            return values_;
+        }
+
+    private:
+        std::vector< T > values_;
     };
 
     /*!
@@ -109,8 +188,8 @@ namespace RINGMesh
     class geomodel_core_api MeshEntityType : public EntityType
     {
     public:
-        explicit MeshEntityType( std::string type )
-            : EntityType( std::move( type ) )
+        explicit MeshEntityType( const std::string& type )
+            : EntityType( type )
         {
         }
         MeshEntityType() = default;
@@ -129,8 +208,8 @@ namespace RINGMesh
     class geomodel_core_api GeologicalEntityType : public EntityType
     {
     public:
-        explicit GeologicalEntityType( std::string type )
-            : EntityType( std::move( type ) )
+        explicit GeologicalEntityType( const std::string& type )
+            : EntityType( type )
         {
         }
         GeologicalEntityType() = default;
@@ -294,4 +373,9 @@ namespace RINGMesh
                    && index_ != NO_ID;
         }
     };
+
+    static_assert( sizeof( gmme_id ) == 8,
+        "gmme_id should only store the type id and the entity index" );
+    static_assert( sizeof( gmge_id ) == 8,
+        "gmge_id should only store the type id and the entity index" );
 } // namespace RINGMesh
@@ -47,6 +47,7 @@
 #include <ringmesh/basic/factory.h>
 
 #include <ringmesh/geomodel/core/geomodel_entity.h>
+#include <ringmesh/geomodel/core/geomodel_ranges.h>
 
 namespace RINGMesh
 {
@@ -158,6 +159,10 @@ namespace RINGMesh
             return static_cast< index_t >( children_.size() );
         }
         const gmme_id& child_gmme( index_t x ) const;
+        /*!
+         * @brief Range over the child ids, iterating does not allocate
+         */
+        child_range child_gmmes() const;
         const GeoModelMeshEntity< DIMENSION >& child( index_t x ) const;
 
         virtual bool is_identification_valid() const;
@@ -74,6 +74,7 @@ namespace RINGMesh
     FORWARD_DECLARATION_DIMENSION_CLASS( LineAABBTree );
     FORWARD_DECLARATION_DIMENSION_CLASS( SurfaceAABBTree );
     FORWARD_DECLARATION_DIMENSION_CLASS( VolumeAABBTree );
+    FORWARD_DECLARATION_DIMENSION_CLASS( VolumeCellGrid );
 
     ALIAS_3D( GeoModel );
     ALIAS_3D( GeoModelMesh );
@@ -219,6 +220,15 @@ namespace RINGMesh
         index_t geomodel_vertex_id( const gmme_id& mesh_entity,
             const ElementLocalVertex& element_local_vertex ) const;
 
+        /*!
+         * @brief Get the GeoModelMesh indices of all the vertices of a
+         * GeoModelMeshEntity
+         * @param[in] mesh_entity Unique id to a GeoModelMeshEntity
+         * @return the GeoModelMesh index of each GeoModelMeshEntity vertex
+         */
+        const std::vector< index_t >& geomodel_vertex_ids(
+            const gmme_id& mesh_entity ) const;
+
         /*!
          * @brief Get the GeoModelMeshEntity vertices from its index in the
          * GeoModelMesh
@@ -256,6 +266,27 @@ namespace RINGMesh
             index_t entity_vertex_index,
             index_t geomodel_vertex_index );
 
+        /*!
+         * @brief Sets the vertices computed beforehand, for instance read
+         * from a file, instead of initializing them from the
+         * GeoModelMeshEntity vertices
+         * @details The mapping of the GeoModelMeshEntity vertices is then
+         * given by assign_vertex_mapping.
+         * @param[in] point_coordinates the coordinates of the vertices
+         */
+        void assign_vertices( const std::vector< double >& point_coordinates );
+
+        /*!
+         * @brief Sets the GeoModelMesh index of all the vertices of a
+         * GeoModelMeshEntity
+         * @pre assign_vertices has been called
+         * @param[in] entity_id the GeoModelMeshEntity
+         * @param[in] geomodel_vertex_ids the GeoModelMesh index of each
+         * vertex of the GeoModelMeshEntity
+         */
+        void assign_vertex_mapping( const gmme_id& entity_id,
+            std::vector< index_t > geomodel_vertex_ids );
+
         /*!
          * @brief Clear the vertices - clear the gme_vertices_ -
          *        clear global vertex information in the all BMME
@@ -1213,6 +1244,13 @@ namespace RINGMesh
          */
         const VolumeAABBTree< DIMENSION >& aabb() const;
 
+        /*!
+         * @brief return the Cartesian grid indexing the cells of the mesh
+         * @details Its containing_cell() is faster than the AABB one
+         * for dense point sampling, at the price of more memory.
+         */
+        const VolumeCellGrid< DIMENSION >& cell_grid() const;
+
         /*!
          * @brief Get the mesh containing all the cells
          * @return the VolumeMesh containing all the cells
@@ -1238,6 +1276,19 @@ namespace RINGMesh
         };
         /// Action to do according a surface index
         using action_on_surface = std::pair< index_t, ActionOnSurface >;
+        /*!
+         * @brief Cells around a vertex to duplicate connected without
+         * crossing a surface, i.e. one side of the vertex.
+         */
+        struct VertexFan
+        {
+            /// Index of the vertex in the GeoModelMesh
+            index_t vertex{ NO_ID };
+            /// First cell corner of the fan, gives the processing order
+            index_t first_corner{ NO_ID };
+            /// Surfaces (sorted and unique) stopping the propagation
+            std::vector< action_on_surface > surfaces;
+        };
 
         /*!
          * @brief Initialize the  cells from the cells
@@ -1284,6 +1335,25 @@ namespace RINGMesh
         bool are_corners_to_duplicate(
             const std::vector< action_on_surface >& surfaces,
             std::vector< ActionOnSurface >& info );
+        /*!
+         * Split the cells around a vertex into VertexFans by propagating
+         * through the cell facets that are not on a surface.
+         * This function is thread safe once the cell facets are initialized.
+         * @param[in] vertex_id the vertex index in the GeoModelMesh
+         * @param[in] vertex_cells the sorted cells around the vertex
+         * are in the range [\p begin, \p end) of this vector
+         * @param[in,out] cell_fans the local fan index of each cell
+         * of the range, must be NO_ID on input
+         * @param[out] fans the fans are appended to this vector
+         * @param[in,out] stack scratch buffer for the propagation
+         */
+        void compute_vertex_fans( index_t vertex_id,
+            const std::vector< index_t >& vertex_cells,
+            index_t begin,
+            index_t end,
+            std::vector< index_t >& cell_fans,
+            std::vector< VertexFan >& fans,
+            std::vector< index_t >& stack ) const;
         /*!
          * Test if the mesh cell facet vector is filled with
          * the colocalised facet. If not fill it.
@@ -1291,6 +1361,8 @@ namespace RINGMesh
         void test_and_initialize_cell_facet() const;
         /*!
          * Initialize the mesh cell facet vector of colocalised facet.
+         * Cell facets and polygons are matched by their sorted vertex
+         * indices.
          */
         void initialize_cell_facet();
 
@@ -42,7 +42,11 @@
 
 #include <ringmesh/geomodel/core/common.h>
 
+#include <atomic>
+#include <mutex>
+
 #include <ringmesh/geomodel/core/geomodel_entity.h>
+#include <ringmesh/geomodel/core/geomodel_ranges.h>
 
 namespace GEO
 {
@@ -54,6 +58,7 @@ namespace RINGMesh
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelGeologicalEntity );
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelMeshEntityAccess );
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelMeshEntityConstAccess );
+    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelMeshEntityLoader );
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelBuilderTopologyBase );
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelBuilderTopology );
     FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelBuilderGeometryBase );
@@ -140,6 +145,10 @@ namespace RINGMesh
         }
         const gmme_id& boundary_gmme( index_t x ) const;
         const GeoModelMeshEntity< DIMENSION >& boundary( index_t x ) const;
+        /*!
+         * @brief Range over the boundary ids, iterating does not allocate
+         */
+        boundary_range boundary_gmmes() const;
 
         index_t nb_incident_entities() const
         {
@@ -148,6 +157,11 @@ namespace RINGMesh
         const gmme_id& incident_entity_gmme( index_t x ) const;
         const GeoModelMeshEntity< DIMENSION >& incident_entity(
             index_t x ) const;
+        /*!
+         * @brief Range over the incident entity ids, iterating does not
+         * allocate
+         */
+        incident_entity_range incident_entity_gmmes() const;
 
         /*!
          * @brief Check if one entity is twice in the boundary
@@ -181,6 +195,10 @@ namespace RINGMesh
         }
 
         const gmge_id& parent_gmge( index_t id ) const;
+        /*!
+         * @brief Range over the parent ids, iterating does not allocate
+         */
+        parent_range parent_gmges() const;
 
         /*!
          * @brief Returns the gmge_id of the parent of the given type.
@@ -206,6 +224,10 @@ namespace RINGMesh
          */
 
         void save( const std::string& filename ) const;
+        /*!
+         * @brief Saves the entity mesh at the end of a memory buffer
+         */
+        void save( std::vector< char >& buffer ) const;
         /*!
          * @brief Return the NNSearch for the Entity vertices.
          */
@@ -297,6 +319,16 @@ namespace RINGMesh
          */
         GEO::AttributesManager& vertex_attribute_manager() const;
 
+        /*!
+         * @brief Tells whether the entity mesh is in memory
+         * @details It is false when the mesh loading has been deferred and
+         * the mesh has not been accessed yet.
+         */
+        bool is_mesh_loaded() const
+        {
+            return !mesh_deferred_;
+        }
+
     protected:
         GeoModelMeshEntity( const GeoModel< DIMENSION >& geomodel, index_t id )
             : GeoModelEntity< DIMENSION >( geomodel, id )
@@ -325,6 +357,18 @@ namespace RINGMesh
             mesh_ = std::move( mesh );
         }
 
+        /*!
+         * @brief Loads the entity mesh if its loading has been deferred
+         * @details Must be called before any access to the mesh.
+         */
+        void load_deferred_mesh() const
+        {
+            if( mesh_deferred_ )
+            {
+                load_mesh_from_loader();
+            }
+        }
+
         /*!
          * All entities in the boundary must have this in their
          *  incident_entity vector
@@ -357,6 +401,28 @@ namespace RINGMesh
         gmge_id could_be_undefined_parent_gmge(
             const GeologicalEntityType& parent_type ) const;
 
+        const MeshBase< DIMENSION >& base_mesh() const
+        {
+            load_deferred_mesh();
+            return *mesh_;
+        }
+
+        void load_mesh_from_loader() const;
+
+        /*!
+         * @brief Defers the loading of the entity mesh until its first access
+         * @param[in] loader the loader of the mesh
+         * @param[in] source the source of the mesh in the \p loader
+         */
+        void set_mesh_loader(
+            std::shared_ptr< GeoModelMeshEntityLoader< DIMENSION > > loader,
+            index_t source );
+
+        /*!
+         * @brief Loads the entity mesh and detaches it from its loader
+         */
+        void release_mesh_loader();
+
     protected:
         /// Boundary relations of this entity
         std::vector< index_t > boundaries_{};
@@ -370,6 +436,12 @@ namespace RINGMesh
     private:
         /// The RINGMesh::Mesh giving the geometry of this entity
         std::shared_ptr< MeshBase< DIMENSION > > mesh_{};
+
+        /// Loader of the mesh when its loading is deferred
+        std::shared_ptr< GeoModelMeshEntityLoader< DIMENSION > > mesh_loader_{};
+        index_t mesh_source_{ NO_ID };
+        mutable std::atomic< bool > mesh_deferred_{ false };
+        mutable std::mutex mesh_lock_{};
     };
     ALIAS_2D_AND_3D( GeoModelMeshEntity );
 
@@ -443,6 +515,7 @@ namespace RINGMesh
          */
         const PointSetMesh< DIMENSION >& mesh() const
         {
+            this->load_deferred_mesh();
             return *point_set_mesh_;
         }
 
@@ -575,6 +648,7 @@ namespace RINGMesh
          */
         const LineMesh< DIMENSION >& mesh() const
         {
+            this->load_deferred_mesh();
             return *line_mesh_;
         }
 
@@ -703,6 +777,7 @@ namespace RINGMesh
          */
         const SurfaceMesh< DIMENSION >& mesh() const
         {
+            this->load_deferred_mesh();
             return *surface_mesh_;
         }
 
@@ -810,6 +885,13 @@ namespace RINGMesh
     public:
         bool is_on_voi() const final;
         const Region< 3 >& incident_entity( index_t x ) const;
+
+        /*!
+         * @brief Gets the Region on one side of the Surface
+         * @param[in] side true for the side pointed by the polygon normals
+         * @return the Region index, NO_ID if there is no Region on this side
+         */
+        index_t region_on_side( bool side ) const;
     };
     ALIAS_2D_AND_3D( Surface );
 
@@ -943,6 +1025,7 @@ namespace RINGMesh
          */
         const VolumeMesh< DIMENSION >& mesh() const
         {
+            this->load_deferred_mesh();
             return *volume_mesh_;
         }
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#pragma once
+
+#include <ringmesh/geomodel/core/common.h>
+
+/*!
+ * @file Deferred loading of the GeoModelMeshEntity meshes
+ */
+
+namespace RINGMesh
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModelMeshEntity );
+    FORWARD_DECLARATION_DIMENSION_CLASS( MeshBase );
+} // namespace RINGMesh
+
+namespace RINGMesh
+{
+    /*!
+     * @brief Loads the meshes of GeoModelMeshEntities on demand
+     * @details A loader is shared by the entities whose mesh loading has
+     * been deferred. Each entity refers to its mesh by a source index
+     * defined by the loader, and its mesh is loaded the first time it is
+     * accessed. A loaded mesh stays in memory until the entity is deleted.
+     * The meshes of the entities modified through a GeoModelBuilder are no
+     * longer handled by the loader.
+     */
+    template < index_t DIMENSION >
+    class GeoModelMeshEntityLoader
+    {
+        ringmesh_disable_copy_and_move( GeoModelMeshEntityLoader );
+        ringmesh_template_assert_2d_or_3d( DIMENSION );
+        friend class GeoModelMeshEntity< DIMENSION >;
+
+    public:
+        virtual ~GeoModelMeshEntityLoader() = default;
+
+    protected:
+        GeoModelMeshEntityLoader() = default;
+
+        /*!
+         * @brief Fills an empty mesh with the mesh stored in a source
+         */
+        virtual void load_mesh(
+            index_t source, MeshBase< DIMENSION >& mesh ) const = 0;
+    };
+    ALIAS_2D_AND_3D( GeoModelMeshEntityLoader );
+} // namespace RINGMesh
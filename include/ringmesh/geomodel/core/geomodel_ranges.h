@@ -37,6 +37,9 @@
 
 #include <ringmesh/geomodel/core/common.h>
 
+#include <ringmesh/geomodel/core/entity_type.h>
+#include <ringmesh/geomodel/core/entity_type_manager.h>
+
 /*!
  * @brief Structures and classes used to index elements in a GeoModel,
  * in the meshes of its entities etc.
@@ -183,4 +186,50 @@ namespace RINGMesh
     protected:
         const GeologicalEntityType type_{};
     };
+
+    /*!
+     * @brief Range over the relations of one entity: its boundaries, its
+     * incident entities, its parents or its children.
+     * @details The relation ids are read in place in the entity and the
+     * related entity ids in the RelationshipManager, so iterating does not
+     * allocate any memory.
+     */
+    template < typename ID,
+        const ID& ( RelationshipManager::*RELATION )( index_t ) const >
+    class relation_range : public range
+    {
+    public:
+        relation_range( const RelationshipManager& manager,
+            const std::vector< index_t >& relations )
+            : range( relations.size() ),
+              manager_( manager ),
+              relations_( relations.data() )
+        {
+        }
+        const relation_range< ID, RELATION >& begin() const
+        {
+            return *this;
+        }
+        const relation_range< ID, RELATION >& end() const
+        {
+            return *this;
+        }
+        const ID& operator*() const
+        {
+            return ( manager_.*RELATION )( relations_[this->iter_] );
+        }
+
+    private:
+        const RelationshipManager& manager_;
+        const index_t* relations_;
+    };
+
+    using boundary_range =
+        relation_range< gmme_id, &RelationshipManager::boundary_gmme >;
+    using incident_entity_range =
+        relation_range< gmme_id, &RelationshipManager::incident_entity_gmme >;
+    using parent_range =
+        relation_range< gmge_id, &RelationshipManager::parent_of_gmme >;
+    using child_range =
+        relation_range< gmme_id, &RelationshipManager::child_of_gmge >;
 } // namespace RINGMesh
@@ -467,6 +467,18 @@ namespace RINGMesh
         void add_well(
             const LineMesh< DIMENSION >& mesh, const std::string& name );
 
+        /*!
+         * Adds wells from their trajectories and makes them conformal to the
+         * associated GeoModel
+         * @details The wells are processed in parallel, then added in the
+         * input order. A well whose name is already used is ignored.
+         * @param[in] trajectories the successive vertices of each well
+         * @param[in] names the names of the wells
+         */
+        void add_wells(
+            const std::vector< std::vector< vecn< DIMENSION > > >& trajectories,
+            const std::vector< std::string >& names );
+
         /*!
          * Gets the number of wells
          */
@@ -496,4 +508,33 @@ namespace RINGMesh
     };
 
     ALIAS_2D_AND_3D( WellGroup );
+
+    /*!
+     * @brief Location of a well vertex in the GeoModelMesh cells
+     */
+    struct WellVertexLocation
+    {
+        /// Region containing the vertex
+        index_t region{ NO_ID };
+        /// GeoModelMesh cell containing the vertex
+        index_t cell{ NO_ID };
+    };
+
+    /*!
+     * @brief Locates the vertices of well trajectories in the GeoModelMesh
+     * cells
+     * @details Along each trajectory, the containing cell of a vertex is
+     * found by walking through the cell adjacencies from the cell of the
+     * previous vertex. The cell AABB tree is used when the walk fails.
+     * The trajectories are processed in parallel.
+     * @param[in] geomodel the GeoModel, whose regions are meshed with
+     * tetrahedra
+     * @param[in] trajectories the vertices of each well trajectory
+     * @return the location of each vertex of each trajectory, NO_ID indices
+     * for vertices outside the GeoModel
+     */
+    std::vector< std::vector< WellVertexLocation > >
+        geomodel_core_api locate_well_trajectories(
+            const GeoModel< 3 >& geomodel,
+            const std::vector< std::vector< vec3 > >& trajectories );
 } // namespace RINGMesh
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#pragma once
+
+#include <ringmesh/geomodel/tools/common.h>
+
+/*!
+ * @file Rasterization of GeoModel regions on Cartesian grids
+ */
+
+namespace RINGMesh
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModel );
+    FORWARD_DECLARATION_DIMENSION_CLASS( CartesianGrid );
+
+    ALIAS_3D( GeoModel );
+    ALIAS_3D( CartesianGrid );
+} // namespace RINGMesh
+
+namespace RINGMesh
+{
+    /*!
+     * @brief Computes the region containing the center of each cell of a
+     * Cartesian grid
+     * @details The grid is processed by slabs of constant third index in
+     * parallel. Along each grid line of the first axis, the crossings with
+     * the GeoModel surfaces are computed once and the regions are deduced
+     * from the surface sides, so that no point location is done per cell.
+     * @param[in] geomodel the GeoModel to rasterize
+     * @param[in,out] grid the grid on which the index_t attribute
+     * "region" is created, NO_ID for cells outside the GeoModel
+     * @param[in] compute_cells if true, the index_t attribute "cell" is also
+     * created with the GeoModelMesh cell containing each grid cell center
+     */
+    void geomodel_tools_api rasterize_regions( const GeoModel3D& geomodel,
+        CartesianGrid3D& grid,
+        bool compute_cells = false );
+} // namespace RINGMesh
@@ -37,6 +37,8 @@
 
 #include <ringmesh/geomodel/tools/common.h>
 
+#include <vector>
+
 /*!
  * @author Benjamin Chauvin
  * This code is inspired from
@@ -62,6 +64,20 @@ namespace RINGMesh
         MIN_SOLID_ANGLE
     };
 
+    /*!
+     * @brief Statistics on the cell qualities of a GeoModel
+     */
+    struct MeshQualityStatistics
+    {
+        double min_quality{ max_float64() };
+        double max_quality{ -max_float64() };
+        double mean_quality{ 0 };
+        index_t nb_cells{ 0 };
+        /// Number of cells per quality interval, the intervals split [0,1]
+        /// in histogram.size() equal parts.
+        std::vector< index_t > histogram;
+    };
+
     /*!
      * @brief Computes and stores mesh quality in the GeoModel.
      *
@@ -77,15 +93,65 @@ namespace RINGMesh
      * href="http://people.sc.fsu.edu/~jburkardt/cpp_src/tet_mesh_quality/tet_mesh_quality.html">
      * TET_MESH_QUALITY Interactive Program for Tet Mesh Quality</a>
      *
+     * The tetrahedra are processed by blocks in parallel, the quality mode
+     * being selected once for all the cells.
+     *
      * @param[in] mesh_qual_mode mesh quality to compute.
      * @param[in,out] geomodel GeoModel in which the mesh quality is performed.
      * The quality is stored on the cells of each Region.
+     * @param[in] nb_histogram_bins number of intervals of the returned
+     * quality histogram.
+     * @return the statistics on the computed qualities.
+     * @throw RINGMeshException if \p nb_histogram_bins is 0.
      *
      * @warning The GeoModel must have at least one region. All the regions
      * must be meshed by simplexes (tetrahedra).
      */
-    void geomodel_tools_api compute_prop_tet_mesh_quality(
-        MeshQualityMode mesh_qual_mode, const GeoModel3D& geomodel );
+    MeshQualityStatistics geomodel_tools_api compute_prop_tet_mesh_quality(
+        MeshQualityMode mesh_qual_mode,
+        const GeoModel3D& geomodel,
+        index_t nb_histogram_bins = 10 );
+
+    /*!
+     * @brief Computes the quality of one tetrahedron with the kernels used
+     * by compute_prop_tet_mesh_quality.
+     * @return the quality between 0 (flat tetrahedron) and 1 (regular
+     * tetrahedron).
+     */
+    double geomodel_tools_api tetrahedron_quality(
+        MeshQualityMode mesh_qual_mode,
+        const vec3& v0,
+        const vec3& v1,
+        const vec3& v2,
+        const vec3& v3 );
+
+    /*!
+     * @brief Improves the cells of low quality after tetrahedralization.
+     *
+     * The quality is computed with compute_prop_tet_mesh_quality, then only
+     * the neighborhood of the cells with a quality below \p min_quality is
+     * modified by local flips and vertex smoothing, keeping the regions
+     * conformal to their boundaries (see improve_tetrahedra_quality).
+     * The quality attribute is finally recomputed on the modified regions.
+     *
+     * @param[in] mesh_qual_mode mesh quality to improve.
+     * @param[in] min_quality cells with a quality below this value are
+     * improved.
+     * @param[in,out] geomodel GeoModel to improve.
+     * @param[in] nb_iterations maximal number of improvement passes.
+     * @param[in] nb_histogram_bins number of intervals of the returned
+     * quality histogram.
+     * @return the statistics on the qualities after improvement.
+     *
+     * @warning All the regions must be meshed by tetrahedra. The cell
+     * attributes of the modified regions are reset.
+     */
+    MeshQualityStatistics geomodel_tools_api improve_tet_mesh_quality(
+        MeshQualityMode mesh_qual_mode,
+        double min_quality,
+        GeoModel3D& geomodel,
+        index_t nb_iterations = 3,
+        index_t nb_histogram_bins = 10 );
 
     /*!
      * @brief Fill the /p output_mesh with cells of quality below \p min_quality
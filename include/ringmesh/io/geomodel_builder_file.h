@@ -58,6 +58,14 @@ namespace RINGMesh
 
         void build_geomodel();
 
+        /*!
+         * @brief Loads the GeoModel without ending its building
+         * @details The file should store a complete GeoModel (such as the
+         * files saved by RINGMesh), no entity mesh is accessed after the
+         * loading of the file.
+         */
+        void load_geomodel();
+
         const std::string& filename() const
         {
             return filename_;
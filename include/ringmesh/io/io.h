@@ -83,6 +83,19 @@ namespace RINGMesh
     template < index_t DIMENSION >
     bool geomodel_load(
         GeoModel< DIMENSION >& geomodel, const std::string& filename );
+    /*!
+     * Loads a GeoModel from a file and defers the loading of each entity
+     * mesh until its first access. Only the native formats (.gm and .gmb)
+     * support deferred loading, the other formats are entirely loaded.
+     * The GeoModel validity is not checked since it would access all the
+     * meshes.
+     * @param[out] geomodel the geomodel to fill
+     * @param[in] filename the file to load
+     * @see GeoModelMeshEntityLoader
+     */
+    template < index_t DIMENSION >
+    void geomodel_load_lazily(
+        GeoModel< DIMENSION >& geomodel, const std::string& filename );
     /*!
      * Saves a GeoModel to a file
      * @param[in] geomodel the geomodel to save
@@ -119,6 +132,9 @@ namespace RINGMesh
         bool load_geomodel(
             const std::string& filename, GeoModel< DIMENSION >& geomodel );
 
+        void load_geomodel_lazily(
+            const std::string& filename, GeoModel< DIMENSION >& geomodel );
+
         virtual index_t dimension( const std::string& filename ) const
         {
             ringmesh_unused( filename );
@@ -129,6 +145,16 @@ namespace RINGMesh
         GeoModelInputHandler() = default;
         virtual void load(
             const std::string& filename, GeoModel< DIMENSION >& geomodel ) = 0;
+
+        /*!
+         * @brief Loads the GeoModel and defers the loading of the entity
+         * meshes when the format allows it
+         */
+        virtual void load_lazily(
+            const std::string& filename, GeoModel< DIMENSION >& geomodel )
+        {
+            load( filename, geomodel );
+        }
     };
 
     ALIAS_2D_AND_3D( GeoModelInputHandler );
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#pragma once
+
+#include <ringmesh/io/common.h>
+
+#include <iosfwd>
+#include <string>
+
+#include <geogram/basic/geometry.h>
+
+#include <ringmesh/basic/task_handler.h>
+
+/*!
+ * @file Fast text formatting of numbers for ASCII exports
+ */
+
+namespace RINGMesh
+{
+    /*!
+     * @brief Buffer of text in which numbers are formatted without going
+     * through std::ostream
+     * @details Floating point values are formatted like an std::ostream of
+     * the same precision in the "C" locale (i.e. printf "%.<precision>g",
+     * or "%.<precision>e" for the std::scientific notation), so that the
+     * output is identical to the stream one.
+     * Integers and integral floating point values are formatted directly.
+     */
+    class io_api TextWriter
+    {
+    public:
+        explicit TextWriter( int precision = 16, bool scientific = false );
+
+        TextWriter& operator<<( double value );
+
+        TextWriter& operator<<( float value )
+        {
+            return *this << static_cast< double >( value );
+        }
+
+        TextWriter& operator<<( int value );
+        TextWriter& operator<<( unsigned int value );
+        TextWriter& operator<<( long value );
+        TextWriter& operator<<( unsigned long value );
+        TextWriter& operator<<( long long value );
+        TextWriter& operator<<( unsigned long long value );
+
+        TextWriter& operator<<( char value )
+        {
+            buffer_.push_back( value );
+            return *this;
+        }
+
+        TextWriter& operator<<( const char* value )
+        {
+            buffer_.append( value );
+            return *this;
+        }
+
+        TextWriter& operator<<( const std::string& value )
+        {
+            buffer_.append( value );
+            return *this;
+        }
+
+        /*!
+         * @brief Writes the coordinates separated by a space,
+         * as GEO::operator<<( std::ostream&, const vecn& )
+         */
+        template < index_t DIMENSION, typename T >
+        TextWriter& operator<<( const GEO::vecng< DIMENSION, T >& value )
+        {
+            for( auto i : range( DIMENSION ) )
+            {
+                if( i != 0 )
+                {
+                    buffer_.push_back( ' ' );
+                }
+                *this << value[i];
+            }
+            return *this;
+        }
+
+        const std::string& str() const
+        {
+            return buffer_;
+        }
+
+        /*!
+         * @brief Writes the buffer in a stream and clears it
+         */
+        void write( std::ostream& out );
+
+        void clear()
+        {
+            buffer_.clear();
+        }
+
+    private:
+        template < typename UNSIGNED >
+        void write_unsigned( UNSIGNED value );
+
+        template < typename SIGNED, typename UNSIGNED >
+        void write_signed( SIGNED value );
+
+    private:
+        std::string buffer_;
+        int precision_;
+        bool scientific_;
+    };
+
+    /*!
+     * @brief Writes the text of a range of elements in a stream
+     * @details The elements are split in chunks formatted in parallel,
+     * each one in its own TextWriter. The chunks are then written in order
+     * in the stream, so the result is the same as a sequential loop.
+     * @param[in] out the stream to write in
+     * @param[in] nb_elements the number of elements
+     * @param[in] format function formatting one element in a TextWriter,
+     * its signature is void( TextWriter&, index_t )
+     * @param[in] precision the precision of the floating point values
+     * @param[in] scientific true to use the std::scientific notation
+     */
+    template < typename FORMAT >
+    void parallel_write_text( std::ostream& out,
+        index_t nb_elements,
+        const FORMAT& format,
+        int precision = 16,
+        bool scientific = false )
+    {
+        const index_t chunk_size{ 4096 };
+        const index_t nb_chunks_per_batch{ 64 };
+        auto nb_chunks = ( nb_elements + chunk_size - 1 ) / chunk_size;
+        std::vector< TextWriter > chunks(
+            std::min( nb_chunks, nb_chunks_per_batch ),
+            TextWriter{ precision, scientific } );
+        for( index_t batch_start = 0; batch_start < nb_chunks;
+             batch_start += nb_chunks_per_batch )
+        {
+            auto nb_batch_chunks =
+                std::min( nb_chunks_per_batch, nb_chunks - batch_start );
+            parallel_for( nb_batch_chunks, [&chunks, &format, batch_start,
+                                               chunk_size,
+                                               nb_elements]( index_t chunk ) {
+                auto start = ( batch_start + chunk ) * chunk_size;
+                auto end = std::min( start + chunk_size, nb_elements );
+                for( auto element : range( start, end ) )
+                {
+                    format( chunks[chunk], element );
+                }
+            } );
+            for( auto chunk : range( nb_batch_chunks ) )
+            {
+                chunks[chunk].write( out );
+            }
+        }
+    }
+} // namespace RINGMesh
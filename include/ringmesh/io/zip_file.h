@@ -37,6 +37,9 @@
 
 #include <ringmesh/io/common.h>
 
+#include <cstdint>
+#include <vector>
+
 #include <ringmesh/basic/pimpl.h>
 
 /*!
@@ -46,6 +49,36 @@
 
 namespace RINGMesh
 {
+    /*!
+     * @brief Content of a file of a zip archive, as stored in the archive.
+     * Files can be compressed and uncompressed independently of the
+     * archive, for instance in parallel, and then written or read at once.
+     */
+    struct io_api CompressedFile
+    {
+        /// Compression method, 0 (stored) or Z_DEFLATED
+        int method{ 0 };
+        std::vector< char > data;
+        std::size_t uncompressed_size{ 0 };
+        /// CRC-32 of the uncompressed content
+        uint32_t crc{ 0 };
+    };
+
+    /*!
+     * @brief Compresses a file content with the deflate method
+     * @param[in] content the content of the file
+     */
+    CompressedFile io_api compress_file_content(
+        const std::vector< char >& content );
+
+    /*!
+     * @brief Uncompresses a file content and checks its CRC
+     * @param[in] file the file as stored in a zip archive
+     * @return the content of the file
+     */
+    std::vector< char > io_api uncompress_file_content(
+        const CompressedFile& file );
+
     class io_api ZipFile
     {
     public:
@@ -53,6 +86,20 @@ namespace RINGMesh
         ~ZipFile();
 
         void add_file( const std::string& filename );
+        /*!
+         * @brief Adds a file to the archive from a memory buffer
+         * @param[in] filename the name of the file in the archive
+         * @param[in] content the content of the file
+         */
+        void add_file(
+            const std::string& filename, const std::vector< char >& content );
+        /*!
+         * @brief Adds a file already compressed to the archive
+         * @param[in] filename the name of the file in the archive
+         * @param[in] file the compressed content of the file
+         */
+        void add_compressed_file(
+            const std::string& filename, const CompressedFile& file );
 
     private:
         IMPLEMENTATION_MEMBER( impl_ );
@@ -72,6 +119,22 @@ namespace RINGMesh
 
         std::string get_file( const std::string& filename );
 
+        /*!
+         * @brief Uncompresses a file of the archive in memory
+         * @param[in] filename the name of the file in the archive
+         * @return the content of the file
+         */
+        std::vector< char > get_file_content( const std::string& filename );
+        /*!
+         * @brief Uncompresses the current file of the archive in memory
+         */
+        std::vector< char > get_current_file_content();
+        /*!
+         * @brief Reads the current file of the archive without
+         * uncompressing it
+         */
+        CompressedFile get_current_compressed_file();
+
     private:
         IMPLEMENTATION_MEMBER( impl_ );
     };
@@ -35,7 +35,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <type_traits>
+#include <typeinfo>
 
 #include <ringmesh/basic/common.h>
 #include <ringmesh/basic/frame.h>
@@ -43,6 +45,7 @@
 #include <ringmesh/basic/logger.h>
 
 #include <ringmesh/mesh/common.h>
+#include <ringmesh/mesh/mapped_attribute_store.h>
 
 #include <geogram/basic/attributes.h>
 
@@ -52,6 +55,7 @@ namespace GEO
 } // namespace GEO
 namespace RINGMesh
 {
+    FORWARD_DECLARATION_DIMENSION_CLASS( CartesianGridBase );
     FORWARD_DECLARATION_DIMENSION_CLASS( CartesianGridBaseBuilder );
     FORWARD_DECLARATION_DIMENSION_CLASS( CartesianGridBuilder );
 }
@@ -63,6 +67,28 @@ namespace RINGMesh
 
 namespace RINGMesh
 {
+    /*!
+     * Saves the geometry of a Cartesian grid and its attributes in a binary
+     * file (.rgrid). The attribute values are written as they are in memory,
+     * aligned on the page size, so that they can be mapped back.
+     */
+    template < index_t DIMENSION >
+    void mesh_api save_cartesian_grid(
+        const CartesianGridBase< DIMENSION >& grid,
+        const std::string& filename );
+
+    /*!
+     * Replaces the geometry and the attributes of a Cartesian grid by the
+     * ones saved in a binary file by save_cartesian_grid.
+     * \param[in] memory_mapped if true, the attribute values are mapped from
+     * the file and only read when accessed, otherwise they are copied.
+     * Modifications of mapped values are not written back into the file.
+     */
+    template < index_t DIMENSION >
+    void mesh_api load_cartesian_grid( CartesianGridBase< DIMENSION >& grid,
+        const std::string& filename,
+        bool memory_mapped );
+
     /**
      * Template base class for Cartesian grids of different dimensions
      * Each value of the grid represents the cell for which the point
@@ -100,12 +126,13 @@ namespace RINGMesh
             attributes_manager_.resize( nb_total_cells_ );
         }
 
+        /*!
+         * Saves the grid and its attributes in a binary file,
+         * see save_cartesian_grid.
+         */
         void save_mesh( const std::string& filename ) const
         {
-            // TODO
-            throw RINGMeshException( "SAVE",
-                "The save_mesh function is not implemented"
-                "for cartesian grids yet." );
+            save_cartesian_grid( *this, filename );
         }
 
         /*!
@@ -347,12 +374,8 @@ namespace RINGMesh
                 GEO::AttributeStore::
                     create_attribute_store_by_element_type_name(
                         type_to_string< T >(), 1 ) );
-            GEO::Attribute< T > attribute{ attributes_manager_,
-                attribute_name };
-            for( auto i : range( nb_total_cells_ ) )
-            {
-                attribute[i] = values[i];
-            }
+            std::copy( values.begin(), values.end(),
+                attribute_values< T >( attribute_name ) );
         }
 
         /*!
@@ -372,6 +395,74 @@ namespace RINGMesh
             attribute.fill( single_value );
         }
 
+        /*!
+         * Creates a new attribute with the name \attribute_name whose values
+         * are stored in the file \filename and mapped in memory, for
+         * attributes larger than the memory. The file is created or extended
+         * to hold one value per grid cell, the values it contains are kept.
+         */
+        template < typename T >
+        void add_mapped_attribute(
+            const std::string& attribute_name, const std::string& filename )
+        {
+            type_to_string< T >();
+            attributes_manager_.bind_attribute_store( attribute_name,
+                new MappedAttributeStore< T >( filename,
+                    MemoryMappedFile::Mode::READ_WRITE, 0, nb_total_cells_ ) );
+        }
+
+        /*!
+         * Returns the values of the attribute \attribute_name on all the grid
+         * cells, stored contiguously in the cell offset order.
+         * The pointer is invalidated when the grid is modified.
+         */
+        template < typename T >
+        const T* attribute_values( const std::string& attribute_name ) const
+        {
+            const auto* store =
+                attributes_manager_.find_attribute_store( attribute_name );
+            if( store == nullptr || store->dimension() != 1
+                || !store->elements_type_matches( typeid( T ).name() ) )
+            {
+                throw RINGMeshException( "CartesianGrid",
+                    "The grid has no attribute ", attribute_name,
+                    " with one value of this type per cell." );
+            }
+            return static_cast< const T* >( store->data() );
+        }
+
+        template < typename T >
+        T* attribute_values( const std::string& attribute_name )
+        {
+            const auto& grid = *this;
+            return const_cast< T* >(
+                grid.template attribute_values< T >( attribute_name ) );
+        }
+
+        /*!
+         * Copies \values, one per grid cell in the cell offset order, into
+         * the attribute \attribute_name.
+         */
+        template < typename T >
+        void set_attribute_values(
+            const std::string& attribute_name, const T* values )
+        {
+            std::copy( values, values + nb_total_cells_,
+                attribute_values< T >( attribute_name ) );
+        }
+
+        /*!
+         * Copies the values of the attribute \attribute_name into \values,
+         * which should be large enough to hold one value per grid cell.
+         */
+        template < typename T >
+        void get_attribute_values(
+            const std::string& attribute_name, T* values ) const
+        {
+            const auto* attribute = attribute_values< T >( attribute_name );
+            std::copy( attribute, attribute + nb_total_cells_, values );
+        }
+
         /*!
          * Returns the value of the attribute \attribute_name at the grid
          * position \position.
@@ -517,6 +608,7 @@ namespace RINGMesh
                 + cartesian_frame_[1] * nb_cells_axis( 1 )
                 + cartesian_frame_[2] * nb_cells_axis( 2 )
             };
+            grid_cage_.clear();
             grid_cage_.reserve( 6 );
             for( auto i : range( 3 ) )
             {
@@ -620,6 +712,17 @@ namespace RINGMesh
                 cartesian_grid_base_.nb_total_cells_ );
         }
 
+        /*!
+         * Replaces the grid associated to this builder by the one saved in
+         * \filename, see load_cartesian_grid.
+         */
+        void load_mesh(
+            const std::string& filename, bool memory_mapped = false )
+        {
+            load_cartesian_grid(
+                cartesian_grid_base_, filename, memory_mapped );
+        }
+
         /*!
          * Changes the length of vector \axis_id of the reference frame of the
          * grid associated to this builder, and sets it to \new_size.
@@ -760,6 +863,13 @@ namespace RINGMesh
         {
         }
 
+        void load_mesh(
+            const std::string& filename, bool memory_mapped = false )
+        {
+            CartesianGridBaseBuilder< 3 >::load_mesh( filename, memory_mapped );
+            cartesian_grid_.create_grid_cage();
+        }
+
         void resize_vec_axis( index_t axis_id, double new_size )
         {
             CartesianGridBaseBuilder< 3 >::resize_vec_axis( axis_id, new_size );
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#pragma once
+
+#include <algorithm>
+#include <typeinfo>
+
+#include <ringmesh/basic/memory_mapped_file.h>
+#include <ringmesh/mesh/common.h>
+
+#include <geogram/basic/attributes.h>
+
+/*!
+ * @file Geogram attribute store backed by a memory-mapped file
+ */
+
+namespace RINGMesh
+{
+    /*!
+     * @brief Attribute store whose values are a memory-mapped range
+     * of a file
+     * @details It is bound in a GEO::AttributesManager like the geogram
+     * stores, so that GEO::Attribute< T > works on it. The values are only
+     * loaded from the disk when they are accessed, which allows attributes
+     * larger than the memory.
+     * The dimension of the items cannot be changed. Only a store mapped
+     * in MemoryMappedFile::Mode::READ_WRITE can grow, the file being
+     * resized.
+     */
+    template < typename T >
+    class MappedAttributeStore : public GEO::AttributeStore
+    {
+    public:
+        /*!
+         * @param[in] filename the file containing the values
+         * @param[in] mode the access to the file
+         * @param[in] offset the position of the first value in the file
+         * @param[in] size the number of items
+         * @param[in] dim the number of elements of each item
+         * @pre \p mode is not MemoryMappedFile::Mode::READ_ONLY since
+         * the attribute values can be modified
+         */
+        MappedAttributeStore( const std::string& filename,
+            MemoryMappedFile::Mode mode,
+            std::size_t offset,
+            index_t size,
+            index_t dim = 1 )
+            : GEO::AttributeStore( index_t( sizeof( T ) ), dim ),
+              file_( filename, mode, offset, nb_bytes( size, dim ) ),
+              mode_( mode )
+        {
+            notify_mapping( size );
+        }
+
+        void resize( index_t new_size ) override
+        {
+            if( mode_ == MemoryMappedFile::Mode::READ_WRITE )
+            {
+                file_.resize( nb_bytes( new_size, dimension() ) );
+            }
+            else if( nb_bytes( new_size, dimension() ) > file_.size() )
+            {
+                throw RINGMeshException( "Attribute",
+                    "A mapped attribute can only grow when mapped "
+                    "in read and write mode" );
+            }
+            notify_mapping( new_size );
+        }
+
+        void reserve( index_t /*unused*/ ) override
+        {
+        }
+
+        void clear( bool /*unused*/ ) override
+        {
+            resize( 0 );
+        }
+
+        void redim( index_t dim ) override
+        {
+            if( dim != dimension() )
+            {
+                throw RINGMeshException( "Attribute",
+                    "The dimension of a mapped attribute cannot change" );
+            }
+        }
+
+        bool elements_type_matches(
+            const std::string& type_name ) const override
+        {
+            return type_name == typeid( T ).name();
+        }
+
+        std::string element_typeid_name() const override
+        {
+            return typeid( T ).name();
+        }
+
+        /*!
+         * @brief Copies the values in a geogram store held in memory
+         */
+        GEO::AttributeStore* clone() const override
+        {
+            auto result = new GEO::TypedAttributeStore< T >( dimension() );
+            result->resize( size() );
+            const auto* values = reinterpret_cast< const T* >( file_.data() );
+            std::copy( values, values + size() * dimension(),
+                result->get_vector().data() );
+            return result;
+        }
+
+    private:
+        static std::size_t nb_bytes( index_t size, index_t dim )
+        {
+            return static_cast< std::size_t >( size ) * dim * sizeof( T );
+        }
+
+        void notify_mapping( index_t size )
+        {
+            cached_capacity_ = size;
+            notify( size == 0 ? nullptr
+                              : reinterpret_cast< GEO::Memory::pointer >(
+                                    file_.mutable_data() ),
+                size, dimension() );
+        }
+
+    private:
+        MemoryMappedFile file_;
+        MemoryMappedFile::Mode mode_;
+    };
+} // namespace RINGMesh
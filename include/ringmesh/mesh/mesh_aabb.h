@@ -35,6 +35,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <ringmesh/basic/aabb.h>
 #include <ringmesh/mesh/common.h>
 
@@ -44,6 +46,7 @@ namespace RINGMesh
     FORWARD_DECLARATION_DIMENSION_CLASS( LineMesh );
     FORWARD_DECLARATION_DIMENSION_CLASS( SurfaceMeshBase );
     FORWARD_DECLARATION_DIMENSION_CLASS( VolumeMesh );
+    FORWARD_DECLARATION_DIMENSION_CLASS( CartesianGrid );
 } // namespace RINGMesh
 
 namespace RINGMesh
@@ -221,4 +224,93 @@ namespace RINGMesh
     };
 
     ALIAS_3D( VolumeAABBTree );
+
+    /*!
+     * @brief Cell location accelerated by a Cartesian grid covering the mesh
+     * @details Each grid cell stores, in compressed rows (CSR), the mesh
+     * cells whose bounding box intersects it. The grid cells have about
+     * the size of the mesh cells, so that a query tests a few candidates in
+     * O(1) expected time. In grid cells crowded by a local refinement,
+     * a walk through the cell adjacencies is tried first, the candidates
+     * are tested if it fails.
+     * This is an alternative to VolumeAABBTree::containing_cell for dense
+     * sampling of the mesh.
+     */
+    template < index_t DIMENSION >
+    class mesh_api VolumeCellGrid
+    {
+        ringmesh_template_assert_3d( DIMENSION );
+
+    public:
+        explicit VolumeCellGrid( const VolumeMesh< DIMENSION >& mesh );
+        ~VolumeCellGrid();
+
+        /*!
+         * @brief Gets the cell containing a point
+         * @param[in] query the point to use
+         * @return the cell index containing \p query,
+         * NO_ID if no cell is corresponding
+         */
+        index_t containing_cell( const vecn< DIMENSION >& query ) const;
+
+        /*!
+         * @brief Gets the Cartesian grid indexing the mesh cells
+         */
+        const CartesianGrid< DIMENSION >& grid() const
+        {
+            return *grid_;
+        }
+
+        /*!
+         * @brief Gets the number of mesh cells intersecting a grid cell
+         * @param[in] grid_cell the offset of the grid cell
+         */
+        index_t nb_mesh_cells( index_t grid_cell ) const
+        {
+            return grid_cell_ptr_[grid_cell + 1] - grid_cell_ptr_[grid_cell];
+        }
+
+        /*!
+         * @brief Gets a mesh cell intersecting a grid cell
+         * @param[in] grid_cell the offset of the grid cell
+         * @param[in] index the index of the mesh cell in the grid cell,
+         * between 0 and nb_mesh_cells( \p grid_cell )
+         */
+        index_t mesh_cell( index_t grid_cell, index_t index ) const
+        {
+            return mesh_cells_[grid_cell_ptr_[grid_cell] + index];
+        }
+
+    private:
+        /*!
+         * @brief Gets the coordinates of the grid cell containing a point,
+         * clamped on the grid
+         */
+        sivecn< DIMENSION > grid_cell_coords(
+            const vecn< DIMENSION >& point ) const;
+        /*!
+         * @brief Fills the rows of the grid cells in parallel
+         * @param[in] cell_ranges the range of grid cell coordinates
+         * intersected by the bounding box of each mesh cell
+         */
+        void fill_rows( const std::vector< std::pair< sivecn< DIMENSION >,
+                sivecn< DIMENSION > > >& cell_ranges );
+        /*!
+         * @brief Walks from a cell to the cell containing a point
+         * by crossing the facet on which the point is the furthest outside
+         * @return NO_ID if the walk reaches the mesh border
+         */
+        index_t walk_to_containing_cell(
+            const vecn< DIMENSION >& query, index_t start_cell ) const;
+
+    private:
+        const VolumeMesh< DIMENSION >& mesh_;
+        Box< DIMENSION > bbox_;
+        std::unique_ptr< CartesianGrid< DIMENSION > > grid_;
+        /// Rows of mesh_cells_ for each grid cell, of size nb grid cells + 1
+        std::vector< index_t > grid_cell_ptr_;
+        std::vector< index_t > mesh_cells_;
+    };
+
+    ALIAS_3D( VolumeCellGrid );
 } // namespace RINGMesh
@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include <ringmesh/basic/factory.h>
 #include <ringmesh/basic/nn_search.h>
@@ -76,6 +77,13 @@ namespace RINGMesh
 
         virtual void save_mesh( const std::string& filename ) const = 0;
 
+        /*!
+         * @brief Saves the mesh at the end of a memory buffer
+         * @details The default implementation throws, the meshes that
+         * support memory buffers override it.
+         */
+        virtual void save_mesh( std::vector< char >& buffer ) const;
+
         virtual std::tuple< index_t, std::vector< index_t > >
             connected_components() const = 0;
 
@@ -84,6 +84,14 @@ namespace RINGMesh
         void copy( const MeshBase< DIMENSION >& rhs, bool copy_attributes );
 
         virtual void load_mesh( const std::string& filename ) = 0;
+        /*!
+         * @brief Loads a mesh saved in a memory buffer by MeshBase::save_mesh
+         * @details The default implementation throws, the meshes that
+         * support memory buffers override it.
+         * @param[in] data pointer to the saved mesh
+         * @param[in] size number of bytes of the saved mesh
+         */
+        virtual void load_mesh( const char* data, std::size_t size );
         /*!
          * @brief Removes all the entities and attributes of this mesh.
          * @param[in] keep_attributes if true, then all the existing attribute
@@ -925,6 +933,11 @@ namespace RINGMesh
          */
         void delete_cell_aabb();
 
+        /*!
+         * @brief Deletes the Cartesian grid on cells
+         */
+        void delete_cell_grid();
+
         void clear_vertex_linked_objects() override
         {
             this->delete_vertex_nn_search();
@@ -934,6 +947,7 @@ namespace RINGMesh
         void clear_cell_linked_objects()
         {
             delete_cell_aabb();
+            delete_cell_grid();
             delete_cell_nn_search();
         }
 
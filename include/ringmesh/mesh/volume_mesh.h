@@ -281,6 +281,19 @@ namespace RINGMesh
             return *cell_aabb_.get();
         }
 
+        /*!
+         * @brief Creates a Cartesian grid indexing the Mesh cells
+         * @details Alternative to cell_aabb() for dense point location
+         */
+        const VolumeCellGrid< DIMENSION >& cell_grid() const
+        {
+            if( !cell_grid_ )
+            {
+                cell_grid_.reset( new VolumeCellGrid< DIMENSION >( *this ) );
+            }
+            return *cell_grid_.get();
+        }
+
         bool is_mesh_valid() const override;
         std::tuple< index_t, std::vector< index_t > >
             connected_components() const final;
@@ -293,6 +306,7 @@ namespace RINGMesh
             cell_facet_nn_search_{};
         mutable std::unique_ptr< NNSearch< DIMENSION > > cell_nn_search_{};
         mutable std::unique_ptr< VolumeAABBTree< DIMENSION > > cell_aabb_{};
+        mutable std::unique_ptr< VolumeCellGrid< DIMENSION > > cell_grid_{};
 
         void flag_cells_around_vertex( index_t cell_hint,
             index_t vertex_id,
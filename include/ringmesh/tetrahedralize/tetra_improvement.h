@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#pragma once
+
+#include <ringmesh/tetrahedralize/common.h>
+
+#include <functional>
+
+/*!
+ * @file Local improvement of tetrahedral meshes
+ * @brief Post-processing of the tetrahedral meshes of the GeoModel regions
+ * improving the cells of low quality by flips and vertex smoothing.
+ */
+
+namespace RINGMesh
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( GeoModel );
+
+    ALIAS_3D( GeoModel );
+} // namespace RINGMesh
+
+namespace RINGMesh
+{
+    /*!
+     * Quality of a tetrahedron given its four vertices, between 0 (flat
+     * tetrahedron) and 1 (regular tetrahedron).
+     * The function is called concurrently and must be thread safe.
+     */
+    using TetQuality = std::function< double(
+        const vec3&, const vec3&, const vec3&, const vec3& ) >;
+
+    /*!
+     * @brief Improves the tetrahedra of low quality of all the GeoModel
+     * regions.
+     * @details Only the neighborhood of the cells whose quality, read in the
+     * cell attribute \p quality_attribute_name, is below \p min_quality is
+     * modified, using 2-3 face flips, 3-2 edge flips and smoothing of the
+     * vertices. A modification is kept only if it increases the minimum
+     * quality of the modified cells.
+     * The vertices located on the region boundaries (including internal
+     * boundaries and wells) are never moved, and the mesh facets and edges
+     * joining these vertices are never flipped, so that the region meshes
+     * remain conformal to the surfaces.
+     * Regions are improved in parallel.
+     * @param[in,out] geomodel GeoModel with regions meshed by tetrahedra.
+     * @param[in] quality_attribute_name name of the cell attribute storing
+     * the cell quality, as computed by compute_prop_tet_mesh_quality.
+     * @param[in] min_quality cells with a quality below this value are
+     * improved.
+     * @param[in] quality quality measure used to evaluate the modifications,
+     * consistent with the quality stored in \p quality_attribute_name.
+     * @param[in] nb_iterations maximal number of improvement passes.
+     * @return the number of modifications (flips and vertex moves) applied.
+     * @warning The cell attributes of the modified regions are reset.
+     */
+    index_t tetrahedralize_api improve_tetrahedra_quality( GeoModel3D& geomodel,
+        const std::string& quality_attribute_name,
+        double min_quality,
+        const TetQuality& quality,
+        index_t nb_iterations = 3 );
+} // namespace RINGMesh
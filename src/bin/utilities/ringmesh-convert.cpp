@@ -35,16 +35,23 @@
 
 #include <ringmesh/basic/common.h>
 
+#include <fstream>
+
 #include <geogram/basic/command_line.h>
 #include <geogram/basic/stopwatch.h>
 #include <geogram/mesh/mesh_io.h>
 
+#include <ringmesh/basic/box.h>
 #include <ringmesh/basic/command_line.h>
 #include <ringmesh/geomodel/builder/geomodel_builder.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_api.h>
+#include <ringmesh/geomodel/core/geomodel_mesh.h>
+#include <ringmesh/geomodel/tools/geomodel_grid.h>
 #include <ringmesh/geomodel/tools/geomodel_validity.h>
 #include <ringmesh/io/io.h>
+#include <ringmesh/io/text_writer.h>
+#include <ringmesh/mesh/cartesian_grid.h>
 
 /*!
  * @author Arnaud Botella
@@ -67,18 +74,104 @@ namespace
         GEO::mesh_save( mesh, mesh_out_name );
     }
 
+    /*!
+     * @brief Rasterizes the regions on a grid aligned on the space axis
+     * covering the GeoModel and saves it as a legacy VTK structured grid
+     */
+    void save_region_grid(
+        const GeoModel3D& geomodel, const std::string& grid_out_name )
+    {
+        std::vector< std::string > sizes;
+        GEO::String::split_string(
+            GEO::CmdLine::get_arg( "out:region_grid_size" ), ' ', sizes );
+        if( sizes.size() != 3 )
+        {
+            throw RINGMeshException( "I/O",
+                "out:region_grid_size should be three numbers of cells" );
+        }
+        ivec3 nb_cells;
+        for( auto i : range( 3 ) )
+        {
+            nb_cells[i] = static_cast< index_t >(
+                std::max( GEO::String::to_int( sizes[i] ), 1 ) );
+        }
+
+        Box3D box;
+        for( auto v : range( geomodel.mesh.vertices.nb() ) )
+        {
+            box.add_point( geomodel.mesh.vertices.vertex( v ) );
+        }
+        auto diagonal = box.diagonal();
+        vec3 spacing;
+        for( auto i : range( 3 ) )
+        {
+            spacing[i] = diagonal[i] / nb_cells[i];
+        }
+        ReferenceFrame3D frame{ box.min(),
+            { { spacing.x, 0., 0. }, { 0., spacing.y, 0. },
+                { 0., 0., spacing.z } } };
+        CartesianGrid3D grid{ nb_cells, frame };
+        rasterize_regions( geomodel, grid );
+
+        std::ofstream out{ grid_out_name.c_str() };
+        if( !out.is_open() )
+        {
+            throw RINGMeshException(
+                "I/O", "Failed to open file: ", grid_out_name );
+        }
+        TextWriter writer;
+        writer << "# vtk DataFile Version 2.0\n"
+               << "Region grid of " << geomodel.name() << "\nASCII\n"
+               << "DATASET STRUCTURED_POINTS\n"
+               << "DIMENSIONS " << nb_cells + ivec3{ 1, 1, 1 } << '\n'
+               << "ORIGIN " << box.min() << '\n'
+               << "SPACING " << spacing << '\n'
+               << "CELL_DATA " << grid.nb_cells() << '\n'
+               << "SCALARS region int 1\nLOOKUP_TABLE default\n";
+        writer.write( out );
+        GEO::Attribute< index_t > region{ grid.attributes_manager(),
+            "region" };
+        parallel_write_text( out, grid.nb_cells(),
+            [&region]( TextWriter& line, index_t c ) {
+                if( region[c] == NO_ID )
+                {
+                    line << "-1\n";
+                }
+                else
+                {
+                    line << region[c] << '\n';
+                }
+            } );
+    }
+
+    template < index_t DIMENSION >
+    void save_region_grid( const GeoModel< DIMENSION >&, const std::string& )
+    {
+        throw RINGMeshException(
+            "I/O", "out:region_grid is only available for 3D GeoModels" );
+    }
+
     template < index_t DIMENSION >
     void convert_geomodel( const std::string& geomodel_in_name )
     {
         GeoModel< DIMENSION > geomodel;
         geomodel_load( geomodel, geomodel_in_name );
         std::string geomodel_out_name = GEO::CmdLine::get_arg( "out:geomodel" );
-        if( geomodel_out_name.empty() )
+        std::string grid_out_name = GEO::CmdLine::get_arg( "out:region_grid" );
+        if( geomodel_out_name.empty() && grid_out_name.empty() )
         {
-            throw RINGMeshException(
-                "I/O", "Give the parameter out:geomodel to save the geomodel" );
+            throw RINGMeshException( "I/O",
+                "Give the parameter out:geomodel to save the geomodel or "
+                "out:region_grid to save its regions on a grid" );
+        }
+        if( !geomodel_out_name.empty() )
+        {
+            geomodel_save( geomodel, geomodel_out_name );
+        }
+        if( !grid_out_name.empty() )
+        {
+            save_region_grid( geomodel, grid_out_name );
         }
-        geomodel_save( geomodel, geomodel_out_name );
     }
 
     void show_usage_example()
@@ -99,6 +192,11 @@ namespace RINGMesh
             GEO::CmdLine::declare_arg(
                 "in:mesh", "", "Filename of the input mesh" );
             GEO::CmdLine::declare_arg( "out:mesh", "", "Saves the mesh" );
+            GEO::CmdLine::declare_arg( "out:region_grid", "",
+                "Saves the GeoModel regions rasterized on a Cartesian grid "
+                "(legacy .vtk)" );
+            GEO::CmdLine::declare_arg( "out:region_grid_size", "100 100 100",
+                "Number of cells of the region grid along X, Y and Z" );
         }
     }
 }
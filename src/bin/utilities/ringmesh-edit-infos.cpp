@@ -53,20 +53,48 @@ namespace
 {
     using namespace RINGMesh;
 
+    /*!
+     * @brief Gives the file in which the edited GeoModel is saved
+     * @details The meshes are lazily loaded from the input file while the
+     * GeoModel is saved, so the input file is not overwritten directly.
+     */
+    std::string edited_geomodel_path( const std::string& geomodel_in_path,
+        const std::string& geomodel_out_path )
+    {
+        if( geomodel_out_path != geomodel_in_path )
+        {
+            return geomodel_out_path;
+        }
+        return GEO::FileSystem::dir_name( geomodel_in_path ) + "/"
+               + GEO::FileSystem::base_name( geomodel_in_path ) + "_edited."
+               + GEO::FileSystem::extension( geomodel_in_path );
+    }
+
+    void move_edited_geomodel(
+        const std::string& saved_path, const std::string& geomodel_out_path )
+    {
+        if( saved_path != geomodel_out_path )
+        {
+            GEO::FileSystem::delete_file( geomodel_out_path );
+            GEO::FileSystem::rename_file( saved_path, geomodel_out_path );
+        }
+    }
+
     template < index_t DIMENSION >
     void edit_geomodel_name( const std::string& geomodel_in_path,
         const std::string& geomodel_new_name,
         const std::string& geomodel_out_path )
     {
-        GeoModel< DIMENSION > geomodel;
-        geomodel_load( geomodel, geomodel_in_path );
-        GeoModelBuilder< DIMENSION > builder( geomodel );
-        builder.info.set_geomodel_name( geomodel_new_name );
-        if( geomodel_out_path == geomodel_in_path )
+        auto saved_path =
+            edited_geomodel_path( geomodel_in_path, geomodel_out_path );
         {
-            GEO::FileSystem::delete_file( geomodel_in_path );
+            GeoModel< DIMENSION > geomodel;
+            geomodel_load_lazily( geomodel, geomodel_in_path );
+            GeoModelBuilder< DIMENSION > builder( geomodel );
+            builder.info.set_geomodel_name( geomodel_new_name );
+            geomodel_save( geomodel, saved_path );
         }
-        geomodel_save( geomodel, geomodel_out_path );
+        move_edited_geomodel( saved_path, geomodel_out_path );
     }
 
     template < index_t DIMENSION >
@@ -75,24 +103,25 @@ namespace
         const std::string& interface_new_name,
         const std::string& geomodel_out_path )
     {
-        GeoModel< DIMENSION > geomodel;
-        geomodel_load( geomodel, geomodel_in_path );
-        GeoModelBuilder< DIMENSION > builder( geomodel );
-
-        for( const auto& ge_interface : geomodel.geol_entities(
-                 Interface< DIMENSION >::type_name_static() ) )
+        auto saved_path =
+            edited_geomodel_path( geomodel_in_path, geomodel_out_path );
         {
-            if( ge_interface.name() == interface_old_name )
+            GeoModel< DIMENSION > geomodel;
+            geomodel_load_lazily( geomodel, geomodel_in_path );
+            GeoModelBuilder< DIMENSION > builder( geomodel );
+
+            for( const auto& ge_interface : geomodel.geol_entities(
+                     Interface< DIMENSION >::type_name_static() ) )
             {
-                builder.info.set_geological_entity_name(
-                    ge_interface.gmge(), interface_new_name );
+                if( ge_interface.name() == interface_old_name )
+                {
+                    builder.info.set_geological_entity_name(
+                        ge_interface.gmge(), interface_new_name );
+                }
             }
+            geomodel_save( geomodel, saved_path );
         }
-        if( geomodel_out_path == geomodel_in_path )
-        {
-            GEO::FileSystem::delete_file( geomodel_in_path );
-        }
-        geomodel_save( geomodel, geomodel_out_path );
+        move_edited_geomodel( saved_path, geomodel_out_path );
     }
 
     void show_usage_example()
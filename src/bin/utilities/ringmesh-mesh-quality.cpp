@@ -68,6 +68,13 @@ namespace
             "Cell quality is defined as low if below this minimum value" );
         GEO::CmdLine::declare_arg( "quality:output", "",
             "Output filename for a mesh containing low quality tetrahedra" );
+        GEO::CmdLine::declare_arg(
+            "quality:nb_bins", 10, "Number of bins of the quality histogram" );
+        GEO::CmdLine::declare_arg( "quality:improve", false,
+            "Improve the cells below quality:min_value by local flips and "
+            "smoothing" );
+        GEO::CmdLine::declare_arg( "quality:nb_iterations", 3,
+            "Maximal number of improvement passes" );
     }
 
     void import_arg_groups()
@@ -99,6 +106,20 @@ namespace
         }
     }
 
+    void print_quality_statistics( const MeshQualityStatistics& stats )
+    {
+        Logger::out( "Quality", "Number of cells: ", stats.nb_cells );
+        Logger::out( "Quality", "Min: ", stats.min_quality,
+            " Max: ", stats.max_quality, " Mean: ", stats.mean_quality );
+        auto nb_bins = static_cast< index_t >( stats.histogram.size() );
+        for( auto bin : range( nb_bins ) )
+        {
+            Logger::out( "Quality", "[", static_cast< double >( bin ) / nb_bins,
+                ", ", static_cast< double >( bin + 1 ) / nb_bins,
+                "]: ", stats.histogram[bin] );
+        }
+    }
+
     void run()
     {
         GEO::Stopwatch total( "Total time" );
@@ -114,8 +135,20 @@ namespace
         check_geomodel_is_3d_meshed_by_simplexes( geomodel );
 
         auto quality_mode = GEO::CmdLine::get_arg_uint( "quality:mode" );
-        compute_prop_tet_mesh_quality(
-            static_cast< MeshQualityMode >( quality_mode ), geomodel );
+        auto stats = compute_prop_tet_mesh_quality(
+            static_cast< MeshQualityMode >( quality_mode ), geomodel,
+            GEO::CmdLine::get_arg_uint( "quality:nb_bins" ) );
+        print_quality_statistics( stats );
+
+        if( GEO::CmdLine::get_arg_bool( "quality:improve" ) )
+        {
+            stats = improve_tet_mesh_quality(
+                static_cast< MeshQualityMode >( quality_mode ),
+                GEO::CmdLine::get_arg_double( "quality:min_value" ), geomodel,
+                GEO::CmdLine::get_arg_uint( "quality:nb_iterations" ),
+                GEO::CmdLine::get_arg_uint( "quality:nb_bins" ) );
+            print_quality_statistics( stats );
+        }
 
         auto min_quality_out_name = GEO::CmdLine::get_arg( "quality:output" );
         if( !min_quality_out_name.empty() )
@@ -64,7 +64,7 @@ namespace
     void print_geomodel2d_stats( const std::string& model_name )
     {
         GeoModel< 2 > geomodel;
-        geomodel_load( geomodel, model_name );
+        geomodel_load_lazily( geomodel, model_name );
         if( GEO::CmdLine::get_arg_bool( "stats:nb" ) )
         {
             print_geomodel_mesh_stats( geomodel );
@@ -74,7 +74,7 @@ namespace
     void print_geomodel3d_stats( const std::string& model_name )
     {
         GeoModel< 3 > geomodel;
-        geomodel_load( geomodel, model_name );
+        geomodel_load_lazily( geomodel, model_name );
         if( GEO::CmdLine::get_arg_bool( "stats:nb" ) )
         {
             print_geomodel_mesh_stats( geomodel );
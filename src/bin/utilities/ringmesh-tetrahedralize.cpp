@@ -41,6 +41,7 @@
 #include <ringmesh/basic/command_line.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/tools/geomodel_tools.h>
+#include <ringmesh/geomodel/tools/mesh_quality.h>
 #include <ringmesh/io/io.h>
 
 /*!
@@ -50,9 +51,21 @@
 
 using namespace RINGMesh;
 
+void import_arg_group_quality()
+{
+    GEO::CmdLine::declare_arg_group( "quality", "Mesh quality improvement" );
+    GEO::CmdLine::declare_arg( "quality:mode", 0, "Mesh quality mode" );
+    GEO::CmdLine::declare_arg( "quality:min_value", 0.,
+        "Cells below this quality are improved after tetrahedralization "
+        "(no improvement if 0)" );
+    GEO::CmdLine::declare_arg( "quality:nb_iterations", 3,
+        "Maximal number of improvement passes" );
+}
+
 void import_arg_groups()
 {
     CmdLine::import_arg_group( "in" );
+    import_arg_group_quality();
     CmdLine::import_arg_group( "out" );
 }
 
@@ -96,6 +109,18 @@ int main( int argc, char** argv )
 
         tetrahedralize( geomodel );
 
+        auto min_quality = GEO::CmdLine::get_arg_double( "quality:min_value" );
+        if( min_quality > 0 )
+        {
+            auto stats = improve_tet_mesh_quality(
+                static_cast< MeshQualityMode >(
+                    GEO::CmdLine::get_arg_uint( "quality:mode" ) ),
+                min_quality, geomodel,
+                GEO::CmdLine::get_arg_uint( "quality:nb_iterations" ) );
+            Logger::out( "Quality", "Min: ", stats.min_quality,
+                " Max: ", stats.max_quality, " Mean: ", stats.mean_quality );
+        }
+
         std::string output_file_name{ GEO::CmdLine::get_arg( "out:geomodel" ) };
         if( output_file_name.empty() )
         {
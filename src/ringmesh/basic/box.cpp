@@ -183,6 +183,39 @@ namespace RINGMesh
         return true;
     }
 
+    template < index_t DIMENSION >
+    bool Box< DIMENSION >::segment_overlap(
+        const vecn< DIMENSION >& p0, const vecn< DIMENSION >& p1 ) const
+    {
+        double t_min{ -global_epsilon };
+        double t_max{ 1. + global_epsilon };
+        for( auto c : range( DIMENSION ) )
+        {
+            auto direction = p1[c] - p0[c];
+            if( direction == 0. )
+            {
+                if( p0[c] < min()[c] || p0[c] > max()[c] )
+                {
+                    return false;
+                }
+                continue;
+            }
+            auto t0 = ( min()[c] - p0[c] ) / direction;
+            auto t1 = ( max()[c] - p0[c] ) / direction;
+            if( t0 > t1 )
+            {
+                std::swap( t0, t1 );
+            }
+            t_min = std::max( t_min, t0 );
+            t_max = std::min( t_max, t1 );
+            if( t_min > t_max + global_epsilon )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     template < index_t DIMENSION >
     double Box< DIMENSION >::signed_distance( const vecn< DIMENSION >& p ) const
     {
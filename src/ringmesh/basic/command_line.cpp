@@ -73,6 +73,22 @@ namespace RINGMesh
             GEO::CmdLine::declare_arg_group( "out", "Output data" );
             GEO::CmdLine::declare_arg(
                 "out:geomodel", "", "Saves the geological model" );
+            GEO::CmdLine::declare_arg( "out:vtk_binary", false,
+                "Saves .vtk files in binary instead of ASCII",
+                GEO::CmdLine::ARG_ADVANCED );
+            GEO::CmdLine::declare_arg( "out:vtu_encoding", "raw",
+                "Encoding of the .vtu appended data (raw or base64)",
+                GEO::CmdLine::ARG_ADVANCED );
+            GEO::CmdLine::declare_arg( "out:vtu_compression", true,
+                "Compresses the .vtu data arrays with zlib",
+                GEO::CmdLine::ARG_ADVANCED );
+            GEO::CmdLine::declare_arg( "out:stl_binary", false,
+                "Saves .stl files in binary instead of ASCII",
+                GEO::CmdLine::ARG_ADVANCED );
+            GEO::CmdLine::declare_arg( "out:msh_binary", false,
+                "Saves .msh files in the binary GMSH 4.1 format instead of "
+                "the ASCII GMSH 2.2 format",
+                GEO::CmdLine::ARG_ADVANCED );
         }
 
         void import_arg_group_validity()
@@ -0,0 +1,359 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/basic/memory_mapped_file.h>
+
+#include <cstdint>
+
+#ifdef RINGMESH_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <ringmesh/basic/pimpl_impl.h>
+
+/*!
+ * @file Memory mapping of a file
+ */
+
+namespace RINGMesh
+{
+    class MemoryMappedFile::Impl
+    {
+    public:
+        explicit Impl( const std::string& filename )
+            : filename_( filename ), mode_( Mode::READ_ONLY )
+        {
+            open_file();
+            map( file_size() );
+        }
+
+        Impl( const std::string& filename,
+            Mode mode,
+            std::size_t offset,
+            std::size_t size )
+            : filename_( filename ), mode_( mode ), offset_( offset )
+        {
+            open_file();
+            if( file_size() < offset + size )
+            {
+                if( mode_ != Mode::READ_WRITE )
+                {
+                    release();
+                    throw RINGMeshException( "I/O",
+                        "Could not map bytes beyond the end of file: ",
+                        filename_ );
+                }
+                resize_file( offset + size );
+            }
+            map( size );
+        }
+
+        ~Impl()
+        {
+            release();
+        }
+
+        const char* data() const
+        {
+            return data_;
+        }
+
+        char* mutable_data()
+        {
+            ringmesh_assert( mode_ != Mode::READ_ONLY );
+            return data_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        void resize( std::size_t size )
+        {
+            ringmesh_assert( mode_ == Mode::READ_WRITE );
+            unmap();
+            resize_file( offset_ + size );
+            map( size );
+        }
+
+    private:
+        /*!
+         * @brief Maps size_ bytes from offset_, the mapping itself starts
+         * at the previous multiple of the allocation granularity
+         */
+        void map( std::size_t size )
+        {
+            size_ = size;
+            if( size_ == 0 )
+            {
+                return;
+            }
+            auto view_offset = offset_ / granularity() * granularity();
+            view_size_ = offset_ - view_offset + size_;
+#ifdef RINGMESH_WINDOWS
+            DWORD protection{ PAGE_READONLY };
+            DWORD access{ FILE_MAP_READ };
+            if( mode_ == Mode::READ_WRITE )
+            {
+                protection = PAGE_READWRITE;
+                access = FILE_MAP_WRITE;
+            }
+            else if( mode_ == Mode::COPY_ON_WRITE )
+            {
+                protection = PAGE_WRITECOPY;
+                access = FILE_MAP_COPY;
+            }
+            mapping_ = CreateFileMappingA(
+                file_, nullptr, protection, 0, 0, nullptr );
+            if( mapping_ != nullptr )
+            {
+                view_ = static_cast< char* >( MapViewOfFile( mapping_, access,
+                    static_cast< DWORD >(
+                        static_cast< std::uint64_t >( view_offset ) >> 32 ),
+                    static_cast< DWORD >( view_offset & 0xFFFFFFFF ),
+                    view_size_ ) );
+            }
+            if( view_ == nullptr )
+            {
+                release();
+                throw RINGMeshException(
+                    "I/O", "Could not map file in memory: ", filename_ );
+            }
+#else
+            auto protection =
+                mode_ == Mode::READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+            auto flags =
+                mode_ == Mode::COPY_ON_WRITE ? MAP_PRIVATE : MAP_SHARED;
+            auto view = mmap( nullptr, view_size_, protection, flags, file_,
+                static_cast< off_t >( view_offset ) );
+            if( view == MAP_FAILED )
+            {
+                release();
+                throw RINGMeshException(
+                    "I/O", "Could not map file in memory: ", filename_ );
+            }
+            view_ = static_cast< char* >( view );
+#endif
+            data_ = view_ + ( offset_ - view_offset );
+        }
+
+        void unmap()
+        {
+#ifdef RINGMESH_WINDOWS
+            if( view_ != nullptr )
+            {
+                UnmapViewOfFile( view_ );
+            }
+            if( mapping_ != nullptr )
+            {
+                CloseHandle( mapping_ );
+            }
+            mapping_ = nullptr;
+#else
+            if( view_ != nullptr )
+            {
+                munmap( view_, view_size_ );
+            }
+#endif
+            view_ = nullptr;
+            data_ = nullptr;
+        }
+
+        void open_file()
+        {
+#ifdef RINGMESH_WINDOWS
+            if( mode_ == Mode::READ_WRITE )
+            {
+                file_ = CreateFileA( filename_.c_str(),
+                    GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                    OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr );
+            }
+            else
+            {
+                file_ = CreateFileA( filename_.c_str(), GENERIC_READ,
+                    FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                    FILE_ATTRIBUTE_NORMAL, nullptr );
+            }
+            if( file_ == INVALID_HANDLE_VALUE )
+            {
+                throw RINGMeshException(
+                    "I/O", "Could not open file: ", filename_ );
+            }
+#else
+            if( mode_ == Mode::READ_WRITE )
+            {
+                file_ = open( filename_.c_str(), O_RDWR | O_CREAT, 0644 );
+            }
+            else
+            {
+                file_ = open( filename_.c_str(), O_RDONLY );
+            }
+            if( file_ < 0 )
+            {
+                throw RINGMeshException(
+                    "I/O", "Could not open file: ", filename_ );
+            }
+#endif
+        }
+
+        std::size_t file_size()
+        {
+#ifdef RINGMESH_WINDOWS
+            LARGE_INTEGER size;
+            if( !GetFileSizeEx( file_, &size ) )
+            {
+                release();
+                throw RINGMeshException(
+                    "I/O", "Could not get the size of file: ", filename_ );
+            }
+            return static_cast< std::size_t >( size.QuadPart );
+#else
+            struct stat file_stat;
+            if( fstat( file_, &file_stat ) != 0 )
+            {
+                release();
+                throw RINGMeshException(
+                    "I/O", "Could not get the size of file: ", filename_ );
+            }
+            return static_cast< std::size_t >( file_stat.st_size );
+#endif
+        }
+
+        void resize_file( std::size_t size )
+        {
+#ifdef RINGMESH_WINDOWS
+            LARGE_INTEGER position;
+            position.QuadPart = static_cast< LONGLONG >( size );
+            auto resized = SetFilePointerEx( file_, position, nullptr,
+                               FILE_BEGIN )
+                           && SetEndOfFile( file_ );
+#else
+            auto resized = ftruncate( file_, static_cast< off_t >( size ) ) == 0;
+#endif
+            if( !resized )
+            {
+                release();
+                throw RINGMeshException(
+                    "I/O", "Could not resize file: ", filename_ );
+            }
+        }
+
+        static std::size_t granularity()
+        {
+#ifdef RINGMESH_WINDOWS
+            SYSTEM_INFO info;
+            GetSystemInfo( &info );
+            return static_cast< std::size_t >( info.dwAllocationGranularity );
+#else
+            return static_cast< std::size_t >( sysconf( _SC_PAGESIZE ) );
+#endif
+        }
+
+        void release()
+        {
+            unmap();
+#ifdef RINGMESH_WINDOWS
+            if( file_ != INVALID_HANDLE_VALUE )
+            {
+                CloseHandle( file_ );
+            }
+            file_ = INVALID_HANDLE_VALUE;
+#else
+            if( file_ >= 0 )
+            {
+                close( file_ );
+            }
+            file_ = -1;
+#endif
+        }
+
+    private:
+        std::string filename_;
+        Mode mode_;
+        std::size_t offset_{ 0 };
+#ifdef RINGMESH_WINDOWS
+        HANDLE file_{ INVALID_HANDLE_VALUE };
+        HANDLE mapping_{ nullptr };
+#else
+        int file_{ -1 };
+#endif
+        char* view_{ nullptr };
+        std::size_t view_size_{ 0 };
+        char* data_{ nullptr };
+        std::size_t size_{ 0 };
+    };
+
+    MemoryMappedFile::MemoryMappedFile( const std::string& filename )
+        : impl_{ filename }
+    {
+    }
+
+    MemoryMappedFile::MemoryMappedFile( const std::string& filename,
+        Mode mode,
+        std::size_t offset,
+        std::size_t size )
+        : impl_{ filename, mode, offset, size }
+    {
+    }
+
+    MemoryMappedFile::~MemoryMappedFile() {}
+
+    const char* MemoryMappedFile::data() const
+    {
+        return impl_->data();
+    }
+
+    char* MemoryMappedFile::mutable_data()
+    {
+        return impl_->mutable_data();
+    }
+
+    std::size_t MemoryMappedFile::size() const
+    {
+        return impl_->size();
+    }
+
+    void MemoryMappedFile::resize( std::size_t size )
+    {
+        impl_->resize( size );
+    }
+} // namespace RINGMesh
@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/geogram_extension/geogram_mesh_serializer.h>
+
+#include <cstring>
+
+#include <geogram/basic/attributes.h>
+#include <geogram/mesh/mesh.h>
+
+#include <ringmesh/basic/logger.h>
+
+/*!
+ * @file Serialization of GEO::Mesh into memory buffers
+ * @details The layout is: a header (magic, version, dimension),
+ * the connectivity of each kind of element and the attributes of
+ * the 7 GEO::Mesh sub-elements (vertices, edges, facets, facet corners,
+ * cells, cell corners and cell facets). The vertex coordinates are stored
+ * as the vertex attribute "point".
+ * The arrays are encoded to be well compressed by the archives: index
+ * arrays are delta (zigzag) encoded and the bytes of all the arrays are
+ * shuffled, i.e. the k-th bytes of all the values are stored contiguously.
+ */
+
+namespace
+{
+    using namespace RINGMesh;
+
+    const char MESH_MAGIC[4] = { 'R', 'M', 'S', 'H' };
+    const index_t MESH_VERSION = 1;
+
+    /*!
+     * @brief Replaces each index by its zigzag encoded difference
+     * with the previous one, close indices give small values
+     */
+    void delta_encode( std::vector< index_t >& values )
+    {
+        index_t previous{ 0 };
+        for( auto& value : values )
+        {
+            const index_t delta = value - previous;
+            previous = value;
+            value = ( delta << 1 ) ^ ( 0u - ( delta >> 31 ) );
+        }
+    }
+
+    void delta_decode( std::vector< index_t >& values )
+    {
+        index_t previous{ 0 };
+        for( auto& value : values )
+        {
+            const index_t delta = ( value >> 1 ) ^ ( 0u - ( value & 1u ) );
+            previous += delta;
+            value = previous;
+        }
+    }
+
+    /*!
+     * @brief Stores the k-th bytes of all the values contiguously
+     * @details Slowly varying bytes (high order bytes of indices,
+     * exponents of floating point values) then form long runs.
+     */
+    void shuffle_bytes( const char* values,
+        std::size_t nb_values,
+        std::size_t value_size,
+        char* shuffled )
+    {
+        for( auto b : range( value_size ) )
+        {
+            auto* out = shuffled + b * nb_values;
+            const auto* in = values + b;
+            for( auto v : range( nb_values ) )
+            {
+                out[v] = in[v * value_size];
+            }
+        }
+    }
+
+    void unshuffle_bytes( const char* shuffled,
+        std::size_t nb_values,
+        std::size_t value_size,
+        char* values )
+    {
+        for( auto b : range( value_size ) )
+        {
+            const auto* in = shuffled + b * nb_values;
+            auto* out = values + b;
+            for( auto v : range( nb_values ) )
+            {
+                out[v * value_size] = in[v];
+            }
+        }
+    }
+
+    class BufferWriter
+    {
+    public:
+        explicit BufferWriter( std::vector< char >& buffer ) : buffer_( buffer )
+        {
+        }
+
+        void write( const void* data, std::size_t size )
+        {
+            if( size == 0 )
+            {
+                return;
+            }
+            auto position = buffer_.size();
+            buffer_.resize( position + size );
+            std::memcpy( &buffer_[position], data, size );
+        }
+
+        template < typename T >
+        void write( const T& value )
+        {
+            write( &value, sizeof( T ) );
+        }
+
+        template < typename T >
+        void write( const std::vector< T >& values )
+        {
+            write( values.data(), values.size() * sizeof( T ) );
+        }
+
+        void write( const std::string& value )
+        {
+            write( static_cast< index_t >( value.size() ) );
+            write( value.data(), value.size() );
+        }
+
+        void write_shuffled(
+            const void* data, std::size_t nb_values, std::size_t value_size )
+        {
+            if( nb_values == 0 )
+            {
+                return;
+            }
+            auto position = buffer_.size();
+            buffer_.resize( position + nb_values * value_size );
+            shuffle_bytes( static_cast< const char* >( data ), nb_values,
+                value_size, &buffer_[position] );
+        }
+
+        void write_indices( std::vector< index_t > values )
+        {
+            delta_encode( values );
+            write_shuffled( values.data(), values.size(), sizeof( index_t ) );
+        }
+
+    private:
+        std::vector< char >& buffer_;
+    };
+
+    class BufferReader
+    {
+    public:
+        BufferReader( const char* data, std::size_t size )
+            : data_( data ), size_( size )
+        {
+        }
+
+        const char* read( std::size_t size )
+        {
+            if( size > size_ - position_ )
+            {
+                throw RINGMeshException(
+                    "I/O", "Unexpected end of serialized mesh" );
+            }
+            const auto* data = data_ + position_;
+            position_ += size;
+            return data;
+        }
+
+        void read( void* data, std::size_t size )
+        {
+            if( size != 0 )
+            {
+                std::memcpy( data, read( size ), size );
+            }
+        }
+
+        template < typename T >
+        T read()
+        {
+            T value;
+            read( &value, sizeof( T ) );
+            return value;
+        }
+
+        template < typename T >
+        std::vector< T > read_vector( index_t nb_values )
+        {
+            std::vector< T > values( nb_values );
+            read( values.data(), values.size() * sizeof( T ) );
+            return values;
+        }
+
+        std::string read_string()
+        {
+            auto length = read< index_t >();
+            return { read( length ), length };
+        }
+
+        void read_shuffled(
+            void* data, std::size_t nb_values, std::size_t value_size )
+        {
+            if( nb_values != 0 )
+            {
+                unshuffle_bytes( read( nb_values * value_size ), nb_values,
+                    value_size, static_cast< char* >( data ) );
+            }
+        }
+
+        std::vector< index_t > read_indices( index_t nb_values )
+        {
+            std::vector< index_t > values( nb_values );
+            read_shuffled( values.data(), values.size(), sizeof( index_t ) );
+            delta_decode( values );
+            return values;
+        }
+
+        std::size_t position() const
+        {
+            return position_;
+        }
+
+    private:
+        const char* data_;
+        std::size_t size_;
+        std::size_t position_{ 0 };
+    };
+
+    std::vector< const GEO::MeshSubElementsStore* > mesh_sub_elements(
+        const GEO::Mesh& mesh )
+    {
+        return { &mesh.vertices, &mesh.edges, &mesh.facets,
+            &mesh.facet_corners, &mesh.cells, &mesh.cell_corners,
+            &mesh.cell_facets };
+    }
+
+    std::vector< GEO::MeshSubElementsStore* > mesh_sub_elements(
+        GEO::Mesh& mesh )
+    {
+        return { &mesh.vertices, &mesh.edges, &mesh.facets,
+            &mesh.facet_corners, &mesh.cells, &mesh.cell_corners,
+            &mesh.cell_facets };
+    }
+
+    void save_attributes(
+        const GEO::MeshSubElementsStore& elements, BufferWriter& out )
+    {
+        const auto& attributes = elements.attributes();
+        GEO::vector< std::string > all_names;
+        attributes.list_attribute_names( all_names );
+        std::vector< std::string > names;
+        std::vector< std::string > type_names;
+        std::vector< const GEO::AttributeStore* > stores;
+        for( const auto& name : all_names )
+        {
+            const auto* store = attributes.find_attribute_store( name );
+            if( !GEO::AttributeStore::element_typeid_name_is_known(
+                    store->element_typeid_name() ) )
+            {
+                Logger::warn( "I/O", "Skipping attribute ", name,
+                    " of unknown type ", store->element_typeid_name() );
+                continue;
+            }
+            names.push_back( name );
+            stores.push_back( store );
+            type_names.push_back(
+                GEO::AttributeStore::element_type_name_by_element_typeid_name(
+                    store->element_typeid_name() ) );
+        }
+
+        out.write( static_cast< index_t >( stores.size() ) );
+        for( auto i : range( stores.size() ) )
+        {
+            const auto* store = stores[i];
+            out.write( names[i] );
+            out.write( type_names[i] );
+            out.write( store->dimension() );
+            out.write( static_cast< index_t >( store->element_size() ) );
+            out.write_shuffled( store->data(),
+                std::size_t( store->size() ) * store->dimension(),
+                store->element_size() );
+        }
+    }
+
+    void load_attributes(
+        GEO::MeshSubElementsStore& elements, BufferReader& in )
+    {
+        auto& attributes = elements.attributes();
+        auto nb_attributes = in.read< index_t >();
+        for( auto i : range( nb_attributes ) )
+        {
+            ringmesh_unused( i );
+            auto name = in.read_string();
+            auto type_name = in.read_string();
+            auto dimension = in.read< index_t >();
+            auto element_size = in.read< index_t >();
+            if( !GEO::AttributeStore::element_type_name_is_known( type_name ) )
+            {
+                throw RINGMeshException( "I/O", "Attribute ", name,
+                    " has an unknown type ", type_name );
+            }
+            auto* store = attributes.find_attribute_store( name );
+            if( store == nullptr )
+            {
+                store = GEO::AttributeStore::
+                    create_attribute_store_by_element_type_name(
+                        type_name, dimension );
+                attributes.bind_attribute_store( name, store );
+            }
+            if( store->dimension() != dimension
+                || store->element_size() != element_size )
+            {
+                throw RINGMeshException(
+                    "I/O", "Attribute ", name, " does not match the mesh" );
+            }
+            in.read_shuffled( store->data(),
+                std::size_t( store->size() ) * dimension, element_size );
+        }
+    }
+
+    void save_connectivity( const GEO::Mesh& mesh, BufferWriter& out )
+    {
+        out.write( mesh.vertices.nb() );
+
+        std::vector< index_t > edge_vertices;
+        edge_vertices.reserve( 2 * mesh.edges.nb() );
+        for( auto e : range( mesh.edges.nb() ) )
+        {
+            edge_vertices.push_back( mesh.edges.vertex( e, 0 ) );
+            edge_vertices.push_back( mesh.edges.vertex( e, 1 ) );
+        }
+        out.write( mesh.edges.nb() );
+        out.write_indices( std::move( edge_vertices ) );
+
+        std::vector< index_t > facet_sizes( mesh.facets.nb() );
+        for( auto f : range( mesh.facets.nb() ) )
+        {
+            facet_sizes[f] = mesh.facets.nb_vertices( f );
+        }
+        std::vector< index_t > facet_corner_vertices(
+            mesh.facet_corners.nb() );
+        std::vector< index_t > facet_corner_adjacents(
+            mesh.facet_corners.nb() );
+        for( auto c : range( mesh.facet_corners.nb() ) )
+        {
+            facet_corner_vertices[c] = mesh.facet_corners.vertex( c );
+            facet_corner_adjacents[c] = mesh.facet_corners.adjacent_facet( c );
+        }
+        out.write( mesh.facets.nb() );
+        out.write( mesh.facet_corners.nb() );
+        out.write_indices( std::move( facet_sizes ) );
+        out.write_indices( std::move( facet_corner_vertices ) );
+        out.write_indices( std::move( facet_corner_adjacents ) );
+
+        std::vector< char > cell_types( mesh.cells.nb() );
+        for( auto c : range( mesh.cells.nb() ) )
+        {
+            cell_types[c] = static_cast< char >( mesh.cells.type( c ) );
+        }
+        std::vector< index_t > cell_corner_vertices( mesh.cell_corners.nb() );
+        for( auto c : range( mesh.cell_corners.nb() ) )
+        {
+            cell_corner_vertices[c] = mesh.cell_corners.vertex( c );
+        }
+        std::vector< index_t > cell_facet_adjacents( mesh.cell_facets.nb() );
+        for( auto f : range( mesh.cell_facets.nb() ) )
+        {
+            cell_facet_adjacents[f] = mesh.cell_facets.adjacent_cell( f );
+        }
+        out.write( mesh.cells.nb() );
+        out.write( mesh.cell_corners.nb() );
+        out.write( mesh.cell_facets.nb() );
+        out.write( cell_types );
+        out.write_indices( std::move( cell_corner_vertices ) );
+        out.write_indices( std::move( cell_facet_adjacents ) );
+    }
+
+    void check_size( index_t value, index_t expected )
+    {
+        if( value != expected )
+        {
+            throw RINGMeshException( "I/O", "Invalid serialized mesh" );
+        }
+    }
+
+    void load_connectivity( GEO::Mesh& mesh, BufferReader& in )
+    {
+        mesh.vertices.create_vertices( in.read< index_t >() );
+
+        auto nb_edges = in.read< index_t >();
+        auto edge_vertices = in.read_indices( 2 * nb_edges );
+        mesh.edges.create_edges( nb_edges );
+        for( auto e : range( nb_edges ) )
+        {
+            mesh.edges.set_vertex( e, 0, edge_vertices[2 * e] );
+            mesh.edges.set_vertex( e, 1, edge_vertices[2 * e + 1] );
+        }
+
+        // Facets are created by chunks of polygons with the same size
+        auto nb_facets = in.read< index_t >();
+        auto nb_facet_corners = in.read< index_t >();
+        auto facet_sizes = in.read_indices( nb_facets );
+        for( index_t f{ 0 }; f < nb_facets; )
+        {
+            auto end = f + 1;
+            while( end < nb_facets && facet_sizes[end] == facet_sizes[f] )
+            {
+                end++;
+            }
+            mesh.facets.create_facets( end - f, facet_sizes[f] );
+            f = end;
+        }
+        check_size( mesh.facet_corners.nb(), nb_facet_corners );
+        auto facet_corner_vertices =
+            in.read_indices( nb_facet_corners );
+        auto facet_corner_adjacents =
+            in.read_indices( nb_facet_corners );
+        for( auto c : range( nb_facet_corners ) )
+        {
+            mesh.facet_corners.set_vertex( c, facet_corner_vertices[c] );
+            mesh.facet_corners.set_adjacent_facet(
+                c, facet_corner_adjacents[c] );
+        }
+
+        // Cells are created by chunks of cells with the same type
+        auto nb_cells = in.read< index_t >();
+        auto nb_cell_corners = in.read< index_t >();
+        auto nb_cell_facets = in.read< index_t >();
+        auto cell_types = in.read_vector< char >( nb_cells );
+        for( index_t c{ 0 }; c < nb_cells; )
+        {
+            auto end = c + 1;
+            while( end < nb_cells && cell_types[end] == cell_types[c] )
+            {
+                end++;
+            }
+            mesh.cells.create_cells(
+                end - c, static_cast< GEO::MeshCellType >( cell_types[c] ) );
+            c = end;
+        }
+        check_size( mesh.cell_corners.nb(), nb_cell_corners );
+        check_size( mesh.cell_facets.nb(), nb_cell_facets );
+        auto cell_corner_vertices = in.read_indices( nb_cell_corners );
+        for( auto c : range( nb_cell_corners ) )
+        {
+            mesh.cell_corners.set_vertex( c, cell_corner_vertices[c] );
+        }
+        auto cell_facet_adjacents = in.read_indices( nb_cell_facets );
+        for( auto f : range( nb_cell_facets ) )
+        {
+            mesh.cell_facets.set_adjacent_cell( f, cell_facet_adjacents[f] );
+        }
+    }
+} // namespace
+
+namespace RINGMesh
+{
+    void save_geogram_mesh( const GEO::Mesh& mesh, std::vector< char >& buffer )
+    {
+        BufferWriter out( buffer );
+        out.write( MESH_MAGIC, sizeof( MESH_MAGIC ) );
+        out.write( MESH_VERSION );
+        out.write( mesh.vertices.dimension() );
+        save_connectivity( mesh, out );
+        for( const auto* elements : mesh_sub_elements( mesh ) )
+        {
+            save_attributes( *elements, out );
+        }
+    }
+
+    std::size_t load_geogram_mesh(
+        const char* data, std::size_t size, GEO::Mesh& mesh )
+    {
+        BufferReader in( data, size );
+        if( std::memcmp( in.read( sizeof( MESH_MAGIC ) ), MESH_MAGIC,
+                sizeof( MESH_MAGIC ) )
+            != 0 )
+        {
+            throw RINGMeshException( "I/O", "Invalid serialized mesh" );
+        }
+        auto version = in.read< index_t >();
+        if( version != MESH_VERSION )
+        {
+            throw RINGMeshException(
+                "I/O", "Unsupported serialized mesh version ", version );
+        }
+        mesh.clear( false, false );
+        mesh.vertices.set_dimension( in.read< index_t >() );
+        load_connectivity( mesh, in );
+        for( auto* elements : mesh_sub_elements( mesh ) )
+        {
+            load_attributes( *elements, in );
+        }
+        return in.position();
+    }
+} // namespace RINGMesh
@@ -68,6 +68,7 @@ namespace RINGMesh
     {
         if( gmme_.mesh_->type_name() != type )
         {
+            gmme_.release_mesh_loader();
             gmme_.unbind_vertex_mapping_attribute();
             gmme_.change_mesh_data_structure( type );
             gmme_.bind_vertex_mapping_attribute();
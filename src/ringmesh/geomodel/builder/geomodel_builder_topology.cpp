@@ -123,52 +123,121 @@ namespace
         return equal;
     }
 
+    /*!
+     * @brief Checks if the incident entities of \p E are the given ones
+     * @details Entities are compared as multisets of indices: each incident
+     * entity of \p E is matched with a distinct entry of the sorted indices,
+     * found by binary search.
+     */
     template < index_t DIMENSION >
-    std::vector< index_t > get_sorted_incident_surfaces(
-        const GeoModelMeshEntity< DIMENSION >& E )
+    bool has_incident_entities( const GeoModelMeshEntity< DIMENSION >& E,
+        const std::vector< index_t >& sorted_incident_entities )
     {
-        std::vector< index_t > incident_surfaces;
-        index_t nb{ E.nb_incident_entities() };
-        incident_surfaces.resize( nb );
-        for( auto i : range( nb ) )
+        if( E.nb_incident_entities() != sorted_incident_entities.size() )
+        {
+            return false;
+        }
+        std::vector< bool > matched( sorted_incident_entities.size(), false );
+        for( const auto& incident : E.incident_entity_gmmes() )
         {
-            incident_surfaces[i] = E.incident_entity_gmme( i ).index();
+            auto it = std::lower_bound( sorted_incident_entities.begin(),
+                sorted_incident_entities.end(), incident.index() );
+            auto position = static_cast< index_t >(
+                it - sorted_incident_entities.begin() );
+            while( position < sorted_incident_entities.size()
+                   && sorted_incident_entities[position] == incident.index()
+                   && matched[position] )
+            {
+                position++;
+            }
+            if( position == sorted_incident_entities.size()
+                || sorted_incident_entities[position] != incident.index() )
+            {
+                return false;
+            }
+            matched[position] = true;
         }
-        std::sort( incident_surfaces.begin(), incident_surfaces.end() );
-        return incident_surfaces;
+        return true;
     }
 
+    /*!
+     * @brief Set of GeoModel entities stored as one flag per entity of each
+     * type, the entities are also listed in insertion order
+     */
+    template < typename Type, typename EntityId >
+    class EntityIdFlags
+    {
+    public:
+        bool contains( const EntityId& id ) const
+        {
+            const auto& flags = flags_.values();
+            const auto type_id = id.type().id();
+            return type_id < flags.size() && id.index() < flags[type_id].size()
+                   && flags[type_id][id.index()];
+        }
+
+        /*!
+         * @return true if the entity was not already in the set
+         */
+        bool insert( const EntityId& id )
+        {
+            auto& flags = flags_[id.type()];
+            if( id.index() >= flags.size() )
+            {
+                flags.resize( id.index() + 1, false );
+            }
+            if( flags[id.index()] )
+            {
+                return false;
+            }
+            flags[id.index()] = true;
+            ids_.push_back( id );
+            return true;
+        }
+
+        const std::vector< EntityId >& ids() const
+        {
+            return ids_;
+        }
+
+    private:
+        EntityTypeMap< Type, std::vector< bool > > flags_;
+        std::vector< EntityId > ids_;
+    };
+
+    using MeshEntityFlags = EntityIdFlags< MeshEntityType, gmme_id >;
+    using GeologicalEntityFlags =
+        EntityIdFlags< GeologicalEntityType, gmge_id >;
+
     template < index_t DIMENSION >
-    index_t add_to_set_children_of_geological_entities(
+    index_t add_children_of_geological_entities(
         const GeoModel< DIMENSION >& geomodel,
-        const std::set< gmge_id >& geological_entities,
-        std::set< gmme_id >& mesh_entities )
+        const GeologicalEntityFlags& geological_entities,
+        MeshEntityFlags& mesh_entities )
     {
-        const auto old_number_of_entities = static_cast< index_t >(
-            mesh_entities.size() + geological_entities.size() );
-        for( const auto& cur_gmge_id : geological_entities )
+        index_t nb_added{ 0 };
+        for( const auto& cur_gmge_id : geological_entities.ids() )
         {
             const auto& cur_geol_entity =
                 geomodel.geological_entity( cur_gmge_id );
-            for( auto child_i : range( cur_geol_entity.nb_children() ) )
+            for( const auto& child : cur_geol_entity.child_gmmes() )
             {
-                mesh_entities.insert( cur_geol_entity.child_gmme( child_i ) );
+                if( mesh_entities.insert( child ) )
+                {
+                    nb_added++;
+                }
             }
         }
-        const auto new_number_of_entities = static_cast< index_t >(
-            mesh_entities.size() + geological_entities.size() );
-        ringmesh_assert( new_number_of_entities >= old_number_of_entities );
-        return new_number_of_entities - old_number_of_entities;
+        return nb_added;
     }
 
     template < index_t DIMENSION >
-    index_t add_to_set_geological_entities_which_have_no_child(
+    index_t add_geological_entities_which_have_no_child(
         const GeoModel< DIMENSION >& geomodel,
-        const std::set< gmme_id >& mesh_entities,
-        std::set< gmge_id >& geological_entities )
+        const MeshEntityFlags& mesh_entities,
+        GeologicalEntityFlags& geological_entities )
     {
-        const auto old_number_of_entities = static_cast< index_t >(
-            mesh_entities.size() + geological_entities.size() );
+        index_t nb_added{ 0 };
         const auto nb_geological_entity_types =
             geomodel.entity_type_manager()
                 .geological_entity_manager.nb_geological_entity_types();
@@ -185,35 +254,29 @@ namespace
                 bool no_child{ true };
                 const auto& cur_geol_entity =
                     geomodel.geological_entity( geol_type, geol_entity_i );
-                for( auto child_i : range( cur_geol_entity.nb_children() ) )
+                for( const auto& child : cur_geol_entity.child_gmmes() )
                 {
-                    if( mesh_entities.count(
-                            cur_geol_entity.child_gmme( child_i ) )
-                        == 0 )
+                    if( !mesh_entities.contains( child ) )
                     {
                         no_child = false;
                         break;
                     }
                 }
-                if( no_child )
+                if( no_child
+                    && geological_entities.insert( cur_geol_entity.gmge() ) )
                 {
-                    geological_entities.insert( cur_geol_entity.gmge() );
+                    nb_added++;
                 }
             }
         }
-        const auto new_number_of_entities = static_cast< index_t >(
-            mesh_entities.size() + geological_entities.size() );
-        ringmesh_assert( new_number_of_entities >= old_number_of_entities );
-        return new_number_of_entities - old_number_of_entities;
+        return nb_added;
     }
 
     template < index_t DIMENSION >
-    index_t add_to_set_mesh_entities_being_boundaries_of_no_mesh_entity(
-        const GeoModel< DIMENSION >& geomodel,
-        std::set< gmme_id >& mesh_entities )
+    index_t add_mesh_entities_being_boundaries_of_no_mesh_entity(
+        const GeoModel< DIMENSION >& geomodel, MeshEntityFlags& mesh_entities )
     {
-        const auto old_number_of_entities =
-            static_cast< index_t >( mesh_entities.size() );
+        index_t nb_added{ 0 };
         for( const auto& mesh_type :
             geomodel.entity_type_manager()
                 .mesh_entity_manager.mesh_entity_types() )
@@ -229,28 +292,23 @@ namespace
                 bool no_incident{ true };
                 const auto& cur_mesh_entity =
                     geomodel.mesh_entity( mesh_type, mesh_entity_i );
-                for( auto incident_entity_i :
-                    range( cur_mesh_entity.nb_incident_entities() ) )
+                for( const auto& incident_entity :
+                    cur_mesh_entity.incident_entity_gmmes() )
                 {
-                    if( mesh_entities.count(
-                            cur_mesh_entity.incident_entity_gmme(
-                                incident_entity_i ) )
-                        == 0 )
+                    if( !mesh_entities.contains( incident_entity ) )
                     {
                         no_incident = false;
                         break;
                     }
                 }
-                if( no_incident )
+                if( no_incident
+                    && mesh_entities.insert( cur_mesh_entity.gmme() ) )
                 {
-                    mesh_entities.insert( cur_mesh_entity.gmme() );
+                    nb_added++;
                 }
             }
         }
-        const auto new_number_of_entities =
-            static_cast< index_t >( mesh_entities.size() );
-        ringmesh_assert( new_number_of_entities >= old_number_of_entities );
-        return new_number_of_entities - old_number_of_entities;
+        return nb_added;
     }
 
 } // namespace
@@ -293,19 +351,49 @@ namespace RINGMesh
         std::set< gmme_id >& mesh_entities,
         std::set< gmge_id >& geological_entities ) const
     {
-        auto nb_added = add_to_set_children_of_geological_entities(
-            geomodel_, geological_entities, mesh_entities );
-        nb_added += add_to_set_geological_entities_which_have_no_child(
-            geomodel_, mesh_entities, geological_entities );
-        nb_added += add_to_set_mesh_entities_being_boundaries_of_no_mesh_entity(
-            geomodel_, mesh_entities );
-
-        // Recursive call till nothing is added
-        if( nb_added > 0 )
+        MeshEntityFlags dependent_mesh_entities;
+        for( const auto& id : mesh_entities )
         {
-            return get_dependent_entities( mesh_entities, geological_entities );
+            dependent_mesh_entities.insert( id );
         }
-        return false;
+        GeologicalEntityFlags dependent_geological_entities;
+        for( const auto& id : geological_entities )
+        {
+            dependent_geological_entities.insert( id );
+        }
+
+        // Iterate till nothing is added
+        index_t nb_added{ 0 };
+        do
+        {
+            nb_added = add_children_of_geological_entities( geomodel_,
+                dependent_geological_entities, dependent_mesh_entities );
+            nb_added += add_geological_entities_which_have_no_child(
+                geomodel_, dependent_mesh_entities,
+                dependent_geological_entities );
+            nb_added += add_mesh_entities_being_boundaries_of_no_mesh_entity(
+                geomodel_, dependent_mesh_entities );
+        } while( nb_added > 0 );
+
+        // The given entities come first in the lists of dependent entities
+        const auto& all_mesh_entities = dependent_mesh_entities.ids();
+        const auto& all_geological_entities =
+            dependent_geological_entities.ids();
+        const auto nb_given_mesh_entities =
+            static_cast< std::ptrdiff_t >( mesh_entities.size() );
+        const auto nb_given_geological_entities =
+            static_cast< std::ptrdiff_t >( geological_entities.size() );
+        mesh_entities.insert(
+            all_mesh_entities.begin() + nb_given_mesh_entities,
+            all_mesh_entities.end() );
+        geological_entities.insert(
+            all_geological_entities.begin() + nb_given_geological_entities,
+            all_geological_entities.end() );
+        return static_cast< std::ptrdiff_t >( all_mesh_entities.size() )
+                   != nb_given_mesh_entities
+               || static_cast< std::ptrdiff_t >(
+                      all_geological_entities.size() )
+                      != nb_given_geological_entities;
     }
 
     template < index_t DIMENSION >
@@ -374,20 +462,11 @@ namespace RINGMesh
             const auto& c0 = line.boundary_gmme( 0 );
             const auto& c1 = line.boundary_gmme( 1 );
 
-            if( ( c0 == first_corner && c1 == second_corner )
-                || ( c0 == second_corner && c1 == first_corner ) )
+            if( ( ( c0 == first_corner && c1 == second_corner )
+                    || ( c0 == second_corner && c1 == first_corner ) )
+                && has_incident_entities( line, sorted_adjacent_surfaces ) )
             {
-                std::vector< index_t > cur_adjacent_surfaces{
-                    get_sorted_incident_surfaces( line )
-                };
-                if( cur_adjacent_surfaces.size()
-                        == sorted_adjacent_surfaces.size()
-                    && std::equal( cur_adjacent_surfaces.begin(),
-                           cur_adjacent_surfaces.end(),
-                           sorted_adjacent_surfaces.begin() ) )
-                {
-                    return line.gmme();
-                }
+                return line.gmme();
             }
         }
         return create_mesh_entity< Line >( mesh_type );
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/geomodel/core/entity_type.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    using namespace RINGMesh;
+
+    /*!
+     * Maximal number of entity type names that can be registered
+     */
+    const index_t MAX_NB_ENTITY_TYPES{ 1024 };
+
+    /*!
+     * @brief Storage of the registered entity type names
+     * @details The names are stored in a fixed array that is never
+     * reallocated. A name is written before its index is given out and is
+     * never modified afterwards, so name() reads it without locking.
+     */
+    class EntityTypeNames
+    {
+    public:
+        static EntityTypeNames& instance()
+        {
+            static EntityTypeNames names;
+            return names;
+        }
+
+        index_t id( const std::string& name )
+        {
+            std::lock_guard< std::mutex > locking( lock_ );
+            auto it = ids_.find( name );
+            if( it != ids_.end() )
+            {
+                return it->second;
+            }
+            auto id = nb_names_.load( std::memory_order_relaxed );
+            if( id == MAX_NB_ENTITY_TYPES )
+            {
+                throw RINGMeshException( "EntityType",
+                    "Too many entity types, cannot register ", name );
+            }
+            names_[id] = name;
+            ids_.emplace( name, id );
+            nb_names_.store( id + 1, std::memory_order_release );
+            return id;
+        }
+
+        const std::string& name( index_t id ) const
+        {
+            ringmesh_assert(
+                id < nb_names_.load( std::memory_order_acquire ) );
+            return names_[id];
+        }
+
+    private:
+        EntityTypeNames()
+        {
+            id( "No_entity_type" );
+        }
+
+    private:
+        std::mutex lock_;
+        std::array< std::string, MAX_NB_ENTITY_TYPES > names_;
+        std::atomic< index_t > nb_names_{ 0 };
+        std::unordered_map< std::string, index_t > ids_;
+    };
+} // namespace
+
+namespace RINGMesh
+{
+    index_t EntityTypeRegistry::id( const std::string& name )
+    {
+        return EntityTypeNames::instance().id( name );
+    }
+
+    const std::string& EntityTypeRegistry::name( index_t id )
+    {
+        return EntityTypeNames::instance().name( id );
+    }
+} // namespace RINGMesh
@@ -49,7 +49,7 @@
 
 namespace RINGMesh
 {
-    using MeshEntityTypeMap = std::map< MeshEntityType, MeshEntityType >;
+    using MeshEntityTypeMap = EntityTypeMap< MeshEntityType, MeshEntityType >;
 
     /*!
      * @brief struct used to map the type of a Mesh Entity to the type of its
@@ -65,7 +65,7 @@ namespace RINGMesh
         void register_boundary(
             const MeshEntityType& type, const MeshEntityType& boundary )
         {
-            map.emplace( type, boundary );
+            map[type] = boundary;
         }
         MeshEntityTypeMap map;
 
@@ -109,7 +109,7 @@ namespace RINGMesh
         void register_incident_entity(
             const MeshEntityType& type, const MeshEntityType& incident_entity )
         {
-            map.emplace( type, incident_entity );
+            map[type] = incident_entity;
         }
         MeshEntityTypeMap map;
 
@@ -185,21 +185,13 @@ namespace RINGMesh
         const MeshEntityType& boundary_entity_type(
             const MeshEntityType& mesh_entity_type ) const
         {
-            MeshEntityTypeMap::const_iterator itr{
-                boundary_relationships_.map.find( mesh_entity_type )
-            };
-            ringmesh_assert( itr != boundary_relationships_.map.end() );
-            return itr->second;
+            return boundary_relationships_.map.at( mesh_entity_type );
         }
 
         const MeshEntityType& incident_entity_type(
             const MeshEntityType& mesh_entity_type ) const
         {
-            MeshEntityTypeMap::const_iterator itr{
-                incident_entity_relationships_.map.find( mesh_entity_type )
-            };
-            ringmesh_assert( itr != incident_entity_relationships_.map.end() );
-            return itr->second;
+            return incident_entity_relationships_.map.at( mesh_entity_type );
         }
 
         bool is_corner( const MeshEntityType& type ) const
@@ -455,6 +447,17 @@ namespace RINGMesh
             return itr->second;
         }
 
+        index_t nb_parent_types( const MeshEntityType& child_type ) const
+        {
+            MeshEntityToParents::const_iterator itr{ child_to_parents_.find(
+                child_type ) };
+            if( itr == child_to_parents_.end() )
+            {
+                return 0;
+            }
+            return static_cast< index_t >( itr->second.size() );
+        }
+
         std::vector< GeologicalEntityType > parent_types(
             const MeshEntityType& child_type ) const
         {
@@ -554,7 +557,7 @@ namespace RINGMesh
     index_t RelationshipManager::nb_parent_types(
         const MeshEntityType& child_type ) const
     {
-        return static_cast< index_t >( parent_types( child_type ).size() );
+        return impl_->nb_parent_types( child_type );
     }
 
     const MeshEntityType RelationshipManager::child_type(
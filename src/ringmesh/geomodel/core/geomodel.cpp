@@ -303,19 +303,17 @@ namespace RINGMesh
                 voi_surfaces.push_back( cur_surface.index() );
                 const auto& incident_region = cur_surface.incident_entity( 0 );
 
-                index_t local_boundary_id{ NO_ID };
-                for( auto region_boundary_i :
-                    range( incident_region.nb_boundaries() ) )
+                index_t local_boundary_id{ 0 };
+                for( const auto& boundary : incident_region.boundary_gmmes() )
                 {
-                    if( incident_region.boundary_gmme( region_boundary_i )
-                            .index()
-                        == cur_surface.index() )
+                    if( boundary.index() == cur_surface.index() )
                     {
-                        local_boundary_id = region_boundary_i;
                         break;
                     }
+                    local_boundary_id++;
                 }
-                ringmesh_assert( local_boundary_id != NO_ID );
+                ringmesh_assert(
+                    local_boundary_id < incident_region.nb_boundaries() );
 
                 voi_surface_region_side.push_back(
                     incident_region.side( local_boundary_id ) );
@@ -154,6 +154,13 @@ namespace RINGMesh
             .relationship_manager.child_of_gmge( children_[x] );
     }
 
+    template < index_t DIMENSION >
+    child_range GeoModelGeologicalEntity< DIMENSION >::child_gmmes() const
+    {
+        return { this->geomodel().entity_type_manager().relationship_manager,
+            children_ };
+    }
+
     template < index_t DIMENSION >
     gmge_id GeoModelGeologicalEntity< DIMENSION >::gmge() const
     {
@@ -230,15 +237,25 @@ namespace RINGMesh
         else
         {
             // All children must have this entity as a parent
-            const GeologicalEntityType entity_type = type_name();
-            for( auto i : range( nb_children() ) )
+            const auto id = gmge();
+            for( const auto& child_id : child_gmmes() )
             {
-                const GeoModelMeshEntity< DIMENSION >& one_child = child( i );
-                if( one_child.parent_gmge( entity_type ) != gmge() )
+                const auto& one_child =
+                    this->geomodel().mesh_entity( child_id );
+                bool found{ false };
+                for( const auto& parent : one_child.parent_gmges() )
+                {
+                    if( parent == id )
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if( !found )
                 {
                     Logger::warn( "GeoModelEntity",
-                        "Inconsistency child-parent between ", gmge(), " and ",
-                        one_child.gmme() );
+                        "Inconsistency child-parent between ", id, " and ",
+                        child_id );
                     valid = false;
                 }
             }
@@ -337,7 +354,8 @@ namespace RINGMesh
     template < index_t DIMENSION >
     GeologicalEntityType Contact< DIMENSION >::type_name_static()
     {
-        return GeologicalEntityType( "Contact" );
+        static const GeologicalEntityType type{ "Contact" };
+        return type;
     }
 
     template < index_t DIMENSION >
@@ -361,7 +379,8 @@ namespace RINGMesh
     template < index_t DIMENSION >
     GeologicalEntityType Interface< DIMENSION >::type_name_static()
     {
-        return GeologicalEntityType( "Interface" );
+        static const GeologicalEntityType type{ "Interface" };
+        return type;
     }
 
     template < index_t DIMENSION >
@@ -385,7 +404,8 @@ namespace RINGMesh
     template < index_t DIMENSION >
     GeologicalEntityType Layer< DIMENSION >::type_name_static()
     {
-        return GeologicalEntityType( "Layer" );
+        static const GeologicalEntityType type{ "Layer" };
+        return type;
     }
 
     template < index_t DIMENSION >
@@ -35,16 +35,17 @@
 
 #include <ringmesh/geomodel/core/geomodel_mesh.h>
 
+#include <array>
+#include <cstring>
 #include <numeric>
-#include <stack>
 
 #include <geogram/basic/algorithm.h>
 
-#include <geogram/basic/permutation.h>
 #include <geogram/mesh/mesh_geometry.h>
 
 #include <ringmesh/basic/algorithm.h>
 #include <ringmesh/basic/pimpl_impl.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geogram_extension/geogram_extension.h>
 #include <ringmesh/geogram_extension/geogram_mesh.h>
 #include <ringmesh/geomodel/core/geomodel.h>
@@ -63,75 +64,132 @@ namespace
 {
     using namespace RINGMesh;
 
-    template < index_t DIMENSION >
-    class GeoModelMeshPolygonsBaseSort
-    {
-    public:
-        GeoModelMeshPolygonsBaseSort( const SurfaceMesh< DIMENSION >& mesh,
-            const std::vector< index_t >& surface_id )
-            : mesh_( mesh ), surface_id_( surface_id )
-        {
-        }
-
-        bool operator()( index_t i, index_t j ) const
-        {
-            if( surface_id_[i] != surface_id_[j] )
+    /*!
+     * @brief Computes the permutation sorting the elements by a small
+     * integer key using a parallel (and stable) counting sort
+     * @param[in] keys the key of each element, in [0, nb_keys)
+     * @param[in] nb_keys the number of different keys
+     * @return the sorted indices, the element at the position i once sorted
+     * is the element sorted_indices[i]
+     */
+    std::vector< index_t > counting_sort_permutation(
+        const std::vector< index_t >& keys, index_t nb_keys )
+    {
+        const index_t min_chunk_size = 16384;
+        auto nb_elements = static_cast< index_t >( keys.size() );
+        auto nb_chunks = std::max( index_t( 1 ),
+            std::min( nb_elements / min_chunk_size,
+                static_cast< index_t >(
+                    std::thread::hardware_concurrency() ) ) );
+        auto chunk_size = ( nb_elements + nb_chunks - 1 ) / nb_chunks;
+
+        // Count the keys of each chunk
+        std::vector< index_t > offsets( nb_chunks * nb_keys, 0 );
+        parallel_for( nb_chunks, [&]( index_t chunk ) {
+            auto* chunk_offsets = &offsets[chunk * nb_keys];
+            for( auto i : range( chunk * chunk_size,
+                     std::min( nb_elements, ( chunk + 1 ) * chunk_size ) ) )
             {
-                return surface_id_[i] < surface_id_[j];
+                ringmesh_assert( keys[i] < nb_keys );
+                chunk_offsets[keys[i]]++;
             }
-            return mesh_.nb_polygon_vertices( i )
-                   < mesh_.nb_polygon_vertices( j );
-        }
+        } );
 
-    private:
-        const SurfaceMesh< DIMENSION >& mesh_;
-        const std::vector< index_t >& surface_id_;
-    };
-
-    template < index_t DIMENSION >
-    class GeoModelMeshCellsSort
-    {
-    public:
-        GeoModelMeshCellsSort( const VolumeMesh< DIMENSION >& mesh,
-            const std::vector< index_t >& region_id )
-            : mesh_( mesh ), region_id_( region_id )
+        // Start of each (key, chunk) pair in the sorted indices
+        index_t offset{ 0 };
+        for( auto key : range( nb_keys ) )
         {
+            for( auto chunk : range( nb_chunks ) )
+            {
+                auto& chunk_offset = offsets[chunk * nb_keys + key];
+                auto nb_chunk_elements = chunk_offset;
+                chunk_offset = offset;
+                offset += nb_chunk_elements;
+            }
         }
 
-        bool operator()( index_t i, index_t j ) const
-        {
-            if( region_id_[i] != region_id_[j] )
+        std::vector< index_t > sorted_indices( nb_elements );
+        parallel_for( nb_chunks, [&]( index_t chunk ) {
+            auto* chunk_offsets = &offsets[chunk * nb_keys];
+            for( auto i : range( chunk * chunk_size,
+                     std::min( nb_elements, ( chunk + 1 ) * chunk_size ) ) )
+            {
+                sorted_indices[chunk_offsets[keys[i]]++] = i;
+            }
+        } );
+        return sorted_indices;
+    }
+
+    /*!
+     * @brief Applies a permutation to two element data vectors
+     * in a single pass
+     * @param[in] sorted_indices the new element i is the old element
+     * sorted_indices[i]
+     */
+    void permute_element_data( const std::vector< index_t >& sorted_indices,
+        std::vector< index_t >& data1,
+        std::vector< index_t >& data2 )
+    {
+        std::vector< index_t > permuted_data1( data1.size() );
+        std::vector< index_t > permuted_data2( data2.size() );
+        parallel_for( static_cast< index_t >( sorted_indices.size() ),
+            [&]( index_t i ) {
+                permuted_data1[i] = data1[sorted_indices[i]];
+                permuted_data2[i] = data2[sorted_indices[i]];
+            } );
+        data1.swap( permuted_data1 );
+        data2.swap( permuted_data2 );
+    }
+
+    /*!
+     * Sorted vertex indices of a polygon or of a cell facet, padded with
+     * NO_ID for triangles. Used as an exact matching key.
+     */
+    using FacetKey = std::array< index_t, 4 >;
+
+    /*!
+     * @brief Gets the sorted keys of the GeoModelMesh polygons that can match
+     * a cell facet (triangles and quads), associated to the polygon index.
+     */
+    template < index_t DIMENSION >
+    std::vector< std::pair< FacetKey, index_t > > sorted_polygon_keys(
+        const GeoModelMeshPolygons< DIMENSION >& polygons )
+    {
+        std::vector< std::pair< FacetKey, index_t > > polygon_keys;
+        polygon_keys.reserve( polygons.nb() );
+        for( auto p : range( polygons.nb() ) )
+        {
+            auto nb_vertices = polygons.nb_vertices( p );
+            if( nb_vertices > 4 )
+            {
+                continue;
+            }
+            FacetKey key;
+            key.fill( NO_ID );
+            for( auto v : range( nb_vertices ) )
             {
-                return region_id_[i] < region_id_[j];
+                key[v] = polygons.vertex( { p, v } );
             }
-            return mesh_.cell_type( i ) < mesh_.cell_type( j );
+            std::sort( key.begin(), key.end() );
+            polygon_keys.emplace_back( key, p );
         }
-
-    private:
-        const VolumeMesh< DIMENSION >& mesh_;
-        const std::vector< index_t >& region_id_;
-    };
+        parallel_sort( polygon_keys );
+        return polygon_keys;
+    }
 
     template < index_t DIMENSION >
-    std::vector< index_t > cell_facets_around_vertex(
-        const VolumeMesh< DIMENSION >& mesh, index_t cell, index_t vertex_id )
+    bool is_vertex_in_cell_facet( const VolumeMesh< DIMENSION >& mesh,
+        const CellLocalFacet& facet,
+        index_t vertex_id )
     {
-        std::vector< index_t > facets;
-        facets.reserve( mesh.nb_cell_facets( cell ) );
-        for( auto f : range( mesh.nb_cell_facets( cell ) ) )
+        for( auto v : range( mesh.nb_cell_facet_vertices( facet ) ) )
         {
-            for( auto v : range( mesh.nb_cell_facet_vertices(
-                     CellLocalFacet( cell, f ) ) ) )
+            if( mesh.cell_facet_vertex( facet, v ) == vertex_id )
             {
-                if( mesh.cell_facet_vertex( CellLocalFacet( cell, f ), v )
-                    == vertex_id )
-                {
-                    facets.push_back( f );
-                    break;
-                }
+                return true;
             }
         }
-        return facets;
+        return false;
     }
 
     template < index_t DIMENSION >
@@ -145,6 +203,195 @@ namespace
             builder->set_vertex( v, mesh.vertex( v ) );
         }
     }
+
+    /*!
+     * @brief Finds an attribute store or creates it with the same element
+     * type and dimension than \p model
+     */
+    GEO::AttributeStore* find_or_create_attribute_store(
+        GEO::AttributesManager& manager,
+        const std::string& name,
+        const GEO::AttributeStore& model )
+    {
+        auto* store = manager.find_attribute_store( name );
+        if( store == nullptr )
+        {
+            const auto type_name = GEO::AttributeStore::
+                element_type_name_by_element_typeid_name(
+                    model.element_typeid_name() );
+            ringmesh_assert(
+                GEO::AttributeStore::element_type_name_is_known( type_name ) );
+            store = GEO::AttributeStore::
+                create_attribute_store_by_element_type_name(
+                    type_name, model.dimension() );
+            manager.bind_attribute_store( name, store );
+        }
+        ringmesh_assert( store->element_size() == model.element_size()
+                         && store->dimension() == model.dimension() );
+        return store;
+    }
+
+    /*!
+     * @brief Lists the attributes to transfer between the GeoModelMesh and
+     * the regions, the coordinates are already in both
+     */
+    std::vector< std::string > transferable_attribute_names(
+        const GEO::AttributesManager& manager )
+    {
+        GEO::vector< std::string > names;
+        manager.list_attribute_names( names );
+        std::vector< std::string > result;
+        result.reserve( names.size() );
+        for( const auto& name : names )
+        {
+            if( name != "point" )
+            {
+                result.push_back( name );
+            }
+        }
+        return result;
+    }
+
+    /*!
+     * @brief Copies the items \p from_ids of an attribute store, the item i
+     * of \p to being the item from_ids[i] of \p from
+     */
+    void gather_attribute_items( const GEO::AttributeStore& from,
+        GEO::AttributeStore& to,
+        const std::vector< index_t >& from_ids )
+    {
+        ringmesh_assert( from_ids.size() <= to.size() );
+        const auto item_size = from.element_size() * from.dimension();
+        const auto* from_data = static_cast< const char* >( from.data() );
+        auto* to_data = static_cast< char* >( to.data() );
+        for( auto i : range( from_ids.size() ) )
+        {
+            std::memcpy( to_data + i * item_size,
+                from_data + from_ids[i] * item_size, item_size );
+        }
+    }
+
+    /*!
+     * @brief Copies the items of an attribute store to the items \p to_ids,
+     * the item to_ids[i] of \p to being the item i of \p from
+     */
+    void scatter_attribute_items( const GEO::AttributeStore& from,
+        GEO::AttributeStore& to,
+        const std::vector< index_t >& to_ids )
+    {
+        ringmesh_assert( to_ids.size() <= from.size() );
+        const auto item_size = from.element_size() * from.dimension();
+        const auto* from_data = static_cast< const char* >( from.data() );
+        auto* to_data = static_cast< char* >( to.data() );
+        for( auto i : range( to_ids.size() ) )
+        {
+            std::memcpy( to_data + to_ids[i] * item_size,
+                from_data + i * item_size, item_size );
+        }
+    }
+
+    /*!
+     * @return for each region, the GeoModelMesh index of each region cell
+     */
+    std::vector< std::vector< index_t > > region_cells_in_gmm(
+        const GeoModel3D& geomodel )
+    {
+        const auto& cells = geomodel.mesh.cells;
+        std::vector< std::vector< index_t > > region_cells(
+            geomodel.nb_regions() );
+        for( const auto& region : geomodel.regions() )
+        {
+            region_cells[region.index()].resize( region.nb_mesh_elements() );
+        }
+        for( auto c : range( cells.nb() ) )
+        {
+            region_cells[cells.region( c )][cells.index_in_region( c )] = c;
+        }
+        return region_cells;
+    }
+
+    /*!
+     * @brief Copies the GeoModelMesh attributes to the regions
+     * @details The stores are found or created once, then the regions are
+     * filled in parallel since each one only modifies its own stores.
+     * @param[in] gmm_manager attributes of the GeoModelMesh elements
+     * @param[in] region_managers attributes of the elements of each region
+     * @param[in] gmm_ids GeoModelMesh index of each element of each region
+     */
+    void transfer_attributes_to_regions(
+        const GEO::AttributesManager& gmm_manager,
+        const std::vector< GEO::AttributesManager* >& region_managers,
+        const std::vector< const std::vector< index_t >* >& gmm_ids )
+    {
+        auto names = transferable_attribute_names( gmm_manager );
+        std::vector< const GEO::AttributeStore* > gmm_stores;
+        std::vector< std::vector< GEO::AttributeStore* > > region_stores(
+            region_managers.size() );
+        for( const auto& name : names )
+        {
+            const auto* gmm_store = gmm_manager.find_attribute_store( name );
+            ringmesh_assert( gmm_store != nullptr );
+            gmm_stores.push_back( gmm_store );
+            for( auto r : range( region_managers.size() ) )
+            {
+                region_stores[r].push_back( find_or_create_attribute_store(
+                    *region_managers[r], name, *gmm_store ) );
+            }
+        }
+        parallel_for( static_cast< index_t >( region_managers.size() ),
+            [&gmm_stores, &region_stores, &gmm_ids]( index_t r ) {
+                for( auto a : range( gmm_stores.size() ) )
+                {
+                    gather_attribute_items(
+                        *gmm_stores[a], *region_stores[r][a], *gmm_ids[r] );
+                }
+            } );
+    }
+
+    /*!
+     * @brief Copies the region attributes to the GeoModelMesh
+     * @details The attributes are copied in parallel. The regions are
+     * visited in order for each attribute, so an item shared by several
+     * regions takes the value of the last one.
+     * @param[in] region_managers attributes of the elements of each region
+     * @param[in] gmm_ids GeoModelMesh index of each element of each region
+     * @param[in] gmm_manager attributes of the GeoModelMesh elements
+     */
+    void transfer_attributes_from_regions(
+        const std::vector< GEO::AttributesManager* >& region_managers,
+        const std::vector< const std::vector< index_t >* >& gmm_ids,
+        GEO::AttributesManager& gmm_manager )
+    {
+        std::vector< std::string > names;
+        std::vector< GEO::AttributeStore* > gmm_stores;
+        for( const auto* region_manager : region_managers )
+        {
+            for( const auto& name :
+                transferable_attribute_names( *region_manager ) )
+            {
+                if( !contains( names, name ) )
+                {
+                    names.push_back( name );
+                    gmm_stores.push_back( find_or_create_attribute_store(
+                        gmm_manager, name,
+                        *region_manager->find_attribute_store( name ) ) );
+                }
+            }
+        }
+        parallel_for( static_cast< index_t >( names.size() ),
+            [&names, &gmm_stores, &region_managers, &gmm_ids]( index_t a ) {
+                for( auto r : range( region_managers.size() ) )
+                {
+                    const auto* region_store =
+                        region_managers[r]->find_attribute_store( names[a] );
+                    if( region_store != nullptr )
+                    {
+                        scatter_attribute_items(
+                            *region_store, *gmm_stores[a], *gmm_ids[r] );
+                    }
+                }
+            } );
+    }
 } // namespace
 
 namespace RINGMesh
@@ -378,6 +625,44 @@ namespace RINGMesh
             }
         }
 
+        /*!
+         * @brief Clears the vertex maps and sizes them to the number of
+         * GeoModelMeshEntities, the map of each GeoModelMeshEntity is left
+         * empty
+         */
+        void bind_empty_mesh_entity_vertex_maps() const
+        {
+            clear();
+            const auto& all_mesh_entity_types =
+                geomodel_.entity_type_manager()
+                    .mesh_entity_manager.mesh_entity_types();
+            for( const auto& cur_entity_type : all_mesh_entity_types )
+            {
+                resize_all_mesh_entity_vertex_maps( cur_entity_type );
+            }
+        }
+
+        /*!
+         * @brief Sets the vertex map of a GeoModelMeshEntity and
+         * the corresponding GME_Vertices
+         * @param[in] mesh_entity_id Unique id to a GeoModelMeshEntity
+         * @param[in] vertex_map Model vertex index of each vertex of the
+         * GeoModelMeshEntity
+         */
+        void assign_vertex_map( const gmme_id& mesh_entity_id,
+            std::vector< index_t > vertex_map ) const
+        {
+            auto& mesh_entity_vertex_map = this->vertex_map( mesh_entity_id );
+            mesh_entity_vertex_map = std::move( vertex_map );
+            for( auto v : range( mesh_entity_vertex_map.size() ) )
+            {
+                ringmesh_assert(
+                    mesh_entity_vertex_map[v] < gme_vertices_.size() );
+                add_to_gme_vertices( GMEVertex( mesh_entity_id, v ),
+                    mesh_entity_vertex_map[v] );
+            }
+        }
+
         /*! @}
          * \name Clearing
          * @{
@@ -496,8 +781,8 @@ namespace RINGMesh
         bool is_mesh_entity_vertex_map_initialized(
             const gmme_id& mesh_entity_id ) const
         {
-            return !vertex_maps_.find( mesh_entity_id.type() )
-                        ->second->at( mesh_entity_id.index() )
+            return !vertex_maps_.at( mesh_entity_id.type() )
+                        ->at( mesh_entity_id.index() )
                         .empty();
         }
 
@@ -506,13 +791,17 @@ namespace RINGMesh
          */
         void clear_all_mesh_entity_vertex_map() const
         {
-            for( auto& vertex_map : vertex_maps_ )
+            for( auto* vertex_map : vertex_maps_.values() )
             {
-                for( auto e : range( vertex_map.second->size() ) )
+                if( vertex_map == nullptr )
+                {
+                    continue;
+                }
+                for( auto e : range( vertex_map->size() ) )
                 {
-                    vertex_map.second->at( e ).clear();
+                    vertex_map->at( e ).clear();
                 }
-                vertex_map.second->clear();
+                vertex_map->clear();
             }
         }
 
@@ -543,7 +832,7 @@ namespace RINGMesh
         std::vector< std::vector< index_t > > line_vertex_maps_;
         std::vector< std::vector< index_t > > surface_vertex_maps_;
         std::vector< std::vector< index_t > > region_vertex_maps_;
-        mutable std::map< MeshEntityType,
+        mutable EntityTypeMap< MeshEntityType,
             std::vector< std::vector< index_t > >* >
             vertex_maps_;
 
@@ -767,6 +1056,15 @@ namespace RINGMesh
         return geomodel_vertex_id( mesh_entity, entity_vertex_index );
     }
 
+    template < index_t DIMENSION >
+    const std::vector< index_t >&
+        GeoModelMeshVerticesBase< DIMENSION >::geomodel_vertex_ids(
+            const gmme_id& mesh_entity ) const
+    {
+        test_and_initialize();
+        return impl_->vertex_map( mesh_entity );
+    }
+
     template < index_t DIMENSION >
     std::vector< index_t >
         GeoModelMeshVerticesBase< DIMENSION >::mesh_entity_vertex_id(
@@ -819,6 +1117,25 @@ namespace RINGMesh
             geomodel_vertex_index );
     }
 
+    template < index_t DIMENSION >
+    void GeoModelMeshVerticesBase< DIMENSION >::assign_vertices(
+        const std::vector< double >& point_coordinates )
+    {
+        this->set_is_initialized( true );
+        auto builder =
+            PointSetMeshBuilder< DIMENSION >::create_builder( *mesh_ );
+        builder->assign_vertices( point_coordinates );
+        impl_->bind_empty_mesh_entity_vertex_maps();
+        impl_->resize_geomodel_vertex_gmes( mesh_->nb_vertices() );
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelMeshVerticesBase< DIMENSION >::assign_vertex_mapping(
+        const gmme_id& entity_id, std::vector< index_t > geomodel_vertex_ids )
+    {
+        impl_->assign_vertex_map( entity_id, std::move( geomodel_vertex_ids ) );
+    }
+
     template < index_t DIMENSION >
     void GeoModelMeshVerticesBase< DIMENSION >::remove_colocated() const
     {
@@ -1137,20 +1454,20 @@ namespace RINGMesh
     template < index_t DIMENSION >
     void GeoModelMeshCells< DIMENSION >::sort_cells()
     {
+        // Sort by region then by cell type
+        const auto nb_types = to_underlying_type( CellType::UNDEFINED );
+        std::vector< index_t > keys( mesh_->nb_cells() );
+        parallel_for( mesh_->nb_cells(), [&]( index_t c ) {
+            keys[c] = region_id_[c] * nb_types
+                      + to_underlying_type( mesh_->cell_type( c ) );
+        } );
+        auto sorted_indices = counting_sort_permutation(
+            keys, this->geomodel_.nb_regions() * nb_types );
+
         auto mesh_builder =
             VolumeMeshBuilder< DIMENSION >::create_builder( *mesh_ );
-        std::vector< index_t > sorted_indices( mesh_->nb_cells() );
-        std::iota( sorted_indices.begin(), sorted_indices.end(), 0 );
-        GeoModelMeshCellsSort< DIMENSION > action( *mesh_, region_id_ );
-        std::sort( sorted_indices.begin(), sorted_indices.end(), action );
         mesh_builder->permute_cells( sorted_indices );
-
-        auto sorted_indices_geo =
-            copy_std_vector_to_geo_vector( sorted_indices );
-        GEO::Permutation::apply(
-            region_id_.data(), sorted_indices_geo, sizeof( index_t ) );
-        GEO::Permutation::apply(
-            cell_id_.data(), sorted_indices_geo, sizeof( index_t ) );
+        permute_element_data( sorted_indices, region_id_, cell_id_ );
     }
 
     template < index_t DIMENSION >
@@ -1549,166 +1866,238 @@ namespace RINGMesh
     {
         test_and_initialize();
 
-        /// 1. Get all the corner vertices (a lot of duplicated vertices)
-        std::vector< vec3 > corner_vertices(
-            mesh_->cell_end( mesh_->nb_cells() - 1 ) );
-        for( auto c : range( mesh_->nb_cells() ) )
+        /// 1. Tag all vertices to duplicate (vertices on a surface to duplicate)
+        std::vector< ActionOnSurface > actions_on_surfaces(
+            this->geomodel_.nb_surfaces(), SKIP );
+        std::vector< index_t > vertex_rank( this->gmm_.vertices.nb(), NO_ID );
+        for( const auto& surface : this->geomodel_.surfaces() )
         {
-            index_t begin = mesh_->cell_begin( c );
-            for( auto v : range( mesh_->nb_cell_vertices( c ) ) )
+            if( !is_surface_to_duplicate( surface.index() ) )
+            {
+                continue;
+            }
+            actions_on_surfaces[surface.index()] = TO_PROCESS;
+            for( auto v : range( surface.nb_vertices() ) )
             {
-                corner_vertices[begin + v] = mesh_->vertex(
-                    mesh_->cell_vertex( ElementLocalVertex( c, v ) ) );
+                vertex_rank[this->gmm_.vertices.geomodel_vertex_id(
+                    surface.gmme(), v )] = 0;
             }
         }
+        std::vector< index_t > vertices_to_duplicate;
+        for( auto v : range( vertex_rank.size() ) )
+        {
+            if( vertex_rank[v] != NO_ID )
+            {
+                vertex_rank[v] =
+                    static_cast< index_t >( vertices_to_duplicate.size() );
+                vertices_to_duplicate.push_back( v );
+            }
+        }
+        auto nb_vertices_to_duplicate =
+            static_cast< index_t >( vertices_to_duplicate.size() );
 
-        /// 2. Tag all corners to duplicate (vertices on a surface to duplicate)
-        std::vector< ActionOnSurface > actions_on_surfaces(
-            this->geomodel_.nb_surfaces(), SKIP );
-        std::vector< bool > is_vertex_to_duplicate(
-            corner_vertices.size(), false );
+        /// 2. Get the sorted cells around each vertex to duplicate,
+        /// the cells of the vertex of rank r are in
+        /// [vertex_cell_ptr[r], vertex_cell_ptr[r + 1]) of vertex_cells
+        std::vector< index_t > vertex_cell_ptr( nb_vertices_to_duplicate + 1, 0 );
+        for( auto c : range( mesh_->nb_cells() ) )
         {
-            NNSearch< DIMENSION > nn_search( corner_vertices, false );
-            for( const auto& surface : this->geomodel_.surfaces() )
+            for( auto v : range( mesh_->nb_cell_vertices( c ) ) )
             {
-                if( !is_surface_to_duplicate( surface.index() ) )
+                auto rank = vertex_rank[mesh_->cell_vertex( { c, v } )];
+                if( rank != NO_ID )
                 {
-                    continue;
+                    vertex_cell_ptr[rank + 1]++;
                 }
-                actions_on_surfaces[surface.index()] = TO_PROCESS;
-                for( auto v : range( surface.nb_vertices() ) )
+            }
+        }
+        std::partial_sum( vertex_cell_ptr.begin(), vertex_cell_ptr.end(),
+            vertex_cell_ptr.begin() );
+        std::vector< index_t > vertex_cells( vertex_cell_ptr.back() );
+        {
+            auto cell_cursor = vertex_cell_ptr;
+            for( auto c : range( mesh_->nb_cells() ) )
+            {
+                for( auto v : range( mesh_->nb_cell_vertices( c ) ) )
                 {
-                    auto colocated_corners = nn_search.get_neighbors(
-                        surface.vertex( v ), this->geomodel_.epsilon() );
-                    for( auto co : colocated_corners )
+                    auto rank = vertex_rank[mesh_->cell_vertex( { c, v } )];
+                    if( rank != NO_ID )
                     {
-                        is_vertex_to_duplicate[co] = true;
+                        vertex_cells[cell_cursor[rank]++] = c;
                     }
                 }
             }
         }
         // Free some memory
-        corner_vertices.clear();
-
-        /// 3. Duplicate the corners
-        /* The goal is to visit the corners of the GeoModelMesh
-         * that are on one side of a Surface. We propagate through the cells
-         * that have one vertex on a Surface without crossing the Surface.
-         * All the corners visited during this propagation around the vertex
-         * are duplicated if needed.
+        vertex_rank.clear();
+
+        /// 3. Split the cells around each vertex into fans
+        /* A fan is the set of cells around a vertex that are on one side of
+         * a Surface. We propagate through the cells around the vertex
+         * without crossing the Surface. The vertices are independent,
+         * so the fans are computed in parallel by chunks of vertices.
          */
         this->gmm_.polygons.test_and_initialize();
-        for( auto c : range( mesh_->nb_cells() ) )
-        {
-            for( auto v : range( mesh_->nb_cell_vertices( c ) ) )
+        test_and_initialize_cell_facet();
+        const index_t nb_vertices_per_task = 256;
+        auto nb_tasks = ( nb_vertices_to_duplicate + nb_vertices_per_task - 1 )
+                        / nb_vertices_per_task;
+        std::vector< index_t > cell_fans( vertex_cells.size(), NO_ID );
+        std::vector< index_t > vertex_fan_ptr( nb_vertices_to_duplicate + 1, 0 );
+        std::vector< std::vector< VertexFan > > task_fans( nb_tasks );
+        parallel_for( nb_tasks, [&]( index_t task ) {
+            std::vector< index_t > stack;
+            auto& fans = task_fans[task];
+            auto end = std::min( nb_vertices_to_duplicate,
+                ( task + 1 ) * nb_vertices_per_task );
+            for( auto rank : range( task * nb_vertices_per_task, end ) )
+            {
+                auto nb_fans = fans.size();
+                compute_vertex_fans( vertices_to_duplicate[rank], vertex_cells,
+                    vertex_cell_ptr[rank], vertex_cell_ptr[rank + 1], cell_fans,
+                    fans, stack );
+                vertex_fan_ptr[rank + 1] =
+                    static_cast< index_t >( fans.size() - nb_fans );
+            }
+        } );
+        std::partial_sum( vertex_fan_ptr.begin(), vertex_fan_ptr.end(),
+            vertex_fan_ptr.begin() );
+        std::vector< VertexFan > fans;
+        fans.reserve( vertex_fan_ptr.back() );
+        for( auto& cur_fans : task_fans )
+        {
+            std::move(
+                cur_fans.begin(), cur_fans.end(), std::back_inserter( fans ) );
+        }
+        task_fans.clear();
+
+        /// 4. Determine which fans should be duplicated
+        /* We need to duplicate only one side of the surface, the first side
+         * encountered decides for the whole surface. The fans are processed
+         * in the cell corner order to always duplicate the same side.
+         */
+        std::vector< index_t > fan_order( fans.size() );
+        std::iota( fan_order.begin(), fan_order.end(), 0 );
+        parallel_sort( fan_order, [&fans]( index_t lhs, index_t rhs ) {
+            return fans[lhs].first_corner < fans[rhs].first_corner;
+        } );
+        std::vector< index_t > duplicated_fan_vertices( fans.size(), NO_ID );
+        for( auto f : fan_order )
+        {
+            if( fans[f].surfaces.empty()
+                || !are_corners_to_duplicate(
+                       fans[f].surfaces, actions_on_surfaces ) )
             {
-                // get the index of the corner inside cell_corners_
-                index_t co = mesh_->cell_begin( c ) + v;
+                continue;
+            }
+            // Add a new duplicated vertex and its associated vertex
+            duplicated_fan_vertices[f] =
+                this->gmm_.vertices.nb()
+                + static_cast< index_t >( duplicated_vertex_indices_.size() );
+            duplicated_vertex_indices_.push_back( fans[f].vertex );
+        }
 
-                if( !is_vertex_to_duplicate[co] )
+        /// 5. Update all the cell corners of the duplicated fans
+        /// to the new duplicated vertex index
+        auto mesh_builder =
+            VolumeMeshBuilder< DIMENSION >::create_builder( *mesh_ );
+        for( auto rank : range( nb_vertices_to_duplicate ) )
+        {
+            auto vertex_id = vertices_to_duplicate[rank];
+            for( auto i :
+                range( vertex_cell_ptr[rank], vertex_cell_ptr[rank + 1] ) )
+            {
+                auto duplicated_vertex_id = duplicated_fan_vertices
+                    [vertex_fan_ptr[rank] + cell_fans[i]];
+                if( duplicated_vertex_id != NO_ID )
                 {
-                    continue;
+                    mesh_builder->set_cell_corner_vertex_index(
+                        mesh_->find_cell_corner( vertex_cells[i], vertex_id ),
+                        duplicated_vertex_id );
                 }
-                // The vertex is on a surface to duplicate
-
-                // Propagate on the cells around the corresponding vertex.
-                // The propagation process cannot cross any surface.
-                auto vertex_id =
-                    mesh_->cell_vertex( ElementLocalVertex( c, v ) );
-
-                // all the cell corners resulting of the propagation
-                std::vector< index_t > corner_used;
-
-                // all cells used during the propagation, used to provide
-                // adding the same cell several times into the stack
-                std::vector< index_t > cell_added;
-
-                // all the surfaces encountered during the propagation
-                // and which side stopped the propagation
-                std::vector< action_on_surface > surfaces;
+            }
+        }
+        mode_ = this->gmm_.duplicate_mode();
+    }
 
-                // stack of the front of cells
-                std::stack< index_t > S;
-                S.push( c );
-                cell_added.push_back( c );
-                do
+    template < index_t DIMENSION >
+    void GeoModelMeshCells< DIMENSION >::compute_vertex_fans( index_t vertex_id,
+        const std::vector< index_t >& vertex_cells,
+        index_t begin,
+        index_t end,
+        std::vector< index_t >& cell_fans,
+        std::vector< VertexFan >& fans,
+        std::vector< index_t >& stack ) const
+    {
+        auto first_cell = vertex_cells.begin() + begin;
+        auto last_cell = vertex_cells.begin() + end;
+        index_t nb_fans{ 0 };
+        for( auto start : range( begin, end ) )
+        {
+            if( cell_fans[start] != NO_ID )
+            {
+                continue;
+            }
+            // The cells are sorted, so the first cell of the fan
+            // gives its first corner
+            VertexFan fan;
+            fan.vertex = vertex_id;
+            fan.first_corner =
+                mesh_->find_cell_corner( vertex_cells[start], vertex_id );
+            ringmesh_assert( fan.first_corner != NO_ID );
+
+            cell_fans[start] = nb_fans;
+            stack.push_back( start );
+            do
+            {
+                auto cur_c = vertex_cells[stack.back()];
+                stack.pop_back();
+                for( auto cur_f : range( mesh_->nb_cell_facets( cur_c ) ) )
                 {
-                    auto cur_c = S.top();
-                    S.pop();
-                    // Find which corner of the current cell matches vertex_id
-                    auto cur_co = mesh_->find_cell_corner( cur_c, vertex_id );
-                    ringmesh_assert( cur_co != NO_ID );
-                    is_vertex_to_duplicate[cur_co] = false;
-                    corner_used.push_back( cur_co );
-
-                    // Find the cell facets including the vertex
-                    auto facets =
-                        cell_facets_around_vertex( *mesh_, cur_c, vertex_id );
-                    for( auto cur_f : facets )
+                    if( !is_vertex_in_cell_facet(
+                            *mesh_, { cur_c, cur_f }, vertex_id ) )
                     {
-                        // Find if the facet is on a surface or inside the
-                        // domain
-                        index_t polygon{ NO_ID };
-                        bool side;
-                        if( is_cell_facet_on_surface(
-                                cur_c, cur_f, polygon, side ) )
-                        {
-                            auto surface_id =
-                                this->gmm_.polygons.surface( polygon );
-                            surfaces.emplace_back(
-                                surface_id, ActionOnSurface( side ) );
-                        }
-                        else
-                        {
-                            // The cell facet is not on a surface.
-                            // Add the adjacent cell to the stack if it exists
-                            // and has not already been processed or added into
-                            // the stack
-                            auto cur_adj =
-                                mesh_->cell_adjacent( { cur_c, cur_f } );
-                            if( cur_adj != NO_ID
-                                && !contains( cell_added, cur_adj ) )
-                            {
-                                cell_added.push_back( cur_adj );
-                                S.push( cur_adj );
-                            }
-                        }
+                        continue;
                     }
-                } while( !S.empty() );
-
-                // Remove redundant occurrences and sort the remaining ones
-                sort_unique( surfaces );
-
-                // Determine if the corners should be duplicated or not because
-                // we need to duplicate only one side of the surface
-                if( are_corners_to_duplicate( surfaces, actions_on_surfaces ) )
-                {
-                    // Add a new duplicated vertex and its associated vertex
-
-                    /* @todo Review : Use the total_nb_vertices function [JP]
-                     * why mm_.vertices.nb_vertices() and not nb_vertices() ?
-                     * Please help the reader !! same thing 2 lines below [JP]
-                     */
-                    auto duplicated_vertex_id =
-                        this->gmm_.vertices.nb()
-                        + static_cast< index_t >(
-                              duplicated_vertex_indices_.size() );
-                    duplicated_vertex_indices_.push_back( vertex_id );
-
-                    // Update all the cell corners on this side of the surface
-                    // to the new duplicated vertex index
-                    auto mesh_builder =
-                        VolumeMeshBuilder< DIMENSION >::create_builder(
-                            *mesh_ );
-                    for( auto cur_co : corner_used )
+                    // Find if the facet is on a surface or inside the domain
+                    index_t polygon{ NO_ID };
+                    bool side;
+                    if( is_cell_facet_on_surface(
+                            cur_c, cur_f, polygon, side ) )
+                    {
+                        auto surface_id =
+                            this->gmm_.polygons.surface( polygon );
+                        fan.surfaces.emplace_back(
+                            surface_id, ActionOnSurface( side ) );
+                        continue;
+                    }
+                    // The cell facet is not on a surface.
+                    // Add the adjacent cell to the stack if it exists
+                    // and has not already been processed or added into
+                    // the stack
+                    auto cur_adj = mesh_->cell_adjacent( { cur_c, cur_f } );
+                    if( cur_adj == NO_ID )
                     {
-                        mesh_builder->set_cell_corner_vertex_index(
-                            cur_co, duplicated_vertex_id );
+                        continue;
+                    }
+                    auto adj_it =
+                        std::lower_bound( first_cell, last_cell, cur_adj );
+                    ringmesh_assert( adj_it != last_cell && *adj_it == cur_adj );
+                    auto adj = static_cast< index_t >(
+                        adj_it - vertex_cells.begin() );
+                    if( cell_fans[adj] == NO_ID )
+                    {
+                        cell_fans[adj] = nb_fans;
+                        stack.push_back( adj );
                     }
                 }
-            }
+            } while( !stack.empty() );
+
+            // Remove redundant occurrences and sort the remaining ones
+            sort_unique( fan.surfaces );
+            fans.push_back( std::move( fan ) );
+            nb_fans++;
         }
-        mode_ = this->gmm_.duplicate_mode();
     }
 
     template < index_t DIMENSION >
@@ -1912,24 +2301,42 @@ namespace RINGMesh
     {
         this->gmm_.polygons.test_and_initialize();
 
+        // Cell facets and polygons are matched by their GeoModelMesh vertex
+        // indices: no geometrical tolerance is involved.
+        const auto polygon_keys =
+            sorted_polygon_keys( this->gmm_.polygons );
         polygon_id_.resize( mesh_->nb_cell_facets(), NO_ID );
-        const auto& nn_search = this->gmm_.polygons.nn_search();
-        for( auto c : range( mesh_->nb_cells() ) )
-        {
+        const auto nb_vertices = mesh_->nb_vertices();
+        parallel_for( mesh_->nb_cells(), [this, &polygon_keys, nb_vertices](
+                                             index_t c ) {
             for( auto f : range( mesh_->nb_cell_facets( c ) ) )
             {
-                auto result = nn_search.get_neighbors(
-                    mesh_->cell_facet_barycenter( { c, f } ),
-                    this->geomodel_.epsilon() );
-                if( !result.empty() )
+                FacetKey key;
+                key.fill( NO_ID );
+                for( auto v :
+                    range( mesh_->nb_cell_facet_vertices( { c, f } ) ) )
                 {
-                    polygon_id_[mesh_->cell_facet( { c, f } )] = result[0];
-                    // If there are more than 1 matching facet, this is WRONG
-                    // and the vertex indices should be checked too [Jeanne]
-                    ringmesh_assert( result.size() == 1 );
+                    auto vertex = mesh_->cell_facet_vertex( { c, f }, v );
+                    // Duplicated vertices are matched by their original
+                    // vertex
+                    key[v] = vertex < nb_vertices
+                                 ? vertex
+                                 : duplicated_vertex_indices_[vertex
+                                                              - nb_vertices];
+                }
+                std::sort( key.begin(), key.end() );
+                auto it = std::lower_bound( polygon_keys.begin(),
+                    polygon_keys.end(), std::make_pair( key, index_t( 0 ) ) );
+                if( it != polygon_keys.end() && it->first == key )
+                {
+                    polygon_id_[mesh_->cell_facet( { c, f } )] = it->second;
+                    // If there are more than 1 matching polygon,
+                    // the surfaces are not conformal
+                    ringmesh_assert( it + 1 == polygon_keys.end()
+                                     || ( it + 1 )->first != key );
                 }
             }
-        }
+        } );
     }
 
     template < index_t DIMENSION >
@@ -1970,6 +2377,14 @@ namespace RINGMesh
         return mesh_->cell_aabb();
     }
 
+    template < index_t DIMENSION >
+    const VolumeCellGrid< DIMENSION >&
+        GeoModelMeshCells< DIMENSION >::cell_grid() const
+    {
+        test_and_initialize();
+        return mesh_->cell_grid();
+    }
+
     /*******************************************************************************/
     template < index_t DIMENSION >
     const std::string GeoModelMeshEdges< DIMENSION >::line_att_name = "line";
@@ -2665,20 +3080,21 @@ namespace RINGMesh
     template < index_t DIMENSION >
     void GeoModelMeshPolygonsBase< DIMENSION >::sort_polygons()
     {
+        // Sort by surface then by polygon type
+        const auto nb_types = to_underlying_type( PolygonType::UNDEFINED );
+        std::vector< index_t > keys( mesh_->nb_polygons() );
+        parallel_for( mesh_->nb_polygons(), [&]( index_t p ) {
+            auto nb_vertices = mesh_->nb_polygon_vertices( p );
+            keys[p] = surface_id_[p] * nb_types
+                      + std::min( nb_vertices, index_t( 5 ) ) - 3;
+        } );
+        auto sorted_indices = counting_sort_permutation(
+            keys, this->geomodel_.nb_surfaces() * nb_types );
+
         auto mesh_builder =
             SurfaceMeshBuilder< DIMENSION >::create_builder( *mesh_ );
-        std::vector< index_t > sorted_indices( mesh_->nb_polygons() );
-        std::iota( sorted_indices.begin(), sorted_indices.end(), 0 );
-        GeoModelMeshPolygonsBaseSort< DIMENSION > action( *mesh_, surface_id_ );
-        std::sort( sorted_indices.begin(), sorted_indices.end(), action );
         mesh_builder->permute_polygons( sorted_indices );
-
-        auto sorted_indices_geo =
-            copy_std_vector_to_geo_vector( sorted_indices );
-        GEO::Permutation::apply(
-            surface_id_.data(), sorted_indices_geo, sizeof( index_t ) );
-        GEO::Permutation::apply(
-            polygon_id_.data(), sorted_indices_geo, sizeof( index_t ) );
+        permute_element_data( sorted_indices, surface_id_, polygon_id_ );
     }
 
     template < index_t DIMENSION >
@@ -2993,264 +3409,59 @@ namespace RINGMesh
     void GeoModelMesh< 3 >::transfer_vertex_attributes_from_gmm_to_gm_regions()
         const
     {
-        auto& gmm_v_attr_mgr = vertices.attribute_manager();
-        GEO::vector< std::string > att_v_names;
-        gmm_v_attr_mgr.list_attribute_names( att_v_names );
-        for( const auto& cur_attr_name : att_v_names )
+        std::vector< GEO::AttributesManager* > region_managers;
+        std::vector< const std::vector< index_t >* > gmm_ids;
+        for( const auto& region : geomodel_.regions() )
         {
-            // It is not necessary to copy the coordinates. There are already
-            // there.
-            if( cur_attr_name == "point" )
-            {
-                continue;
-            }
-
-            auto* cur_v_att_store_in_gmm =
-                gmm_v_attr_mgr.find_attribute_store( cur_attr_name );
-            ringmesh_assert( cur_v_att_store_in_gmm != nullptr );
-            auto dim = cur_v_att_store_in_gmm->dimension();
-
-            for( auto v : range( vertices.nb() ) )
-            {
-                auto vertices_on_geomodel_region = vertices.gme_type_vertices(
-                    Region3D::type_name_static(), v );
-                for( const auto& cur_vertex_on_geomodel :
-                    vertices_on_geomodel_region )
-                {
-                    const auto& cur_region =
-                        geomodel_.region( cur_vertex_on_geomodel.gmme.index() );
-                    auto& reg_v_attr_mgr =
-                        cur_region.vertex_attribute_manager();
-                    GEO::AttributeStore* cur_v_att_store_in_reg{ nullptr };
-
-                    if( !reg_v_attr_mgr.is_defined( cur_attr_name ) )
-                    {
-                        const auto cur_type_name = GEO::AttributeStore::
-                            element_type_name_by_element_typeid_name(
-                                cur_v_att_store_in_gmm->element_typeid_name() );
-                        ringmesh_assert(
-                            GEO::AttributeStore::element_type_name_is_known(
-                                cur_type_name ) );
-                        cur_v_att_store_in_reg = GEO::AttributeStore::
-                            create_attribute_store_by_element_type_name(
-                                cur_type_name, dim );
-                        reg_v_attr_mgr.bind_attribute_store(
-                            cur_attr_name, cur_v_att_store_in_reg );
-                    }
-                    else
-                    {
-                        cur_v_att_store_in_reg =
-                            reg_v_attr_mgr.find_attribute_store(
-                                cur_attr_name );
-                    }
-                    ringmesh_assert( cur_v_att_store_in_reg != nullptr );
-                    ringmesh_assert(
-                        cur_v_att_store_in_reg->element_size()
-                        == cur_v_att_store_in_gmm->element_size() );
-
-                    GEO::Memory::copy(
-                        static_cast< GEO::Memory::pointer >(
-                            cur_v_att_store_in_reg->data() )
-                            + cur_vertex_on_geomodel.v_index * dim
-                                  * cur_v_att_store_in_reg->element_size(),
-                        static_cast< GEO::Memory::pointer >(
-                            cur_v_att_store_in_gmm->data() )
-                            + v * dim * cur_v_att_store_in_gmm->element_size(),
-                        dim * cur_v_att_store_in_reg->element_size() );
-                }
-            }
+            region_managers.push_back( &region.vertex_attribute_manager() );
+            gmm_ids.push_back( &vertices.geomodel_vertex_ids( region.gmme() ) );
         }
+        transfer_attributes_to_regions(
+            vertices.attribute_manager(), region_managers, gmm_ids );
     }
 
     void GeoModelMesh< 3 >::transfer_vertex_attributes_from_gm_regions_to_gmm()
         const
     {
-        for( const auto& cur_reg : geomodel().regions() )
+        std::vector< GEO::AttributesManager* > region_managers;
+        std::vector< const std::vector< index_t >* > gmm_ids;
+        for( const auto& region : geomodel_.regions() )
         {
-            GEO::vector< std::string > att_v_names;
-            GEO::AttributesManager& reg_vertex_attr_mgr =
-                cur_reg.vertex_attribute_manager();
-            reg_vertex_attr_mgr.list_attribute_names( att_v_names );
-            for( const auto& cur_attr_name : att_v_names )
-            {
-                // It is not necessary to copy the coordinates. There are
-                // already there.
-                if( cur_attr_name == "point" )
-                {
-                    continue;
-                }
-
-                auto* cur_v_att_store_in_reg =
-                    reg_vertex_attr_mgr.find_attribute_store( cur_attr_name );
-                ringmesh_assert( cur_v_att_store_in_reg != nullptr );
-                index_t dim = cur_v_att_store_in_reg->dimension();
-                GEO::AttributeStore* cur_v_att_store{ nullptr };
-                if( !vertices.attribute_manager().is_defined( cur_attr_name ) )
-                {
-                    const auto cur_type_name = GEO::AttributeStore::
-                        element_type_name_by_element_typeid_name(
-                            cur_v_att_store_in_reg->element_typeid_name() );
-                    ringmesh_assert(
-                        GEO::AttributeStore::element_type_name_is_known(
-                            cur_type_name ) );
-                    cur_v_att_store = GEO::AttributeStore::
-                        create_attribute_store_by_element_type_name(
-                            cur_type_name, dim );
-                    vertices.attribute_manager().bind_attribute_store(
-                        cur_attr_name, cur_v_att_store );
-                }
-                else
-                {
-                    cur_v_att_store =
-                        vertices.attribute_manager().find_attribute_store(
-                            cur_attr_name );
-                }
-                ringmesh_assert( cur_v_att_store != nullptr );
-                ringmesh_assert( cur_v_att_store->element_size()
-                                 == cur_v_att_store_in_reg->element_size() );
-
-                for( auto v_in_reg_itr : range( cur_reg.nb_vertices() ) )
-                {
-                    auto v_id_in_gmm = vertices.geomodel_vertex_id(
-                        cur_reg.gmme(), v_in_reg_itr );
-                    GEO::Memory::copy(
-                        static_cast< GEO::Memory::pointer >(
-                            cur_v_att_store->data() )
-                            + v_id_in_gmm * dim
-                                  * cur_v_att_store->element_size(),
-                        static_cast< GEO::Memory::pointer >(
-                            cur_v_att_store_in_reg->data() )
-                            + v_in_reg_itr * dim
-                                  * cur_v_att_store_in_reg->element_size(),
-                        dim * cur_v_att_store->element_size() );
-                }
-            }
+            region_managers.push_back( &region.vertex_attribute_manager() );
+            gmm_ids.push_back( &vertices.geomodel_vertex_ids( region.gmme() ) );
         }
+        transfer_attributes_from_regions(
+            region_managers, gmm_ids, vertices.attribute_manager() );
     }
 
     void GeoModelMesh< 3 >::transfer_cell_attributes_from_gmm_to_gm_regions()
         const
     {
-        auto& gmm_c_attr_mgr = cells.attribute_manager();
-        GEO::vector< std::string > att_c_names;
-        gmm_c_attr_mgr.list_attribute_names( att_c_names );
-        const auto& nn_search = cells.cell_nn_search();
-
-        for( const auto& cur_attr_name : att_c_names )
+        auto region_cells = region_cells_in_gmm( geomodel_ );
+        std::vector< GEO::AttributesManager* > region_managers;
+        std::vector< const std::vector< index_t >* > gmm_ids;
+        for( const auto& region : geomodel_.regions() )
         {
-            auto* cur_c_att_store_in_gmm =
-                gmm_c_attr_mgr.find_attribute_store( cur_attr_name );
-            ringmesh_assert( cur_c_att_store_in_gmm != nullptr );
-            auto dim = cur_c_att_store_in_gmm->dimension();
-
-            for( const auto& cur_region : geomodel_.regions() )
-            {
-                auto& reg_c_attr_mgr = cur_region.cell_attribute_manager();
-                GEO::AttributeStore* cur_c_att_store_in_reg{ nullptr };
-
-                if( !reg_c_attr_mgr.is_defined( cur_attr_name ) )
-                {
-                    const auto cur_type_name = GEO::AttributeStore::
-                        element_type_name_by_element_typeid_name(
-                            cur_c_att_store_in_gmm->element_typeid_name() );
-                    ringmesh_assert(
-                        GEO::AttributeStore::element_type_name_is_known(
-                            cur_type_name ) );
-                    cur_c_att_store_in_reg = GEO::AttributeStore::
-                        create_attribute_store_by_element_type_name(
-                            cur_type_name, dim );
-                    reg_c_attr_mgr.bind_attribute_store(
-                        cur_attr_name, cur_c_att_store_in_reg );
-                }
-                else
-                {
-                    cur_c_att_store_in_reg =
-                        reg_c_attr_mgr.find_attribute_store( cur_attr_name );
-                }
-                ringmesh_assert( cur_c_att_store_in_reg != nullptr );
-                ringmesh_assert( cur_c_att_store_in_reg->element_size()
-                                 == cur_c_att_store_in_gmm->element_size() );
-
-                for( auto c : range( cur_region.nb_mesh_elements() ) )
-                {
-                    auto center = cur_region.mesh_element_barycenter( c );
-                    auto c_in_geom_model_mesh =
-                        nn_search.get_neighbors( center, geomodel_.epsilon() );
-                    ringmesh_assert( c_in_geom_model_mesh.size() == 1 );
-                    GEO::Memory::copy(
-                        static_cast< GEO::Memory::pointer >(
-                            cur_c_att_store_in_reg->data() )
-                            + c * dim * cur_c_att_store_in_reg->element_size(),
-                        static_cast< GEO::Memory::pointer >(
-                            cur_c_att_store_in_gmm->data() )
-                            + c_in_geom_model_mesh[0] * dim
-                                  * cur_c_att_store_in_gmm->element_size(),
-                        dim * cur_c_att_store_in_reg->element_size() );
-                }
-            }
+            region_managers.push_back( &region.cell_attribute_manager() );
+            gmm_ids.push_back( &region_cells[region.index()] );
         }
+        transfer_attributes_to_regions(
+            cells.attribute_manager(), region_managers, gmm_ids );
     }
 
     void GeoModelMesh< 3 >::transfer_cell_attributes_from_gm_regions_to_gmm()
         const
     {
-        const auto& nn_search = cells.cell_nn_search();
-        for( const auto& cur_reg : geomodel().regions() )
+        auto region_cells = region_cells_in_gmm( geomodel_ );
+        std::vector< GEO::AttributesManager* > region_managers;
+        std::vector< const std::vector< index_t >* > gmm_ids;
+        for( const auto& region : geomodel_.regions() )
         {
-            GEO::vector< std::string > att_c_names;
-            auto& reg_cell_attr_mgr = cur_reg.cell_attribute_manager();
-            reg_cell_attr_mgr.list_attribute_names( att_c_names );
-            for( const auto& cur_attr_name : att_c_names )
-            {
-                auto* cur_c_att_store_in_reg =
-                    reg_cell_attr_mgr.find_attribute_store( cur_attr_name );
-                ringmesh_assert( cur_c_att_store_in_reg != nullptr );
-                index_t dim = cur_c_att_store_in_reg->dimension();
-                GEO::AttributeStore* cur_c_att_store{ nullptr };
-                if( !cells.attribute_manager().is_defined( cur_attr_name ) )
-                {
-                    const std::string cur_type_name = GEO::AttributeStore::
-                        element_type_name_by_element_typeid_name(
-                            cur_c_att_store_in_reg->element_typeid_name() );
-                    ringmesh_assert(
-                        GEO::AttributeStore::element_type_name_is_known(
-                            cur_type_name ) );
-                    cur_c_att_store = GEO::AttributeStore::
-                        create_attribute_store_by_element_type_name(
-                            cur_type_name, dim );
-                    cells.attribute_manager().bind_attribute_store(
-                        cur_attr_name, cur_c_att_store );
-                }
-                else
-                {
-                    cur_c_att_store =
-                        cells.attribute_manager().find_attribute_store(
-                            cur_attr_name );
-                }
-                ringmesh_assert( cur_c_att_store != nullptr );
-                ringmesh_assert( cur_c_att_store->element_size()
-                                 == cur_c_att_store_in_reg->element_size() );
-
-                for( auto c_in_reg_itr : range( cur_reg.nb_mesh_elements() ) )
-                {
-                    auto center =
-                        cur_reg.mesh_element_barycenter( c_in_reg_itr );
-                    auto c_in_geom_model_mesh =
-                        nn_search.get_neighbors( center, geomodel_.epsilon() );
-                    ringmesh_assert( c_in_geom_model_mesh.size() == 1 );
-                    GEO::Memory::copy(
-                        static_cast< GEO::Memory::pointer >(
-                            cur_c_att_store->data() )
-                            + c_in_geom_model_mesh[0] * dim
-                                  * cur_c_att_store->element_size(),
-                        static_cast< GEO::Memory::pointer >(
-                            cur_c_att_store_in_reg->data() )
-                            + c_in_reg_itr * dim
-                                  * cur_c_att_store_in_reg->element_size(),
-                        dim * cur_c_att_store->element_size() );
-                }
-            }
+            region_managers.push_back( &region.cell_attribute_manager() );
+            gmm_ids.push_back( &region_cells[region.index()] );
         }
+        transfer_attributes_from_regions(
+            region_managers, gmm_ids, cells.attribute_manager() );
     }
 
     template class geomodel_core_api GeoModelMeshBase< 2 >;
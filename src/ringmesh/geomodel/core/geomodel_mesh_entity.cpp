@@ -43,6 +43,7 @@
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_geological_entity.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity_loader.h>
 
 #include <ringmesh/mesh/line_mesh.h>
 #include <ringmesh/mesh/mesh_builder.h>
@@ -211,18 +212,54 @@ namespace RINGMesh
     {
     }
 
+    template < index_t DIMENSION >
+    void GeoModelMeshEntity< DIMENSION >::load_mesh_from_loader() const
+    {
+        std::lock_guard< std::mutex > locking( mesh_lock_ );
+        if( !mesh_deferred_ )
+        {
+            return;
+        }
+        mesh_loader_->load_mesh( mesh_source_, *mesh_ );
+        mesh_deferred_ = false;
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelMeshEntity< DIMENSION >::set_mesh_loader(
+        std::shared_ptr< GeoModelMeshEntityLoader< DIMENSION > > loader,
+        index_t source )
+    {
+        ringmesh_assert( loader != nullptr );
+        release_mesh_loader();
+        mesh_loader_ = std::move( loader );
+        mesh_source_ = source;
+        mesh_deferred_ = true;
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelMeshEntity< DIMENSION >::release_mesh_loader()
+    {
+        if( !mesh_loader_ )
+        {
+            return;
+        }
+        load_deferred_mesh();
+        mesh_loader_.reset();
+        mesh_source_ = NO_ID;
+    }
+
     template < index_t DIMENSION >
     const NNSearch< DIMENSION >&
         GeoModelMeshEntity< DIMENSION >::vertex_nn_search() const
     {
-        return mesh_->vertex_nn_search();
+        return base_mesh().vertex_nn_search();
     }
 
     template < index_t DIMENSION >
     GEO::AttributesManager&
         GeoModelMeshEntity< DIMENSION >::vertex_attribute_manager() const
     {
-        return mesh_->vertex_attribute_manager();
+        return base_mesh().vertex_attribute_manager();
     }
 
     template < index_t DIMENSION >
@@ -315,14 +352,13 @@ namespace RINGMesh
             {
                 const auto& E = boundary( i );
                 bool found{ false };
-                index_t j{ 0 };
-                while( !found && j < E.nb_incident_entities() )
+                for( const auto& incident_entity : E.incident_entity_gmmes() )
                 {
-                    if( E.incident_entity_gmme( j ) == id )
+                    if( incident_entity == id )
                     {
                         found = true;
+                        break;
                     }
-                    j++;
                 }
                 if( !found )
                 {
@@ -361,14 +397,13 @@ namespace RINGMesh
             {
                 const auto& E = incident_entity( i );
                 bool found{ false };
-                index_t j{ 0 };
-                while( !found && j < E.nb_boundaries() )
+                for( const auto& boundary : E.boundary_gmmes() )
                 {
-                    if( E.boundary_gmme( j ) == id )
+                    if( boundary == id )
                     {
                         found = true;
+                        break;
                     }
-                    j++;
                 }
                 if( !found )
                 {
@@ -413,14 +448,13 @@ namespace RINGMesh
 
                     // The parent must have this entity in its children
                     bool found{ false };
-                    index_t j{ 0 };
-                    while( !found && j < E.nb_children() )
+                    for( const auto& child : E.child_gmmes() )
                     {
-                        if( E.child_gmme( j ) == id )
+                        if( child == id )
                         {
                             found = true;
+                            break;
                         }
-                        j++;
                     }
                     if( !found )
                     {
@@ -472,20 +506,27 @@ namespace RINGMesh
     void GeoModelMeshEntity< DIMENSION >::save(
         const std::string& filename ) const
     {
-        mesh_->save_mesh( filename );
+        base_mesh().save_mesh( filename );
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelMeshEntity< DIMENSION >::save(
+        std::vector< char >& buffer ) const
+    {
+        base_mesh().save_mesh( buffer );
     }
 
     template < index_t DIMENSION >
     index_t GeoModelMeshEntity< DIMENSION >::nb_vertices() const
     {
-        return mesh_->nb_vertices();
+        return base_mesh().nb_vertices();
     }
 
     template < index_t DIMENSION >
     const vecn< DIMENSION >& GeoModelMeshEntity< DIMENSION >::vertex(
         index_t vertex_index ) const
     {
-        return mesh_->vertex( vertex_index );
+        return base_mesh().vertex( vertex_index );
     }
 
     template < index_t DIMENSION >
@@ -529,6 +570,13 @@ namespace RINGMesh
             .relationship_manager.boundary_gmme( boundaries_[x] );
     }
 
+    template < index_t DIMENSION >
+    boundary_range GeoModelMeshEntity< DIMENSION >::boundary_gmmes() const
+    {
+        return { this->geomodel().entity_type_manager().relationship_manager,
+            boundaries_ };
+    }
+
     template < index_t DIMENSION >
     const GeoModelMeshEntity< DIMENSION >&
         GeoModelMeshEntity< DIMENSION >::boundary( index_t x ) const
@@ -553,6 +601,14 @@ namespace RINGMesh
             .relationship_manager.incident_entity_gmme( incident_entities_[x] );
     }
 
+    template < index_t DIMENSION >
+    incident_entity_range
+        GeoModelMeshEntity< DIMENSION >::incident_entity_gmmes() const
+    {
+        return { this->geomodel().entity_type_manager().relationship_manager,
+            incident_entities_ };
+    }
+
     template < index_t DIMENSION >
     const gmge_id& GeoModelMeshEntity< DIMENSION >::parent_gmge(
         index_t id ) const
@@ -563,6 +619,13 @@ namespace RINGMesh
             .relationship_manager.parent_of_gmme( parents_[id] );
     }
 
+    template < index_t DIMENSION >
+    parent_range GeoModelMeshEntity< DIMENSION >::parent_gmges() const
+    {
+        return { this->geomodel().entity_type_manager().relationship_manager,
+            parents_ };
+    }
+
     template < index_t DIMENSION >
     bool GeoModelMeshEntity< DIMENSION >::has_parent(
         const GeologicalEntityType& parent_type ) const
@@ -615,7 +678,7 @@ namespace RINGMesh
         index_t mesh_element ) const
     {
         ringmesh_unused( mesh_element );
-        index_t nb_vertices = point_set_mesh_->nb_vertices();
+        index_t nb_vertices = mesh().nb_vertices();
         ringmesh_assert( nb_vertices < 2 );
         return nb_vertices;
     }
@@ -627,10 +690,10 @@ namespace RINGMesh
         if( this->nb_vertices() != 1 )
         {
             Logger::err( "GeoModelEntity", this->gmme(), " mesh has ",
-                point_set_mesh_->nb_vertices(), " vertices " );
+                mesh().nb_vertices(), " vertices " );
             valid = false;
         }
-        if( !point_set_mesh_->is_mesh_valid() )
+        if( !mesh().is_mesh_valid() )
         {
             Logger::err( "GeoModelEntity", this->gmme(), " mesh is invalid" );
             valid = false;
@@ -649,7 +712,8 @@ namespace RINGMesh
     template < index_t DIMENSION >
     MeshEntityType Corner< DIMENSION >::type_name_static()
     {
-        return MeshEntityType( "Corner" );
+        static const MeshEntityType type{ "Corner" };
+        return type;
     }
 
     template < index_t DIMENSION >
@@ -682,7 +746,7 @@ namespace RINGMesh
     {
         bool valid{ true };
 
-        if( !line_mesh_->is_mesh_valid() )
+        if( !mesh().is_mesh_valid() )
         {
             Logger::err( "GeoModelEntity", this->gmme(), " mesh is invalid" );
             valid = false;
@@ -794,26 +858,26 @@ namespace RINGMesh
     template < index_t DIMENSION >
     const LineAABBTree< DIMENSION >& Line< DIMENSION >::edge_aabb() const
     {
-        return line_mesh_->edge_aabb();
+        return mesh().edge_aabb();
     }
 
     template < index_t DIMENSION >
     const NNSearch< DIMENSION >& Line< DIMENSION >::edge_nn_search() const
     {
-        return line_mesh_->edge_nn_search();
+        return mesh().edge_nn_search();
     }
 
     template < index_t DIMENSION >
     index_t Line< DIMENSION >::nb_mesh_elements() const
     {
-        return line_mesh_->nb_edges();
+        return mesh().nb_edges();
     }
 
     template < index_t DIMENSION >
     double Line< DIMENSION >::mesh_element_size( index_t edge_index ) const
     {
         ringmesh_assert( edge_index < nb_mesh_elements() );
-        return line_mesh_->edge_length( edge_index );
+        return mesh().edge_length( edge_index );
     }
 
     template < index_t DIMENSION >
@@ -821,7 +885,7 @@ namespace RINGMesh
         index_t edge_index ) const
     {
         ringmesh_assert( edge_index < nb_mesh_elements() );
-        return line_mesh_->edge_barycenter( edge_index );
+        return mesh().edge_barycenter( edge_index );
     }
 
     template < index_t DIMENSION >
@@ -850,13 +914,14 @@ namespace RINGMesh
     {
         ringmesh_assert( element_local_vertex.element_id < nb_mesh_elements() );
         ringmesh_assert( element_local_vertex.local_vertex_id < 2 );
-        return line_mesh_->edge_vertex( element_local_vertex );
+        return mesh().edge_vertex( element_local_vertex );
     }
 
     template < index_t DIMENSION >
     MeshEntityType Line< DIMENSION >::type_name_static()
     {
-        return MeshEntityType( "Line" );
+        static const MeshEntityType type{ "Line" };
+        return type;
     }
 
     template < index_t DIMENSION >
@@ -911,34 +976,34 @@ namespace RINGMesh
     template < index_t DIMENSION >
     index_t SurfaceBase< DIMENSION >::nb_mesh_elements() const
     {
-        return surface_mesh_->nb_polygons();
+        return mesh().nb_polygons();
     }
 
     template < index_t DIMENSION >
     bool SurfaceBase< DIMENSION >::is_simplicial() const
     {
-        return surface_mesh_->polygons_are_simplices();
+        return mesh().polygons_are_simplices();
     }
 
     template < index_t DIMENSION >
     const SurfaceAABBTree< DIMENSION >&
         SurfaceBase< DIMENSION >::polygon_aabb() const
     {
-        return surface_mesh_->polygon_aabb();
+        return mesh().polygon_aabb();
     }
 
     template < index_t DIMENSION >
     const NNSearch< DIMENSION >&
         SurfaceBase< DIMENSION >::polygon_nn_search() const
     {
-        return surface_mesh_->polygon_nn_search();
+        return mesh().polygon_nn_search();
     }
 
     template < index_t DIMENSION >
     GEO::AttributesManager&
         SurfaceBase< DIMENSION >::polygon_attribute_manager() const
     {
-        return surface_mesh_->polygon_attribute_manager();
+        return mesh().polygon_attribute_manager();
     }
 
     template < index_t DIMENSION >
@@ -946,7 +1011,7 @@ namespace RINGMesh
         index_t polygon_index ) const
     {
         ringmesh_assert( polygon_index < nb_mesh_elements() );
-        return surface_mesh_->nb_polygon_vertices( polygon_index );
+        return mesh().nb_polygon_vertices( polygon_index );
     }
 
     template < index_t DIMENSION >
@@ -954,7 +1019,7 @@ namespace RINGMesh
         index_t polygon_index ) const
     {
         ringmesh_assert( polygon_index < nb_mesh_elements() );
-        return surface_mesh_->polygon_barycenter( polygon_index );
+        return mesh().polygon_barycenter( polygon_index );
     }
 
     template < index_t DIMENSION >
@@ -962,7 +1027,7 @@ namespace RINGMesh
         index_t polygon_index ) const
     {
         ringmesh_assert( polygon_index < nb_mesh_elements() );
-        return surface_mesh_->polygon_area( polygon_index );
+        return mesh().polygon_area( polygon_index );
     }
 
     template < index_t DIMENSION >
@@ -973,7 +1038,7 @@ namespace RINGMesh
         ringmesh_assert(
             polygon_local_edge.local_edge_id
             < nb_mesh_element_vertices( polygon_local_edge.polygon_id ) );
-        return surface_mesh_->polygon_adjacent( polygon_local_edge );
+        return mesh().polygon_adjacent( polygon_local_edge );
     }
 
     template < index_t DIMENSION >
@@ -984,7 +1049,7 @@ namespace RINGMesh
         ringmesh_assert(
             element_local_vertex.local_vertex_id
             < nb_mesh_element_vertices( element_local_vertex.element_id ) );
-        return surface_mesh_->polygon_vertex( element_local_vertex );
+        return mesh().polygon_vertex( element_local_vertex );
     }
 
     template < index_t DIMENSION >
@@ -993,7 +1058,7 @@ namespace RINGMesh
         bool valid{ true };
         auto id = this->gmme();
 
-        if( !surface_mesh_->is_mesh_valid() )
+        if( !mesh().is_mesh_valid() )
         {
             Logger::err( "GeoModelEntity", this->gmme(), " mesh is invalid" );
             valid = false;
@@ -1002,7 +1067,7 @@ namespace RINGMesh
         // No zero area polygon
         // No polygon incident to the same vertex check local and global indices
         index_t nb_degenerate{ 0 };
-        for( auto p : range( surface_mesh_->nb_polygons() ) )
+        for( auto p : range( mesh().nb_polygons() ) )
         {
             if( polygon_is_degenerate( *this, p ) )
             {
@@ -1044,7 +1109,8 @@ namespace RINGMesh
     template < index_t DIMENSION >
     MeshEntityType SurfaceBase< DIMENSION >::type_name_static()
     {
-        return MeshEntityType( "Surface" );
+        static const MeshEntityType type{ "Surface" };
+        return type;
     }
 
     bool Surface< 2 >::is_on_voi() const
@@ -1079,6 +1145,24 @@ namespace RINGMesh
             GeoModelMeshEntity3D::incident_entity( x ) );
     }
 
+    index_t Surface< 3 >::region_on_side( bool side ) const
+    {
+        for( const auto& region_id : incident_entity_gmmes() )
+        {
+            const auto& region = geomodel().region( region_id.index() );
+            index_t s{ 0 };
+            for( const auto& boundary : region.boundary_gmmes() )
+            {
+                if( boundary.index() == index() && region.side( s ) == side )
+                {
+                    return region.index();
+                }
+                s++;
+            }
+        }
+        return NO_ID;
+    }
+
     bool Surface< 2 >::is_meshed() const
     {
         return mesh().nb_polygons() > 0;
@@ -1128,7 +1212,7 @@ namespace RINGMesh
             ringmesh_assert(
                 element_local_vertex.local_vertex_id
                 < nb_mesh_element_vertices( element_local_vertex.element_id ) );
-            return volume_mesh_->cell_vertex( element_local_vertex );
+            return mesh().cell_vertex( element_local_vertex );
         }
         ringmesh_assert_not_reached;
         return NO_ID;
@@ -1157,37 +1241,37 @@ namespace RINGMesh
     template < index_t DIMENSION >
     bool Region< DIMENSION >::is_meshed() const
     {
-        return volume_mesh_->nb_cells() > 0;
+        return mesh().nb_cells() > 0;
     }
 
     template < index_t DIMENSION >
     bool Region< DIMENSION >::is_simplicial() const
     {
-        return volume_mesh_->cells_are_simplicies();
+        return mesh().cells_are_simplicies();
     }
 
     template < index_t DIMENSION >
     const VolumeAABBTree< DIMENSION >& Region< DIMENSION >::cell_aabb() const
     {
-        return volume_mesh_->cell_aabb();
+        return mesh().cell_aabb();
     }
 
     template < index_t DIMENSION >
     const NNSearch< DIMENSION >& Region< DIMENSION >::cell_nn_search() const
     {
-        return volume_mesh_->cell_nn_search();
+        return mesh().cell_nn_search();
     }
 
     template < index_t DIMENSION >
     GEO::AttributesManager& Region< DIMENSION >::cell_attribute_manager() const
     {
-        return volume_mesh_->cell_attribute_manager();
+        return mesh().cell_attribute_manager();
     }
 
     template < index_t DIMENSION >
     index_t Region< DIMENSION >::nb_mesh_elements() const
     {
-        return volume_mesh_->nb_cells();
+        return mesh().nb_cells();
     }
 
     template < index_t DIMENSION >
@@ -1197,7 +1281,7 @@ namespace RINGMesh
         if( is_meshed() )
         {
             ringmesh_assert( cell_index < nb_mesh_elements() );
-            return volume_mesh_->nb_cell_vertices( cell_index );
+            return mesh().nb_cell_vertices( cell_index );
         }
         ringmesh_assert_not_reached;
         return NO_ID;
@@ -1209,7 +1293,7 @@ namespace RINGMesh
         if( is_meshed() )
         {
             ringmesh_assert( cell_index < nb_mesh_elements() );
-            return volume_mesh_->cell_type( cell_index );
+            return mesh().cell_type( cell_index );
         }
         ringmesh_assert_not_reached;
         return CellType::UNDEFINED;
@@ -1221,7 +1305,7 @@ namespace RINGMesh
         if( is_meshed() )
         {
             ringmesh_assert( cell_index < nb_mesh_elements() );
-            return volume_mesh_->nb_cell_edges( cell_index );
+            return mesh().nb_cell_edges( cell_index );
         }
         ringmesh_assert_not_reached;
         return NO_ID;
@@ -1233,7 +1317,7 @@ namespace RINGMesh
         if( is_meshed() )
         {
             ringmesh_assert( cell_index < nb_mesh_elements() );
-            return volume_mesh_->nb_cell_facets( cell_index );
+            return mesh().nb_cell_facets( cell_index );
         }
         ringmesh_assert_not_reached;
         return NO_ID;
@@ -1247,7 +1331,7 @@ namespace RINGMesh
         {
             ringmesh_assert( cell_index < nb_mesh_elements() );
             ringmesh_assert( facet_index < nb_cell_facets( cell_index ) );
-            return volume_mesh_->nb_cell_facet_vertices(
+            return mesh().nb_cell_facet_vertices(
                 { cell_index, facet_index } );
         }
         ringmesh_assert_not_reached;
@@ -1264,7 +1348,7 @@ namespace RINGMesh
             ringmesh_assert( edge_index < nb_cell_edges( cell_index ) );
             ringmesh_assert(
                 vertex_index < nb_mesh_element_vertices( cell_index ) );
-            return volume_mesh_->cell_edge_vertex(
+            return mesh().cell_edge_vertex(
                 cell_index, edge_index, vertex_index );
         }
         ringmesh_assert_not_reached;
@@ -1281,7 +1365,7 @@ namespace RINGMesh
             ringmesh_assert( facet_index < nb_cell_facets( cell_index ) );
             ringmesh_assert(
                 vertex_index < nb_mesh_element_vertices( cell_index ) );
-            return volume_mesh_->cell_facet_vertex(
+            return mesh().cell_facet_vertex(
                 { cell_index, facet_index }, vertex_index );
         }
         ringmesh_assert_not_reached;
@@ -1296,7 +1380,7 @@ namespace RINGMesh
         {
             ringmesh_assert( cell_index < nb_mesh_elements() );
             ringmesh_assert( facet_index < nb_cell_facets( cell_index ) );
-            return volume_mesh_->cell_adjacent( { cell_index, facet_index } );
+            return mesh().cell_adjacent( { cell_index, facet_index } );
         }
         ringmesh_assert_not_reached;
         return NO_ID;
@@ -1308,7 +1392,7 @@ namespace RINGMesh
         if( is_meshed() )
         {
             ringmesh_assert( cell_index < nb_mesh_elements() );
-            return volume_mesh_->cell_volume( cell_index );
+            return mesh().cell_volume( cell_index );
         }
         ringmesh_assert_not_reached;
         return 0;
@@ -1349,7 +1433,7 @@ namespace RINGMesh
         if( is_meshed() )
         {
             ringmesh_assert( cell_index < nb_mesh_elements() );
-            return volume_mesh_->cell_barycenter( cell_index );
+            return mesh().cell_barycenter( cell_index );
         }
         ringmesh_assert_not_reached;
         return vecn< DIMENSION >();
@@ -1359,13 +1443,14 @@ namespace RINGMesh
     std::vector< index_t > Region< DIMENSION >::cells_around_vertex(
         index_t vertex_id, index_t cell_hint ) const
     {
-        return volume_mesh_->cells_around_vertex( vertex_id, cell_hint );
+        return mesh().cells_around_vertex( vertex_id, cell_hint );
     }
 
     template < index_t DIMENSION >
     MeshEntityType Region< DIMENSION >::type_name_static()
     {
-        return MeshEntityType( "Region" );
+        static const MeshEntityType type{ "Region" };
+        return type;
     }
 
     template < index_t DIMENSION >
@@ -1383,7 +1468,7 @@ namespace RINGMesh
         }
         bool valid{ true };
 
-        if( !volume_mesh_->is_mesh_valid() )
+        if( !mesh().is_mesh_valid() )
         {
             Logger::err( "GeoModelEntity", this->gmme(), " mesh is invalid" );
             valid = false;
@@ -1392,7 +1477,7 @@ namespace RINGMesh
         // No cell with negative volume
         // No cell incident to the same vertex check local and global indices
         index_t nb_degenerate{ 0 };
-        for( auto c : range( volume_mesh_->nb_cells() ) )
+        for( auto c : range( mesh().nb_cells() ) )
         {
             if( cell_is_degenerate( *this, c ) )
             {
@@ -1423,7 +1508,7 @@ namespace RINGMesh
         auto new_mesh = PointSetMesh< DIMENSION >::create_mesh( type );
         auto builder =
             PointSetMeshBuilder< DIMENSION >::create_builder( *new_mesh );
-        builder->copy( *point_set_mesh_, true );
+        builder->copy( mesh(), true );
         update_mesh_storage_type( std::move( new_mesh ) );
     }
 
@@ -1433,7 +1518,7 @@ namespace RINGMesh
         auto new_mesh = LineMesh< DIMENSION >::create_mesh( type );
         auto builder =
             LineMeshBuilder< DIMENSION >::create_builder( *new_mesh );
-        builder->copy( *line_mesh_, true );
+        builder->copy( mesh(), true );
         update_mesh_storage_type( std::move( new_mesh ) );
     }
 
@@ -1444,7 +1529,7 @@ namespace RINGMesh
         auto new_mesh = SurfaceMesh< DIMENSION >::create_mesh( type );
         auto builder =
             SurfaceMeshBuilder< DIMENSION >::create_builder( *new_mesh );
-        builder->copy( *surface_mesh_, true );
+        builder->copy( mesh(), true );
         update_mesh_storage_type( std::move( new_mesh ) );
     }
 
@@ -1454,7 +1539,7 @@ namespace RINGMesh
             const vecn< DIMENSION >& vertex_vec ) const
     {
         ElementLocalVertex cell_local_vertex;
-        volume_mesh_->find_cell_from_colocated_vertex_within_distance_if_any(
+        mesh().find_cell_from_colocated_vertex_within_distance_if_any(
             vertex_vec, this->geomodel_.epsilon(), cell_local_vertex.element_id,
             cell_local_vertex.local_vertex_id );
         return cell_local_vertex;
@@ -1466,7 +1551,7 @@ namespace RINGMesh
         auto new_mesh = VolumeMesh< DIMENSION >::create_mesh( type );
         auto builder =
             VolumeMeshBuilder< DIMENSION >::create_builder( *new_mesh );
-        builder->copy( *volume_mesh_, true );
+        builder->copy( mesh(), true );
         update_mesh_storage_type( std::move( new_mesh ) );
     }
 
@@ -35,9 +35,11 @@
 
 #include <ringmesh/geomodel/core/well.h>
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <stack>
+#include <unordered_set>
 
 #include <geogram/mesh/mesh.h>
 #include <geogram/mesh/mesh_geometry.h>
@@ -45,10 +47,12 @@
 #include <ringmesh/basic/algorithm.h>
 #include <ringmesh/basic/box.h>
 #include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 
 #include <ringmesh/mesh/line_mesh.h>
+#include <ringmesh/mesh/mesh_aabb.h>
 #include <ringmesh/mesh/mesh_builder.h>
 #include <ringmesh/mesh/mesh_index.h>
 #include <ringmesh/mesh/point_set_mesh.h>
@@ -63,35 +67,6 @@ namespace
 {
     using namespace RINGMesh;
 
-    /*!
-     * @brief Returns the index of the region of the geomodel neighboring the
-     * surface.
-     * @param[in] geomodel to consider
-     * @param[in] surface_part_id Index of the Surface
-     * @param[in] side Side of the Surface
-     * @return The region index or NO_ID if none found.
-     */
-    index_t find_region(
-        const GeoModel3D& geomodel, index_t surface_part_id, bool side )
-    {
-        ringmesh_assert( surface_part_id < geomodel.nb_surfaces() );
-        gmme_id cur_surface( Surface3D::type_name_static(), surface_part_id );
-        const Surface3D& surface = geomodel.surface( surface_part_id );
-        for( auto r : range( surface.nb_incident_entities() ) )
-        {
-            const Region3D& cur_region = surface.incident_entity( r );
-            for( auto s : range( cur_region.nb_boundaries() ) )
-            {
-                if( cur_region.side( s ) == side
-                    && cur_region.boundary_gmme( s ) == cur_surface )
-                {
-                    return r;
-                }
-            }
-        }
-        return NO_ID;
-    }
-
     struct LineInstersection
     {
         explicit LineInstersection( const vec3& intersection,
@@ -152,39 +127,27 @@ namespace
     {
         if( start.surface_id_ != NO_ID )
         {
-            bool sign = get_side( vertices[1], start.intersection_,
-                geomodel.surface( start.surface_id_ ), start.trgl_id_ );
-            return find_region( geomodel, start.surface_id_, sign );
+            const auto& surface = geomodel.surface( start.surface_id_ );
+            bool sign = get_side(
+                vertices[1], start.intersection_, surface, start.trgl_id_ );
+            return surface.region_on_side( sign );
         }
         if( end.surface_id_ != NO_ID )
         {
-            bool sign =
-                get_side( vertices[vertices.size() - 2], end.intersection_,
-                    geomodel.surface( end.surface_id_ ), end.trgl_id_ );
-            return find_region( geomodel, end.surface_id_, sign );
-        }
-        double best_distance = max_float64();
-        index_t best_surface = NO_ID;
-        vec3 best_nearest;
-        index_t best_triangle = NO_ID;
-        for( const auto& surface : geomodel.surfaces() )
-        {
-            index_t triangle = NO_ID;
-            vec3 nearest;
-            double distance = max_float64();
-            std::tie( triangle, nearest, distance ) =
-                surface.polygon_aabb().closest_triangle( start.intersection_ );
-            if( distance < best_distance )
-            {
-                best_distance = distance;
-                best_nearest = nearest;
-                best_surface = surface.index();
-                best_triangle = triangle;
-            }
+            const auto& surface = geomodel.surface( end.surface_id_ );
+            bool sign = get_side( vertices[vertices.size() - 2],
+                end.intersection_, surface, end.trgl_id_ );
+            return surface.region_on_side( sign );
         }
-        bool sign = get_side( start.intersection_, best_nearest,
-            geomodel.surface( best_surface ), best_triangle );
-        return find_region( geomodel, best_surface, sign );
+        const auto& polygons = geomodel.mesh.polygons;
+        index_t polygon = NO_ID;
+        vec3 nearest;
+        std::tie( polygon, nearest, std::ignore ) =
+            polygons.aabb().closest_triangle( start.intersection_ );
+        const auto& surface = geomodel.surface( polygons.surface( polygon ) );
+        bool sign = get_side( start.intersection_, nearest, surface,
+            polygons.index_in_surface( polygon ) );
+        return surface.region_on_side( sign );
     }
 
     template < index_t DIMENSION >
@@ -217,38 +180,73 @@ namespace
     class EdgeConformerAction
     {
     public:
-        EdgeConformerAction( const Surface3D& surface,
+        EdgeConformerAction( const GeoModel3D& geomodel,
             const vec3& v_from,
             const vec3& v_to,
             std::vector< LineInstersection >& intersections )
-            : surface_( surface ),
+            : geomodel_( geomodel ),
               segment_( v_from, v_to ),
               intersections_( intersections )
         {
         }
 
-        void operator()( index_t trgl )
+        void operator()( index_t polygon )
         {
+            const auto& polygons = geomodel_.mesh.polygons;
+            const auto& surface =
+                geomodel_.surface( polygons.surface( polygon ) );
+            auto trgl = polygons.index_in_surface( polygon );
             bool does_seg_intersect_triangle = false;
             vec3 result;
             std::tie( does_seg_intersect_triangle, result ) =
                 Intersection::segment_triangle( segment_,
-                    { surface_.mesh_element_vertex( { trgl, 0 } ),
-                        surface_.mesh_element_vertex( { trgl, 1 } ),
-                        surface_.mesh_element_vertex( { trgl, 2 } ) } );
+                    { surface.mesh_element_vertex( { trgl, 0 } ),
+                        surface.mesh_element_vertex( { trgl, 1 } ),
+                        surface.mesh_element_vertex( { trgl, 2 } ) } );
             if( does_seg_intersect_triangle )
             {
-                intersections_.emplace_back( result, surface_.index(), trgl );
+                intersections_.emplace_back( result, surface.index(), trgl );
             }
         }
 
     private:
-        const Surface3D& surface_;
+        const GeoModel3D& geomodel_;
         Geometry::Segment3D segment_;
 
         std::vector< LineInstersection >& intersections_;
     };
 
+    /*!
+     * @brief Computes the intersections between an edge and the geomodel
+     * surfaces, sorted by distance to \p from
+     * @details The segment traverses the single AABB tree built on all the
+     * GeoModelMesh polygons, only visiting the nodes it crosses.
+     */
+    std::vector< LineInstersection > compute_edge_intersections(
+        const GeoModel3D& geomodel, const vec3& from, const vec3& to )
+    {
+        std::vector< LineInstersection > intersections;
+        EdgeConformerAction action( geomodel, from, to, intersections );
+        geomodel.mesh.polygons.aabb()
+            .compute_segment_element_bbox_intersections( from, to, action );
+
+        std::vector< std::pair< double, index_t > > distances;
+        distances.reserve( intersections.size() );
+        for( auto i : range( intersections.size() ) )
+        {
+            distances.emplace_back(
+                length( from - intersections[i].intersection_ ), i );
+        }
+        std::sort( distances.begin(), distances.end() );
+        std::vector< LineInstersection > sorted_intersections;
+        sorted_intersections.reserve( intersections.size() );
+        for( const auto& distance : distances )
+        {
+            sorted_intersections.push_back( intersections[distance.second] );
+        }
+        return sorted_intersections;
+    }
+
     struct OrientedEdge
     {
         OrientedEdge(
@@ -306,6 +304,277 @@ namespace
         }
         ringmesh_assert( count == 1 );
     }
+
+    std::vector< LineInstersection > compute_mesh_edge_intersections(
+        const GeoModel3D& geomodel, const LineMesh3D& mesh, index_t edge )
+    {
+        const auto& from_vertex =
+            mesh.vertex( mesh.edge_vertex( ElementLocalVertex( edge, 0 ) ) );
+        const auto& to_vertex =
+            mesh.vertex( mesh.edge_vertex( ElementLocalVertex( edge, 1 ) ) );
+        return compute_edge_intersections( geomodel, from_vertex, to_vertex );
+    }
+
+    /*!
+     * @brief Builds the well mesh split at its intersections with the
+     * geomodel surfaces
+     * @param[in] in the input well mesh
+     * @param[in] edge_intersections the sorted intersections of each edge
+     * @param[in] epsilon the geomodel tolerance
+     * @param[out] out the conformal mesh, with a LineInstersection
+     * attribute named "info" on its vertices
+     */
+    void build_conformal_mesh( const LineMesh3D& in,
+        const std::vector< std::vector< LineInstersection > >&
+            edge_intersections,
+        double epsilon,
+        LineMesh3D& out )
+    {
+        std::unique_ptr< LineMeshBuilder3D > builder =
+            LineMeshBuilder3D::create_builder( out );
+        builder->clear( false, false );
+
+        GEO::Attribute< LineInstersection > vertex_info(
+            out.vertex_attribute_manager(), "info" );
+        builder->create_vertices( in.nb_vertices() );
+        for( auto v : range( in.nb_vertices() ) )
+        {
+            const vec3& vertex = in.vertex( v );
+            builder->set_vertex( v, vertex );
+            vertex_info[v] = LineInstersection( vertex );
+        }
+
+        for( auto e : range( in.nb_edges() ) )
+        {
+            index_t from_id = in.edge_vertex( ElementLocalVertex( e, 0 ) );
+            const vec3& from_vertex = in.vertex( from_id );
+            index_t to_id = in.edge_vertex( ElementLocalVertex( e, 1 ) );
+            const vec3& to_vertex = in.vertex( to_id );
+
+            double edge_length = length( from_vertex - to_vertex );
+            index_t last_vertex = from_id;
+            for( const auto& intersection : edge_intersections[e] )
+            {
+                double distance =
+                    length( from_vertex - intersection.intersection_ );
+                if( distance < epsilon )
+                {
+                    vertex_info[from_id] = intersection;
+                }
+                else if( std::fabs( distance - edge_length ) < epsilon )
+                {
+                    vertex_info[to_id] = intersection;
+                }
+                else
+                {
+                    index_t vertex_id =
+                        builder->create_vertex( intersection.intersection_ );
+                    vertex_info[vertex_id] = intersection;
+                    builder->create_edge( last_vertex, vertex_id );
+                    last_vertex = vertex_id;
+                }
+            }
+            builder->create_edge( last_vertex, to_id );
+        }
+    }
+
+    /*!
+     * @brief Creates the parts and corners of a well from its conformal mesh
+     */
+    void create_well_parts( const GeoModel3D& geomodel,
+        const LineMesh3D& conformal_mesh,
+        Well3D& well )
+    {
+        auto edges_around_vertices =
+            get_edges_around_vertices( conformal_mesh );
+
+        std::stack< OrientedEdge > S;
+        for( auto v : range( conformal_mesh.nb_vertices() ) )
+        {
+            const auto& edges = edges_around_vertices[v];
+            if( edges.size() == 1 )
+            {
+                S.emplace( conformal_mesh, edges.front(), v );
+            }
+        }
+        if( S.empty() )
+        {
+            throw RINGMeshException( "Well",
+                "A well should have at least one starting or ending point" );
+        }
+
+        GEO::Attribute< LineInstersection > vertex_info(
+            conformal_mesh.vertex_attribute_manager(), "info" );
+        std::vector< bool > edge_visited( conformal_mesh.nb_edges(), false );
+        do
+        {
+            OrientedEdge cur_edge = S.top();
+            S.pop();
+            if( edge_visited[cur_edge.edge_] )
+            {
+                continue;
+            }
+            edge_visited[cur_edge.edge_] = true;
+
+            std::vector< vec3 > well_part_points;
+            std::stack< OrientedEdge > S_part;
+            S_part.push( cur_edge );
+            do
+            {
+                OrientedEdge cur_edge_part = S_part.top();
+                S_part.pop();
+                edge_visited[cur_edge_part.edge_] = true;
+                const vec3& v_from =
+                    conformal_mesh.vertex( cur_edge_part.vertex_from_ );
+                index_t v_to_id = conformal_mesh.edge_vertex(
+                    ElementLocalVertex( cur_edge_part.edge_,
+                        ( cur_edge_part.edge_vertex_ + 1 ) % 2 ) );
+                const vec3& v_to = conformal_mesh.vertex( v_to_id );
+                well_part_points.push_back( v_from );
+
+                const auto& edges = edges_around_vertices[v_to_id];
+                if( edges.size() == 2 )
+                {
+                    process_linear_edges(
+                        edges, edge_visited, conformal_mesh, S_part, v_to_id );
+                }
+                else
+                {
+                    well_part_points.push_back( v_to );
+                    create_well_part_and_corners( geomodel, well,
+                        well_part_points, vertex_info[cur_edge.vertex_from_],
+                        vertex_info[v_to_id] );
+                    for( auto edge : edges )
+                    {
+                        S.emplace( conformal_mesh, edge, v_to_id );
+                    }
+                }
+            } while( !S_part.empty() );
+        } while( !S.empty() );
+    }
+
+    /*!
+     * @brief Locates successive points in the GeoModelMesh tetrahedra
+     * @details Each point is searched by walking through the cell
+     * adjacencies from the cell containing the previous point. The cell
+     * AABB tree is only used when the walk fails.
+     */
+    class ContainingCellWalker
+    {
+    public:
+        explicit ContainingCellWalker( const GeoModel3D& geomodel )
+            : vertices_( geomodel.mesh.vertices ), cells_( geomodel.mesh.cells )
+        {
+        }
+
+        index_t containing_cell( const vec3& point )
+        {
+            auto cell = walk( point );
+            if( cell == NO_ID )
+            {
+                cell = cells_.aabb().containing_cell( point );
+            }
+            if( cell != NO_ID )
+            {
+                last_cell_ = cell;
+            }
+            return cell;
+        }
+
+    private:
+        index_t walk( const vec3& point ) const
+        {
+            auto cell = last_cell_;
+            for( auto step : range( MAX_WALK_STEPS ) )
+            {
+                ringmesh_unused( step );
+                if( cell == NO_ID
+                    || cells_.type( cell ) != CellType::TETRAHEDRON )
+                {
+                    return NO_ID;
+                }
+                auto facet = exit_facet( cell, point );
+                if( facet == NO_ID )
+                {
+                    return is_point_in_tetra( cell, point ) ? cell : NO_ID;
+                }
+                cell = cells_.adjacent( cell, facet );
+            }
+            return NO_ID;
+        }
+
+        /*!
+         * @brief Gets the facet the point is the farthest beyond, NO_ID if
+         * the point is on the inner side of all the facets
+         */
+        index_t exit_facet( index_t cell, const vec3& point ) const
+        {
+            vec3 barycenter;
+            for( auto v : range( 4 ) )
+            {
+                barycenter += cell_vertex( cell, v );
+            }
+            barycenter /= 4.;
+
+            index_t result{ NO_ID };
+            double max_distance{ 0. };
+            for( auto f : range( 4 ) )
+            {
+                const auto& p0 = facet_vertex( cell, f, 0 );
+                auto normal = cross( facet_vertex( cell, f, 1 ) - p0,
+                    facet_vertex( cell, f, 2 ) - p0 );
+                auto normal_length = length( normal );
+                if( normal_length == 0. )
+                {
+                    continue;
+                }
+                if( dot( normal, barycenter - p0 ) > 0 )
+                {
+                    normal = -normal;
+                }
+                auto distance = dot( normal, point - p0 ) / normal_length;
+                if( distance > max_distance )
+                {
+                    max_distance = distance;
+                    result = f;
+                }
+            }
+            return result;
+        }
+
+        bool is_point_in_tetra( index_t cell, const vec3& point ) const
+        {
+            return Position::point_inside_tetra( point,
+                { cell_vertex( cell, 0 ), cell_vertex( cell, 1 ),
+                    cell_vertex( cell, 2 ), cell_vertex( cell, 3 ) } );
+        }
+
+        const vec3& cell_vertex( index_t cell, index_t v ) const
+        {
+            return vertex( cells_.vertex( { cell, v } ) );
+        }
+
+        const vec3& facet_vertex( index_t cell, index_t f, index_t v ) const
+        {
+            return vertex( cells_.facet_vertex( { cell, f }, v ) );
+        }
+
+        const vec3& vertex( index_t v ) const
+        {
+            if( v >= vertices_.nb() )
+            {
+                v = cells_.duplicated_vertex( v - vertices_.nb() );
+            }
+            return vertices_.vertex( v );
+        }
+
+    private:
+        static const index_t MAX_WALK_STEPS = 1000;
+
+        const GeoModelMeshVertices3D& vertices_;
+        const GeoModelMeshCells3D& cells_;
+        index_t last_cell_{ NO_ID };
+    };
 } // namespace
 
 namespace RINGMesh
@@ -587,73 +856,17 @@ namespace RINGMesh
     void WellGroup< 3 >::compute_conformal_mesh(
         const LineMesh3D& in, LineMesh3D& out )
     {
-        double epsilon = geomodel_->epsilon();
-        std::unique_ptr< LineMeshBuilder3D > builder =
-            LineMeshBuilder3D::create_builder( out );
-        builder->clear( false, false );
-
-        GEO::Attribute< LineInstersection > vertex_info(
-            out.vertex_attribute_manager(), "info" );
-        builder->create_vertices( in.nb_vertices() );
-        for( auto v : range( in.nb_vertices() ) )
-        {
-            const vec3& vertex = in.vertex( v );
-            builder->set_vertex( v, vertex );
-            vertex_info[v] = LineInstersection( vertex );
-        }
-
-        for( auto e : range( in.nb_edges() ) )
-        {
-            index_t from_id = in.edge_vertex( ElementLocalVertex( e, 0 ) );
-            const vec3& from_vertex = in.vertex( from_id );
-            index_t to_id = in.edge_vertex( ElementLocalVertex( e, 1 ) );
-            const vec3& to_vertex = in.vertex( to_id );
-
-            Box3D box;
-            box.add_point( from_vertex );
-            box.add_point( to_vertex );
-            std::vector< LineInstersection > intersections;
-            for( const auto& surface : geomodel_->surfaces() )
-            {
-                EdgeConformerAction action(
-                    surface, from_vertex, to_vertex, intersections );
-                surface.polygon_aabb().compute_bbox_element_bbox_intersections(
-                    box, action );
-            }
-
-            std::vector< index_t > indices( intersections.size() );
-            std::iota( indices.begin(), indices.end(), 0 );
-            std::vector< double > distances( intersections.size() );
-            for( auto i : range( intersections.size() ) )
-            {
-                distances[i] =
-                    length( from_vertex - intersections[i].intersection_ );
-            }
-            indirect_sort( distances, indices );
-            double edge_length = length( from_vertex - to_vertex );
-            index_t last_vertex = from_id;
-            for( auto i : range( intersections.size() ) )
-            {
-                if( distances[indices[i]] < epsilon )
-                {
-                    vertex_info[from_id] = intersections[i];
-                }
-                else if( std::fabs( distances[indices[i]] - edge_length )
-                         < epsilon )
-                {
-                    vertex_info[to_id] = intersections[i];
-                }
-                else
-                {
-                    index_t vertex_id = builder->create_vertex(
-                        intersections[i].intersection_ );
-                    vertex_info[vertex_id] = intersections[i];
-                    builder->create_edge( last_vertex, vertex_id );
-                    last_vertex = vertex_id;
-                }
-            }
-            builder->create_edge( last_vertex, to_id );
-        }
+        // Lazy initializations of the GeoModel are not thread safe
+        auto epsilon = geomodel_->epsilon();
+        geomodel_->mesh.polygons.aabb();
+        std::vector< std::vector< LineInstersection > > edge_intersections(
+            in.nb_edges() );
+        parallel_for(
+            in.nb_edges(), [&in, &edge_intersections, this]( index_t e ) {
+                edge_intersections[e] =
+                    compute_mesh_edge_intersections( *geomodel_, in, e );
+            } );
+        build_conformal_mesh( in, edge_intersections, epsilon, out );
     }
 
     template <>
@@ -681,73 +894,81 @@ namespace RINGMesh
 
         auto conformal_mesh = LineMesh3D::create_mesh();
         compute_conformal_mesh( mesh, *conformal_mesh );
+        create_well_parts( *geomodel(), *conformal_mesh, new_well );
+    }
 
-        auto edges_around_vertices =
-            get_edges_around_vertices( *conformal_mesh );
+    template <>
+    void geomodel_core_api WellGroup< 2 >::add_wells(
+        const std::vector< std::vector< vec2 > >& trajectories,
+        const std::vector< std::string >& names )
+    {
+        ringmesh_unused( trajectories );
+        ringmesh_unused( names );
+        throw RINGMeshException(
+            "Wells", "2D Wells not fully implemented yet" );
+    }
 
-        std::stack< OrientedEdge > S;
-        for( auto v : range( conformal_mesh->nb_vertices() ) )
-        {
-            const auto& edges = edges_around_vertices[v];
-            if( edges.size() == 1 )
-            {
-                S.emplace( *conformal_mesh, edges.front(), v );
-            }
-        }
-        if( S.empty() )
+    template <>
+    void geomodel_core_api WellGroup< 3 >::add_wells(
+        const std::vector< std::vector< vec3 > >& trajectories,
+        const std::vector< std::string >& names )
+    {
+        ringmesh_assert( geomodel() );
+        ringmesh_assert( trajectories.size() == names.size() );
+        std::unordered_set< std::string > used_names;
+        for( const auto& well : wells_ )
         {
-            throw RINGMeshException( "Well",
-                "A well should have at least one starting or ending point" );
+            used_names.insert( well->name() );
         }
-
-        GEO::Attribute< LineInstersection > vertex_info(
-            conformal_mesh->vertex_attribute_manager(), "info" );
-        std::vector< bool > edge_visited( conformal_mesh->nb_edges(), false );
-        do
+        std::vector< index_t > new_wells;
+        for( auto w : range( names.size() ) )
         {
-            OrientedEdge cur_edge = S.top();
-            S.pop();
-            if( edge_visited[cur_edge.edge_] )
+            if( used_names.insert( names[w] ).second )
             {
-                continue;
+                new_wells.push_back( w );
             }
-            edge_visited[cur_edge.edge_] = true;
-
-            std::vector< vec3 > well_part_points;
-            std::stack< OrientedEdge > S_part;
-            S_part.push( cur_edge );
-            do
-            {
-                OrientedEdge cur_edge_part = S_part.top();
-                S_part.pop();
-                edge_visited[cur_edge_part.edge_] = true;
-                const vec3& v_from =
-                    conformal_mesh->vertex( cur_edge_part.vertex_from_ );
-                index_t v_to_id = conformal_mesh->edge_vertex(
-                    ElementLocalVertex( cur_edge_part.edge_,
-                        ( cur_edge_part.edge_vertex_ + 1 ) % 2 ) );
-                const vec3& v_to = conformal_mesh->vertex( v_to_id );
-                well_part_points.push_back( v_from );
+        }
 
-                const auto& edges = edges_around_vertices[v_to_id];
-                if( edges.size() == 2 )
+        // Lazy initializations of the GeoModel are not thread safe
+        auto epsilon = geomodel_->epsilon();
+        geomodel_->mesh.polygons.aabb();
+        std::vector< std::unique_ptr< Well3D > > wells( new_wells.size() );
+        parallel_for( static_cast< index_t >( new_wells.size() ),
+            [&trajectories, &names, &new_wells, &wells, epsilon, this](
+                index_t w ) {
+                const auto& trajectory = trajectories[new_wells[w]];
+                auto mesh = LineMesh3D::create_mesh();
                 {
-                    process_linear_edges(
-                        edges, edge_visited, *conformal_mesh, S_part, v_to_id );
-                }
-                else
-                {
-                    well_part_points.push_back( v_to );
-                    create_well_part_and_corners( *geomodel(), new_well,
-                        well_part_points, vertex_info[cur_edge.vertex_from_],
-                        vertex_info[v_to_id] );
-                    for( auto edge : edges )
+                    auto builder = LineMeshBuilder3D::create_builder( *mesh );
+                    for( const auto& vertex : trajectory )
                     {
-                        S.emplace( *conformal_mesh, edge, v_to_id );
+                        auto id = builder->create_vertex( vertex );
+                        if( id > 0 )
+                        {
+                            builder->create_edge( id - 1, id );
+                        }
                     }
                 }
-            } while( !S_part.empty() );
-        } while( !S.empty() );
+                std::vector< std::vector< LineInstersection > >
+                    edge_intersections( mesh->nb_edges() );
+                for( auto e : range( mesh->nb_edges() ) )
+                {
+                    edge_intersections[e] =
+                        compute_mesh_edge_intersections( *geomodel_, *mesh, e );
+                }
+                auto conformal_mesh = LineMesh3D::create_mesh();
+                build_conformal_mesh(
+                    *mesh, edge_intersections, epsilon, *conformal_mesh );
+                mesh.reset();
+
+                wells[w].reset( new Well3D );
+                wells[w]->set_name( names[new_wells[w]] );
+                create_well_parts( *geomodel_, *conformal_mesh, *wells[w] );
+            } );
+        for( auto& well : wells )
+        {
+            wells_.push_back( well.release() );
+        }
     }
 
     template < index_t DIMENSION >
@@ -762,6 +983,44 @@ namespace RINGMesh
         }
         return NO_ID;
     }
+
+    std::vector< std::vector< WellVertexLocation > > locate_well_trajectories(
+        const GeoModel3D& geomodel,
+        const std::vector< std::vector< vec3 > >& trajectories )
+    {
+        std::vector< std::vector< WellVertexLocation > > locations(
+            trajectories.size() );
+        const auto& cells = geomodel.mesh.cells;
+        if( cells.nb() == 0 )
+        {
+            for( auto w : range( trajectories.size() ) )
+            {
+                locations[w].resize( trajectories[w].size() );
+            }
+            return locations;
+        }
+
+        // Lazy initializations of the GeoModelMesh are not thread safe
+        cells.aabb();
+        parallel_for( static_cast< index_t >( trajectories.size() ),
+            [&geomodel, &cells, &trajectories, &locations]( index_t w ) {
+                ContainingCellWalker walker( geomodel );
+                auto& well_locations = locations[w];
+                well_locations.reserve( trajectories[w].size() );
+                for( const auto& point : trajectories[w] )
+                {
+                    WellVertexLocation location;
+                    location.cell = walker.containing_cell( point );
+                    if( location.cell != NO_ID )
+                    {
+                        location.region = cells.region( location.cell );
+                    }
+                    well_locations.push_back( location );
+                }
+            } );
+        return locations;
+    }
+
     template class geomodel_core_api WellEntity< 2 >;
     template class geomodel_core_api WellCorner< 2 >;
     template class geomodel_core_api WellPart< 2 >;
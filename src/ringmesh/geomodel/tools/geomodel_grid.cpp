@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/geomodel/tools/geomodel_grid.h>
+
+#include <algorithm>
+
+#include <geogram/basic/attributes.h>
+
+#include <ringmesh/basic/box.h>
+#include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/task_handler.h>
+
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+#include <ringmesh/mesh/cartesian_grid.h>
+#include <ringmesh/mesh/mesh_aabb.h>
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * @file Rasterization of GeoModel regions on Cartesian grids
+ */
+
+namespace
+{
+    using namespace RINGMesh;
+
+    struct GridLineCrossing
+    {
+        GridLineCrossing( double t, index_t before, index_t after )
+            : t( t ), region_before( before ), region_after( after )
+        {
+        }
+
+        bool operator<( const GridLineCrossing& rhs ) const
+        {
+            return t < rhs.t;
+        }
+
+        /// Position along the grid line, from 0 at its start to 1 at its end
+        double t;
+        index_t region_before;
+        index_t region_after;
+    };
+
+    /*!
+     * @brief Computes the crossings between a grid line and the polygons
+     * of the GeoModelMesh
+     */
+    class GridLineCrossingAction
+    {
+    public:
+        GridLineCrossingAction( const GeoModel3D& geomodel,
+            const vec3& start,
+            const vec3& end,
+            std::vector< GridLineCrossing >& crossings )
+            : geomodel_( geomodel ),
+              segment_( start, end ),
+              direction_( end - start ),
+              crossings_( crossings )
+        {
+        }
+
+        void operator()( index_t polygon )
+        {
+            const auto& polygons = geomodel_.mesh.polygons;
+            const auto& p0 = vertex( polygon, 0 );
+            for( auto v : range( 1, polygons.nb_vertices( polygon ) - 1 ) )
+            {
+                const auto& p1 = vertex( polygon, v );
+                const auto& p2 = vertex( polygon, v + 1 );
+                bool does_intersect{ false };
+                vec3 intersection;
+                std::tie( does_intersect, intersection ) =
+                    Intersection::segment_triangle( segment_, { p0, p1, p2 } );
+                if( !does_intersect )
+                {
+                    continue;
+                }
+                const auto& surface =
+                    geomodel_.surface( polygons.surface( polygon ) );
+                auto side = dot( direction_, cross( p1 - p0, p2 - p0 ) ) > 0;
+                auto t = dot( intersection - segment_.p0, direction_ )
+                         / direction_.length2();
+                crossings_.emplace_back( t, surface.region_on_side( !side ),
+                    surface.region_on_side( side ) );
+                return;
+            }
+        }
+
+    private:
+        const vec3& vertex( index_t polygon, index_t v ) const
+        {
+            return geomodel_.mesh.vertices.vertex(
+                geomodel_.mesh.polygons.vertex( { polygon, v } ) );
+        }
+
+    private:
+        const GeoModel3D& geomodel_;
+        Geometry::Segment3D segment_;
+        vec3 direction_;
+        std::vector< GridLineCrossing >& crossings_;
+    };
+
+    class RegionRasterizer
+    {
+    public:
+        RegionRasterizer( const GeoModel3D& geomodel,
+            const CartesianGrid3D& grid,
+            GEO::Attribute< index_t >& regions )
+            : geomodel_( geomodel ), grid_( grid ), regions_( regions )
+        {
+        }
+
+        /*!
+         * @brief Computes the regions of the grid cells (*, \p j, \p k)
+         */
+        void rasterize_line( index_t j, index_t k ) const
+        {
+            const auto& frame = grid_.grid_vectors();
+            auto nb_cells = grid_.nb_cells_axis( 0 );
+            auto start = frame.origin() + frame[1] * ( j + 0.5 )
+                         + frame[2] * ( k + 0.5 );
+            auto end = start + frame[0] * nb_cells;
+
+            std::vector< GridLineCrossing > crossings;
+            GridLineCrossingAction action( geomodel_, start, end, crossings );
+            geomodel_.mesh.polygons.aabb()
+                .compute_segment_element_bbox_intersections(
+                    start, end, action );
+            std::sort( crossings.begin(), crossings.end() );
+
+            auto region = crossings.empty()
+                              ? locate_region( start + frame[0] * 0.5 )
+                              : crossings.front().region_before;
+            auto offset = grid_.cell_offset(
+                { 0, static_cast< signed_index_t >( j ),
+                    static_cast< signed_index_t >( k ) } );
+            index_t cur_crossing{ 0 };
+            for( auto i : range( nb_cells ) )
+            {
+                auto t = ( i + 0.5 ) / nb_cells;
+                while( cur_crossing < crossings.size()
+                       && crossings[cur_crossing].t <= t )
+                {
+                    region = crossings[cur_crossing].region_after;
+                    cur_crossing++;
+                }
+                regions_[offset + i] = region;
+            }
+        }
+
+    private:
+        /*!
+         * @brief Gets the region containing a point from the side of the
+         * nearest polygon
+         */
+        index_t locate_region( const vec3& point ) const
+        {
+            const auto& polygons = geomodel_.mesh.polygons;
+            index_t polygon{ NO_ID };
+            vec3 nearest;
+            std::tie( polygon, nearest, std::ignore ) =
+                polygons.aabb().closest_triangle( point );
+            const auto& p0 = geomodel_.mesh.vertices.vertex(
+                polygons.vertex( { polygon, 0 } ) );
+            const auto& p1 = geomodel_.mesh.vertices.vertex(
+                polygons.vertex( { polygon, 1 } ) );
+            const auto& p2 = geomodel_.mesh.vertices.vertex(
+                polygons.vertex( { polygon, 2 } ) );
+            auto side = dot( point - nearest, cross( p1 - p0, p2 - p0 ) ) > 0;
+            return geomodel_.surface( polygons.surface( polygon ) )
+                .region_on_side( side );
+        }
+
+    private:
+        const GeoModel3D& geomodel_;
+        const CartesianGrid3D& grid_;
+        GEO::Attribute< index_t >& regions_;
+    };
+} // namespace
+
+namespace RINGMesh
+{
+    void rasterize_regions( const GeoModel3D& geomodel,
+        CartesianGrid3D& grid,
+        bool compute_cells )
+    {
+        grid.add_attribute< index_t >( "region", NO_ID );
+        GEO::Attribute< index_t > regions(
+            grid.attributes_manager(), "region" );
+
+        // Lazy initializations of the GeoModelMesh are not thread safe
+        geomodel.mesh.polygons.aabb();
+        RegionRasterizer rasterizer( geomodel, grid, regions );
+        parallel_for(
+            grid.nb_cells_axis( 2 ), [&grid, &rasterizer]( index_t k ) {
+                for( auto j : range( grid.nb_cells_axis( 1 ) ) )
+                {
+                    rasterizer.rasterize_line( j, k );
+                }
+            } );
+
+        if( !compute_cells )
+        {
+            return;
+        }
+        grid.add_attribute< index_t >( "cell", NO_ID );
+        if( geomodel.mesh.cells.nb() == 0 )
+        {
+            return;
+        }
+        GEO::Attribute< index_t > cells( grid.attributes_manager(), "cell" );
+        const auto& cell_aabb = geomodel.mesh.cells.aabb();
+        parallel_for( grid.nb_cells(),
+            [&grid, &regions, &cells, &cell_aabb]( index_t c ) {
+                if( regions[c] == NO_ID )
+                {
+                    return;
+                }
+                auto center = grid.cell_corner_global_coords(
+                    grid.local_from_offset( c ) );
+                for( auto i : range( 3 ) )
+                {
+                    center += grid.grid_vectors()[i] * 0.5;
+                }
+                cells[c] = cell_aabb.containing_cell( center );
+            } );
+    }
+} // namespace RINGMesh
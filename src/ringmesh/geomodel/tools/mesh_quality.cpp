@@ -34,8 +34,15 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 
 #include <geogram/basic/attributes.h>
+
+#include <ringmesh/basic/task_handler.h>
+
+#include <ringmesh/geogram_extension/geogram_extension.h>
+
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
 #include <ringmesh/geomodel/tools/mesh_quality.h>
@@ -44,6 +51,8 @@
 #include <ringmesh/mesh/mesh_index.h>
 
 #include <ringmesh/mesh/volume_mesh.h>
+
+#include <ringmesh/tetrahedralize/tetra_improvement.h>
 /*!
  * @author Benjamin Chauvin
  * This code is inspired from
@@ -55,29 +64,250 @@ namespace
     using namespace RINGMesh;
 
     /*!
-     * @brief Computes the radius of the tetrahedron insphere.
-     *
-     * The tetrahedron insphere is the sphere inside the tetrahedron which
-     * is tangent to each tetrahedron facet.
+     * @param[in] mesh_qual_mode mesh quality number.
+     * @return the property name associated to the mesh quality number
+     * \p mesh_qual_mode.
+     */
+    std::string mesh_qual_mode_to_prop_name( MeshQualityMode mesh_qual_mode )
+    {
+        std::string quality_name;
+        switch( mesh_qual_mode )
+        {
+        case INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS:
+            quality_name = "INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS";
+            break;
+        case INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH:
+            quality_name = "INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH";
+            break;
+        case VOLUME_BY_SUM_SQUARE_EDGE:
+            quality_name = "VOLUME_BY_SUM_SQUARE_EDGE";
+            break;
+        case MIN_SOLID_ANGLE:
+            quality_name = "MIN_SOLID_ANGLE";
+            break;
+        default:
+            ringmesh_assert_not_reached;
+        }
+        ringmesh_assert( !quality_name.empty() );
+        return quality_name;
+    }
+
+    /// Number of tetrahedra processed at once by the quality kernels
+    static const index_t TET_BLOCK_SIZE = 8;
+
+    /// Number of tetrahedron blocks processed by one parallel task
+    static const index_t NB_BLOCKS_PER_TASK = 512;
+
+    /// Tetrahedron edges as pairs of local vertices (01, 02, 03, 12, 13, 23)
+    static const index_t tet_edges[6][2] = { { 0, 1 }, { 0, 2 }, { 0, 3 },
+        { 1, 2 }, { 1, 3 }, { 2, 3 } };
+
+    /*!
+     * @brief Block of tetrahedra stored as a structure of arrays.
      *
-     * @param[in] v0 first vertex of the tetrahedron.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     * @return the radius of the tetrahedron insphere.
+     * Each coordinate of each tetrahedron vertex is stored in a contiguous
+     * array of TET_BLOCK_SIZE lanes so that the quality kernels, which loop
+     * over the lanes, are vectorized by the compiler.
      */
-    double tetra_insphere_radius(
-        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
+    struct TetBlock
+    {
+        double x[4][TET_BLOCK_SIZE];
+        double y[4][TET_BLOCK_SIZE];
+        double z[4][TET_BLOCK_SIZE];
+    };
+
+    /*!
+     * @brief Fills a TetBlock with the tetrahedra [\p first_cell,
+     * \p first_cell + \p nb_cells) of a Region.
+     * The unused lanes are padded with the first tetrahedron of the block.
+     */
+    void fill_tet_block( const Region3D& region,
+        index_t first_cell,
+        index_t nb_cells,
+        TetBlock& block )
     {
-        double tet_volume = GEO::Geom::tetra_volume( v0, v1, v2, v3 );
-        double A1 = GEO::Geom::triangle_area( v0, v1, v2 );
-        double A2 = GEO::Geom::triangle_area( v1, v2, v3 );
-        double A3 = GEO::Geom::triangle_area( v2, v3, v0 );
-        double A4 = GEO::Geom::triangle_area( v3, v0, v1 );
-        ringmesh_assert( A1 + A2 + A3 + A4 > global_epsilon );
-        return ( 3 * tet_volume ) / ( A1 + A2 + A3 + A4 );
+        for( auto lane : range( TET_BLOCK_SIZE ) )
+        {
+            auto cell = first_cell + ( lane < nb_cells ? lane : 0 );
+            for( auto v : range( 4 ) )
+            {
+                const auto& point = region.mesh_element_vertex( { cell, v } );
+                block.x[v][lane] = point.x;
+                block.y[v][lane] = point.y;
+                block.z[v][lane] = point.z;
+            }
+        }
+    }
+
+    /*!
+     * @brief Computes the square length of the 6 edges of each tetrahedron
+     * of the block. Edges are ordered as in tet_edges.
+     */
+    void compute_square_edge_lengths(
+        const TetBlock& block, double length2[6][TET_BLOCK_SIZE] )
+    {
+        for( auto e : range( 6 ) )
+        {
+            const auto v0 = tet_edges[e][0];
+            const auto v1 = tet_edges[e][1];
+            for( auto lane : range( TET_BLOCK_SIZE ) )
+            {
+                const double dx = block.x[v1][lane] - block.x[v0][lane];
+                const double dy = block.y[v1][lane] - block.y[v0][lane];
+                const double dz = block.z[v1][lane] - block.z[v0][lane];
+                length2[e][lane] = dx * dx + dy * dy + dz * dz;
+            }
+        }
+    }
+
+    /*!
+     * @brief Computes the volume of each tetrahedron of the block.
+     * Same formula as GEO::Geom::tetra_volume.
+     */
+    void compute_volumes(
+        const TetBlock& block, double volume[TET_BLOCK_SIZE] )
+    {
+        for( auto lane : range( TET_BLOCK_SIZE ) )
+        {
+            const double ax = block.x[1][lane] - block.x[0][lane];
+            const double ay = block.y[1][lane] - block.y[0][lane];
+            const double az = block.z[1][lane] - block.z[0][lane];
+            const double bx = block.x[2][lane] - block.x[0][lane];
+            const double by = block.y[2][lane] - block.y[0][lane];
+            const double bz = block.z[2][lane] - block.z[0][lane];
+            const double cx = block.x[3][lane] - block.x[0][lane];
+            const double cy = block.y[3][lane] - block.y[0][lane];
+            const double cz = block.z[3][lane] - block.z[0][lane];
+            const double det = ax * ( by * cz - bz * cy )
+                               + ay * ( bz * cx - bx * cz )
+                               + az * ( bx * cy - by * cx );
+            volume[lane] = std::fabs( det ) / 6.;
+        }
     }
 
+    /*!
+     * @brief Computes the insphere radius of each tetrahedron of the block.
+     * @param[in] volume volumes of the tetrahedra, see compute_volumes.
+     */
+    void compute_insphere_radii( const TetBlock& block,
+        const double volume[TET_BLOCK_SIZE],
+        double in_radius[TET_BLOCK_SIZE] )
+    {
+        static const index_t tet_faces[4][3] = { { 0, 1, 2 }, { 1, 2, 3 },
+            { 2, 3, 0 }, { 3, 0, 1 } };
+        double area_sum[TET_BLOCK_SIZE] = {};
+        for( auto f : range( 4 ) )
+        {
+            const auto v0 = tet_faces[f][0];
+            const auto v1 = tet_faces[f][1];
+            const auto v2 = tet_faces[f][2];
+            for( auto lane : range( TET_BLOCK_SIZE ) )
+            {
+                const double ax = block.x[v1][lane] - block.x[v0][lane];
+                const double ay = block.y[v1][lane] - block.y[v0][lane];
+                const double az = block.z[v1][lane] - block.z[v0][lane];
+                const double bx = block.x[v2][lane] - block.x[v0][lane];
+                const double by = block.y[v2][lane] - block.y[v0][lane];
+                const double bz = block.z[v2][lane] - block.z[v0][lane];
+                const double nx = ay * bz - az * by;
+                const double ny = az * bx - ax * bz;
+                const double nz = ax * by - ay * bx;
+                area_sum[lane] += 0.5 * std::sqrt( nx * nx + ny * ny + nz * nz );
+            }
+        }
+        for( auto lane : range( TET_BLOCK_SIZE ) )
+        {
+            in_radius[lane] = area_sum[lane] > 0.
+                                  ? ( 3 * volume[lane] ) / area_sum[lane]
+                                  : 0.;
+        }
+    }
+
+    /*!
+     * @brief Computes the circumsphere radius of each tetrahedron of the
+     * block. Same formula as GEO::Geom::tetra_circum_center.
+     */
+    void compute_circumsphere_radii(
+        const TetBlock& block, double circum_radius[TET_BLOCK_SIZE] )
+    {
+        for( auto lane : range( TET_BLOCK_SIZE ) )
+        {
+            const double ax = block.x[1][lane] - block.x[0][lane];
+            const double ay = block.y[1][lane] - block.y[0][lane];
+            const double az = block.z[1][lane] - block.z[0][lane];
+            const double bx = block.x[2][lane] - block.x[0][lane];
+            const double by = block.y[2][lane] - block.y[0][lane];
+            const double bz = block.z[2][lane] - block.z[0][lane];
+            const double cx = block.x[3][lane] - block.x[0][lane];
+            const double cy = block.y[3][lane] - block.y[0][lane];
+            const double cz = block.z[3][lane] - block.z[0][lane];
+            const double a2 = ax * ax + ay * ay + az * az;
+            const double b2 = bx * bx + by * by + bz * bz;
+            const double c2 = cx * cx + cy * cy + cz * cz;
+            // b x c, c x a and a x b
+            const double bcx = by * cz - bz * cy;
+            const double bcy = bz * cx - bx * cz;
+            const double bcz = bx * cy - by * cx;
+            const double cax = cy * az - cz * ay;
+            const double cay = cz * ax - cx * az;
+            const double caz = cx * ay - cy * ax;
+            const double abx = ay * bz - az * by;
+            const double aby = az * bx - ax * bz;
+            const double abz = ax * by - ay * bx;
+            const double denominator = 2. * ( ax * bcx + ay * bcy + az * bcz );
+            const double nx = a2 * bcx + b2 * cax + c2 * abx;
+            const double ny = a2 * bcy + b2 * cay + c2 * aby;
+            const double nz = a2 * bcz + b2 * caz + c2 * abz;
+            // The circumsphere of a flat tetrahedron is infinite
+            circum_radius[lane] =
+                denominator != 0.
+                    ? std::sqrt( nx * nx + ny * ny + nz * nz )
+                          / std::fabs( denominator )
+                    : max_float64();
+        }
+    }
+
+    /*!
+     * @brief Computes the sinus of the half solid angle on the vertex a of
+     * the tetrahedra (a, b, c, d) of the block.
+     * @param[in] volume volumes of the tetrahedra.
+     * @param[in] lab, lac, lad, lbc, lbd, lcd edge lengths of the tetrahedra.
+     * @param[in,out] min_sin minimum over the already computed vertices,
+     * updated with the value on vertex a.
+     */
+    void update_min_sin_half_solid_angle( const double volume[TET_BLOCK_SIZE],
+        const double lab[TET_BLOCK_SIZE],
+        const double lac[TET_BLOCK_SIZE],
+        const double lad[TET_BLOCK_SIZE],
+        const double lbc[TET_BLOCK_SIZE],
+        const double lbd[TET_BLOCK_SIZE],
+        const double lcd[TET_BLOCK_SIZE],
+        double min_sin[TET_BLOCK_SIZE] )
+    {
+        for( auto lane : range( TET_BLOCK_SIZE ) )
+        {
+            double denominator =
+                ( lab[lane] + lac[lane] + lbc[lane] )
+                * ( lab[lane] + lac[lane] - lbc[lane] )
+                * ( lac[lane] + lad[lane] + lcd[lane] )
+                * ( lac[lane] + lad[lane] - lcd[lane] )
+                * ( lad[lane] + lab[lane] + lbd[lane] )
+                * ( lad[lane] + lab[lane] - lbd[lane] );
+            const double sin_half_angle =
+                denominator > 0. ? 12 * volume[lane] / std::sqrt( denominator )
+                                 : 0.;
+            min_sin[lane] = std::min( min_sin[lane], sin_half_angle );
+        }
+    }
+
+    /*
+     * Quality kernels: each one computes the quality of all the tetrahedra
+     * of a TetBlock. The kernel is a template parameter of compute_quality
+     * so that the quality mode is resolved at compile time.
+     * Degenerate tetrahedra, including the ones tested by the local mesh
+     * improvement, have a quality of 0.
+     */
+
     /*!
      * @brief Tetrahedron quality based on the insphere and circumsphere radii.
      *
@@ -88,49 +318,25 @@ namespace
      * href="http://people.sc.fsu.edu/~jburkardt/cpp_src/tet_mesh_quality/tet_mesh_quality.html">
      * TET_MESH_QUALITY Interactive Program for Tet Mesh Quality</a>
      *
-     * @param[in] v0 first vertex of the tetrahedron.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     * @return 3 * the insphere radius divided by the circumsphere radius.
+     * Computed as 3 * the insphere radius divided by the circumsphere radius.
      */
-    double tet_quality_insphere_radius_by_circumsphere_radius(
-        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
+    struct InsphereRadiusByCircumsphereRadiusKernel
     {
-        const vec3 tetra_circum_center =
-            GEO::Geom::tetra_circum_center( v0, v1, v2, v3 );
-        const double tetra_circum_radius =
-            vec3( tetra_circum_center - v0 ).length();
-        ringmesh_assert( std::abs( tetra_circum_radius
-                                   - ( tetra_circum_center - v1 ).length() )
-                         < global_epsilon );
-        ringmesh_assert( std::abs( tetra_circum_radius
-                                   - ( tetra_circum_center - v2 ).length() )
-                         < global_epsilon );
-        ringmesh_assert( std::abs( tetra_circum_radius
-                                   - ( tetra_circum_center - v3 ).length() )
-                         < global_epsilon );
-
-        // insphere computation
-        double in_radius = tetra_insphere_radius( v0, v1, v2, v3 );
-        return 3. * in_radius / tetra_circum_radius;
-    }
-
-    /*!
-     * @param[in] v0 first vertex of the tetrahedron.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     * @return the maximum of the tetrahedron edge length.
-     */
-    double max_tet_edge_length(
-        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
-    {
-        std::initializer_list< double > edge_length{ ( v1 - v0 ).length(),
-            ( v2 - v0 ).length(), ( v3 - v0 ).length(), ( v2 - v1 ).length(),
-            ( v3 - v1 ).length(), ( v3 - v2 ).length() };
-        return std::max( edge_length );
-    }
+        static void compute(
+            const TetBlock& block, double quality[TET_BLOCK_SIZE] )
+        {
+            double volume[TET_BLOCK_SIZE];
+            double in_radius[TET_BLOCK_SIZE];
+            double circum_radius[TET_BLOCK_SIZE];
+            compute_volumes( block, volume );
+            compute_insphere_radii( block, volume, in_radius );
+            compute_circumsphere_radii( block, circum_radius );
+            for( auto lane : range( TET_BLOCK_SIZE ) )
+            {
+                quality[lane] = 3. * in_radius[lane] / circum_radius[lane];
+            }
+        }
+    };
 
     /*!
      * @brief Tetrahedron quality based on the insphere radius and the maximum
@@ -148,40 +354,35 @@ namespace
      * href="http://people.sc.fsu.edu/~jburkardt/cpp_src/tet_mesh_quality/tet_mesh_quality.html">
      * TET_MESH_QUALITY Interactive Program for Tet Mesh Quality</a>
      *
-     * @param[in] v0 first vertex of the tetrahedron.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     * @return 2 * sqrt( 6 ) * the insphere radius divided by the maximum of the
+     * Computed as 2 * sqrt( 6 ) * the insphere radius divided by the maximum of the
      * tetrhedron edge length.
      */
-    double tet_quality_insphere_radius_by_max_edge_length(
-        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
-    {
-        double in_radius = tetra_insphere_radius( v0, v1, v2, v3 );
-        double edge_length = max_tet_edge_length( v0, v1, v2, v3 );
-
-        return 2 * std::sqrt( 6. ) * in_radius / edge_length;
-    }
-
-    /*!
-     * @param[in] v0 first vertex of the tetrahedron.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     * @return the sum of the square tetrahedron edge length.
-     */
-    double sum_square_edge_length(
-        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
+    struct InsphereRadiusByMaxEdgeLengthKernel
     {
-        double l1 = vec3( v1 - v0 ).length2();
-        double l2 = vec3( v2 - v0 ).length2();
-        double l3 = vec3( v3 - v0 ).length2();
-        double l4 = vec3( v2 - v1 ).length2();
-        double l5 = vec3( v3 - v1 ).length2();
-        double l6 = vec3( v3 - v2 ).length2();
-        return l1 + l2 + l3 + l4 + l5 + l6;
-    }
+        static void compute(
+            const TetBlock& block, double quality[TET_BLOCK_SIZE] )
+        {
+            double volume[TET_BLOCK_SIZE];
+            double in_radius[TET_BLOCK_SIZE];
+            double length2[6][TET_BLOCK_SIZE];
+            compute_volumes( block, volume );
+            compute_insphere_radii( block, volume, in_radius );
+            compute_square_edge_lengths( block, length2 );
+            const double factor = 2 * std::sqrt( 6. );
+            for( auto lane : range( TET_BLOCK_SIZE ) )
+            {
+                double max_length2 = length2[0][lane];
+                for( auto e : range( 1, 6 ) )
+                {
+                    max_length2 = std::max( max_length2, length2[e][lane] );
+                }
+                quality[lane] =
+                    max_length2 > 0.
+                        ? factor * in_radius[lane] / std::sqrt( max_length2 )
+                        : 0.;
+            }
+        }
+    };
 
     /*!
      * @brief Tetrahedron quality based on the tetrahedron volume and
@@ -194,52 +395,30 @@ namespace
      * href="http://people.sc.fsu.edu/~jburkardt/cpp_src/tet_mesh_quality/tet_mesh_quality.html">
      * TET_MESH_QUALITY Interactive Program for Tet Mesh Quality</a>
      *
-     * @param[in] v0 first vertex of the tetrahedron.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     *
-     * @return 12. * (3 * volume)^(2/3) / sum of the square edge.
-     */
-    double tet_quality_volume_by_sum_square_edges(
-        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
-    {
-        const double tet_volume = GEO::Geom::tetra_volume( v0, v1, v2, v3 );
-        double sum_square_edge = sum_square_edge_length( v0, v1, v2, v3 );
-        ringmesh_assert( sum_square_edge > global_epsilon );
-        return 12. * std::pow( 3. * tet_volume, 2. / 3. ) / sum_square_edge;
-    }
-
-    /*!
-     * @bried Computes the sinus of the half solid angle relatively to a
-     * tetrahedron vertex.
-     * @param[in] v0 first vertex of the tetrahedron. The solid angle is
-     * computed
-     * relatively to this vertex.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     * @return the sinus of the half solid angle on the vertex \p v0.
+     * Computed as 12. * (3 * volume)^(2/3) / sum of the square edge.
      */
-    double sin_half_solid_angle(
-        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
+    struct VolumeBySumSquareEdgeKernel
     {
-        double tet_volume = GEO::Geom::tetra_volume( v0, v1, v2, v3 );
-        double l01 = ( v1 - v0 ).length();
-        double l02 = ( v2 - v0 ).length();
-        double l03 = ( v3 - v0 ).length();
-        double l12 = ( v2 - v1 ).length();
-        double l13 = ( v3 - v1 ).length();
-        double l23 = ( v3 - v2 ).length();
-        double denominator = ( l01 + l02 + l12 ) * ( l01 + l02 - l12 )
-                             * ( l02 + l03 + l23 ) * ( l02 + l03 - l23 )
-                             * ( l03 + l01 + l13 ) * ( l03 + l01 - l13 );
-
-        ringmesh_assert( denominator > global_epsilon_sq );
-
-        denominator = std::sqrt( denominator );
-        return 12 * tet_volume / denominator;
-    }
+        static void compute(
+            const TetBlock& block, double quality[TET_BLOCK_SIZE] )
+        {
+            double volume[TET_BLOCK_SIZE];
+            double length2[6][TET_BLOCK_SIZE];
+            compute_volumes( block, volume );
+            compute_square_edge_lengths( block, length2 );
+            for( auto lane : range( TET_BLOCK_SIZE ) )
+            {
+                const double sum_square_edge =
+                    length2[0][lane] + length2[1][lane] + length2[2][lane]
+                    + length2[3][lane] + length2[4][lane] + length2[5][lane];
+                quality[lane] =
+                    sum_square_edge > 0.
+                        ? 12. * std::pow( 3. * volume[lane], 2. / 3. )
+                              / sum_square_edge
+                        : 0.;
+            }
+        }
+    };
 
     /*!
      * @brief Tetrahedron quality based on the solid angles.
@@ -259,128 +438,294 @@ namespace
      * href="http://people.sc.fsu.edu/~jburkardt/cpp_src/tet_mesh_quality/tet_mesh_quality.html">
      * TET_MESH_QUALITY Interactive Program for Tet Mesh Quality</a>
      *
-     * @param[in] v0 first vertex of the tetrahedron.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     *
-     * @return 1.5 * sqrt( 6 ) * the minimun of the sinus of the half
+     * Computed as 1.5 * sqrt( 6 ) * the minimun of the sinus of the half
      * solid angles. 1.5 * sqrt( 6 ) is a factor to scale the metrics between
      * 0 and 1.
      * 0 corresponds to a bad tetrahedron, and
      * 1 to a good tetrahedron (equilaterality).
      */
-    double tet_quality_min_solid_angle(
-        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
+    struct MinSolidAngleKernel
     {
-        double min_sin_half_solid_angle = std::min(
-            std::min( std::min( sin_half_solid_angle( v0, v1, v2, v3 ),
-                          sin_half_solid_angle( v1, v0, v2, v3 ) ),
-                sin_half_solid_angle( v2, v0, v1, v3 ) ),
-            sin_half_solid_angle( v3, v0, v1, v2 ) );
-        return 1.5 * std::sqrt( 6. ) * min_sin_half_solid_angle;
+        static void compute(
+            const TetBlock& block, double quality[TET_BLOCK_SIZE] )
+        {
+            double volume[TET_BLOCK_SIZE];
+            double length[6][TET_BLOCK_SIZE];
+            compute_volumes( block, volume );
+            compute_square_edge_lengths( block, length );
+            for( auto e : range( 6 ) )
+            {
+                for( auto lane : range( TET_BLOCK_SIZE ) )
+                {
+                    length[e][lane] = std::sqrt( length[e][lane] );
+                }
+            }
+            const auto& l01 = length[0];
+            const auto& l02 = length[1];
+            const auto& l03 = length[2];
+            const auto& l12 = length[3];
+            const auto& l13 = length[4];
+            const auto& l23 = length[5];
+            double min_sin[TET_BLOCK_SIZE];
+            std::fill( min_sin, min_sin + TET_BLOCK_SIZE, max_float64() );
+            update_min_sin_half_solid_angle(
+                volume, l01, l02, l03, l12, l13, l23, min_sin );
+            update_min_sin_half_solid_angle(
+                volume, l01, l12, l13, l02, l03, l23, min_sin );
+            update_min_sin_half_solid_angle(
+                volume, l02, l12, l23, l01, l03, l13, min_sin );
+            update_min_sin_half_solid_angle(
+                volume, l03, l13, l23, l01, l02, l12, min_sin );
+            const double factor = 1.5 * std::sqrt( 6. );
+            for( auto lane : range( TET_BLOCK_SIZE ) )
+            {
+                quality[lane] = factor * min_sin[lane];
+            }
+        }
+    };
+
+    /*!
+     * @brief Returns 0 for the non-finite qualities computed on degenerate
+     * tetrahedra (e.g. infinite circumsphere radius of a flat tetrahedron).
+     */
+    double finite_quality( double quality )
+    {
+        return std::isfinite( quality ) ? quality : 0.;
     }
 
     /*!
-     * @param[in] mesh_qual_mode mesh quality number.
-     * @return the property name associated to the mesh quality number
-     * \p mesh_qual_mode.
+     * @brief Computes the quality of a single tetrahedron with \p KERNEL.
      */
-    std::string mesh_qual_mode_to_prop_name( MeshQualityMode mesh_qual_mode )
+    template < typename KERNEL >
+    double compute_tet_quality(
+        const vec3& v0, const vec3& v1, const vec3& v2, const vec3& v3 )
     {
-        std::string quality_name;
-        switch( mesh_qual_mode )
+        const std::array< const vec3*, 4 > vertices{ { &v0, &v1, &v2, &v3 } };
+        TetBlock block;
+        for( auto v : range( 4 ) )
         {
-        case INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS:
-            quality_name = "INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS";
-            break;
-        case INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH:
-            quality_name = "INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH";
-            break;
-        case VOLUME_BY_SUM_SQUARE_EDGE:
-            quality_name = "VOLUME_BY_SUM_SQUARE_EDGE";
-            break;
-        case MIN_SOLID_ANGLE:
-            quality_name = "MIN_SOLID_ANGLE";
-            break;
-        default:
-            ringmesh_assert_not_reached;
+            for( auto lane : range( TET_BLOCK_SIZE ) )
+            {
+                block.x[v][lane] = vertices[v]->x;
+                block.y[v][lane] = vertices[v]->y;
+                block.z[v][lane] = vertices[v]->z;
+            }
         }
-        ringmesh_assert( !quality_name.empty() );
-        return quality_name;
+        double quality[TET_BLOCK_SIZE];
+        KERNEL::compute( block, quality );
+        return finite_quality( quality[0] );
     }
 
-    /*!
-     * @brief Gets the quality for one tetrahedron.
-     *
-     * The quality is between 0 and 1. 0 corresponds to a bad tetrahedron, and
-     * 1 to a good tetrahedron (equilaterality).
-     *
-     * @param[in] v0 first vertex of the tetrahedron.
-     * @param[in] v1 second vertex of the tetrahedron.
-     * @param[in] v2 third vertex of the tetrahedron.
-     * @param[in] v3 fourth vertex of the tetrahedron.
-     * @param[in] mesh_qual_mode tetrahedron quality to get.
-     * @return the tetrahedron quality.
-     */
-    double get_tet_quality( const vec3& v0,
-        const vec3& v1,
-        const vec3& v2,
-        const vec3& v3,
-        MeshQualityMode mesh_qual_mode )
+    TetQuality tet_quality_function( MeshQualityMode mesh_qual_mode )
     {
-        double quality = -1;
         switch( mesh_qual_mode )
         {
         case INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS:
-            quality = tet_quality_insphere_radius_by_circumsphere_radius(
-                v0, v1, v2, v3 );
-            break;
+            return compute_tet_quality<
+                InsphereRadiusByCircumsphereRadiusKernel >;
         case INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH:
-            quality = tet_quality_insphere_radius_by_max_edge_length(
-                v0, v1, v2, v3 );
-            break;
+            return compute_tet_quality< InsphereRadiusByMaxEdgeLengthKernel >;
         case VOLUME_BY_SUM_SQUARE_EDGE:
-            quality = tet_quality_volume_by_sum_square_edges( v0, v1, v2, v3 );
-            break;
+            return compute_tet_quality< VolumeBySumSquareEdgeKernel >;
         case MIN_SOLID_ANGLE:
-            quality = tet_quality_min_solid_angle( v0, v1, v2, v3 );
-            break;
+            return compute_tet_quality< MinSolidAngleKernel >;
         default:
-            ringmesh_assert_not_reached;
+            throw RINGMeshException( "Quality", "Unknown mesh quality mode ",
+                static_cast< index_t >( mesh_qual_mode ) );
         }
+    }
+
+    /*!
+     * @brief Adds a quality value to the statistics.
+     */
+    void add_to_statistics( double quality, MeshQualityStatistics& stats )
+    {
         ringmesh_assert(
             quality > -1 * global_epsilon && quality < 1 + global_epsilon );
-        return quality;
+        stats.min_quality = std::min( stats.min_quality, quality );
+        stats.max_quality = std::max( stats.max_quality, quality );
+        stats.mean_quality += quality;
+        const auto nb_bins = static_cast< index_t >( stats.histogram.size() );
+        ringmesh_assert( nb_bins != 0 );
+        index_t bin{ 0 };
+        if( quality > 0 )
+        {
+            bin = std::min(
+                static_cast< index_t >( quality * nb_bins ), nb_bins - 1 );
+        }
+        stats.histogram[bin]++;
+        stats.nb_cells++;
+    }
+
+    /*!
+     * @brief Merges the statistics \p from into \p to.
+     * Mean values are not normalized.
+     */
+    void merge_statistics(
+        const MeshQualityStatistics& from, MeshQualityStatistics& to )
+    {
+        to.min_quality = std::min( to.min_quality, from.min_quality );
+        to.max_quality = std::max( to.max_quality, from.max_quality );
+        to.mean_quality += from.mean_quality;
+        to.nb_cells += from.nb_cells;
+        for( auto bin : range( to.histogram.size() ) )
+        {
+            to.histogram[bin] += from.histogram[bin];
+        }
+    }
+
+    /*!
+     * @brief Range of tetrahedron blocks of one Region processed by a task
+     */
+    struct QualityTask
+    {
+        index_t region;
+        index_t first_cell;
+        index_t nb_cells;
+    };
+
+    /*!
+     * @brief Computes the quality of all the Region cells, with
+     * the quality mode given at compile time by \p KERNEL.
+     * The work is split in tasks of NB_BLOCKS_PER_TASK blocks over all the
+     * regions and processed in parallel. Each task gathers its own
+     * statistics that are merged at the end.
+     */
+    template < typename KERNEL >
+    MeshQualityStatistics compute_quality( const GeoModel3D& geomodel,
+        AttributeVector< double >& attributes,
+        index_t nb_histogram_bins )
+    {
+        const index_t nb_cells_per_task = TET_BLOCK_SIZE * NB_BLOCKS_PER_TASK;
+        std::vector< QualityTask > tasks;
+        for( const auto& region : geomodel.regions() )
+        {
+            for( index_t first_cell = 0;
+                 first_cell < region.nb_mesh_elements();
+                 first_cell += nb_cells_per_task )
+            {
+                tasks.push_back( { region.index(), first_cell,
+                    std::min( nb_cells_per_task,
+                        region.nb_mesh_elements() - first_cell ) } );
+            }
+        }
+
+        MeshQualityStatistics empty_stats;
+        empty_stats.histogram.resize( nb_histogram_bins, 0 );
+        std::vector< MeshQualityStatistics > task_stats(
+            tasks.size(), empty_stats );
+        parallel_for( static_cast< index_t >( tasks.size() ),
+            [&geomodel, &attributes, &tasks, &task_stats]( index_t t ) {
+                const auto& task = tasks[t];
+                const auto& region = geomodel.region( task.region );
+                auto& attribute = attributes[task.region];
+                auto& stats = task_stats[t];
+                TetBlock block;
+                double quality[TET_BLOCK_SIZE];
+                for( index_t offset = 0; offset < task.nb_cells;
+                     offset += TET_BLOCK_SIZE )
+                {
+                    auto first_cell = task.first_cell + offset;
+                    auto nb_block_cells =
+                        std::min( TET_BLOCK_SIZE, task.nb_cells - offset );
+                    fill_tet_block( region, first_cell, nb_block_cells, block );
+                    KERNEL::compute( block, quality );
+                    for( auto lane : range( nb_block_cells ) )
+                    {
+                        const auto cell_quality =
+                            finite_quality( quality[lane] );
+                        attribute[first_cell + lane] = cell_quality;
+                        add_to_statistics( cell_quality, stats );
+                    }
+                }
+            } );
+
+        for( const auto& stats : task_stats )
+        {
+            merge_statistics( stats, empty_stats );
+        }
+        if( empty_stats.nb_cells != 0 )
+        {
+            empty_stats.mean_quality /= empty_stats.nb_cells;
+        }
+        return empty_stats;
     }
 } // namespace
 
 namespace RINGMesh
 {
-    void compute_prop_tet_mesh_quality(
-        MeshQualityMode mesh_qual_mode, const GeoModel3D& geomodel )
+    MeshQualityStatistics compute_prop_tet_mesh_quality(
+        MeshQualityMode mesh_qual_mode,
+        const GeoModel3D& geomodel,
+        index_t nb_histogram_bins )
     {
         ringmesh_assert( geomodel.nb_regions() != 0 );
+        if( nb_histogram_bins == 0 )
+        {
+            throw RINGMeshException(
+                "Quality", "The quality histogram needs at least one bin" );
+        }
+        AttributeVector< double > attributes( geomodel.nb_regions() );
         for( const auto& region : geomodel.regions() )
         {
             ringmesh_assert( region.is_meshed() );
             ringmesh_assert( region.is_simplicial() );
-            GEO::AttributesManager& reg_attr_mgr =
-                region.cell_attribute_manager();
-            GEO::Attribute< double > attr(
-                reg_attr_mgr, mesh_qual_mode_to_prop_name( mesh_qual_mode ) );
-            for( auto cell_itr : range( region.nb_mesh_elements() ) )
-            {
-                attr[cell_itr] = get_tet_quality(
-                    region.mesh_element_vertex( { cell_itr, 0 } ),
-                    region.mesh_element_vertex( { cell_itr, 1 } ),
-                    region.mesh_element_vertex( { cell_itr, 2 } ),
-                    region.mesh_element_vertex( { cell_itr, 3 } ),
-                    mesh_qual_mode );
-            }
+            attributes.bind_one_attribute( region.index(),
+                region.cell_attribute_manager(),
+                mesh_qual_mode_to_prop_name( mesh_qual_mode ) );
+        }
+
+        switch( mesh_qual_mode )
+        {
+        case INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS:
+            return compute_quality< InsphereRadiusByCircumsphereRadiusKernel >(
+                geomodel, attributes, nb_histogram_bins );
+        case INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH:
+            return compute_quality< InsphereRadiusByMaxEdgeLengthKernel >(
+                geomodel, attributes, nb_histogram_bins );
+        case VOLUME_BY_SUM_SQUARE_EDGE:
+            return compute_quality< VolumeBySumSquareEdgeKernel >(
+                geomodel, attributes, nb_histogram_bins );
+        case MIN_SOLID_ANGLE:
+            return compute_quality< MinSolidAngleKernel >(
+                geomodel, attributes, nb_histogram_bins );
+        default:
+            throw RINGMeshException( "Quality", "Unknown mesh quality mode ",
+                static_cast< index_t >( mesh_qual_mode ) );
         }
     }
 
+    MeshQualityStatistics improve_tet_mesh_quality(
+        MeshQualityMode mesh_qual_mode,
+        double min_quality,
+        GeoModel3D& geomodel,
+        index_t nb_iterations,
+        index_t nb_histogram_bins )
+    {
+        if( nb_histogram_bins == 0 )
+        {
+            throw RINGMeshException(
+                "Quality", "The quality histogram needs at least one bin" );
+        }
+        compute_prop_tet_mesh_quality( mesh_qual_mode, geomodel );
+        auto nb_modifications = improve_tetrahedra_quality( geomodel,
+            mesh_qual_mode_to_prop_name( mesh_qual_mode ), min_quality,
+            tet_quality_function( mesh_qual_mode ), nb_iterations );
+        Logger::out( "Quality", nb_modifications,
+            " local modifications to improve the mesh quality" );
+        return compute_prop_tet_mesh_quality(
+            mesh_qual_mode, geomodel, nb_histogram_bins );
+    }
+
+    double tetrahedron_quality( MeshQualityMode mesh_qual_mode,
+        const vec3& v0,
+        const vec3& v1,
+        const vec3& v2,
+        const vec3& v3 )
+    {
+        return tet_quality_function( mesh_qual_mode )( v0, v1, v2, v3 );
+    }
+
     double fill_mesh_with_low_quality_cells( MeshQualityMode mesh_qual_mode,
         double min_quality,
         const GeoModel3D& geomodel,
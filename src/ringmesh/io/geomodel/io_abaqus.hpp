@@ -82,16 +82,16 @@ namespace
         {
             const GeoModelMeshVertices3D& vertices = geomodel.mesh.vertices;
             out << "*NODE" << EOL;
-            for( auto v : range( vertices.nb() ) )
-            {
-                out << v + 1;
-                const vec3& vertex = vertices.vertex( v );
-                for( auto i : range( 3 ) )
-                {
-                    out << COMMA << SPACE << vertex[i];
-                }
-                out << EOL;
-            }
+            parallel_write_text(
+                out, vertices.nb(), [&vertices]( TextWriter& text, index_t v ) {
+                    text << v + 1;
+                    const vec3& vertex = vertices.vertex( v );
+                    for( auto i : range( 3 ) )
+                    {
+                        text << COMMA << SPACE << vertex[i];
+                    }
+                    text << EOL;
+                } );
         }
         void save_nb_polygons(
             const GeoModel3D& geomodel, std::ofstream& out ) const
@@ -147,21 +147,21 @@ namespace
                     << EOL;
                 for( auto r : range( geomodel.nb_regions() ) )
                 {
-                    for( auto c : range( cells.nb_tet( r ) ) )
-                    {
-                        index_t tetra = cells.tet( r, c );
-                        out << tetra + 1;
-                        for( auto v : range( 4 ) )
-                        {
-                            index_t vertex_id =
-                                tet_descriptor_abaqus.vertices[v];
-                            out << COMMA << SPACE
-                                << cells.vertex(
-                                       ElementLocalVertex( tetra, vertex_id ) )
-                                       + 1;
-                        }
-                        out << EOL;
-                    }
+                    parallel_write_text( out, cells.nb_tet( r ),
+                        [&cells, r]( TextWriter& text, index_t c ) {
+                            index_t tetra = cells.tet( r, c );
+                            text << tetra + 1;
+                            for( auto v : range( 4 ) )
+                            {
+                                index_t vertex_id =
+                                    tet_descriptor_abaqus.vertices[v];
+                                text << COMMA << SPACE
+                                     << cells.vertex( ElementLocalVertex(
+                                            tetra, vertex_id ) )
+                                            + 1;
+                            }
+                            text << EOL;
+                        } );
                 }
             }
         }
@@ -174,21 +174,21 @@ namespace
                     << EOL;
                 for( auto r : range( geomodel.nb_regions() ) )
                 {
-                    for( auto c : range( cells.nb_hex( r ) ) )
-                    {
-                        index_t hex = cells.hex( r, c );
-                        out << hex + 1;
-                        for( auto v : range( 8 ) )
-                        {
-                            index_t vertex_id =
-                                hex_descriptor_abaqus.vertices[v];
-                            out << COMMA << SPACE
-                                << cells.vertex(
-                                       ElementLocalVertex( hex, vertex_id ) )
-                                       + 1;
-                        }
-                        out << EOL;
-                    }
+                    parallel_write_text( out, cells.nb_hex( r ),
+                        [&cells, r]( TextWriter& text, index_t c ) {
+                            index_t hex = cells.hex( r, c );
+                            text << hex + 1;
+                            for( auto v : range( 8 ) )
+                            {
+                                index_t vertex_id =
+                                    hex_descriptor_abaqus.vertices[v];
+                                text << COMMA << SPACE
+                                     << cells.vertex( ElementLocalVertex(
+                                            hex, vertex_id ) )
+                                            + 1;
+                            }
+                            text << EOL;
+                        } );
                 }
             }
         }
@@ -133,6 +133,7 @@ namespace
         {
             const auto& nn =
                 geomodel_.mesh_entity( region_gmme_ ).vertex_nn_search();
+            TextWriter text;
             for( const auto& corner_gmme : corners_ )
             {
                 std::vector< index_t > element_vertices( 1 );
@@ -140,9 +141,11 @@ namespace
                     nn.get_closest_neighbor(
                         geomodel_.mesh_entity( corner_gmme ).vertex( 0 ) )
                     + offset_vertices_;
-                write_mesh_entity_element( adeli_point_type, element_vertices,
-                    offset_corners_++, out );
+                write_mesh_entity_element( offset_elements_++,
+                    adeli_point_type, element_vertices, offset_corners_++,
+                    text );
             }
+            text.write( out );
         }
         void write_entities( const std::vector< gmme_id >& entities,
             index_t& offset,
@@ -159,40 +162,44 @@ namespace
             index_t offset,
             std::ofstream& out )
         {
-            for( auto mesh_entity_element :
-                range( mesh_entity.nb_mesh_elements() ) )
-            {
-                std::vector< index_t > element_vertices =
-                    get_element_vertices( mesh_entity, mesh_entity_element );
-                write_mesh_entity_element(
-                    adeli_cell_types[mesh_entity.nb_mesh_element_vertices(
-                                         mesh_entity_element )
-                                     - 1],
-                    element_vertices, offset, out );
-            }
+            const auto& nn =
+                geomodel_.mesh_entity( region_gmme_ ).vertex_nn_search();
+            auto first_element = offset_elements_;
+            parallel_write_text( out, mesh_entity.nb_mesh_elements(),
+                [this, &mesh_entity, &nn, offset, first_element](
+                    TextWriter& text, index_t mesh_entity_element ) {
+                    std::vector< index_t > element_vertices =
+                        get_element_vertices(
+                            nn, mesh_entity, mesh_entity_element );
+                    write_mesh_entity_element(
+                        first_element + mesh_entity_element,
+                        adeli_cell_types[mesh_entity.nb_mesh_element_vertices(
+                                             mesh_entity_element )
+                                         - 1],
+                        element_vertices, offset, text );
+                } );
+            offset_elements_ += mesh_entity.nb_mesh_elements();
         }
 
-        void write_mesh_entity_element( index_t cell_descriptor,
+        void write_mesh_entity_element( index_t element_id,
+            index_t cell_descriptor,
             const std::vector< index_t >& element_vertices,
             index_t offset,
-            std::ofstream& out )
+            TextWriter& text ) const
         {
-            out << offset_elements_++ << " " << cell_descriptor << " "
-                << reg_phys << " " << offset << " " << element_vertices.size()
-                << " ";
+            text << element_id << " " << cell_descriptor << " " << reg_phys
+                 << " " << offset << " " << element_vertices.size() << " ";
             for( auto element_vertex : element_vertices )
             {
-                out << element_vertex << " ";
+                text << element_vertex << " ";
             }
-            out << EOL;
+            text << EOL;
         }
 
-        std::vector< index_t > get_element_vertices(
+        std::vector< index_t > get_element_vertices( const NNSearch3D& nn,
             const GeoModelMeshEntity3D& mesh_entity,
             index_t element_index ) const
         {
-            const auto& nn =
-                geomodel_.mesh_entity( region_gmme_ ).vertex_nn_search();
             index_t nb_vertices{ mesh_entity.nb_mesh_element_vertices(
                 element_index ) };
             std::vector< index_t > element_vertices( nb_vertices );
@@ -348,10 +355,12 @@ namespace
             index_t vertex_index{ id_offset_adeli };
             for( const auto& region : geomodel.regions() )
             {
-                for( auto v : range( region.nb_vertices() ) )
-                {
-                    out << vertex_index++ << " " << region.vertex( v ) << EOL;
-                }
+                parallel_write_text( out, region.nb_vertices(),
+                    [&region, vertex_index]( TextWriter& text, index_t v ) {
+                        text << vertex_index + v << " " << region.vertex( v )
+                             << EOL;
+                    } );
+                vertex_index += region.nb_vertices();
             }
             out << "$ENDNOD" << EOL;
         }
@@ -98,11 +98,11 @@ namespace
             const RINGMesh::GeoModelMesh3D& geomodel_mesh ) const
         {
             out << "COOR_3D" << EOL;
-            for( auto v : range( geomodel_mesh.vertices.nb() ) )
-            {
-                out << "V" << v << " " << geomodel_mesh.vertices.vertex( v )
-                    << EOL;
-            }
+            parallel_write_text( out, geomodel_mesh.vertices.nb(),
+                [&geomodel_mesh]( TextWriter& text, index_t v ) {
+                    text << "V" << v << " "
+                         << geomodel_mesh.vertices.vertex( v ) << EOL;
+                } );
             out << "FINSF" << EOL;
         }
 
@@ -151,21 +151,23 @@ namespace
             out << *cell_name_in_aster_mail_file[to_underlying_type(
                        cell_type )]
                 << EOL;
-            for( auto c :
-                range( geomodel_mesh.cells.nb_cells( region, cell_type ) ) )
-            {
-                index_t global_id =
-                    geomodel_mesh.cells.cell( region, c, cell_type );
-                out << "C" << global_id << " ";
-                for( auto v : range( geomodel_mesh.cells.nb_vertices( c ) ) )
-                {
-                    out << "V"
-                        << geomodel_mesh.cells.vertex(
-                               ElementLocalVertex( global_id, v ) )
-                        << " ";
-                }
-                out << EOL;
-            }
+            parallel_write_text( out,
+                geomodel_mesh.cells.nb_cells( region, cell_type ),
+                [&geomodel_mesh, region, cell_type](
+                    TextWriter& text, index_t c ) {
+                    index_t global_id =
+                        geomodel_mesh.cells.cell( region, c, cell_type );
+                    text << "C" << global_id << " ";
+                    for( auto v :
+                        range( geomodel_mesh.cells.nb_vertices( c ) ) )
+                    {
+                        text << "V"
+                             << geomodel_mesh.cells.vertex(
+                                    ElementLocalVertex( global_id, v ) )
+                             << " ";
+                    }
+                    text << EOL;
+                } );
             out << "FINSF" << EOL;
         }
 
@@ -177,21 +179,21 @@ namespace
             out << *polygon_name_in_aster_mail_file[to_underlying_type(
                        polygon_type )]
                 << EOL;
-            for( auto p :
-                range( mesh.polygons.nb_polygons( surface, polygon_type ) ) )
-            {
-                index_t global_id =
-                    mesh.polygons.polygon( surface, p, polygon_type );
-                out << "F" << global_id << " ";
-                for( auto v : range( mesh.polygons.nb_vertices( p ) ) )
-                {
-                    out << "V"
-                        << mesh.polygons.vertex(
-                               ElementLocalVertex( global_id, v ) )
-                        << " ";
-                }
-                out << EOL;
-            }
+            parallel_write_text( out,
+                mesh.polygons.nb_polygons( surface, polygon_type ),
+                [&mesh, surface, polygon_type]( TextWriter& text, index_t p ) {
+                    index_t global_id =
+                        mesh.polygons.polygon( surface, p, polygon_type );
+                    text << "F" << global_id << " ";
+                    for( auto v : range( mesh.polygons.nb_vertices( p ) ) )
+                    {
+                        text << "V"
+                             << mesh.polygons.vertex(
+                                    ElementLocalVertex( global_id, v ) )
+                             << " ";
+                    }
+                    text << EOL;
+                } );
             out << "FINSF" << EOL;
         }
 
@@ -204,13 +206,14 @@ namespace
                 {
                     out << "GROUP_MA" << EOL;
                     out << region.name() << EOL;
-                    for( auto c : range(
-                             geomodel.mesh.cells.nb_cells( region.index() ) ) )
-                    {
-                        out << "C"
-                            << geomodel.mesh.cells.cell( region.index(), c )
-                            << EOL;
-                    }
+                    parallel_write_text( out,
+                        geomodel.mesh.cells.nb_cells( region.index() ),
+                        [&geomodel, &region]( TextWriter& text, index_t c ) {
+                            text << "C"
+                                 << geomodel.mesh.cells.cell(
+                                        region.index(), c )
+                                 << EOL;
+                        } );
                     out << "FINSF" << EOL;
                 }
             }
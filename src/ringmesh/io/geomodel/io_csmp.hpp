@@ -79,6 +79,50 @@ namespace
     static RINGMesh2CSMP* cell_type_to_cell_descriptor[4] = { &tet_descriptor,
         &hex_descriptor, &prism_descriptor, &pyramid_descriptor };
 
+    /*!
+     * @brief Concatenates the values of a range of elements
+     * @details The values are counted first, then each element writes its
+     * values in parallel at its offset in the result.
+     * @param[in] nb_elements the number of elements
+     * @param[in] nb_values function giving the number of values of an
+     * element, its signature is index_t( index_t )
+     * @param[in] fill function writing the values of an element,
+     * its signature is void( index_t, T* )
+     */
+    template < typename T, typename SIZE, typename FILL >
+    std::vector< T > gather_values(
+        index_t nb_elements, const SIZE& nb_values, const FILL& fill )
+    {
+        std::vector< index_t > offsets( nb_elements + 1, 0 );
+        parallel_for( nb_elements, [&offsets, &nb_values]( index_t e ) {
+            offsets[e + 1] = nb_values( e );
+        } );
+        for( auto e : range( nb_elements ) )
+        {
+            offsets[e + 1] += offsets[e];
+        }
+        std::vector< T > values( offsets.back() );
+        parallel_for( nb_elements, [&offsets, &fill, &values]( index_t e ) {
+            fill( e, values.data() + offsets[e] );
+        } );
+        return values;
+    }
+
+    /*!
+     * @brief Writes a value right aligned in a field, as std::setw
+     */
+    template < typename T >
+    void write_field( TextWriter& writer, T value, index_t width )
+    {
+        TextWriter field;
+        field << value;
+        for( auto i = field.str().size(); i < width; i++ )
+        {
+            writer << SPACE;
+        }
+        writer << field.str();
+    }
+
     class CSMPIOHandler final : public GeoModelOutputHandler3D
     {
     public:
@@ -116,24 +160,21 @@ namespace
 
             const GeoModelMesh3D& mesh = geomodel.mesh;
             const GeoModelMeshPolygons3D& polygons = mesh.polygons;
-            index_t count = 0;
             // Conversion from (X,Y,Z) to (X,Z,-Y)
             signed_index_t conversion_sign[3] = { 1, 1, -1 };
             index_t conversion_axis[3] = { 0, 2, 1 };
             data << mesh.vertices.nb() << " # PX, PY, PZ" << EOL;
             for( auto dim : range( 3 ) )
             {
-                for( auto v : range( mesh.vertices.nb() ) )
-                {
-                    data << " "
-                         << conversion_sign[dim]
-                                * mesh.vertices.vertex(
-                                      v )[conversion_axis[dim]];
-                    new_line( count, 5, data );
-                }
-                reset_line( count, data );
+                write_values( data, mesh.vertices.nb(), 5,
+                    [&mesh, &conversion_sign, &conversion_axis, dim](
+                        TextWriter& writer, index_t v ) {
+                        writer << " "
+                               << conversion_sign[dim]
+                                      * mesh.vertices.vertex(
+                                            v )[conversion_axis[dim]];
+                    } );
             }
-            reset_line( count, data );
 
             index_t nb_families = 0;
             index_t nb_interfaces = geomodel.nb_geological_entities(
@@ -220,71 +261,54 @@ namespace
             }
 
             data << "# PBFLAGS" << EOL;
-            for( auto p : range( mesh.vertices.nb() ) )
-            {
-                data << " " << std::setw( 3 ) << point_boundary( p );
-                new_line( count, 20, data );
-            }
-            reset_line( count, data );
+            write_values( data, mesh.vertices.nb(), 20,
+                [this]( TextWriter& writer, index_t p ) {
+                    writer << " ";
+                    write_field( writer, point_boundary( p ), 3 );
+                } );
 
             data << "# PBVALS" << EOL;
-            for( auto p : range( mesh.vertices.nb() ) )
-            {
-                ringmesh_unused( p );
-                data << " " << std::setw( 3 ) << 0;
-                new_line( count, 20, data );
-            }
-            reset_line( count, data );
+            write_values( data, mesh.vertices.nb(), 20, write_zero );
 
             index_t nb_total_entities = mesh.cells.nb_cells()
                                         + polygons.nb_polygons()
                                         + mesh.wells.nb_edges();
             data << nb_total_entities << " # PELEMENT" << EOL;
+            std::vector< index_t > element_types;
+            element_types.reserve( nb_total_entities );
             for( auto r : range( geomodel.nb_regions() ) )
             {
-                index_t entity_type[4] = { 4, 6, 12, 18 };
                 for( auto type :
                     range( to_underlying_type( CellType::TETRAHEDRON ),
                         to_underlying_type( CellType::UNCLASSIFIED ) ) )
                 {
                     CellType T = static_cast< CellType >( type );
-                    for( auto el : range( mesh.cells.nb_cells( r, T ) ) )
-                    {
-                        ringmesh_unused( el );
-                        data << " " << std::setw( 3 ) << entity_type[type];
-                        new_line( count, 20, data );
-                    }
+                    element_types.insert( element_types.end(),
+                        mesh.cells.nb_cells( r, T ),
+                        cell_type_to_cell_descriptor[type]->entity_type );
                 }
             }
             for( auto i : range( nb_interfaces ) )
             {
-                for( auto el : range( nb_triangle_interface[i] ) )
-                {
-                    ringmesh_unused( el );
-                    data << " " << std::setw( 3 ) << 8;
-                    new_line( count, 20, data );
-                }
-                for( auto el : range( nb_quad_interface[i] ) )
-                {
-                    ringmesh_unused( el );
-                    data << " " << std::setw( 3 ) << 14;
-                    new_line( count, 20, data );
-                }
+                element_types.insert(
+                    element_types.end(), nb_triangle_interface[i], 8 );
+                element_types.insert(
+                    element_types.end(), nb_quad_interface[i], 14 );
             }
             if( geomodel.wells() )
             {
                 for( auto w : range( geomodel.wells()->nb_wells() ) )
                 {
-                    const Well3D& well = geomodel.wells()->well( w );
-                    for( auto e : range( well.nb_edges() ) )
-                    {
-                        ringmesh_unused( e );
-                        data << " " << std::setw( 3 ) << 2;
-                        new_line( count, 20, data );
-                    }
+                    element_types.insert( element_types.end(),
+                        geomodel.wells()->well( w ).nb_edges(), 2 );
                 }
             }
-            reset_line( count, data );
+            write_values( data,
+                static_cast< index_t >( element_types.size() ), 20,
+                [&element_types]( TextWriter& writer, index_t e ) {
+                    writer << " ";
+                    write_field( writer, element_types[e], 3 );
+                } );
 
             ascii << "# now the entities which make up each object are listed "
                      "in sequence"
@@ -304,13 +328,8 @@ namespace
                     {
                         ascii << region.name() << " " << entity_type[type]
                               << " " << mesh.cells.nb_cells( r, T ) << EOL;
-                        for( auto el : range( mesh.cells.nb_cells( r, T ) ) )
-                        {
-                            ringmesh_unused( el );
-                            ascii << cur_cell++ << " ";
-                            new_line( count, 10, ascii );
-                        }
-                        reset_line( count, ascii );
+                        write_entities(
+                            ascii, cur_cell, mesh.cells.nb_cells( r, T ) );
                     }
                 }
             }
@@ -321,26 +340,14 @@ namespace
                     ascii << interface_csmp_name( i, geomodel ) << " "
                           << "TRI_3"
                           << " " << nb_triangle_interface[i] << EOL;
-                    for( auto el : range( nb_triangle_interface[i] ) )
-                    {
-                        ringmesh_unused( el );
-                        ascii << cur_cell++ << " ";
-                        new_line( count, 10, ascii );
-                    }
-                    reset_line( count, ascii );
+                    write_entities( ascii, cur_cell, nb_triangle_interface[i] );
                 }
                 if( nb_quad_interface[i] > 0 )
                 {
                     ascii << interface_csmp_name( i, geomodel ) << " "
                           << "QUAD_4"
                           << " " << nb_quad_interface[i] << EOL;
-                    for( auto el : range( nb_quad_interface[i] ) )
-                    {
-                        ringmesh_unused( el );
-                        ascii << cur_cell++ << " ";
-                        new_line( count, 10, ascii );
-                    }
-                    reset_line( count, ascii );
+                    write_entities( ascii, cur_cell, nb_quad_interface[i] );
                 }
             }
             if( geomodel.wells() )
@@ -351,13 +358,24 @@ namespace
                     ascii << well.name() << " "
                           << "BAR_2"
                           << " " << well.nb_edges() << EOL;
-                    for( auto e : range( well.nb_edges() ) )
-                    {
-                        ringmesh_unused( e );
-                        ascii << cur_cell++ << " ";
-                        new_line( count, 10, ascii );
-                    }
-                    reset_line( count, ascii );
+                    write_entities( ascii, cur_cell, well.nb_edges() );
+                }
+            }
+
+            auto cells = ordered_cells( geomodel );
+            auto interface_polygons =
+                ordered_interface_polygons( geomodel, nb_interfaces );
+            auto nb_cells = static_cast< index_t >( cells.size() );
+            auto nb_polygons =
+                static_cast< index_t >( interface_polygons.size() );
+            auto nb_well_edges = mesh.wells.nb_edges();
+            std::vector< std::pair< index_t, index_t > > well_edges;
+            well_edges.reserve( nb_well_edges );
+            for( auto w : range( mesh.wells.nb_wells() ) )
+            {
+                for( auto e : range( mesh.wells.nb_edges( w ) ) )
+                {
+                    well_edges.emplace_back( w, e );
                 }
             }
 
@@ -367,193 +385,146 @@ namespace
                 + 6 * mesh.cells.nb_prism() + 8 * mesh.cells.nb_hex()
                 + 2 * mesh.wells.nb_edges();
             data << nb_plist << " # PLIST" << EOL;
-            for( auto r : range( geomodel.nb_regions() ) )
-            {
-                for( auto type :
-                    range( to_underlying_type( CellType::TETRAHEDRON ),
-                        to_underlying_type( CellType::UNCLASSIFIED ) ) )
-                {
-                    CellType T = static_cast< CellType >( type );
-                    RINGMesh2CSMP& descriptor =
-                        *cell_type_to_cell_descriptor[type];
-                    for( auto el : range( mesh.cells.nb_cells( r, T ) ) )
+            auto plist = gather_values< index_t >(
+                nb_cells + nb_polygons + nb_well_edges,
+                [&cells, &interface_polygons, &polygons, nb_cells,
+                    nb_polygons]( index_t e ) {
+                    if( e < nb_cells )
+                    {
+                        return cell_type_to_cell_descriptor[to_underlying_type(
+                                                                cells[e].type )]
+                            ->nb_vertices;
+                    }
+                    if( e < nb_cells + nb_polygons )
                     {
-                        index_t cell = mesh.cells.cell( r, el, T );
+                        return polygons.nb_vertices(
+                            interface_polygons[e - nb_cells] );
+                    }
+                    return index_t( 2 );
+                },
+                [&mesh, &cells, &interface_polygons, &well_edges, nb_cells,
+                    nb_polygons]( index_t e, index_t* values ) {
+                    if( e < nb_cells )
+                    {
+                        const auto& cell = cells[e];
+                        const RINGMesh2CSMP& descriptor =
+                            *cell_type_to_cell_descriptor[to_underlying_type(
+                                cell.type )];
+                        index_t cell_id = mesh.cells.cell(
+                            cell.region, cell.index, cell.type );
                         for( auto p : range( descriptor.nb_vertices ) )
                         {
                             index_t csmp_p = descriptor.vertices[p];
-                            index_t vertex_id = mesh.cells.vertex(
-                                ElementLocalVertex( cell, csmp_p ) );
-                            data << " " << std::setw( 7 ) << vertex_id;
-                            new_line( count, 10, data );
+                            values[p] = mesh.cells.vertex(
+                                ElementLocalVertex( cell_id, csmp_p ) );
                         }
                     }
-                }
-            }
-            for( auto i : range( nb_interfaces ) )
-            {
-                const GeoModelGeologicalEntity3D& interf =
-                    geomodel.geological_entity(
-                        Interface3D::type_name_static(), i );
-                for( auto s : range( interf.nb_children() ) )
-                {
-                    index_t s_id = interf.child_gmme( s ).index();
-                    for( auto el : range( polygons.nb_triangle( s_id ) ) )
+                    else if( e < nb_cells + nb_polygons )
                     {
-                        index_t tri = polygons.triangle( s_id, el );
-                        for( auto p : range( polygons.nb_vertices( tri ) ) )
+                        index_t polygon = interface_polygons[e - nb_cells];
+                        for( auto p :
+                            range( mesh.polygons.nb_vertices( polygon ) ) )
                         {
-                            index_t vertex_id =
-                                polygons.vertex( ElementLocalVertex( tri, p ) );
-                            data << " " << std::setw( 7 ) << vertex_id;
-                            new_line( count, 10, data );
+                            values[p] = mesh.polygons.vertex(
+                                ElementLocalVertex( polygon, p ) );
                         }
                     }
-                    for( auto el : range( polygons.nb_quad( s_id ) ) )
+                    else
                     {
-                        index_t quad = polygons.quad( s_id, el );
-                        for( auto p : range( polygons.nb_vertices( quad ) ) )
+                        const auto& edge =
+                            well_edges[e - nb_cells - nb_polygons];
+                        for( auto v : range( 2 ) )
                         {
-                            index_t vertex_id = polygons.vertex(
-                                ElementLocalVertex( quad, p ) );
-                            data << " " << std::setw( 7 ) << vertex_id;
-                            new_line( count, 10, data );
+                            values[v] = mesh.wells.vertex(
+                                edge.first, edge.second, v );
                         }
                     }
-                }
-            }
-            for( auto w : range( mesh.wells.nb_wells() ) )
-            {
-                for( auto e : range( mesh.wells.nb_edges( w ) ) )
-                {
-                    for( auto v : range( 2 ) )
-                    {
-                        index_t vertex_id = mesh.wells.vertex( w, e, v );
-                        data << " " << std::setw( 7 ) << vertex_id;
-                        new_line( count, 10, data );
-                    }
-                }
-            }
-            reset_line( count, data );
-
-            index_t nb_polygons =
+                } );
+            write_values( data, static_cast< index_t >( plist.size() ), 10,
+                [&plist]( TextWriter& writer, index_t i ) {
+                    writer << " ";
+                    write_field( writer, plist[i], 7 );
+                } );
+
+            index_t nb_pfverts =
                 3 * polygons.nb_triangle() + 4 * polygons.nb_quad()
                 + 4 * mesh.cells.nb_tet() + 5 * mesh.cells.nb_pyramid()
                 + 5 * mesh.cells.nb_prism() + 6 * mesh.cells.nb_hex()
                 + 2 * mesh.wells.nb_edges();
-            data << nb_polygons << " # PFVERTS" << EOL;
-            for( auto r : range( geomodel.nb_regions() ) )
-            {
-                for( auto type :
-                    range( to_underlying_type( CellType::TETRAHEDRON ),
-                        to_underlying_type( CellType::UNCLASSIFIED ) ) )
-                {
-                    CellType T = static_cast< CellType >( type );
-                    RINGMesh2CSMP& descriptor =
-                        *cell_type_to_cell_descriptor[type];
-                    for( auto el : range( mesh.cells.nb_cells( r, T ) ) )
+            data << nb_pfverts << " # PFVERTS" << EOL;
+            auto pfverts = gather_values< signed_index_t >(
+                nb_cells + nb_polygons,
+                [&cells, &interface_polygons, &polygons, nb_cells](
+                    index_t e ) {
+                    if( e < nb_cells )
                     {
-                        index_t cell = mesh.cells.cell( r, el );
-                        for( auto p : range( descriptor.nb_polygons ) )
-                        {
-                            index_t csmp_f = descriptor.polygon[p];
-                            index_t adj = mesh.cells.adjacent( cell, csmp_f );
-                            if( adj == NO_ID )
-                            {
-                                data << " " << std::setw( 7 ) << -28;
-                            }
-                            else
-                            {
-                                data << " " << std::setw( 7 ) << adj;
-                            }
-                            new_line( count, 10, data );
-                        }
+                        return cell_type_to_cell_descriptor[to_underlying_type(
+                                                                cells[e].type )]
+                            ->nb_polygons;
                     }
-                }
-            }
-            for( auto i : range( nb_interfaces ) )
-            {
-                const GeoModelGeologicalEntity3D& interf =
-                    geomodel.geological_entity(
-                        Interface3D::type_name_static(), i );
-                for( auto s : range( interf.nb_children() ) )
-                {
-                    index_t s_id = interf.child_gmme( s ).index();
-                    for( auto el : range( polygons.nb_triangle( s_id ) ) )
+                    return polygons.nb_vertices(
+                        interface_polygons[e - nb_cells] );
+                },
+                [&mesh, &cells, &interface_polygons, nb_cells](
+                    index_t e, signed_index_t* values ) {
+                    if( e < nb_cells )
                     {
-                        index_t tri = polygons.triangle( s_id, el );
-                        for( auto e : range( polygons.nb_vertices( tri ) ) )
+                        const auto& cell = cells[e];
+                        const RINGMesh2CSMP& descriptor =
+                            *cell_type_to_cell_descriptor[to_underlying_type(
+                                cell.type )];
+                        index_t cell_id =
+                            mesh.cells.cell( cell.region, cell.index );
+                        for( auto p : range( descriptor.nb_polygons ) )
                         {
-                            index_t adj =
-                                polygons.adjacent( PolygonLocalEdge( tri, e ) );
-                            if( adj == NO_ID )
-                            {
-                                data << " " << std::setw( 7 ) << -28;
-                            }
-                            else
-                            {
-                                data << " " << std::setw( 7 ) << adj;
-                            }
-                            new_line( count, 10, data );
+                            index_t csmp_f = descriptor.polygon[p];
+                            values[p] = adjacent_value(
+                                mesh.cells.adjacent( cell_id, csmp_f ) );
                         }
                     }
-                    for( auto el : range( polygons.nb_quad( s_id ) ) )
+                    else
                     {
-                        index_t quad = polygons.quad( s_id, el );
-                        for( auto e : range( polygons.nb_vertices( quad ) ) )
+                        index_t polygon = interface_polygons[e - nb_cells];
+                        for( auto p :
+                            range( mesh.polygons.nb_vertices( polygon ) ) )
                         {
-                            index_t adj = polygons.adjacent(
-                                PolygonLocalEdge( quad, e ) );
-                            if( adj == NO_ID )
-                            {
-                                data << " " << std::setw( 7 ) << -28;
-                            }
-                            else
-                            {
-                                data << " " << std::setw( 7 ) << adj;
-                            }
-                            new_line( count, 10, data );
+                            values[p] = adjacent_value( mesh.polygons.adjacent(
+                                PolygonLocalEdge( polygon, p ) ) );
                         }
                     }
-                }
-            }
+                } );
             index_t edge_offset = polygons.nb() + mesh.cells.nb();
             index_t cur_edge = 0;
             for( auto w : range( mesh.wells.nb_wells() ) )
             {
-                data << " " << std::setw( 7 ) << -28;
-                new_line( count, 10, data );
+                pfverts.push_back( -28 );
                 if( mesh.wells.nb_edges( w ) > 1 )
                 {
-                    data << " " << std::setw( 7 ) << edge_offset + cur_edge + 1;
+                    pfverts.push_back(
+                        adjacent_value( edge_offset + cur_edge + 1 ) );
                     cur_edge++;
-                    new_line( count, 10, data );
                     for( index_t e = 1; e < mesh.wells.nb_edges( w ) - 1;
                          e++, cur_edge++ )
                     {
-                        data << " " << std::setw( 7 )
-                             << edge_offset + cur_edge - 1;
-                        new_line( count, 10, data );
-                        data << " " << std::setw( 7 )
-                             << edge_offset + cur_edge + 1;
-                        new_line( count, 10, data );
+                        pfverts.push_back(
+                            adjacent_value( edge_offset + cur_edge - 1 ) );
+                        pfverts.push_back(
+                            adjacent_value( edge_offset + cur_edge + 1 ) );
                     }
-                    data << " " << std::setw( 7 ) << edge_offset + cur_edge - 1;
-                    new_line( count, 10, data );
+                    pfverts.push_back(
+                        adjacent_value( edge_offset + cur_edge - 1 ) );
                 }
-                data << " " << std::setw( 7 ) << -28;
+                pfverts.push_back( -28 );
                 cur_edge++;
-                new_line( count, 10, data );
             }
-            reset_line( count, data );
+            write_values( data, static_cast< index_t >( pfverts.size() ), 10,
+                [&pfverts]( TextWriter& writer, index_t i ) {
+                    writer << " ";
+                    write_field( writer, pfverts[i], 7 );
+                } );
 
             data << nb_total_entities << " # PMATERIAL" << EOL;
-            for( auto i : range( nb_total_entities ) )
-            {
-                ringmesh_unused( i );
-                data << " " << std::setw( 3 ) << 0;
-                new_line( count, 20, data );
-            }
+            write_values( data, nb_total_entities, 20, write_zero, false );
 
             ascii << std::flush;
             data << std::flush;
@@ -561,24 +532,136 @@ namespace
         }
 
     private:
-        void new_line(
-            index_t& count, index_t number_of_counts, std::ofstream& out ) const
+        /*!
+         * A cell of a region given by its index among the cells of its type
+         */
+        struct CSMPCell
+        {
+            index_t region;
+            index_t index;
+            CellType type;
+        };
+
+        /*!
+         * @brief Writes values in lines of @p nb_values_per_line values
+         * @details The lines are formatted in parallel.
+         * @param[in] format function formatting one value,
+         * its signature is void( TextWriter&, index_t )
+         * @param[in] end_last_line if false, the last line is not ended
+         * when it is incomplete
+         */
+        template < typename FORMAT >
+        void write_values( std::ostream& out,
+            index_t nb_values,
+            index_t nb_values_per_line,
+            const FORMAT& format,
+            bool end_last_line = true ) const
+        {
+            auto nb_lines =
+                ( nb_values + nb_values_per_line - 1 ) / nb_values_per_line;
+            parallel_write_text( out, nb_lines,
+                [nb_values, nb_values_per_line, &format, end_last_line](
+                    TextWriter& writer, index_t line ) {
+                    auto start = line * nb_values_per_line;
+                    auto end =
+                        std::min( start + nb_values_per_line, nb_values );
+                    for( auto value : range( start, end ) )
+                    {
+                        format( writer, value );
+                    }
+                    if( end_last_line || end - start == nb_values_per_line )
+                    {
+                        writer << EOL;
+                    }
+                } );
+        }
+
+        static void write_zero( TextWriter& writer, index_t )
+        {
+            writer << " ";
+            write_field( writer, 0, 3 );
+        }
+
+        /*!
+         * @brief Writes the indices of the @p nb_entities entities
+         * starting at @p cur_entity, and increments it
+         */
+        void write_entities(
+            std::ostream& out, index_t& cur_entity, index_t nb_entities ) const
         {
-            count++;
-            if( count == number_of_counts )
+            auto first = cur_entity;
+            write_values( out, nb_entities, 10,
+                [first]( TextWriter& writer, index_t e ) {
+                    writer << first + e << " ";
+                } );
+            cur_entity += nb_entities;
+        }
+
+        static signed_index_t adjacent_value( index_t adjacent )
+        {
+            if( adjacent == NO_ID )
             {
-                count = 0;
-                out << EOL;
+                return -28;
             }
+            return static_cast< signed_index_t >( adjacent );
         }
-        void reset_line( index_t& count, std::ofstream& out ) const
+
+        /*!
+         * @brief Lists the cells region by region then type by type
+         */
+        std::vector< CSMPCell > ordered_cells(
+            const GeoModel3D& geomodel ) const
         {
-            if( count != 0 )
+            const GeoModelMesh3D& mesh = geomodel.mesh;
+            std::vector< CSMPCell > cells;
+            cells.reserve( mesh.cells.nb() );
+            for( auto r : range( geomodel.nb_regions() ) )
             {
-                count = 0;
-                out << EOL;
+                for( auto type :
+                    range( to_underlying_type( CellType::TETRAHEDRON ),
+                        to_underlying_type( CellType::UNCLASSIFIED ) ) )
+                {
+                    CellType T = static_cast< CellType >( type );
+                    for( auto el : range( mesh.cells.nb_cells( r, T ) ) )
+                    {
+                        cells.push_back( { r, el, T } );
+                    }
+                }
             }
+            return cells;
         }
+
+        /*!
+         * @brief Lists the polygons interface by interface, the triangles
+         * of each surface being before its quads
+         */
+        std::vector< index_t > ordered_interface_polygons(
+            const GeoModel3D& geomodel, index_t nb_interfaces ) const
+        {
+            const GeoModelMeshPolygons3D& polygons = geomodel.mesh.polygons;
+            std::vector< index_t > result;
+            result.reserve( polygons.nb() );
+            for( auto i : range( nb_interfaces ) )
+            {
+                const GeoModelGeologicalEntity3D& interf =
+                    geomodel.geological_entity(
+                        Interface3D::type_name_static(), i );
+                for( auto s : range( interf.nb_children() ) )
+                {
+                    index_t s_id = interf.child_gmme( s ).index();
+                    for( auto el : range( polygons.nb_triangle( s_id ) ) )
+                    {
+                        result.push_back( polygons.triangle( s_id, el ) );
+                    }
+                    for( auto el : range( polygons.nb_quad( s_id ) ) )
+                    {
+                        result.push_back( polygons.quad( s_id, el ) );
+                    }
+                }
+            }
+            return result;
+        }
+
         void clear()
         {
             point_boundaries_.clear();
@@ -782,24 +865,21 @@ namespace
                 corner_boundary_flags_[front_bottom_right] = -11;
             }
 
-            point_boundaries_.resize( gm.mesh.vertices.nb() );
-            for( const auto& surface : gm.surfaces() )
-            {
-                index_t interface_id = surface.parent_gmge( 0 ).index();
-                for( auto p :
-                    range( gm.mesh.polygons.nb_polygons( surface.index() ) ) )
+            const GeoModelMeshVertices3D& vertices = gm.mesh.vertices;
+            point_boundaries_.resize( vertices.nb() );
+            parallel_for( vertices.nb(), [&gm, &vertices, this]( index_t v ) {
+                for( const auto& gme_vertex : vertices.gme_vertices( v ) )
                 {
-                    index_t p_id =
-                        gm.mesh.polygons.polygon( surface.index(), p );
-                    for( auto v :
-                        range( gm.mesh.polygons.nb_vertices( p_id ) ) )
+                    if( gme_vertex.gmme.type()
+                        == Surface3D::type_name_static() )
                     {
-                        index_t vertex_id = gm.mesh.polygons.vertex(
-                            ElementLocalVertex( p_id, v ) );
-                        point_boundaries_[vertex_id].insert( interface_id );
+                        const auto& surface =
+                            gm.surface( gme_vertex.gmme.index() );
+                        point_boundaries_[v].insert(
+                            surface.parent_gmge( 0 ).index() );
                     }
                 }
-            }
+            } );
         }
         std::string interface_csmp_name(
             index_t i, const GeoModel3D& geomodel ) const
@@ -147,38 +147,39 @@ namespace
             out << SPACE << min_nb_vertices_per_element << SPACE
                 << max_nb_vertices_per_element << "\n";
 
-            for( auto c : range( cells.nb() ) )
-            {
-                const RINGMesh2Feflow& descriptor =
-                    *cell_type_to_feflow_cell_descriptor[to_underlying_type(
-                        cells.type( c ) )];
-                out << SPACE << descriptor.entity_type;
-                for( auto v : range( cells.nb_vertices( c ) ) )
-                {
-                    out << SPACE
-                        << cells.vertex(
-                               ElementLocalVertex( c, descriptor.vertices[v] ) )
-                               + STARTING_OFFSET;
-                }
-                out << "\n";
-            }
+            parallel_write_text(
+                out, cells.nb(), [&cells]( TextWriter& text, index_t c ) {
+                    const RINGMesh2Feflow& descriptor =
+                        *cell_type_to_feflow_cell_descriptor
+                            [to_underlying_type( cells.type( c ) )];
+                    text << SPACE << descriptor.entity_type;
+                    for( auto v : range( cells.nb_vertices( c ) ) )
+                    {
+                        text << SPACE
+                             << cells.vertex( ElementLocalVertex(
+                                    c, descriptor.vertices[v] ) )
+                                    + STARTING_OFFSET;
+                    }
+                    text << "\n";
+                } );
         }
         void write_vertices(
             const GeoModel3D& geomodel, std::ofstream& out ) const
         {
             const GeoModelMeshVertices3D& vertices = geomodel.mesh.vertices;
-            out << "XYZCOOR\n" << std::scientific;
-            for( auto v : range( vertices.nb() ) )
-            {
-                const vec3& point = vertices.vertex( v );
-                std::string sep = "";
-                for( auto i : range( 3 ) )
-                {
-                    out << sep << SPACE << point[i];
-                    sep = ",";
-                }
-                out << "\n";
-            }
+            out << "XYZCOOR\n";
+            parallel_write_text( out, vertices.nb(),
+                [&vertices]( TextWriter& text, index_t v ) {
+                    const vec3& point = vertices.vertex( v );
+                    std::string sep = "";
+                    for( auto i : range( 3 ) )
+                    {
+                        text << sep << SPACE << point[i];
+                        sep = ",";
+                    }
+                    text << "\n";
+                },
+                16, true );
             out << std::fixed;
         }
         void write_regions(
@@ -38,7 +38,179 @@ namespace
     using namespace RINGMesh;
 
     template < index_t >
-    class GeoModelBuilderGM;
+    class GeoModelBuilderGMBase;
+
+    /// Extension of the mesh entity files saved with MeshBase::save_mesh
+    const std::string MESH_ENTITY_EXTENSION{ "rmsh" };
+
+    /// Version of the written files, the entity meshes are .rmsh files
+    /// since version 3
+    const index_t GM_FILE_VERSION{ 3 };
+
+    /*!
+     * @brief Reads the lines and fields of a file uncompressed in memory.
+     * It provides the subset of the GEO::LineInput interface used to parse
+     * the .gm text files.
+     */
+    class BufferLineInput
+    {
+    public:
+        explicit BufferLineInput( std::vector< char > buffer )
+            : buffer_( std::move( buffer ) )
+        {
+        }
+
+        bool eof() const
+        {
+            return position_ >= buffer_.size();
+        }
+
+        bool get_line()
+        {
+            if( eof() )
+            {
+                return false;
+            }
+            auto begin =
+                buffer_.begin()
+                + static_cast< std::vector< char >::difference_type >(
+                      position_ );
+            auto end = std::find( begin, buffer_.end(), '\n' );
+            line_.assign( begin, end );
+            position_ = static_cast< std::size_t >( end - buffer_.begin() ) + 1;
+            line_number_++;
+            return true;
+        }
+
+        void get_fields()
+        {
+            fields_.clear();
+            std::istringstream line{ line_ };
+            std::string field;
+            while( line >> field )
+            {
+                fields_.push_back( field );
+            }
+        }
+
+        index_t nb_fields() const
+        {
+            return static_cast< index_t >( fields_.size() );
+        }
+
+        const char* field( index_t f ) const
+        {
+            ringmesh_assert( f < nb_fields() );
+            return fields_[f].c_str();
+        }
+
+        index_t field_as_uint( index_t f ) const
+        {
+            index_t value{ NO_ID };
+            if( !GEO::String::from_string( field( f ), value ) )
+            {
+                throw RINGMeshException( "I/O", "Invalid line: ", line_number_,
+                    ", field ", f, " is not an unsigned integer" );
+            }
+            return value;
+        }
+
+        bool field_matches( index_t f, const char* s ) const
+        {
+            return fields_[f] == s;
+        }
+
+        index_t line_number() const
+        {
+            return line_number_;
+        }
+
+    private:
+        std::vector< char > buffer_;
+        std::size_t position_{ 0 };
+        std::string line_;
+        std::vector< std::string > fields_;
+        index_t line_number_{ 0 };
+    };
+
+    /*!
+     * @brief Compressed mesh of a GeoModelMeshEntity read in a .gm file
+     */
+    struct MeshEntityEntry
+    {
+        gmme_id entity;
+        CompressedFile file;
+    };
+
+    /*!
+     * @brief Mesh of a GeoModelMeshEntity stored in a file, either
+     * serialized in memory or, for old archives, extracted in a file
+     */
+    struct MeshEntitySource
+    {
+        template < index_t DIMENSION >
+        void load( MeshBaseBuilder< DIMENSION >& builder ) const
+        {
+            if( filename.empty() )
+            {
+                builder.load_mesh( data, size );
+            }
+            else
+            {
+                builder.load_mesh( filename );
+            }
+        }
+
+        const char* data{ nullptr };
+        std::size_t size{ 0 };
+        std::string filename;
+    };
+
+    /*!
+     * @brief Loads on demand the entity meshes of a .gm file.
+     * The meshes are kept compressed in memory until they are accessed.
+     */
+    template < index_t DIMENSION >
+    class GeoModelMeshEntityLoaderGM final
+        : public GeoModelMeshEntityLoader< DIMENSION >
+    {
+    public:
+        explicit GeoModelMeshEntityLoaderGM(
+            std::vector< CompressedFile > files )
+            : files_( std::move( files ) )
+        {
+        }
+
+    private:
+        void load_mesh(
+            index_t source, MeshBase< DIMENSION >& mesh ) const final
+        {
+            auto content = uncompress_file_content( files_[source] );
+            MeshEntitySource entity_source;
+            entity_source.data = content.data();
+            entity_source.size = content.size();
+            entity_source.load(
+                *MeshBaseBuilder< DIMENSION >::create_builder( mesh ) );
+        }
+
+    private:
+        std::vector< CompressedFile > files_;
+    };
+
+    /*!
+     * @brief Gets the GeoModelMeshEntity saved in a file named by
+     * build_string_for_geomodel_entity_export
+     */
+    gmme_id mesh_entity_from_file_name( const std::string& file_name )
+    {
+        auto file_without_extension = GEO::FileSystem::base_name( file_name );
+        std::string entity_type, entity_id;
+        GEO::String::split_string(
+            file_without_extension, '_', entity_type, entity_id );
+        index_t id{ NO_ID };
+        GEO::String::from_string( entity_id, id );
+        return { MeshEntityType{ entity_type }, id };
+    }
 
     bool match_mesh_entity_type( const MeshEntityType& type )
     {
@@ -57,17 +229,17 @@ namespace
     class GeoModelBuilderGMImpl
     {
     public:
-        GeoModelBuilderGMImpl( GeoModelBuilderGM< DIMENSION >& builder,
+        GeoModelBuilderGMImpl( GeoModelBuilderGMBase< DIMENSION >& builder,
             GeoModel< DIMENSION >& geomodel )
             : builder_( builder ), geomodel_( geomodel )
         {
         }
         virtual ~GeoModelBuilderGMImpl() = default;
 
-        virtual void read_mesh_entity_line( GEO::LineInput& file_line ) = 0;
+        virtual void read_mesh_entity_line( BufferLineInput& file_line ) = 0;
 
     protected:
-        GeoModelBuilderGM< DIMENSION >& builder_;
+        GeoModelBuilderGMBase< DIMENSION >& builder_;
         GeoModel< DIMENSION >& geomodel_;
     };
 
@@ -75,14 +247,14 @@ namespace
     class GeoModelBuilderGMImpl_0 : public GeoModelBuilderGMImpl< DIMENSION >
     {
     public:
-        GeoModelBuilderGMImpl_0( GeoModelBuilderGM< DIMENSION >& builder,
+        GeoModelBuilderGMImpl_0( GeoModelBuilderGMBase< DIMENSION >& builder,
             GeoModel< DIMENSION >& geomodel )
             : GeoModelBuilderGMImpl< DIMENSION >( builder, geomodel )
         {
         }
         virtual ~GeoModelBuilderGMImpl_0() = default;
 
-        void read_mesh_entity_line( GEO::LineInput& file_line ) override
+        void read_mesh_entity_line( BufferLineInput& file_line ) override
         {
             // First line : type - id - name - geol_feature
             if( file_line.nb_fields() < 4 )
@@ -97,7 +269,7 @@ namespace
         }
 
     protected:
-        virtual gmme_id read_first_line( GEO::LineInput& file_line )
+        virtual gmme_id read_first_line( BufferLineInput& file_line )
         {
             gmme_id cur_gmme{ MeshEntityType{ file_line.field( 0 ) },
                 file_line.field_as_uint( 1 ) };
@@ -106,21 +278,21 @@ namespace
             return cur_gmme;
         }
         void read_second_line(
-            GEO::LineInput& file_line, const gmme_id& entity );
+            BufferLineInput& file_line, const gmme_id& entity );
     };
 
     template < index_t DIMENSION >
     class GeoModelBuilderGMImpl_1 : public GeoModelBuilderGMImpl_0< DIMENSION >
     {
     public:
-        GeoModelBuilderGMImpl_1( GeoModelBuilderGM< DIMENSION >& builder,
+        GeoModelBuilderGMImpl_1( GeoModelBuilderGMBase< DIMENSION >& builder,
             GeoModel< DIMENSION >& geomodel )
             : GeoModelBuilderGMImpl_0< DIMENSION >( builder, geomodel )
         {
         }
         virtual ~GeoModelBuilderGMImpl_1() = default;
 
-        void read_mesh_entity_line( GEO::LineInput& file_line ) override
+        void read_mesh_entity_line( BufferLineInput& file_line ) override
         {
             // Read this entity
             // First line : type - id - name - geol_feature - mesh type
@@ -171,14 +343,14 @@ namespace
     class GeoModelBuilderGMImpl_2 : public GeoModelBuilderGMImpl_1< DIMENSION >
     {
     public:
-        GeoModelBuilderGMImpl_2( GeoModelBuilderGM< DIMENSION >& builder,
+        GeoModelBuilderGMImpl_2( GeoModelBuilderGMBase< DIMENSION >& builder,
             GeoModel< DIMENSION >& geomodel )
             : GeoModelBuilderGMImpl_1< DIMENSION >( builder, geomodel )
         {
         }
         virtual ~GeoModelBuilderGMImpl_2() = default;
 
-        void read_mesh_entity_line( GEO::LineInput& file_line ) override
+        void read_mesh_entity_line( BufferLineInput& file_line ) override
         {
             // Read this entity
             // First line : type - id - name  - mesh type
@@ -199,12 +371,17 @@ namespace
         }
     };
 
+    /*!
+     * @brief Builds a GeoModel from the files saved by GeoModelHandlerGM:
+     * the topology text files and the serialized meshes of the entities.
+     * Derived classes read these files from their container.
+     */
     template < index_t DIMENSION >
-    class GeoModelBuilderGM final : public GeoModelBuilderFile< DIMENSION >
+    class GeoModelBuilderGMBase : public GeoModelBuilderFile< DIMENSION >
     {
     public:
-        static const index_t NB_VERSION = 3;
-        GeoModelBuilderGM(
+        static const index_t NB_VERSION = GM_FILE_VERSION + 1;
+        GeoModelBuilderGMBase(
             GeoModel< DIMENSION >& geomodel, std::string filename )
             : GeoModelBuilderFile< DIMENSION >(
                   geomodel, std::move( filename ) )
@@ -215,14 +392,47 @@ namespace
                 new GeoModelBuilderGMImpl_1< DIMENSION >( *this, geomodel ) );
             version_impl_[2].reset(
                 new GeoModelBuilderGMImpl_2< DIMENSION >( *this, geomodel ) );
+            // Version 3 only changes the format of the entity mesh files
+            version_impl_[3].reset(
+                new GeoModelBuilderGMImpl_2< DIMENSION >( *this, geomodel ) );
+        }
+        virtual ~GeoModelBuilderGMBase() = default;
+
+        /*!
+         * @brief Defers the loading of the entity meshes until their first
+         * access
+         */
+        void defer_mesh_loading()
+        {
+            mesh_loading_deferred_ = true;
+        }
+
+    protected:
+        bool is_mesh_loading_deferred() const
+        {
+            return mesh_loading_deferred_;
+        }
+
+        /*!
+         * @brief Gives the entity meshes to load to a loader
+         * @param[in] loader the loader
+         * @param[in] entities the entity of each source of the \p loader
+         */
+        void set_mesh_entity_loader(
+            std::shared_ptr< GeoModelMeshEntityLoader< DIMENSION > > loader,
+            const std::vector< gmme_id >& entities )
+        {
+            for( auto source : range( entities.size() ) )
+            {
+                this->geometry.defer_mesh_loading(
+                    entities[source], loader, source );
+            }
         }
-        virtual ~GeoModelBuilderGM() = default;
 
-    private:
         void load_geological_entities(
-            const std::string& geological_entity_file )
+            std::vector< char > geological_entity_file )
         {
-            GEO::LineInput file_line{ geological_entity_file };
+            BufferLineInput file_line{ std::move( geological_entity_file ) };
             while( !file_line.eof() && file_line.get_line() )
             {
                 file_line.get_fields();
@@ -269,107 +479,13 @@ namespace
             }
         }
 
-        /*!
-         * @brief Load meshes of all the mesh entities from a zip file
-         * @param[in] uz the zip file
-         */
-        void load_meshes( UnZipFile& uz )
-        {
-            uz.start_extract();
-
-            Logger::instance()->set_minimal( true );
-            std::vector< std::future< void > > files;
-            do
-            {
-                if( GEO::FileSystem::extension( uz.get_current_filename() )
-                    == "txt" )
-                {
-                    continue;
-                }
-
-                const auto file_name = uz.get_current_file();
-                files.push_back(
-                    std::async( std::launch::deferred, [file_name, this] {
-                        auto file_without_extension =
-                            GEO::FileSystem::base_name( file_name );
-                        std::string entity_type, entity_id;
-                        GEO::String::split_string( file_without_extension, '_',
-                            entity_type, entity_id );
-                        index_t id{ NO_ID };
-                        GEO::String::from_string( entity_id, id );
-                        load_mesh_entity(
-                            MeshEntityType{ entity_type }, file_name, id );
-                        GEO::FileSystem::delete_file( file_name );
-                    } ) );
-            } while( uz.next_file() );
-
-            for( auto& file : files )
-            {
-                file.wait();
-            }
-            Logger::instance()->set_minimal( false );
-        }
-
         void load_mesh_entity( const MeshEntityType& entity_type,
-            const std::string& file_name,
+            const MeshEntitySource& source,
             index_t id );
 
-        bool load_mesh_entity_base( const MeshEntityType& entity_type,
-            const std::string& file_name,
-            index_t id )
+        void load_mesh_entities( std::vector< char > mesh_entity_file )
         {
-            const auto& manager =
-                this->geomodel_.entity_type_manager().mesh_entity_manager;
-            if( manager.is_corner( entity_type ) )
-            {
-                auto builder = this->geometry.create_corner_builder( id );
-                builder->load_mesh( file_name );
-                return true;
-            }
-            else if( manager.is_line( entity_type ) )
-            {
-                auto builder = this->geometry.create_line_builder( id );
-                builder->load_mesh( file_name );
-                return true;
-            }
-            else if( manager.is_surface( entity_type ) )
-            {
-                auto builder = this->geometry.create_surface_builder( id );
-                builder->load_mesh( file_name );
-                return true;
-            }
-            return false;
-        }
-
-        void load_file() final
-        {
-            const std::string directory_to_unzip{
-                GEO::FileSystem::normalized_path(
-                    GEO::FileSystem::dir_name( this->filename() ) )
-                + "/" + std::to_string(
-                            std::hash< std::string >()( this->filename() ) )
-            };
-            UnZipFile uz{ this->filename(), directory_to_unzip };
-
-            const auto mesh_entity_file = uz.get_file( "mesh_entities.txt" );
-            load_mesh_entities( mesh_entity_file );
-            auto ok = GEO::FileSystem::delete_file( mesh_entity_file );
-            ringmesh_unused( ok ); // avoids warning in release
-            ringmesh_assert( ok );
-            load_meshes( uz );
-
-            const auto geological_entity_file =
-                uz.get_file( "geological_entities.txt" );
-            load_geological_entities( geological_entity_file );
-            ok = GEO::FileSystem::delete_file( geological_entity_file );
-            ringmesh_assert( ok );
-
-            GEO::FileSystem::delete_directory( directory_to_unzip );
-        }
-
-        void load_mesh_entities( const std::string& mesh_entity_file )
-        {
-            GEO::LineInput file_line{ mesh_entity_file };
+            BufferLineInput file_line{ std::move( mesh_entity_file ) };
             while( !file_line.eof() && file_line.get_line() )
             {
                 file_line.get_fields();
@@ -378,6 +494,13 @@ namespace
                     if( file_line.field_matches( 0, "Version" ) )
                     {
                         file_version_ = file_line.field_as_uint( 1 );
+                        if( file_version_ >= NB_VERSION )
+                        {
+                            throw RINGMeshException( "I/O", "The file ",
+                                this->filename(), " has the version ",
+                                file_version_, ", the last supported ",
+                                "version is ", GM_FILE_VERSION );
+                        }
                     }
                     // Name of the geomodel
                     else if( file_line.field_matches( 0, "GeoModel" ) )
@@ -407,40 +530,183 @@ namespace
             }
         }
 
-        void load_region_if_entity_is_region( const std::string& entity_type,
-            index_t id,
-            const std::string& file_name,
-            const MeshEntityTypeManager< DIMENSION >& manager );
+    private:
+        bool load_mesh_entity_base( const MeshEntityType& entity_type,
+            const MeshEntitySource& source,
+            index_t id )
+        {
+            const auto& manager =
+                this->geomodel_.entity_type_manager().mesh_entity_manager;
+            if( manager.is_corner( entity_type ) )
+            {
+                auto builder = this->geometry.create_corner_builder( id );
+                source.load( *builder );
+                return true;
+            }
+            else if( manager.is_line( entity_type ) )
+            {
+                auto builder = this->geometry.create_line_builder( id );
+                source.load( *builder );
+                return true;
+            }
+            else if( manager.is_surface( entity_type ) )
+            {
+                auto builder = this->geometry.create_surface_builder( id );
+                source.load( *builder );
+                return true;
+            }
+            return false;
+        }
 
     private:
         index_t file_version_{ 0 };
         std::unique_ptr< GeoModelBuilderGMImpl< DIMENSION > >
             version_impl_[NB_VERSION];
+        bool mesh_loading_deferred_{ false };
+    };
+
+    template < index_t DIMENSION >
+    class GeoModelBuilderGM final : public GeoModelBuilderGMBase< DIMENSION >
+    {
+    public:
+        GeoModelBuilderGM(
+            GeoModel< DIMENSION >& geomodel, std::string filename )
+            : GeoModelBuilderGMBase< DIMENSION >(
+                  geomodel, std::move( filename ) )
+        {
+        }
+        virtual ~GeoModelBuilderGM() = default;
+
+    private:
+        /*!
+         * @brief Load meshes of all the mesh entities from a zip file
+         * @details The archive is read sequentially, then the entity meshes
+         * are uncompressed and built in parallel since each one only
+         * modifies its own GeoModelMeshEntity.
+         * @param[in] uz the zip file
+         */
+        void load_meshes( UnZipFile& uz )
+        {
+            std::vector< MeshEntityEntry > entries;
+            uz.start_extract();
+
+            Logger::instance()->set_minimal( true );
+            do
+            {
+                const auto file_name = uz.get_current_filename();
+                const auto extension = GEO::FileSystem::extension( file_name );
+                if( extension == "txt" )
+                {
+                    continue;
+                }
+
+                const auto entity = mesh_entity_from_file_name( file_name );
+                if( extension == MESH_ENTITY_EXTENSION )
+                {
+                    entries.push_back(
+                        { entity, uz.get_current_compressed_file() } );
+                }
+                else
+                {
+                    // Old archives store files readable by geogram only
+                    MeshEntitySource source;
+                    source.filename = uz.get_current_file();
+                    this->load_mesh_entity(
+                        entity.type(), source, entity.index() );
+                    GEO::FileSystem::delete_file( source.filename );
+                }
+            } while( uz.next_file() );
+
+            if( this->is_mesh_loading_deferred() )
+            {
+                defer_meshes_loading( std::move( entries ) );
+            }
+            else
+            {
+                load_mesh_entries( entries );
+            }
+            Logger::instance()->set_minimal( false );
+        }
+
+        void load_mesh_entries( std::vector< MeshEntityEntry >& entries )
+        {
+            parallel_for( static_cast< index_t >( entries.size() ),
+                [&entries, this]( index_t i ) {
+                    auto& entry = entries[i];
+                    auto content = uncompress_file_content( entry.file );
+                    std::vector< char >().swap( entry.file.data );
+                    MeshEntitySource source;
+                    source.data = content.data();
+                    source.size = content.size();
+                    this->load_mesh_entity(
+                        entry.entity.type(), source, entry.entity.index() );
+                } );
+        }
+
+        void defer_meshes_loading( std::vector< MeshEntityEntry > entries )
+        {
+            std::vector< gmme_id > entities;
+            entities.reserve( entries.size() );
+            std::vector< CompressedFile > files;
+            files.reserve( entries.size() );
+            for( auto& entry : entries )
+            {
+                entities.push_back( entry.entity );
+                files.push_back( std::move( entry.file ) );
+            }
+            this->set_mesh_entity_loader(
+                std::make_shared< GeoModelMeshEntityLoaderGM< DIMENSION > >(
+                    std::move( files ) ),
+                entities );
+        }
+
+        void load_file() final
+        {
+            // The directory is only created to extract old archives
+            const std::string directory_to_unzip{
+                GEO::FileSystem::normalized_path(
+                    GEO::FileSystem::dir_name( this->filename() ) )
+                + "/" + std::to_string(
+                            std::hash< std::string >()( this->filename() ) )
+            };
+            UnZipFile uz{ this->filename(), directory_to_unzip };
+
+            this->load_mesh_entities(
+                uz.get_file_content( "mesh_entities.txt" ) );
+            load_meshes( uz );
+            this->load_geological_entities(
+                uz.get_file_content( "geological_entities.txt" ) );
+
+            if( GEO::FileSystem::is_directory( directory_to_unzip ) )
+            {
+                GEO::FileSystem::delete_directory( directory_to_unzip );
+            }
+        }
     };
 
     template <>
-    void GeoModelBuilderGM< 2 >::load_mesh_entity(
+    void GeoModelBuilderGMBase< 2 >::load_mesh_entity(
         const MeshEntityType& entity_type,
-        const std::string& file_name,
+        const MeshEntitySource& source,
         index_t id )
     {
-        load_mesh_entity_base( entity_type, file_name, id );
+        load_mesh_entity_base( entity_type, source, id );
     }
 
     template <>
-    void GeoModelBuilderGM< 3 >::load_mesh_entity(
+    void GeoModelBuilderGMBase< 3 >::load_mesh_entity(
         const MeshEntityType& entity_type,
-        const std::string& file_name,
+        const MeshEntitySource& source,
         index_t id )
     {
-        if( !load_mesh_entity_base( entity_type, file_name, id ) )
+        if( !load_mesh_entity_base( entity_type, source, id ) )
         {
             const auto& manager =
                 this->geomodel_.entity_type_manager().mesh_entity_manager;
             if( manager.is_region( entity_type ) )
             {
                 auto builder = geometry.create_region_builder( id );
-                builder->load_mesh( file_name );
+                source.load( *builder );
             }
         }
     }
@@ -451,7 +717,7 @@ namespace
      */
     template < index_t DIMENSION >
     void save_geological_entity(
-        std::ofstream& out, const GeoModelGeologicalEntity< DIMENSION >& E )
+        std::ostream& out, const GeoModelGeologicalEntity< DIMENSION >& E )
     {
         /// First line:  TYPE - ID - NAME - GEOL
         out << E.gmge() << " " << E.name() << " ";
@@ -468,22 +734,14 @@ namespace
     }
 
     /*!
-     * @brief Save the connectivity of a GeoModel in a file
-     * @param[in] M the GeoModel
-     * @param[in] file_name path to the input file
+     * @brief Save the connectivity of a GeoModel in a stream
+     * @param[in] geomodel the GeoModel
+     * @param[in] out the output stream
      */
     template < index_t DIMENSION >
     void save_geological_entities(
-        const GeoModel< DIMENSION >& geomodel, const std::string& file_name )
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out )
     {
-        std::ofstream out{ file_name.c_str() };
-        out.precision( 16 );
-        if( out.bad() )
-        {
-            throw RINGMeshException(
-                "I/O", "Error when opening the file: ", file_name );
-        }
-
         if( geomodel.nb_geological_entity_types() == 0 )
         {
             // Compression of an empty files crashes ? (in debug on windows at
@@ -512,7 +770,7 @@ namespace
 
     template < typename ENTITY, index_t DIMENSION >
     void save_mesh_entities_of_type(
-        const GeoModel< DIMENSION >& geomodel, std::ofstream& out )
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out )
     {
         const MeshEntityType& type = ENTITY::type_name_static();
         for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
@@ -530,22 +788,22 @@ namespace
         }
     }
 
-    void save_dimension( index_t dimension, std::ofstream& out )
+    void save_dimension( index_t dimension, std::ostream& out )
     {
         out << "Dimension " << dimension << EOL;
     }
 
     template < index_t DIMENSION >
     void save_version_and_name(
-        const GeoModel< DIMENSION >& geomodel, std::ofstream& out )
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out )
     {
-        out << "Version 2" << EOL;
+        out << "Version " << GM_FILE_VERSION << EOL;
         out << "GeoModel name " << geomodel.name() << EOL;
     }
 
     template < index_t DIMENSION >
     void save_number_of_mesh_entities_base(
-        const GeoModel< DIMENSION >& geomodel, std::ofstream& out )
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out )
     {
         // Numbers of the different types of mesh entities
         out << "Nb " << Corner< DIMENSION >::type_name_static() << " "
@@ -558,18 +816,18 @@ namespace
 
     template < index_t DIMENSION >
     void save_number_of_mesh_entities(
-        const GeoModel< DIMENSION >& M, std::ofstream& out );
+        const GeoModel< DIMENSION >& M, std::ostream& out );
 
     template <>
     void save_number_of_mesh_entities(
-        const GeoModel2D& geomodel, std::ofstream& out )
+        const GeoModel2D& geomodel, std::ostream& out )
     {
         save_number_of_mesh_entities_base( geomodel, out );
     }
 
     template <>
     void save_number_of_mesh_entities(
-        const GeoModel3D& geomodel, std::ofstream& out )
+        const GeoModel3D& geomodel, std::ostream& out )
     {
         save_number_of_mesh_entities_base( geomodel, out );
         out << "Nb " << Region< 3 >::type_name_static() << " "
@@ -578,11 +836,11 @@ namespace
 
     template < index_t DIMENSION >
     void save_mesh_entities_topology_and_sides(
-        const GeoModel< DIMENSION >& geomodel, std::ofstream& out );
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out );
 
     template < template < index_t > class ENTITY, index_t DIMENSION >
     void save_mesh_entities_topology_and_sides_impl(
-        const GeoModel< DIMENSION >& geomodel, std::ofstream& out )
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out )
     {
         for( auto i : range( geomodel.nb_mesh_entities(
                  ENTITY< DIMENSION >::type_name_static() ) ) )
@@ -612,21 +870,21 @@ namespace
 
     template <>
     void save_mesh_entities_topology_and_sides(
-        const GeoModel2D& geomodel, std::ofstream& out )
+        const GeoModel2D& geomodel, std::ostream& out )
     {
         save_mesh_entities_topology_and_sides_impl< Surface >( geomodel, out );
     }
 
     template <>
     void save_mesh_entities_topology_and_sides(
-        const GeoModel3D& geomodel, std::ofstream& out )
+        const GeoModel3D& geomodel, std::ostream& out )
     {
         save_mesh_entities_topology_and_sides_impl< Region >( geomodel, out );
     }
 
     template < index_t DIMENSION >
     void save_mesh_entities_topology_base(
-        const GeoModel< DIMENSION >& geomodel, std::ofstream& out )
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out )
     {
         save_mesh_entities_of_type< Corner< DIMENSION > >( geomodel, out );
         save_mesh_entities_of_type< Line< DIMENSION > >( geomodel, out );
@@ -634,38 +892,31 @@ namespace
 
     template < index_t DIMENSION >
     void save_mesh_entities_topology(
-        const GeoModel< DIMENSION >& geomodel, std::ofstream& out );
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out );
 
     template <>
     void save_mesh_entities_topology(
-        const GeoModel2D& geomodel, std::ofstream& out )
+        const GeoModel2D& geomodel, std::ostream& out )
     {
         save_mesh_entities_topology_base( geomodel, out );
     }
     template <>
     void save_mesh_entities_topology(
-        const GeoModel3D& geomodel, std::ofstream& out )
+        const GeoModel3D& geomodel, std::ostream& out )
     {
         save_mesh_entities_topology_base( geomodel, out );
         save_mesh_entities_of_type< Surface3D >( geomodel, out );
     }
 
     /*!
-     * @brief Save the topology of a GeoModelin a file
+     * @brief Save the topology of a GeoModel in a stream
      * @param[in] geomodel the GeoModel
-     * @param[in] file_name the output file name
+     * @param[in] out the output stream
      */
     template < index_t DIMENSION >
     void save_mesh_entities(
-        const GeoModel< DIMENSION >& geomodel, const std::string& file_name )
+        const GeoModel< DIMENSION >& geomodel, std::ostream& out )
     {
-        std::ofstream out( file_name.c_str() );
-        out.precision( 16 );
-        if( out.bad() )
-        {
-            throw RINGMeshException(
-                "I/O", "Error when opening the file: ", file_name );
-        }
         save_dimension( DIMENSION, out );
         save_version_and_name( geomodel, out );
         save_number_of_mesh_entities( geomodel, out );
@@ -676,11 +927,11 @@ namespace
 
     template < index_t DIMENSION >
     bool save_mesh( const GeoModelMeshEntity< DIMENSION >& geomodel_entity_mesh,
-        const std::string& name );
+        std::vector< char >& buffer );
 
     template <>
     bool save_mesh( const GeoModelMeshEntity3D& geomodel_entity_mesh,
-        const std::string& name )
+        std::vector< char >& buffer )
     {
         if( geomodel_entity_mesh.type_name() == Region3D::type_name_static() )
         {
@@ -692,13 +943,13 @@ namespace
                 return false;
             }
         }
-        geomodel_entity_mesh.save( name );
+        geomodel_entity_mesh.save( buffer );
         return true;
     }
 
     template <>
     bool save_mesh( const GeoModelMeshEntity2D& geomodel_entity_mesh,
-        const std::string& name )
+        std::vector< char >& buffer )
     {
         if( geomodel_entity_mesh.type_name() == Surface2D::type_name_static() )
         {
@@ -709,7 +960,7 @@ namespace
                 return false;
             }
         }
-        geomodel_entity_mesh.save( name );
+        geomodel_entity_mesh.save( buffer );
         return true;
     }
 
@@ -719,82 +970,109 @@ namespace
         const auto& id = entity.gmme();
         std::string base_name =
             id.type().string() + "_" + std::to_string( id.index() );
-        return base_name + "." + entity.mesh().default_extension();
+        return base_name + "." + MESH_ENTITY_EXTENSION;
     }
 
+    /// Name and compressed content of a file to add in the .gm archive
+    using ZipEntry = std::pair< std::string, CompressedFile >;
+
     /*!
-     * @brief Save the GeoModelMeshEntity in a meshb file
+     * @brief Save and compress the GeoModelMeshEntity in a memory buffer
      * @param[in] geomodel_entity_mesh the GeoModelMeshEntity you want to save
-     * @param[in] zf the zip file
+     * @param[out] entry the file to add in the archive, its name is left
+     * empty if the entity has no mesh to save
      */
     template < typename ENTITY >
-    void save_geomodel_mesh_entity( const ENTITY& geomodel_entity_mesh,
-        std::vector< std::string >& filenames )
+    void save_geomodel_mesh_entity(
+        const ENTITY& geomodel_entity_mesh, ZipEntry& entry )
     {
-        static std::mutex lock;
-        auto name =
-            build_string_for_geomodel_entity_export( geomodel_entity_mesh );
-        if( save_mesh( geomodel_entity_mesh, name ) )
+        std::vector< char > buffer;
+        if( save_mesh( geomodel_entity_mesh, buffer ) )
         {
-            std::lock_guard< std::mutex > locking( lock );
-            filenames.push_back( name );
+            entry.first =
+                build_string_for_geomodel_entity_export( geomodel_entity_mesh );
+            entry.second = compress_file_content( buffer );
         }
     }
 
-    void zip_files( const std::vector< std::string >& filenames, ZipFile& zf )
+    /*!
+     * @brief Removes the entries of the entities without mesh
+     */
+    template < typename ENTRY >
+    void remove_unsaved_entries( std::vector< ENTRY >& entries )
     {
-        for( const std::string& name : filenames )
+        entries.erase( std::remove_if( entries.begin(), entries.end(),
+                           []( const ENTRY& entry ) {
+                               return entry.first.empty();
+                           } ),
+            entries.end() );
+    }
+
+    ZipEntry stream_to_zip_entry(
+        const std::string& filename, const std::ostringstream& stream )
+    {
+        auto content = stream.str();
+        return { filename,
+            compress_file_content( { content.begin(), content.end() } ) };
+    }
+
+    void zip_entries( std::vector< ZipEntry >& entries, ZipFile& zf )
+    {
+        remove_unsaved_entries( entries );
+        std::sort( entries.begin(), entries.end(),
+            []( const ZipEntry& lhs, const ZipEntry& rhs ) {
+                return lhs.first < rhs.first;
+            } );
+        for( const auto& entry : entries )
         {
-            zf.add_file( name );
-            GEO::FileSystem::delete_file( name );
+            zf.add_compressed_file( entry.first, entry.second );
         }
     }
 
-    template < template < index_t > class ENTITY, index_t DIMENSION >
-    void save_geomodel_mesh_entities( const GeoModel< DIMENSION >& geomodel,
-        std::vector< std::string >& filenames )
+    template < template < index_t > class ENTITY,
+        index_t DIMENSION,
+        typename ENTRY >
+    void save_geomodel_mesh_entities(
+        const GeoModel< DIMENSION >& geomodel, std::vector< ENTRY >& entries )
     {
         const auto& type = ENTITY< DIMENSION >::type_name_static();
         auto* logger = Logger::instance();
         auto logger_status = logger->is_quiet();
         logger->set_quiet( true );
+        auto offset = entries.size();
+        entries.resize( offset + geomodel.nb_mesh_entities( type ) );
         parallel_for( geomodel.nb_mesh_entities( type ),
-            [&geomodel, &type, &filenames]( index_t i ) {
+            [&geomodel, &type, &entries, offset]( index_t i ) {
                 const auto& entity = dynamic_cast< const ENTITY< DIMENSION >& >(
                     geomodel.mesh_entity( type, i ) );
                 save_geomodel_mesh_entity< ENTITY< DIMENSION > >(
-                    entity, filenames );
+                    entity, entries[offset + i] );
             } );
         logger->set_quiet( logger_status );
     }
 
-    template < index_t DIMENSION >
+    template < index_t DIMENSION, typename ENTRY >
     void save_all_geomodel_mesh_entities_base(
-        const GeoModel< DIMENSION >& geomodel,
-        std::vector< std::string >& filenames )
+        const GeoModel< DIMENSION >& geomodel, std::vector< ENTRY >& entries )
     {
-        save_geomodel_mesh_entities< Corner, DIMENSION >( geomodel, filenames );
-        save_geomodel_mesh_entities< Line, DIMENSION >( geomodel, filenames );
-        save_geomodel_mesh_entities< Surface, DIMENSION >(
-            geomodel, filenames );
+        save_geomodel_mesh_entities< Corner >( geomodel, entries );
+        save_geomodel_mesh_entities< Line >( geomodel, entries );
+        save_geomodel_mesh_entities< Surface >( geomodel, entries );
     }
 
-    template < index_t DIMENSION >
-    void save_all_geomodel_mesh_entities( const GeoModel< DIMENSION >& geomodel,
-        std::vector< std::string >& filenames );
-
-    template <>
+    template < typename ENTRY >
     void save_all_geomodel_mesh_entities(
-        const GeoModel2D& geomodel, std::vector< std::string >& filenames )
+        const GeoModel2D& geomodel, std::vector< ENTRY >& entries )
     {
-        save_all_geomodel_mesh_entities_base( geomodel, filenames );
+        save_all_geomodel_mesh_entities_base( geomodel, entries );
     }
-    template <>
+
+    template < typename ENTRY >
     void save_all_geomodel_mesh_entities(
-        const GeoModel3D& geomodel, std::vector< std::string >& filenames )
+        const GeoModel3D& geomodel, std::vector< ENTRY >& entries )
     {
-        save_all_geomodel_mesh_entities_base( geomodel, filenames );
-        save_geomodel_mesh_entities< Region, 3 >( geomodel, filenames );
+        save_all_geomodel_mesh_entities_base( geomodel, entries );
+        save_geomodel_mesh_entities< Region >( geomodel, entries );
     }
 
     template < index_t DIMENSION >
@@ -814,9 +1092,9 @@ namespace
                + geomodel.nb_surfaces() + geomodel.nb_regions();
     }
 
-    index_t find_dimension( const std::string& mesh_entities_filename )
+    index_t find_dimension( std::vector< char > mesh_entities_file )
     {
-        GEO::LineInput file_line{ mesh_entities_filename };
+        BufferLineInput file_line{ std::move( mesh_entities_file ) };
         while( !file_line.eof() && file_line.get_line() )
         {
             file_line.get_fields();
@@ -843,56 +1121,53 @@ namespace
             builder.build_geomodel();
         }
 
+        void load_lazily( const std::string& filename,
+            GeoModel< DIMENSION >& geomodel ) final
+        {
+            GeoModelBuilderGM< DIMENSION > builder{ geomodel, filename };
+            builder.defer_mesh_loading();
+            builder.load_geomodel();
+        }
+
         void save( const GeoModel< DIMENSION >& geomodel,
             const std::string& filename ) final
         {
             ZipFile zf{ filename };
+            std::vector< ZipEntry > entries;
+            entries.reserve( nb_mesh_entities( geomodel ) + 2 );
 
-            const std::string mesh_entity_file{ "mesh_entities.txt" };
-            save_mesh_entities( geomodel, mesh_entity_file );
-            zf.add_file( mesh_entity_file );
-            GEO::FileSystem::delete_file( mesh_entity_file );
+            std::ostringstream mesh_entities;
+            mesh_entities.precision( 16 );
+            save_mesh_entities( geomodel, mesh_entities );
+            entries.push_back(
+                stream_to_zip_entry( "mesh_entities.txt", mesh_entities ) );
 
-            const std::string geological_entity_file{
-                "geological_entities.txt"
-            };
-            save_geological_entities( geomodel, geological_entity_file );
-            zf.add_file( geological_entity_file );
-            GEO::FileSystem::delete_file( geological_entity_file );
+            std::ostringstream geological_entities;
+            geological_entities.precision( 16 );
+            save_geological_entities( geomodel, geological_entities );
+            entries.push_back( stream_to_zip_entry(
+                "geological_entities.txt", geological_entities ) );
 
-            auto nb_mesh_entites = nb_mesh_entities( geomodel );
-            std::vector< std::string > filenames;
-            filenames.reserve( nb_mesh_entites );
             Logger::instance()->set_quiet( true );
-            save_all_geomodel_mesh_entities( geomodel, filenames );
+            save_all_geomodel_mesh_entities( geomodel, entries );
             Logger::instance()->set_quiet( false );
-            std::sort( filenames.begin(), filenames.end() );
-            zip_files( filenames, zf );
+            zip_entries( entries, zf );
         }
 
         index_t dimension( const std::string& filename ) const final
         {
             UnZipFile uz{ filename };
-            const std::string mesh_entity_file( "mesh_entities.txt" );
-            uz.get_file( mesh_entity_file );
-            auto dimension = find_dimension( mesh_entity_file );
-            auto ok = GEO::FileSystem::delete_file( mesh_entity_file );
-            ringmesh_unused( ok );
-            return dimension;
+            return find_dimension( uz.get_file_content( "mesh_entities.txt" ) );
         }
 
         virtual ~GeoModelHandlerGM() = default;
-
-    private:
-        void save_geomodel_regions( const GeoModel< DIMENSION >& geomodel,
-            std::vector< std::string >& filenames );
     };
 
     ALIAS_2D_AND_3D( GeoModelHandlerGM );
 
     template <>
     void GeoModelBuilderGMImpl_0< 2 >::read_second_line(
-        GEO::LineInput& file_line, const gmme_id& entity )
+        BufferLineInput& file_line, const gmme_id& entity )
     {
         file_line.get_line();
         file_line.get_fields();
@@ -929,7 +1204,7 @@ namespace
 
     template <>
     void GeoModelBuilderGMImpl_0< 3 >::read_second_line(
-        GEO::LineInput& file_line, const gmme_id& entity )
+        BufferLineInput& file_line, const gmme_id& entity )
     {
         file_line.get_line();
         file_line.get_fields();
@@ -0,0 +1,1787 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+namespace
+{
+    using namespace RINGMesh;
+
+    /*
+     * Binary GeoModel file (.gmb), in the byte order of the machine:
+     *  - a header: magic, byte order marker, version, number of sections
+     *    and dimension,
+     *  - a table giving the name, offset and size of each section,
+     *  - the sections, aligned on GMB_ALIGNMENT bytes.
+     * Each section is an array of fixed size records or values used in
+     * place in the mapped file: the topology tables, the vertex, element
+     * and attribute arrays of the entity meshes, and the GeoModelMesh
+     * vertices with the vertex map of each entity.
+     */
+    const char GMB_MAGIC[8] = { 'R', 'I', 'N', 'G', 'M', 'E', 'S', 'H' };
+    const std::uint32_t GMB_BYTE_ORDER{ 0x01020304 };
+    const std::uint32_t GMB_VERSION{ 2 };
+    const std::size_t GMB_ALIGNMENT{ 64 };
+    const std::size_t GMB_SECTION_NAME_SIZE{ 48 };
+
+    struct GMBHeader
+    {
+        char magic[8];
+        std::uint32_t byte_order;
+        std::uint32_t version;
+        std::uint64_t nb_sections;
+        std::uint32_t dimension;
+        char padding[GMB_ALIGNMENT - 28];
+    };
+
+    struct GMBSection
+    {
+        char name[GMB_SECTION_NAME_SIZE];
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    /// Characters of a string in the "strings" section
+    struct GMBString
+    {
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    /// Entities of a type, stored contiguously in an entity section
+    struct GMBEntityType
+    {
+        GMBString name;
+        std::uint64_t first_entity;
+        std::uint64_t nb_entities;
+    };
+
+    struct GMBGeoModel
+    {
+        GMBString name;
+    };
+
+    /*!
+     * GeoModelMeshEntity with the ranges of its boundaries, vertices
+     * (also used for the "geomodel_vertex_maps" section), elements (for the
+     * "element_types" and "element_ptr" sections), element vertices,
+     * element adjacents and attributes.
+     * An element starts at its element_ptr in the element vertices of
+     * the entity. Polygons have one adjacent by vertex, cells one by facet.
+     */
+    struct GMBMeshEntity
+    {
+        GMBString name;
+        GMBString mesh_type;
+        std::uint64_t first_boundary;
+        std::uint64_t first_vertex;
+        std::uint64_t first_element;
+        std::uint64_t first_element_vertex;
+        std::uint64_t first_adjacent;
+        std::uint64_t first_attribute;
+        std::uint32_t nb_boundaries;
+        std::uint32_t nb_vertices;
+        std::uint32_t nb_elements;
+        std::uint32_t nb_element_vertices;
+        std::uint32_t nb_adjacents;
+        std::uint32_t nb_attributes;
+    };
+
+    struct GMBBoundary
+    {
+        std::uint32_t index;
+        std::uint32_t side;
+    };
+
+    struct GMBGeologicalEntity
+    {
+        GMBString name;
+        GMBString geological_feature;
+        std::uint64_t first_child;
+        std::uint64_t nb_children;
+    };
+
+    /// Mesh elements to which a GMBAttribute is attached
+    enum struct GMBAttributeLocation : std::uint32_t
+    {
+        VERTICES,
+        ELEMENTS,
+        CELL_FACETS
+    };
+
+    /*!
+     * Geogram attribute of a GeoModelMeshEntity mesh, its values are
+     * stored in the "attribute_values" section
+     */
+    struct GMBAttribute
+    {
+        GMBString name;
+        GMBString element_type;
+        std::uint64_t offset;
+        std::uint64_t size;
+        GMBAttributeLocation location;
+        std::uint32_t dimension;
+        std::uint32_t element_size;
+        std::uint32_t padding;
+    };
+
+    static_assert( sizeof( GMBHeader ) == GMB_ALIGNMENT,
+        "GMBHeader should fill an aligned block" );
+    static_assert( sizeof( GMBSection ) == GMB_ALIGNMENT,
+        "GMBSection should fill an aligned block" );
+    static_assert( sizeof( index_t ) == sizeof( std::uint32_t ),
+        "Indices are stored on 32 bits" );
+
+    std::uint64_t align_offset( std::uint64_t offset )
+    {
+        return ( offset + GMB_ALIGNMENT - 1 ) / GMB_ALIGNMENT * GMB_ALIGNMENT;
+    }
+
+    /// Name and content of a section to write
+    struct GMBSectionContent
+    {
+        std::string name;
+        const char* data;
+        std::size_t size;
+    };
+
+    template < typename T >
+    GMBSectionContent gmb_section(
+        std::string name, const std::vector< T >& values )
+    {
+        return { std::move( name ),
+            reinterpret_cast< const char* >( values.data() ),
+            values.size() * sizeof( T ) };
+    }
+
+    /*!
+     * @brief Writes a binary GeoModel file
+     * @param[in] filename the output file name
+     * @param[in] dimension the GeoModel dimension
+     * @param[in] sections the name and content of each section
+     */
+    void save_gmb_sections( const std::string& filename,
+        index_t dimension,
+        const std::vector< GMBSectionContent >& sections )
+    {
+        GMBHeader header;
+        std::memset( &header, 0, sizeof( GMBHeader ) );
+        std::memcpy( header.magic, GMB_MAGIC, sizeof( GMB_MAGIC ) );
+        header.byte_order = GMB_BYTE_ORDER;
+        header.version = GMB_VERSION;
+        header.nb_sections = sections.size();
+        header.dimension = dimension;
+
+        std::vector< GMBSection > table( sections.size() );
+        std::memset( table.data(), 0, table.size() * sizeof( GMBSection ) );
+        auto offset = align_offset(
+            sizeof( GMBHeader ) + table.size() * sizeof( GMBSection ) );
+        for( auto s : range( sections.size() ) )
+        {
+            const auto& name = sections[s].name;
+            if( name.size() >= GMB_SECTION_NAME_SIZE )
+            {
+                throw RINGMeshException(
+                    "I/O", "Section name too long: ", name );
+            }
+            std::memcpy( table[s].name, name.c_str(), name.size() );
+            table[s].offset = offset;
+            table[s].size = sections[s].size;
+            offset = align_offset( offset + table[s].size );
+        }
+
+        std::ofstream out{ filename.c_str(), std::ios::binary };
+        if( !out )
+        {
+            throw RINGMeshException(
+                "I/O", "Error when opening the file: ", filename );
+        }
+        out.write( reinterpret_cast< const char* >( &header ),
+            sizeof( GMBHeader ) );
+        out.write( reinterpret_cast< const char* >( table.data() ),
+            static_cast< std::streamsize >(
+                table.size() * sizeof( GMBSection ) ) );
+        const char padding[GMB_ALIGNMENT] = {};
+        for( auto s : range( sections.size() ) )
+        {
+            auto position = static_cast< std::uint64_t >( out.tellp() );
+            out.write( padding,
+                static_cast< std::streamsize >( table[s].offset - position ) );
+            out.write( sections[s].data,
+                static_cast< std::streamsize >( table[s].size ) );
+        }
+        if( !out )
+        {
+            throw RINGMeshException(
+                "I/O", "Error when writing the file: ", filename );
+        }
+    }
+
+    /*!
+     * @brief Content of the sections of a binary GeoModel file
+     */
+    struct GMBContent
+    {
+        GMBString add_string( const std::string& value )
+        {
+            GMBString result{ strings.size(), value.size() };
+            strings.insert( strings.end(), value.begin(), value.end() );
+            return result;
+        }
+
+        std::vector< GMBSectionContent > sections() const
+        {
+            return { gmb_section( "strings", strings ),
+                gmb_section( "geomodel", geomodel ),
+                gmb_section( "mesh_entity_types", mesh_entity_types ),
+                gmb_section( "mesh_entities", mesh_entities ),
+                gmb_section( "boundaries", boundaries ),
+                gmb_section(
+                    "geological_entity_types", geological_entity_types ),
+                gmb_section( "geological_entities", geological_entities ),
+                gmb_section( "children", children ),
+                gmb_section( "vertices", vertices ),
+                gmb_section( "element_types", element_types ),
+                gmb_section( "element_ptr", element_ptr ),
+                gmb_section( "element_vertices", element_vertices ),
+                gmb_section( "element_adjacents", element_adjacents ),
+                gmb_section( "attributes", attributes ),
+                gmb_section( "attribute_values", attribute_values ),
+                gmb_section( "geomodel_vertices", geomodel_vertices ),
+                gmb_section( "geomodel_vertex_maps", geomodel_vertex_maps ) };
+        }
+
+        std::vector< char > strings;
+        std::vector< GMBGeoModel > geomodel;
+        std::vector< GMBEntityType > mesh_entity_types;
+        std::vector< GMBMeshEntity > mesh_entities;
+        std::vector< GMBBoundary > boundaries;
+        std::vector< GMBEntityType > geological_entity_types;
+        std::vector< GMBGeologicalEntity > geological_entities;
+        std::vector< index_t > children;
+        std::vector< double > vertices;
+        std::vector< std::uint8_t > element_types;
+        std::vector< index_t > element_ptr;
+        std::vector< index_t > element_vertices;
+        std::vector< index_t > element_adjacents;
+        std::vector< GMBAttribute > attributes;
+        std::vector< char > attribute_values;
+        std::vector< double > geomodel_vertices;
+        std::vector< index_t > geomodel_vertex_maps;
+    };
+
+    /*!
+     * @brief Saves the attributes of a mesh whose element type is known
+     * by geogram
+     */
+    void save_gmb_attributes( const GEO::AttributesManager& manager,
+        GMBAttributeLocation location,
+        GMBContent& content )
+    {
+        GEO::vector< std::string > names;
+        manager.list_attribute_names( names );
+        for( const auto& name : names )
+        {
+            // Vertex coordinates are saved in the "vertices" section
+            if( location == GMBAttributeLocation::VERTICES && name == "point" )
+            {
+                continue;
+            }
+            const auto* store = manager.find_attribute_store( name );
+            const auto typeid_name = store->element_typeid_name();
+            if( !GEO::AttributeStore::element_typeid_name_is_known(
+                    typeid_name ) )
+            {
+                continue;
+            }
+            GMBAttribute attribute;
+            std::memset( &attribute, 0, sizeof( GMBAttribute ) );
+            attribute.name = content.add_string( name );
+            attribute.element_type = content.add_string(
+                GEO::AttributeStore::element_type_name_by_element_typeid_name(
+                    typeid_name ) );
+            attribute.location = location;
+            attribute.dimension = store->dimension();
+            attribute.element_size =
+                static_cast< std::uint32_t >( store->element_size() );
+            attribute.offset = align_offset( content.attribute_values.size() );
+            attribute.size = static_cast< std::uint64_t >( manager.size() )
+                             * store->dimension() * store->element_size();
+            content.attribute_values.resize( static_cast< std::size_t >(
+                attribute.offset + attribute.size ) );
+            if( attribute.size > 0 )
+            {
+                std::memcpy( &content.attribute_values[static_cast<
+                                 std::size_t >( attribute.offset )],
+                    store->data(),
+                    static_cast< std::size_t >( attribute.size ) );
+            }
+            content.attributes.push_back( attribute );
+        }
+    }
+
+    template < index_t DIMENSION >
+    void save_gmb_vertices(
+        const MeshBase< DIMENSION >& mesh, GMBContent& content )
+    {
+        content.vertices.reserve(
+            content.vertices.size() + DIMENSION * mesh.nb_vertices() );
+        for( auto v : range( mesh.nb_vertices() ) )
+        {
+            const auto& vertex = mesh.vertex( v );
+            for( auto i : range( DIMENSION ) )
+            {
+                content.vertices.push_back( vertex[i] );
+            }
+        }
+        save_gmb_attributes( mesh.vertex_attribute_manager(),
+            GMBAttributeLocation::VERTICES, content );
+    }
+
+    void start_gmb_element(
+        const GMBMeshEntity& entity, std::uint8_t type, GMBContent& content )
+    {
+        content.element_types.push_back( type );
+        content.element_ptr.push_back( static_cast< index_t >(
+            content.element_vertices.size() - entity.first_element_vertex ) );
+    }
+
+    template < index_t DIMENSION >
+    void save_gmb_mesh( const PointSetMesh< DIMENSION >& mesh,
+        const GMBMeshEntity& entity,
+        GMBContent& content )
+    {
+        ringmesh_unused( entity );
+        save_gmb_vertices( mesh, content );
+    }
+
+    template < index_t DIMENSION >
+    void save_gmb_mesh( const LineMesh< DIMENSION >& mesh,
+        const GMBMeshEntity& entity,
+        GMBContent& content )
+    {
+        save_gmb_vertices( mesh, content );
+        for( auto e : range( mesh.nb_edges() ) )
+        {
+            start_gmb_element( entity, 0, content );
+            for( auto v : range( 2 ) )
+            {
+                content.element_vertices.push_back(
+                    mesh.edge_vertex( { e, v } ) );
+            }
+        }
+        save_gmb_attributes( mesh.edge_attribute_manager(),
+            GMBAttributeLocation::ELEMENTS, content );
+    }
+
+    template < index_t DIMENSION >
+    void save_gmb_mesh( const SurfaceMesh< DIMENSION >& mesh,
+        const GMBMeshEntity& entity,
+        GMBContent& content )
+    {
+        save_gmb_vertices( mesh, content );
+        for( auto p : range( mesh.nb_polygons() ) )
+        {
+            start_gmb_element( entity, 0, content );
+            for( auto v : range( mesh.nb_polygon_vertices( p ) ) )
+            {
+                content.element_vertices.push_back(
+                    mesh.polygon_vertex( { p, v } ) );
+                content.element_adjacents.push_back(
+                    mesh.polygon_adjacent( { p, v } ) );
+            }
+        }
+        save_gmb_attributes( mesh.polygon_attribute_manager(),
+            GMBAttributeLocation::ELEMENTS, content );
+    }
+
+    void save_gmb_mesh( const VolumeMesh3D& mesh,
+        const GMBMeshEntity& entity,
+        GMBContent& content )
+    {
+        save_gmb_vertices( mesh, content );
+        for( auto c : range( mesh.nb_cells() ) )
+        {
+            start_gmb_element( entity,
+                static_cast< std::uint8_t >( mesh.cell_type( c ) ), content );
+            for( auto v : range( mesh.nb_cell_vertices( c ) ) )
+            {
+                content.element_vertices.push_back(
+                    mesh.cell_vertex( { c, v } ) );
+            }
+            for( auto f : range( mesh.nb_cell_facets( c ) ) )
+            {
+                content.element_adjacents.push_back(
+                    mesh.cell_adjacent( { c, f } ) );
+            }
+        }
+        save_gmb_attributes( mesh.cell_attribute_manager(),
+            GMBAttributeLocation::ELEMENTS, content );
+        save_gmb_attributes( mesh.cell_facet_attribute_manager(),
+            GMBAttributeLocation::CELL_FACETS, content );
+    }
+
+    /// Only Region3D and Surface2D have oriented boundaries
+    template < typename ENTITY >
+    bool gmb_boundary_side( const ENTITY& entity, index_t boundary )
+    {
+        ringmesh_unused( entity );
+        ringmesh_unused( boundary );
+        return false;
+    }
+
+    bool gmb_boundary_side( const Region3D& region, index_t boundary )
+    {
+        return region.side( boundary );
+    }
+
+    bool gmb_boundary_side( const Surface2D& surface, index_t boundary )
+    {
+        return surface.side( boundary );
+    }
+
+    template < template < index_t > class ENTITY, index_t DIMENSION >
+    void save_gmb_mesh_entities(
+        const GeoModel< DIMENSION >& geomodel, GMBContent& content )
+    {
+        const auto& type = ENTITY< DIMENSION >::type_name_static();
+        GMBEntityType entity_type;
+        entity_type.name = content.add_string( type.string() );
+        entity_type.first_entity = content.mesh_entities.size();
+        entity_type.nb_entities = geomodel.nb_mesh_entities( type );
+        content.mesh_entity_types.push_back( entity_type );
+
+        for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
+        {
+            const auto& entity = static_cast< const ENTITY< DIMENSION >& >(
+                geomodel.mesh_entity( type, e ) );
+            GMBMeshEntity record;
+            std::memset( &record, 0, sizeof( GMBMeshEntity ) );
+            record.name = content.add_string( entity.name() );
+            record.mesh_type = content.add_string( entity.mesh().type_name() );
+            record.first_boundary = content.boundaries.size();
+            record.first_vertex = content.vertices.size() / DIMENSION;
+            record.first_element = content.element_types.size();
+            record.first_element_vertex = content.element_vertices.size();
+            record.first_adjacent = content.element_adjacents.size();
+            record.first_attribute = content.attributes.size();
+
+            for( auto b : range( entity.nb_boundaries() ) )
+            {
+                content.boundaries.push_back(
+                    { entity.boundary_gmme( b ).index(),
+                        gmb_boundary_side( entity, b ) ? 1u : 0u } );
+            }
+            save_gmb_mesh( entity.mesh(), record, content );
+            if( entity.nb_vertices() > 0 )
+            {
+                const auto& vertex_map =
+                    geomodel.mesh.vertices.geomodel_vertex_ids( entity.gmme() );
+                if( vertex_map.size() != entity.nb_vertices() )
+                {
+                    throw RINGMeshException( "I/O",
+                        "Invalid GeoModelMesh vertex map of ", entity.gmme() );
+                }
+                content.geomodel_vertex_maps.insert(
+                    content.geomodel_vertex_maps.end(), vertex_map.begin(),
+                    vertex_map.end() );
+            }
+
+            record.nb_boundaries = entity.nb_boundaries();
+            record.nb_vertices = entity.nb_vertices();
+            record.nb_elements = static_cast< std::uint32_t >(
+                content.element_types.size() - record.first_element );
+            record.nb_element_vertices = static_cast< std::uint32_t >(
+                content.element_vertices.size()
+                - record.first_element_vertex );
+            record.nb_adjacents = static_cast< std::uint32_t >(
+                content.element_adjacents.size() - record.first_adjacent );
+            record.nb_attributes = static_cast< std::uint32_t >(
+                content.attributes.size() - record.first_attribute );
+            content.mesh_entities.push_back( record );
+        }
+    }
+
+    template < index_t DIMENSION >
+    void save_all_gmb_mesh_entities(
+        const GeoModel< DIMENSION >& geomodel, GMBContent& content );
+
+    template <>
+    void save_all_gmb_mesh_entities(
+        const GeoModel2D& geomodel, GMBContent& content )
+    {
+        save_gmb_mesh_entities< Corner >( geomodel, content );
+        save_gmb_mesh_entities< Line >( geomodel, content );
+        save_gmb_mesh_entities< Surface >( geomodel, content );
+    }
+
+    template <>
+    void save_all_gmb_mesh_entities(
+        const GeoModel3D& geomodel, GMBContent& content )
+    {
+        save_gmb_mesh_entities< Corner >( geomodel, content );
+        save_gmb_mesh_entities< Line >( geomodel, content );
+        save_gmb_mesh_entities< Surface >( geomodel, content );
+        save_gmb_mesh_entities< Region >( geomodel, content );
+    }
+
+    template < index_t DIMENSION >
+    void save_gmb_geological_entities(
+        const GeoModel< DIMENSION >& geomodel, GMBContent& content )
+    {
+        for( auto t : range( geomodel.nb_geological_entity_types() ) )
+        {
+            const auto& type = geomodel.geological_entity_type( t );
+            GMBEntityType entity_type;
+            entity_type.name = content.add_string( type.string() );
+            entity_type.first_entity = content.geological_entities.size();
+            entity_type.nb_entities = geomodel.nb_geological_entities( type );
+            content.geological_entity_types.push_back( entity_type );
+
+            for( auto e : range( geomodel.nb_geological_entities( type ) ) )
+            {
+                const auto& entity = geomodel.geological_entity( type, e );
+                GMBGeologicalEntity record;
+                record.name = content.add_string( entity.name() );
+                record.geological_feature = content.add_string(
+                    GeoModelGeologicalEntity< DIMENSION >::geol_name(
+                        entity.geological_feature() ) );
+                record.first_child = content.children.size();
+                record.nb_children = entity.nb_children();
+                for( auto c : range( entity.nb_children() ) )
+                {
+                    content.children.push_back(
+                        entity.child_gmme( c ).index() );
+                }
+                content.geological_entities.push_back( record );
+            }
+        }
+    }
+
+    template < index_t DIMENSION >
+    void save_gmb_geomodel_vertices(
+        const GeoModel< DIMENSION >& geomodel, GMBContent& content )
+    {
+        const auto& vertices = geomodel.mesh.vertices;
+        content.geomodel_vertices.reserve( DIMENSION * vertices.nb() );
+        for( auto v : range( vertices.nb() ) )
+        {
+            const auto& vertex = vertices.vertex( v );
+            for( auto i : range( DIMENSION ) )
+            {
+                content.geomodel_vertices.push_back( vertex[i] );
+            }
+        }
+    }
+
+    /*!
+     * @brief Values of a section used in place in the mapped file
+     */
+    template < typename T >
+    class GMBArray
+    {
+    public:
+        GMBArray() = default;
+        GMBArray( const T* values, std::size_t size )
+            : values_( values ), size_( size )
+        {
+        }
+
+        const T* data() const
+        {
+            return values_;
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        const T& operator[]( std::uint64_t i ) const
+        {
+            ringmesh_assert( i < size_ );
+            return values_[i];
+        }
+
+        /*!
+         * @brief Tests if the values [first, first + nb) are in the array,
+         * without arithmetic that could wrap on corrupted files
+         */
+        bool contains( std::uint64_t first, std::uint64_t nb ) const
+        {
+            return first <= size_ && nb <= size_ - first;
+        }
+
+    private:
+        const T* values_{ nullptr };
+        std::size_t size_{ 0 };
+    };
+
+    /*!
+     * @brief Binary GeoModel file mapped in memory.
+     * The sections are accessed in place, only the pages of the read
+     * sections are loaded from the disk.
+     */
+    class GeoModelBinaryFile
+    {
+    public:
+        explicit GeoModelBinaryFile( const std::string& filename )
+            : file_( filename )
+        {
+            if( file_.size() < sizeof( GMBHeader ) )
+            {
+                throw RINGMeshException(
+                    "I/O", "Invalid binary GeoModel file: ", filename );
+            }
+            std::memcpy( &header_, file_.data(), sizeof( GMBHeader ) );
+            if( std::memcmp( header_.magic, GMB_MAGIC, sizeof( GMB_MAGIC ) )
+                != 0 )
+            {
+                throw RINGMeshException(
+                    "I/O", "Invalid binary GeoModel file: ", filename );
+            }
+            if( header_.byte_order != GMB_BYTE_ORDER )
+            {
+                throw RINGMeshException( "I/O", "Binary GeoModel file ",
+                    filename, " was written with another byte order" );
+            }
+            if( header_.version != GMB_VERSION )
+            {
+                throw RINGMeshException( "I/O", "Binary GeoModel file version ",
+                    header_.version, " is not supported: ", filename );
+            }
+            // Header values are compared to the file size without
+            // arithmetic on them, that could wrap on corrupted files
+            const auto file_size = static_cast< std::uint64_t >( file_.size() );
+            const auto max_nb_sections =
+                ( file_size - sizeof( GMBHeader ) ) / sizeof( GMBSection );
+            if( header_.nb_sections > max_nb_sections )
+            {
+                throw RINGMeshException(
+                    "I/O", "Truncated binary GeoModel file: ", filename );
+            }
+            sections_.resize(
+                static_cast< std::size_t >( header_.nb_sections ) );
+            std::memcpy( sections_.data(), file_.data() + sizeof( GMBHeader ),
+                sections_.size() * sizeof( GMBSection ) );
+            for( auto& section : sections_ )
+            {
+                section.name[GMB_SECTION_NAME_SIZE - 1] = '\0';
+                if( section.offset > file_size
+                    || section.size > file_size - section.offset )
+                {
+                    throw RINGMeshException(
+                        "I/O", "Truncated binary GeoModel file: ", filename );
+                }
+                if( section.offset % GMB_ALIGNMENT != 0 )
+                {
+                    throw RINGMeshException(
+                        "I/O", "Invalid binary GeoModel file: ", filename );
+                }
+            }
+        }
+
+        index_t dimension() const
+        {
+            return header_.dimension;
+        }
+
+        /*!
+         * @brief Gets the values of a section, in place in the mapped file
+         * @param[in] name the section name
+         */
+        template < typename T >
+        GMBArray< T > section( const std::string& name ) const
+        {
+            for( const auto& section : sections_ )
+            {
+                if( section.name != name )
+                {
+                    continue;
+                }
+                if( section.size % sizeof( T ) != 0 )
+                {
+                    throw RINGMeshException( "I/O", "Invalid section ", name,
+                        " in binary GeoModel file" );
+                }
+                return { reinterpret_cast< const T* >(
+                             file_.data() + section.offset ),
+                    static_cast< std::size_t >( section.size / sizeof( T ) ) };
+            }
+            throw RINGMeshException( "I/O", "Missing section ", name,
+                " in binary GeoModel file" );
+        }
+
+    private:
+        MemoryMappedFile file_;
+        GMBHeader header_;
+        std::vector< GMBSection > sections_;
+    };
+
+    /*!
+     * @brief Sections of a binary GeoModel file.
+     * The ranges and strings of all the records are checked when the file
+     * is opened, the mesh arrays when the meshes are loaded.
+     */
+    struct GMBSections
+    {
+        explicit GMBSections( const GeoModelBinaryFile& file )
+            : dimension( file.dimension() ),
+              strings( file.section< char >( "strings" ) ),
+              geomodel( file.section< GMBGeoModel >( "geomodel" ) ),
+              mesh_entity_types(
+                  file.section< GMBEntityType >( "mesh_entity_types" ) ),
+              mesh_entities(
+                  file.section< GMBMeshEntity >( "mesh_entities" ) ),
+              boundaries( file.section< GMBBoundary >( "boundaries" ) ),
+              geological_entity_types(
+                  file.section< GMBEntityType >( "geological_entity_types" ) ),
+              geological_entities( file.section< GMBGeologicalEntity >(
+                  "geological_entities" ) ),
+              children( file.section< index_t >( "children" ) ),
+              vertices( file.section< double >( "vertices" ) ),
+              element_types( file.section< std::uint8_t >( "element_types" ) ),
+              element_ptr( file.section< index_t >( "element_ptr" ) ),
+              element_vertices(
+                  file.section< index_t >( "element_vertices" ) ),
+              element_adjacents(
+                  file.section< index_t >( "element_adjacents" ) ),
+              attributes( file.section< GMBAttribute >( "attributes" ) ),
+              attribute_values( file.section< char >( "attribute_values" ) ),
+              geomodel_vertices(
+                  file.section< double >( "geomodel_vertices" ) ),
+              geomodel_vertex_maps(
+                  file.section< index_t >( "geomodel_vertex_maps" ) )
+        {
+            if( !check_records() )
+            {
+                throw RINGMeshException(
+                    "I/O", "Invalid records in binary GeoModel file" );
+            }
+        }
+
+        std::string string( const GMBString& value ) const
+        {
+            return { strings.data() + value.offset,
+                static_cast< std::size_t >( value.size ) };
+        }
+
+        index_t nb_vertices() const
+        {
+            return static_cast< index_t >( vertices.size() / dimension );
+        }
+
+        index_t nb_geomodel_vertices() const
+        {
+            return static_cast< index_t >(
+                geomodel_vertices.size() / dimension );
+        }
+
+        index_t dimension;
+        GMBArray< char > strings;
+        GMBArray< GMBGeoModel > geomodel;
+        GMBArray< GMBEntityType > mesh_entity_types;
+        GMBArray< GMBMeshEntity > mesh_entities;
+        GMBArray< GMBBoundary > boundaries;
+        GMBArray< GMBEntityType > geological_entity_types;
+        GMBArray< GMBGeologicalEntity > geological_entities;
+        GMBArray< index_t > children;
+        GMBArray< double > vertices;
+        GMBArray< std::uint8_t > element_types;
+        GMBArray< index_t > element_ptr;
+        GMBArray< index_t > element_vertices;
+        GMBArray< index_t > element_adjacents;
+        GMBArray< GMBAttribute > attributes;
+        GMBArray< char > attribute_values;
+        GMBArray< double > geomodel_vertices;
+        GMBArray< index_t > geomodel_vertex_maps;
+
+    private:
+        bool check_string( const GMBString& value ) const
+        {
+            return strings.contains( value.offset, value.size );
+        }
+
+        /*!
+         * @brief Tests if the types give, one after the other, the type of
+         * each entity
+         */
+        bool check_entity_types( const GMBArray< GMBEntityType >& types,
+            std::size_t nb_entities ) const
+        {
+            std::uint64_t nb_typed_entities{ 0 };
+            for( auto t : range( types.size() ) )
+            {
+                const auto& type = types[t];
+                if( !check_string( type.name )
+                    || type.first_entity != nb_typed_entities
+                    || type.nb_entities > nb_entities - nb_typed_entities
+                    || type.nb_entities > NO_ID )
+                {
+                    return false;
+                }
+                nb_typed_entities += type.nb_entities;
+            }
+            return nb_typed_entities == nb_entities;
+        }
+
+        bool check_mesh_entity( const GMBMeshEntity& entity ) const
+        {
+            return check_string( entity.name )
+                   && check_string( entity.mesh_type )
+                   && boundaries.contains(
+                          entity.first_boundary, entity.nb_boundaries )
+                   && entity.first_vertex <= nb_vertices()
+                   && entity.nb_vertices <= nb_vertices() - entity.first_vertex
+                   && element_types.contains(
+                          entity.first_element, entity.nb_elements )
+                   && element_vertices.contains( entity.first_element_vertex,
+                          entity.nb_element_vertices )
+                   && element_adjacents.contains(
+                          entity.first_adjacent, entity.nb_adjacents )
+                   && attributes.contains(
+                          entity.first_attribute, entity.nb_attributes );
+        }
+
+        bool check_geological_entity(
+            const GMBGeologicalEntity& entity ) const
+        {
+            return check_string( entity.name )
+                   && check_string( entity.geological_feature )
+                   && children.contains(
+                          entity.first_child, entity.nb_children );
+        }
+
+        bool check_attribute( const GMBAttribute& attribute ) const
+        {
+            return check_string( attribute.name )
+                   && check_string( attribute.element_type )
+                   && attribute.location <= GMBAttributeLocation::CELL_FACETS
+                   && attribute_values.contains(
+                          attribute.offset, attribute.size );
+        }
+
+        bool check_records() const
+        {
+            if( ( dimension != 2 && dimension != 3 ) || geomodel.size() != 1
+                || !check_string( geomodel[0].name )
+                || vertices.size() % dimension != 0
+                || geomodel_vertices.size() % dimension != 0
+                || element_ptr.size() != element_types.size()
+                || geomodel_vertex_maps.size() != nb_vertices() )
+            {
+                return false;
+            }
+            if( !check_entity_types( mesh_entity_types, mesh_entities.size() )
+                || !check_entity_types(
+                       geological_entity_types, geological_entities.size() ) )
+            {
+                return false;
+            }
+            for( auto e : range( mesh_entities.size() ) )
+            {
+                if( !check_mesh_entity( mesh_entities[e] ) )
+                {
+                    return false;
+                }
+            }
+            for( auto e : range( geological_entities.size() ) )
+            {
+                if( !check_geological_entity( geological_entities[e] ) )
+                {
+                    return false;
+                }
+            }
+            for( auto a : range( attributes.size() ) )
+            {
+                if( !check_attribute( attributes[a] ) )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    /*!
+     * @brief Gives a mesh the attributes saved for some of its elements
+     * @return false if the saved attributes do not match the mesh
+     */
+    bool load_gmb_attributes( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        GMBAttributeLocation location,
+        GEO::AttributesManager& manager )
+    {
+        for( auto a : range( entity.nb_attributes ) )
+        {
+            const auto& attribute =
+                sections.attributes[entity.first_attribute + a];
+            if( attribute.location != location )
+            {
+                continue;
+            }
+            const auto element_type =
+                sections.string( attribute.element_type );
+            if( attribute.dimension == 0
+                || !GEO::AttributeStore::element_type_name_is_known(
+                       element_type ) )
+            {
+                return false;
+            }
+            const auto name = sections.string( attribute.name );
+            auto* store = manager.find_attribute_store( name );
+            if( store == nullptr )
+            {
+                store = GEO::AttributeStore::
+                    create_attribute_store_by_element_type_name(
+                        element_type, attribute.dimension );
+                manager.bind_attribute_store( name, store );
+            }
+            else if( store->element_typeid_name()
+                         != GEO::AttributeStore::
+                                element_typeid_name_by_element_type_name(
+                                    element_type )
+                     || store->dimension() != attribute.dimension )
+            {
+                return false;
+            }
+            if( store->element_size() != attribute.element_size
+                || attribute.size != static_cast< std::uint64_t >(
+                                         manager.size() )
+                                         * attribute.dimension
+                                         * attribute.element_size )
+            {
+                return false;
+            }
+            if( attribute.size > 0 )
+            {
+                std::memcpy( store->data(),
+                    sections.attribute_values.data() + attribute.offset,
+                    static_cast< std::size_t >( attribute.size ) );
+            }
+        }
+        return true;
+    }
+
+    /*!
+     * @brief Creates the vertices of a mesh, the coordinates are copied in
+     * one block when the mesh stores them in a geogram attribute
+     */
+    template < index_t DIMENSION >
+    bool load_gmb_vertices( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        MeshBaseBuilder< DIMENSION >& builder,
+        const MeshBase< DIMENSION >& mesh )
+    {
+        builder.create_vertices( entity.nb_vertices );
+        const auto* coordinates =
+            sections.vertices.data() + DIMENSION * entity.first_vertex;
+        auto* points =
+            mesh.vertex_attribute_manager().find_attribute_store( "point" );
+        if( points != nullptr && points->dimension() == DIMENSION
+            && points->element_size() == sizeof( double ) )
+        {
+            if( entity.nb_vertices > 0 )
+            {
+                std::memcpy( points->data(), coordinates,
+                    DIMENSION * entity.nb_vertices * sizeof( double ) );
+            }
+        }
+        else
+        {
+            for( auto v : range( entity.nb_vertices ) )
+            {
+                vecn< DIMENSION > vertex;
+                for( auto i : range( DIMENSION ) )
+                {
+                    vertex[i] = coordinates[DIMENSION * v + i];
+                }
+                builder.set_vertex( v, vertex );
+            }
+        }
+        return load_gmb_attributes( sections, entity,
+            GMBAttributeLocation::VERTICES, mesh.vertex_attribute_manager() );
+    }
+
+    /*!
+     * @brief Elements of a GMBMeshEntity, in place in the mapped file
+     */
+    class GMBElements
+    {
+    public:
+        GMBElements( const GMBSections& sections, const GMBMeshEntity& entity )
+            : types_( sections.element_types.data() + entity.first_element ),
+              ptr_( sections.element_ptr.data() + entity.first_element ),
+              vertices_( sections.element_vertices.data()
+                         + entity.first_element_vertex ),
+              adjacents_(
+                  sections.element_adjacents.data() + entity.first_adjacent ),
+              nb_elements_( entity.nb_elements ),
+              nb_element_vertices_( entity.nb_element_vertices ),
+              nb_adjacents_( entity.nb_adjacents )
+        {
+        }
+
+        /*!
+         * @brief Tests if the elements are ranges of the element vertices
+         * and refer to existing vertices and elements
+         * @param[in] nb_vertices the number of vertices of the mesh
+         */
+        bool is_valid( index_t nb_vertices ) const
+        {
+            for( auto e : range( nb_elements_ ) )
+            {
+                if( ptr_[e] > end( e ) || end( e ) > nb_element_vertices_ )
+                {
+                    return false;
+                }
+            }
+            for( auto v : range( nb_element_vertices_ ) )
+            {
+                if( vertices_[v] >= nb_vertices )
+                {
+                    return false;
+                }
+            }
+            for( auto a : range( nb_adjacents_ ) )
+            {
+                if( adjacents_[a] >= nb_elements_ && adjacents_[a] != NO_ID )
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        index_t nb_elements() const
+        {
+            return nb_elements_;
+        }
+
+        std::uint8_t type( index_t element ) const
+        {
+            return types_[element];
+        }
+
+        index_t nb_vertices( index_t element ) const
+        {
+            return end( element ) - ptr_[element];
+        }
+
+        /// Position of the first vertex of an element in the element
+        /// vertices of the mesh
+        index_t first_vertex( index_t element ) const
+        {
+            return ptr_[element];
+        }
+
+        index_t vertex( const ElementLocalVertex& element_local_vertex ) const
+        {
+            return vertices_[ptr_[element_local_vertex.element_id]
+                             + element_local_vertex.local_vertex_id];
+        }
+
+        const index_t* vertices() const
+        {
+            return vertices_;
+        }
+
+        index_t nb_element_vertices() const
+        {
+            return nb_element_vertices_;
+        }
+
+        const index_t* adjacents() const
+        {
+            return adjacents_;
+        }
+
+        index_t nb_adjacents() const
+        {
+            return nb_adjacents_;
+        }
+
+    private:
+        index_t end( index_t element ) const
+        {
+            return element + 1 < nb_elements_ ? ptr_[element + 1]
+                                               : nb_element_vertices_;
+        }
+
+    private:
+        const std::uint8_t* types_;
+        const index_t* ptr_;
+        const index_t* vertices_;
+        const index_t* adjacents_;
+        index_t nb_elements_;
+        index_t nb_element_vertices_;
+        index_t nb_adjacents_;
+    };
+
+    template < index_t DIMENSION >
+    bool load_gmb_mesh( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        PointSetMeshBuilder< DIMENSION >& builder,
+        const PointSetMesh< DIMENSION >& mesh )
+    {
+        return load_gmb_vertices( sections, entity, builder, mesh );
+    }
+
+    template < index_t DIMENSION >
+    bool load_gmb_mesh( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        LineMeshBuilder< DIMENSION >& builder,
+        const LineMesh< DIMENSION >& mesh )
+    {
+        GMBElements edges{ sections, entity };
+        if( !load_gmb_vertices( sections, entity, builder, mesh )
+            || !edges.is_valid( entity.nb_vertices )
+            || edges.nb_element_vertices() != 2 * edges.nb_elements() )
+        {
+            return false;
+        }
+        builder.create_edges( edges.nb_elements() );
+        for( auto e : range( edges.nb_elements() ) )
+        {
+            if( edges.nb_vertices( e ) != 2 )
+            {
+                return false;
+            }
+            for( auto v : range( 2 ) )
+            {
+                builder.set_edge_vertex( { e, v }, edges.vertex( { e, v } ) );
+            }
+        }
+        return load_gmb_attributes( sections, entity,
+            GMBAttributeLocation::ELEMENTS, mesh.edge_attribute_manager() );
+    }
+
+    template < index_t DIMENSION >
+    bool load_gmb_mesh( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        SurfaceMeshBuilder< DIMENSION >& builder,
+        const SurfaceMesh< DIMENSION >& mesh )
+    {
+        GMBElements polygons{ sections, entity };
+        if( !load_gmb_vertices( sections, entity, builder, mesh )
+            || !polygons.is_valid( entity.nb_vertices )
+            || polygons.nb_adjacents() != polygons.nb_element_vertices() )
+        {
+            return false;
+        }
+        bool triangles{ true };
+        for( auto p : range( polygons.nb_elements() ) )
+        {
+            if( polygons.nb_vertices( p ) < 3 )
+            {
+                return false;
+            }
+            triangles = triangles && polygons.nb_vertices( p ) == 3;
+        }
+        if( triangles )
+        {
+            builder.create_triangles( polygons.nb_elements() );
+            for( auto p : range( polygons.nb_elements() ) )
+            {
+                for( auto v : range( 3 ) )
+                {
+                    builder.set_polygon_vertex(
+                        { p, v }, polygons.vertex( { p, v } ) );
+                }
+            }
+        }
+        else
+        {
+            std::vector< index_t > polygon_vertices;
+            for( auto p : range( polygons.nb_elements() ) )
+            {
+                const auto* first =
+                    polygons.vertices() + polygons.first_vertex( p );
+                polygon_vertices.assign(
+                    first, first + polygons.nb_vertices( p ) );
+                builder.create_polygon( polygon_vertices );
+            }
+        }
+        for( auto p : range( polygons.nb_elements() ) )
+        {
+            const auto* adjacents =
+                polygons.adjacents() + polygons.first_vertex( p );
+            for( auto e : range( polygons.nb_vertices( p ) ) )
+            {
+                builder.set_polygon_adjacent( { p, e }, adjacents[e] );
+            }
+        }
+        return load_gmb_attributes( sections, entity,
+            GMBAttributeLocation::ELEMENTS, mesh.polygon_attribute_manager() );
+    }
+
+    /*!
+     * @brief Creates the cells of a volume mesh
+     * @return true if the cell vertices are set too, that is when all the
+     * cells are tetrahedra
+     */
+    bool create_gmb_cells(
+        const GMBElements& cells, VolumeMeshBuilder3D& builder )
+    {
+        bool tetrahedra{ cells.nb_elements() > 0
+                         && cells.nb_element_vertices()
+                                == 4 * cells.nb_elements() };
+        for( auto c : range( cells.nb_elements() ) )
+        {
+            tetrahedra = tetrahedra
+                         && cells.type( c )
+                                == to_underlying_type( CellType::TETRAHEDRON );
+        }
+        if( tetrahedra )
+        {
+            builder.assign_cell_tet_mesh( std::vector< index_t >(
+                cells.vertices(),
+                cells.vertices() + cells.nb_element_vertices() ) );
+            return true;
+        }
+        // Cells of the same type are created together
+        index_t first{ 0 };
+        while( first < cells.nb_elements() )
+        {
+            auto end = first + 1;
+            while( end < cells.nb_elements()
+                   && cells.type( end ) == cells.type( first ) )
+            {
+                end++;
+            }
+            builder.create_cells(
+                end - first, static_cast< CellType >( cells.type( first ) ) );
+            first = end;
+        }
+        return false;
+    }
+
+    bool load_gmb_mesh( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        VolumeMeshBuilder3D& builder,
+        const VolumeMesh3D& mesh )
+    {
+        GMBElements cells{ sections, entity };
+        if( !load_gmb_vertices( sections, entity, builder, mesh )
+            || !cells.is_valid( entity.nb_vertices ) )
+        {
+            return false;
+        }
+        for( auto c : range( cells.nb_elements() ) )
+        {
+            if( cells.type( c ) >= to_underlying_type( CellType::UNDEFINED ) )
+            {
+                return false;
+            }
+        }
+        const auto vertices_set = create_gmb_cells( cells, builder );
+        if( mesh.nb_cell_facets() != cells.nb_adjacents() )
+        {
+            return false;
+        }
+        index_t facet{ 0 };
+        for( auto c : range( cells.nb_elements() ) )
+        {
+            if( mesh.nb_cell_vertices( c ) != cells.nb_vertices( c ) )
+            {
+                return false;
+            }
+            if( !vertices_set )
+            {
+                for( auto v : range( cells.nb_vertices( c ) ) )
+                {
+                    builder.set_cell_vertex(
+                        { c, v }, cells.vertex( { c, v } ) );
+                }
+            }
+            for( auto f : range( mesh.nb_cell_facets( c ) ) )
+            {
+                builder.set_cell_adjacent(
+                    { c, f }, cells.adjacents()[facet++] );
+            }
+        }
+        return load_gmb_attributes( sections, entity,
+                   GMBAttributeLocation::ELEMENTS,
+                   mesh.cell_attribute_manager() )
+               && load_gmb_attributes( sections, entity,
+                      GMBAttributeLocation::CELL_FACETS,
+                      mesh.cell_facet_attribute_manager() );
+    }
+
+    template < index_t DIMENSION >
+    bool load_gmb_volume_mesh( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        MeshBase< DIMENSION >& mesh )
+    {
+        // Volume meshes only exist in 3D
+        ringmesh_unused( sections );
+        ringmesh_unused( entity );
+        ringmesh_unused( mesh );
+        return false;
+    }
+
+    bool load_gmb_volume_mesh( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        MeshBase3D& mesh )
+    {
+        auto* volume = dynamic_cast< VolumeMesh3D* >( &mesh );
+        if( volume == nullptr )
+        {
+            return false;
+        }
+        return load_gmb_mesh( sections, entity,
+            *VolumeMeshBuilder3D::create_builder( *volume ), *volume );
+    }
+
+    /*!
+     * @brief Loads a mesh from the builder of its concrete type
+     * @return false if the saved mesh is invalid
+     */
+    template < index_t DIMENSION >
+    bool load_gmb_mesh( const GMBSections& sections,
+        const GMBMeshEntity& entity,
+        MeshBase< DIMENSION >& mesh )
+    {
+        if( auto* point_set = dynamic_cast< PointSetMesh< DIMENSION >* >(
+                &mesh ) )
+        {
+            return load_gmb_mesh( sections, entity,
+                *PointSetMeshBuilder< DIMENSION >::create_builder( *point_set ),
+                *point_set );
+        }
+        if( auto* line = dynamic_cast< LineMesh< DIMENSION >* >( &mesh ) )
+        {
+            return load_gmb_mesh( sections, entity,
+                *LineMeshBuilder< DIMENSION >::create_builder( *line ),
+                *line );
+        }
+        if( auto* surface =
+                dynamic_cast< SurfaceMesh< DIMENSION >* >( &mesh ) )
+        {
+            return load_gmb_mesh( sections, entity,
+                *SurfaceMeshBuilder< DIMENSION >::create_builder( *surface ),
+                *surface );
+        }
+        return load_gmb_volume_mesh( sections, entity, mesh );
+    }
+
+    /*!
+     * @brief Loads on demand the entity meshes of a .gmb file,
+     * from the arrays of the mapped file
+     */
+    template < index_t DIMENSION >
+    class GeoModelMeshEntityLoaderGMB final
+        : public GeoModelMeshEntityLoader< DIMENSION >
+    {
+    public:
+        GeoModelMeshEntityLoaderGMB(
+            std::shared_ptr< const GeoModelBinaryFile > file,
+            const GMBSections& sections )
+            : file_( std::move( file ) ), sections_( sections )
+        {
+        }
+
+    private:
+        void load_mesh(
+            index_t source, MeshBase< DIMENSION >& mesh ) const final
+        {
+            if( !load_gmb_mesh(
+                    sections_, sections_.mesh_entities[source], mesh ) )
+            {
+                throw RINGMeshException( "I/O",
+                    "Invalid mesh in binary GeoModel file for the entity ",
+                    sections_.string( sections_.mesh_entities[source].name ) );
+            }
+        }
+
+    private:
+        // Keeps the file mapped while the sections are used
+        std::shared_ptr< const GeoModelBinaryFile > file_;
+        GMBSections sections_;
+    };
+
+    /*!
+     * @brief Builds a GeoModel from the tables of a .gmb file
+     */
+    template < index_t DIMENSION >
+    class GeoModelBuilderGMB final : public GeoModelBuilderGMBase< DIMENSION >
+    {
+    public:
+        GeoModelBuilderGMB(
+            GeoModel< DIMENSION >& geomodel, std::string filename )
+            : GeoModelBuilderGMBase< DIMENSION >(
+                  geomodel, std::move( filename ) )
+        {
+        }
+        virtual ~GeoModelBuilderGMB() = default;
+
+    private:
+        void load_file() final
+        {
+            auto file = std::make_shared< const GeoModelBinaryFile >(
+                this->filename() );
+            if( file->dimension() != DIMENSION )
+            {
+                throw RINGMeshException( "I/O", "The binary GeoModel file ",
+                    this->filename(), " is of dimension ", file->dimension() );
+            }
+            GMBSections sections{ *file };
+            this->info.set_geomodel_name(
+                sections.string( sections.geomodel[0].name ) );
+            const auto entities = load_topology( sections );
+            load_meshes( file, sections, entities );
+            load_geology( sections );
+            load_geomodel_vertices( sections, entities );
+        }
+
+        /*!
+         * @brief Creates the mesh entities and their boundary relations
+         * @return the entity of each mesh entity record
+         */
+        std::vector< gmme_id > load_topology( const GMBSections& sections )
+        {
+            const auto& manager =
+                this->geomodel_.entity_type_manager().mesh_entity_manager;
+            std::vector< gmme_id > entities;
+            entities.reserve( sections.mesh_entities.size() );
+            for( auto t : range( sections.mesh_entity_types.size() ) )
+            {
+                const auto& type = sections.mesh_entity_types[t];
+                const MeshEntityType entity_type{ sections.string(
+                    type.name ) };
+                if( !manager.is_valid_type( entity_type ) )
+                {
+                    throw RINGMeshException( "I/O", "Invalid mesh entity type ",
+                        entity_type, " in binary GeoModel file" );
+                }
+                const auto nb_entities =
+                    static_cast< index_t >( type.nb_entities );
+                this->topology.create_mesh_entities( entity_type, nb_entities );
+                for( auto e : range( nb_entities ) )
+                {
+                    entities.emplace_back( entity_type, e );
+                }
+            }
+
+            for( auto r : range( entities.size() ) )
+            {
+                const auto& record = sections.mesh_entities[r];
+                this->info.set_mesh_entity_name(
+                    entities[r], sections.string( record.name ) );
+                this->geometry.change_mesh_data_structure(
+                    entities[r], sections.string( record.mesh_type ) );
+            }
+            for( auto r : range( entities.size() ) )
+            {
+                const auto& entity = entities[r];
+                const auto& record = sections.mesh_entities[r];
+                for( auto b : range( record.nb_boundaries ) )
+                {
+                    const auto& boundary =
+                        sections.boundaries[record.first_boundary + b];
+                    if( boundary.index
+                        >= this->geomodel_.nb_mesh_entities(
+                               manager.boundary_entity_type( entity.type() ) ) )
+                    {
+                        throw RINGMeshException( "I/O", "Invalid boundary of ",
+                            entity, " in binary GeoModel file" );
+                    }
+                    add_boundary_relation(
+                        entity, boundary.index, boundary.side != 0 );
+                }
+            }
+            return entities;
+        }
+
+        void add_boundary_relation(
+            const gmme_id& entity, index_t boundary, bool side );
+
+        /*!
+         * @brief Loads the entity meshes in parallel, or gives them to a
+         * loader when their loading is deferred
+         */
+        void load_meshes(
+            const std::shared_ptr< const GeoModelBinaryFile >& file,
+            const GMBSections& sections,
+            const std::vector< gmme_id >& entities )
+        {
+            if( this->is_mesh_loading_deferred() )
+            {
+                using Loader = GeoModelMeshEntityLoaderGMB< DIMENSION >;
+                this->set_mesh_entity_loader(
+                    std::make_shared< Loader >( file, sections ), entities );
+                return;
+            }
+            std::atomic< bool > valid{ true };
+            Logger::instance()->set_minimal( true );
+            parallel_for( static_cast< index_t >( entities.size() ),
+                [&sections, &entities, &valid, this]( index_t r ) {
+                    if( !load_mesh(
+                            sections, entities[r], sections.mesh_entities[r] ) )
+                    {
+                        valid = false;
+                    }
+                } );
+            Logger::instance()->set_minimal( false );
+            if( !valid )
+            {
+                throw RINGMeshException( "I/O",
+                    "Invalid entity mesh in binary GeoModel file ",
+                    this->filename() );
+            }
+        }
+
+        bool load_mesh( const GMBSections& sections,
+            const gmme_id& entity,
+            const GMBMeshEntity& record );
+
+        bool load_mesh_base( const GMBSections& sections,
+            const gmme_id& entity,
+            const GMBMeshEntity& record )
+        {
+            const auto& manager =
+                this->geomodel_.entity_type_manager().mesh_entity_manager;
+            const auto id = entity.index();
+            if( manager.is_corner( entity.type() ) )
+            {
+                auto builder = this->geometry.create_corner_builder( id );
+                return load_gmb_mesh( sections, record, *builder,
+                    this->geomodel_.corner( id ).mesh() );
+            }
+            if( manager.is_line( entity.type() ) )
+            {
+                auto builder = this->geometry.create_line_builder( id );
+                return load_gmb_mesh( sections, record, *builder,
+                    this->geomodel_.line( id ).mesh() );
+            }
+            if( manager.is_surface( entity.type() ) )
+            {
+                auto builder = this->geometry.create_surface_builder( id );
+                return load_gmb_mesh( sections, record, *builder,
+                    this->geomodel_.surface( id ).mesh() );
+            }
+            return false;
+        }
+
+        void load_geology( const GMBSections& sections )
+        {
+            const auto& types = sections.geological_entity_types;
+            for( auto t : range( types.size() ) )
+            {
+                this->geology.create_geological_entities(
+                    GeologicalEntityType{ sections.string( types[t].name ) },
+                    static_cast< index_t >( types[t].nb_entities ) );
+            }
+            for( auto t : range( types.size() ) )
+            {
+                const GeologicalEntityType type{ sections.string(
+                    types[t].name ) };
+                const auto& child_type =
+                    this->geomodel_.entity_type_manager()
+                        .relationship_manager.child_type( type );
+                for( auto e :
+                    range( static_cast< index_t >( types[t].nb_entities ) ) )
+                {
+                    const auto& record =
+                        sections.geological_entities[types[t].first_entity + e];
+                    const gmge_id entity{ type, e };
+                    this->info.set_geological_entity_name(
+                        entity, sections.string( record.name ) );
+                    this->geology.set_geological_entity_geol_feature( entity,
+                        GeoModelGeologicalEntity< DIMENSION >::
+                            determine_geological_type( sections.string(
+                                record.geological_feature ) ) );
+                    for( auto c : range( record.nb_children ) )
+                    {
+                        const auto child =
+                            sections.children[record.first_child + c];
+                        if( child
+                            >= this->geomodel_.nb_mesh_entities( child_type ) )
+                        {
+                            throw RINGMeshException( "I/O",
+                                "Invalid child of ", entity,
+                                " in binary GeoModel file" );
+                        }
+                        this->geology.add_parent_children_relation(
+                            entity, { child_type, child } );
+                    }
+                }
+            }
+        }
+
+        /*!
+         * @brief Restores the GeoModelMesh vertices and the vertex map of
+         * each entity, so that they are not computed again
+         */
+        void load_geomodel_vertices( const GMBSections& sections,
+            const std::vector< gmme_id >& entities )
+        {
+            if( sections.geomodel_vertices.size() == 0 )
+            {
+                return;
+            }
+            auto& vertices = this->geomodel_.mesh.vertices;
+            vertices.assign_vertices( std::vector< double >(
+                sections.geomodel_vertices.data(),
+                sections.geomodel_vertices.data()
+                    + sections.geomodel_vertices.size() ) );
+            for( auto r : range( entities.size() ) )
+            {
+                const auto& record = sections.mesh_entities[r];
+                const auto* first = sections.geomodel_vertex_maps.data()
+                                    + record.first_vertex;
+                std::vector< index_t > vertex_map(
+                    first, first + record.nb_vertices );
+                for( auto vertex : vertex_map )
+                {
+                    if( vertex >= sections.nb_geomodel_vertices() )
+                    {
+                        throw RINGMeshException( "I/O",
+                            "Invalid GeoModelMesh vertex of ", entities[r],
+                            " in binary GeoModel file" );
+                    }
+                }
+                vertices.assign_vertex_mapping(
+                    entities[r], std::move( vertex_map ) );
+            }
+        }
+    };
+
+    template <>
+    void GeoModelBuilderGMB< 2 >::add_boundary_relation(
+        const gmme_id& entity, index_t boundary, bool side )
+    {
+        const auto& manager =
+            geomodel_.entity_type_manager().mesh_entity_manager;
+        if( manager.is_surface( entity.type() ) )
+        {
+            topology.add_surface_line_boundary_relation(
+                entity.index(), boundary, side );
+        }
+        else if( manager.is_line( entity.type() ) )
+        {
+            topology.add_line_corner_boundary_relation(
+                entity.index(), boundary );
+        }
+    }
+
+    template <>
+    void GeoModelBuilderGMB< 3 >::add_boundary_relation(
+        const gmme_id& entity, index_t boundary, bool side )
+    {
+        const auto& manager =
+            geomodel_.entity_type_manager().mesh_entity_manager;
+        if( manager.is_region( entity.type() ) )
+        {
+            topology.add_region_surface_boundary_relation(
+                entity.index(), boundary, side );
+        }
+        else if( manager.is_surface( entity.type() ) )
+        {
+            topology.add_surface_line_boundary_relation(
+                entity.index(), boundary );
+        }
+        else if( manager.is_line( entity.type() ) )
+        {
+            topology.add_line_corner_boundary_relation(
+                entity.index(), boundary );
+        }
+    }
+
+    template <>
+    bool GeoModelBuilderGMB< 2 >::load_mesh( const GMBSections& sections,
+        const gmme_id& entity,
+        const GMBMeshEntity& record )
+    {
+        return load_mesh_base( sections, entity, record );
+    }
+
+    template <>
+    bool GeoModelBuilderGMB< 3 >::load_mesh( const GMBSections& sections,
+        const gmme_id& entity,
+        const GMBMeshEntity& record )
+    {
+        if( geomodel_.entity_type_manager().mesh_entity_manager.is_region(
+                entity.type() ) )
+        {
+            auto builder = geometry.create_region_builder( entity.index() );
+            return load_gmb_mesh( sections, record, *builder,
+                geomodel_.region( entity.index() ).mesh() );
+        }
+        return load_mesh_base( sections, entity, record );
+    }
+
+    template < index_t DIMENSION >
+    class GeoModelHandlerGMB final : public GeoModelOutputHandler< DIMENSION >,
+                                     public GeoModelInputHandler< DIMENSION >
+    {
+    public:
+        void load(
+            const std::string& filename, GeoModel< DIMENSION >& geomodel ) final
+        {
+            GeoModelBuilderGMB< DIMENSION > builder{ geomodel, filename };
+            builder.build_geomodel();
+        }
+
+        void load_lazily( const std::string& filename,
+            GeoModel< DIMENSION >& geomodel ) final
+        {
+            GeoModelBuilderGMB< DIMENSION > builder{ geomodel, filename };
+            builder.defer_mesh_loading();
+            builder.load_geomodel();
+        }
+
+        void save( const GeoModel< DIMENSION >& geomodel,
+            const std::string& filename ) final
+        {
+            GMBContent content;
+            content.geomodel.push_back(
+                { content.add_string( geomodel.name() ) } );
+            save_all_gmb_mesh_entities( geomodel, content );
+            save_gmb_geological_entities( geomodel, content );
+            save_gmb_geomodel_vertices( geomodel, content );
+            save_gmb_sections( filename, DIMENSION, content.sections() );
+        }
+
+        index_t dimension( const std::string& filename ) const final
+        {
+            GeoModelBinaryFile file{ filename };
+            return file.dimension();
+        }
+
+        virtual ~GeoModelHandlerGMB() = default;
+    };
+
+    ALIAS_2D_AND_3D( GeoModelHandlerGMB );
+
+} // namespace
@@ -125,10 +125,10 @@ namespace
             out << "vertices" << EOL;
             out << geomodel_mesh.vertices.nb() << EOL;
             out << DIMENSION << EOL;
-            for( auto v : range( geomodel_mesh.vertices.nb() ) )
-            {
-                out << geomodel_mesh.vertices.vertex( v ) << EOL;
-            }
+            parallel_write_text( out, geomodel_mesh.vertices.nb(),
+                [&geomodel_mesh]( TextWriter& text, index_t v ) {
+                    text << geomodel_mesh.vertices.vertex( v ) << EOL;
+                } );
         }
     };
 
@@ -177,20 +177,20 @@ namespace
         index_t nb_cells{ geomodel_mesh.cells.nb() };
         out << "elements" << EOL;
         out << nb_cells << EOL;
-        for( auto c : range( nb_cells ) )
-        {
-            out << geomodel_mesh.cells.region( c ) + mfem_offset << " ";
-            out << cell_type_mfem[to_underlying_type(
-                       geomodel_mesh.cells.type( c ) )]
-                << " ";
-            for( auto v : range( geomodel_mesh.cells.nb_vertices( c ) ) )
-            {
-                out << geomodel_mesh.cells.vertex(
-                           ElementLocalVertex( c, cell2mfem[v] ) )
-                    << " ";
-            }
-            out << EOL;
-        }
+        parallel_write_text(
+            out, nb_cells, [&geomodel_mesh]( TextWriter& text, index_t c ) {
+                text << geomodel_mesh.cells.region( c ) + mfem_offset << " ";
+                text << cell_type_mfem[to_underlying_type(
+                            geomodel_mesh.cells.type( c ) )]
+                     << " ";
+                for( auto v : range( geomodel_mesh.cells.nb_vertices( c ) ) )
+                {
+                    text << geomodel_mesh.cells.vertex(
+                                ElementLocalVertex( c, cell2mfem[v] ) )
+                         << " ";
+                }
+                text << EOL;
+            } );
         out << EOL;
     }
 
@@ -201,18 +201,20 @@ namespace
         index_t nb_triangles{ geomodel_mesh.polygons.nb_triangle() };
         out << "elements" << EOL;
         out << nb_triangles << EOL;
-        for( auto c : range( nb_triangles ) )
-        {
-            out << geomodel_mesh.polygons.surface( c ) + mfem_offset << " ";
-            out << TRIANGLE << " ";
-            for( auto v : range( geomodel_mesh.polygons.nb_vertices( c ) ) )
-            {
-                out << geomodel_mesh.polygons.vertex(
-                           ElementLocalVertex( c, v ) )
-                    << " ";
-            }
-            out << EOL;
-        }
+        parallel_write_text( out, nb_triangles,
+            [&geomodel_mesh]( TextWriter& text, index_t c ) {
+                text << geomodel_mesh.polygons.surface( c ) + mfem_offset
+                     << " ";
+                text << TRIANGLE << " ";
+                for( auto v :
+                    range( geomodel_mesh.polygons.nb_vertices( c ) ) )
+                {
+                    text << geomodel_mesh.polygons.vertex(
+                                ElementLocalVertex( c, v ) )
+                         << " ";
+                }
+                text << EOL;
+            } );
         out << EOL;
     }
 
@@ -233,18 +235,20 @@ namespace
         const GeoModelMeshPolygons3D& polygons = geomodel_mesh.polygons;
         out << "boundary" << EOL;
         out << polygons.nb() << EOL;
-        for( auto p : range( polygons.nb() ) )
-        {
-            out << polygons.surface( p ) + mfem_offset << " ";
-            PolygonType polygon_type;
-            std::tie( polygon_type, std::ignore ) = polygons.type( p );
-            out << polygon_type_mfem[to_underlying_type( polygon_type )] << " ";
-            for( auto v : range( polygons.nb_vertices( p ) ) )
-            {
-                out << polygons.vertex( ElementLocalVertex( p, v ) ) << " ";
-            }
-            out << EOL;
-        }
+        parallel_write_text(
+            out, polygons.nb(), [&polygons]( TextWriter& text, index_t p ) {
+                text << polygons.surface( p ) + mfem_offset << " ";
+                PolygonType polygon_type;
+                std::tie( polygon_type, std::ignore ) = polygons.type( p );
+                text << polygon_type_mfem[to_underlying_type( polygon_type )]
+                     << " ";
+                for( auto v : range( polygons.nb_vertices( p ) ) )
+                {
+                    text << polygons.vertex( ElementLocalVertex( p, v ) )
+                         << " ";
+                }
+                text << EOL;
+            } );
         out << EOL;
     }
 
@@ -255,16 +259,16 @@ namespace
         const GeoModelMeshEdges2D& edges = geomodel_mesh.edges;
         out << "boundary" << EOL;
         out << edges.nb() << EOL;
-        for( auto p : range( edges.nb() ) )
-        {
-            out << edges.line( p ) + mfem_offset << " ";
-            out << SEGMENT << " ";
-            for( auto v : range( 2 ) )
-            {
-                out << edges.vertex( ElementLocalVertex( p, v ) ) << " ";
-            }
-            out << EOL;
-        }
+        parallel_write_text(
+            out, edges.nb(), [&edges]( TextWriter& text, index_t p ) {
+                text << edges.line( p ) + mfem_offset << " ";
+                text << SEGMENT << " ";
+                for( auto v : range( 2 ) )
+                {
+                    text << edges.vertex( ElementLocalVertex( p, v ) ) << " ";
+                }
+                text << EOL;
+            } );
         out << EOL;
     }
 }
@@ -336,25 +336,25 @@ namespace
                     dynamic_cast< const Surface3D& >( tsurf.child( j ) );
 
                 out << "TFACE" << EOL;
-                for( auto k : range( surface.nb_vertices() ) )
-                {
-                    out << "VRTX " << vertex_count << " " << surface.vertex( k )
-                        << EOL;
-                    vertex_count++;
-                }
-                for( auto k : range( surface.nb_mesh_elements() ) )
-                {
-                    out << "TRGL "
-                        << surface.mesh_element_vertex_index( { k, 0 } )
-                               + offset
-                        << " "
-                        << surface.mesh_element_vertex_index( { k, 1 } )
-                               + offset
-                        << " "
-                        << surface.mesh_element_vertex_index( { k, 2 } )
-                               + offset
-                        << EOL;
-                }
+                parallel_write_text( out, surface.nb_vertices(),
+                    [&surface, offset]( TextWriter& text, index_t k ) {
+                        text << "VRTX " << offset + k << " "
+                             << surface.vertex( k ) << EOL;
+                    } );
+                vertex_count += surface.nb_vertices();
+                parallel_write_text( out, surface.nb_mesh_elements(),
+                    [&surface, offset]( TextWriter& text, index_t k ) {
+                        text << "TRGL "
+                             << surface.mesh_element_vertex_index( { k, 0 } )
+                                    + offset
+                             << " "
+                             << surface.mesh_element_vertex_index( { k, 1 } )
+                                    + offset
+                             << " "
+                             << surface.mesh_element_vertex_index( { k, 2 } )
+                                    + offset
+                             << EOL;
+                    } );
                 for( auto k : range( surface.nb_boundaries() ) )
                 {
                     const auto& line = surface.boundary( k );
@@ -83,16 +83,1066 @@ namespace
     // in GMSH, a tag is a physical id (not used) or a geometry id
     index_t nb_of_tags = 2;
 
+    // Number of vertices of the GMSH elements used in RINGMesh
+    // indexed by the GMSH element type
+    index_t nb_vertices_in_gmsh_element[16] = { 0, 2, 3, 4, 4, 8, 6, 5, 0, 0,
+        0, 0, 0, 0, 0, 1 };
+
+    // Cell types of the GMSH volumetric elements indexed by the GMSH element
+    // type
+    CellType cell_type_of_gmsh_element[8] = { CellType::UNDEFINED,
+        CellType::UNDEFINED, CellType::UNDEFINED, CellType::UNDEFINED,
+        CellType::TETRAHEDRON, CellType::HEXAHEDRON, CellType::PRISM,
+        CellType::PYRAMID };
+
+    // The binary GMSH files store the sizes on 8 bytes and the tags on 4 bytes
+    using gmsh_size_t = std::uint64_t;
+    using gmsh_int_t = std::int32_t;
+
+    template < typename T >
+    void write_binary( std::ostream& out, const T& value )
+    {
+        out.write( reinterpret_cast< const char* >( &value ), sizeof( T ) );
+    }
+
+    template < typename T >
+    void write_binary( std::ostream& out, const std::vector< T >& values )
+    {
+        out.write( reinterpret_cast< const char* >( values.data() ),
+            static_cast< std::streamsize >( values.size() * sizeof( T ) ) );
+    }
+
+    /*!
+     * @brief Export for the binary GMSH format 4.1 which is described here:
+     * http://gmsh.info/doc/texinfo/gmsh.html#MSH-file-format
+     * @details Each mesh entity is a GMSH entity of its dimension (Corner 0,
+     * Line 1, Surface 2 and Region 3) tagged by its index + 1, bounded by
+     * the GMSH entities of its boundaries. The geological entities are saved
+     * as physical groups.
+     * A vertex is saved in the nodes of the first mesh entity in which it
+     * appears. The nodes and the elements are filled in parallel, one block
+     * at a time.
+     */
+    class MSHBinaryWriter
+    {
+    public:
+        MSHBinaryWriter(
+            const GeoModel3D& geomodel, const std::string& filename )
+            : geomodel_( geomodel ),
+              out_( filename.c_str(), std::ios::binary ),
+              types_( geomodel.entity_type_manager()
+                          .mesh_entity_manager.mesh_entity_types() )
+        {
+        }
+
+        void save()
+        {
+            out_ << "$MeshFormat" << EOL;
+            out_ << "4.1 1 " << sizeof( gmsh_size_t ) << EOL;
+            write_binary( out_, gmsh_int_t{ 1 } );
+            out_ << EOL << "$EndMeshFormat" << EOL;
+            save_physical_names();
+            save_entities();
+            save_nodes();
+            save_elements();
+            out_ << std::flush;
+        }
+
+    private:
+        struct ElementBlock
+        {
+            gmme_id entity;
+            index_t gmsh_type;
+            std::vector< index_t > elements;
+        };
+
+        index_t dimension( const MeshEntityType& type ) const
+        {
+            return static_cast< index_t >(
+                std::find( types_.begin(), types_.end(), type )
+                - types_.begin() );
+        }
+
+        std::vector< GeologicalEntityType > parent_types(
+            index_t dimension ) const
+        {
+            return geomodel_.entity_type_manager()
+                .relationship_manager.parent_types( types_[dimension] );
+        }
+
+        /*!
+         * @brief The physical groups of a dimension are the geological
+         * entities of all the parent types of this dimension
+         */
+        gmsh_int_t physical_tag(
+            index_t dimension, const gmge_id& geological_entity ) const
+        {
+            index_t offset{ 0 };
+            for( const auto& type : parent_types( dimension ) )
+            {
+                if( type == geological_entity.type() )
+                {
+                    break;
+                }
+                offset += geomodel_.nb_geological_entities( type );
+            }
+            return static_cast< gmsh_int_t >(
+                offset + geological_entity.index() + gmsh_offset );
+        }
+
+        void save_physical_names()
+        {
+            std::ostringstream names;
+            index_t nb_names{ 0 };
+            for( auto dimension : range( types_.size() ) )
+            {
+                for( const auto& type : parent_types( dimension ) )
+                {
+                    for( auto i :
+                        range( geomodel_.nb_geological_entities( type ) ) )
+                    {
+                        gmge_id id{ type, i };
+                        auto name = geomodel_.geological_entity( id ).name();
+                        if( name.empty() )
+                        {
+                            name = type.string() + "_" + std::to_string( i );
+                        }
+                        names << dimension << SPACE
+                              << physical_tag( dimension, id ) << " \""
+                              << name << "\"" << EOL;
+                        nb_names++;
+                    }
+                }
+            }
+            if( nb_names == 0 )
+            {
+                return;
+            }
+            out_ << "$PhysicalNames" << EOL;
+            out_ << nb_names << EOL;
+            out_ << names.str();
+            out_ << "$EndPhysicalNames" << EOL;
+        }
+
+        void save_tags( const std::vector< gmsh_int_t >& tags )
+        {
+            write_binary( out_, static_cast< gmsh_size_t >( tags.size() ) );
+            write_binary( out_, tags );
+        }
+
+        void save_physical_tags( const GeoModelMeshEntity3D& entity )
+        {
+            std::vector< gmsh_int_t > tags;
+            for( auto p : range( entity.nb_parents() ) )
+            {
+                tags.push_back( physical_tag( dimension( entity.type_name() ),
+                    entity.parent_gmge( p ) ) );
+            }
+            save_tags( tags );
+        }
+
+        /*!
+         * @brief Saves the bounding entities of a mesh entity
+         * @details As in GMSH, the second Corner of a Line is negative.
+         * The sign of a Region boundary is its side.
+         */
+        void save_bounding_tags( const GeoModelMeshEntity3D& entity )
+        {
+            auto entity_dimension = dimension( entity.type_name() );
+            std::vector< gmsh_int_t > tags;
+            for( auto b : range( entity.nb_boundaries() ) )
+            {
+                auto tag = static_cast< gmsh_int_t >(
+                    entity.boundary_gmme( b ).index() + gmsh_offset );
+                if( ( entity_dimension == 1 && b == 1 )
+                    || ( entity_dimension == 3
+                           && !geomodel_.region( entity.index() ).side( b ) ) )
+                {
+                    tag = -tag;
+                }
+                tags.push_back( tag );
+            }
+            save_tags( tags );
+        }
+
+        void save_bounding_box( const GeoModelMeshEntity3D& entity )
+        {
+            Box3D box;
+            for( auto v : range( entity.nb_vertices() ) )
+            {
+                box.add_point( entity.vertex( v ) );
+            }
+            write_binary( out_, box.min() );
+            write_binary( out_, box.max() );
+        }
+
+        void save_entities()
+        {
+            out_ << "$Entities" << EOL;
+            for( const auto& type : types_ )
+            {
+                write_binary( out_, static_cast< gmsh_size_t >(
+                                        geomodel_.nb_mesh_entities( type ) ) );
+            }
+            for( const auto& id : mesh_entities() )
+            {
+                const auto& entity = geomodel_.mesh_entity( id );
+                write_binary( out_,
+                    static_cast< gmsh_int_t >( id.index() + gmsh_offset ) );
+                if( dimension( id.type() ) == 0 )
+                {
+                    write_binary( out_, entity.vertex( 0 ) );
+                    save_physical_tags( entity );
+                }
+                else
+                {
+                    save_bounding_box( entity );
+                    save_physical_tags( entity );
+                    save_bounding_tags( entity );
+                }
+            }
+            out_ << EOL << "$EndEntities" << EOL;
+        }
+
+        std::vector< gmme_id > mesh_entities() const
+        {
+            std::vector< gmme_id > entities;
+            for( const auto& type : types_ )
+            {
+                for( auto e : range( geomodel_.nb_mesh_entities( type ) ) )
+                {
+                    entities.emplace_back( type, e );
+                }
+            }
+            return entities;
+        }
+
+        void save_block_header(
+            const gmme_id& entity, index_t value, std::size_t nb_values )
+        {
+            write_binary(
+                out_, static_cast< gmsh_int_t >( dimension( entity.type() ) ) );
+            write_binary( out_,
+                static_cast< gmsh_int_t >( entity.index() + gmsh_offset ) );
+            write_binary( out_, static_cast< gmsh_int_t >( value ) );
+            write_binary( out_, static_cast< gmsh_size_t >( nb_values ) );
+        }
+
+        /*!
+         * @brief Gets the vertices saved in the node block of each mesh entity
+         */
+        std::vector< std::vector< index_t > > node_blocks(
+            const std::vector< gmme_id >& entities ) const
+        {
+            const auto& vertices = geomodel_.mesh.vertices;
+            std::vector< bool > saved( vertices.nb(), false );
+            std::vector< std::vector< index_t > > blocks( entities.size() );
+            for( auto e : range( entities.size() ) )
+            {
+                const auto& entity = geomodel_.mesh_entity( entities[e] );
+                for( auto v : range( entity.nb_vertices() ) )
+                {
+                    auto vertex =
+                        vertices.geomodel_vertex_id( entities[e], v );
+                    if( !saved[vertex] )
+                    {
+                        saved[vertex] = true;
+                        blocks[e].push_back( vertex );
+                    }
+                }
+            }
+            return blocks;
+        }
+
+        void save_nodes()
+        {
+            const auto& vertices = geomodel_.mesh.vertices;
+            const auto entities = mesh_entities();
+            const auto blocks = node_blocks( entities );
+            auto nb_blocks = std::count_if( blocks.begin(), blocks.end(),
+                []( const std::vector< index_t >& block ) {
+                    return !block.empty();
+                } );
+
+            out_ << "$Nodes" << EOL;
+            write_binary( out_, static_cast< gmsh_size_t >( nb_blocks ) );
+            write_binary( out_, static_cast< gmsh_size_t >( vertices.nb() ) );
+            write_binary( out_, static_cast< gmsh_size_t >( gmsh_offset ) );
+            write_binary( out_, static_cast< gmsh_size_t >( vertices.nb() ) );
+            std::vector< gmsh_size_t > tags;
+            std::vector< double > coordinates;
+            for( auto e : range( entities.size() ) )
+            {
+                const auto& block = blocks[e];
+                if( block.empty() )
+                {
+                    continue;
+                }
+                // The nodes are not parametric
+                save_block_header( entities[e], 0, block.size() );
+                tags.resize( block.size() );
+                coordinates.resize( 3 * block.size() );
+                parallel_for( static_cast< index_t >( block.size() ),
+                    [&vertices, &block, &tags, &coordinates]( index_t v ) {
+                        tags[v] = block[v] + gmsh_offset;
+                        const auto& point = vertices.vertex( block[v] );
+                        for( auto i : range( 3 ) )
+                        {
+                            coordinates[3 * v + i] = point[i];
+                        }
+                    } );
+                write_binary( out_, tags );
+                write_binary( out_, coordinates );
+            }
+            out_ << EOL << "$EndNodes" << EOL;
+        }
+
+        /*!
+         * @brief Gets the elements of each mesh entity sorted by GMSH type
+         */
+        std::vector< ElementBlock > element_blocks() const
+        {
+            std::vector< ElementBlock > blocks;
+            for( const auto& id : mesh_entities() )
+            {
+                const auto& entity = geomodel_.mesh_entity( id );
+                auto entity_dimension = dimension( id.type() );
+                std::map< index_t, std::vector< index_t > > elements;
+                for( auto e : range( entity.nb_mesh_elements() ) )
+                {
+                    auto nb_vertices = entity.nb_mesh_element_vertices( e );
+                    auto type = nb_vertices + entity_dimension < 12
+                                    ? element_type[nb_vertices
+                                                   + entity_dimension]
+                                    : NO_ID;
+                    if( type == NO_ID )
+                    {
+                        throw RINGMeshException( "I/O", "Element ", e, " of ",
+                            id, " cannot be saved in GMSH format" );
+                    }
+                    elements[type].push_back( e );
+                }
+                for( auto& type_elements : elements )
+                {
+                    blocks.push_back( { id, type_elements.first,
+                        std::move( type_elements.second ) } );
+                }
+            }
+            return blocks;
+        }
+
+        void save_elements()
+        {
+            const auto blocks = element_blocks();
+            gmsh_size_t nb_elements{ 0 };
+            for( const auto& block : blocks )
+            {
+                nb_elements += block.elements.size();
+            }
+
+            out_ << "$Elements" << EOL;
+            write_binary( out_, static_cast< gmsh_size_t >( blocks.size() ) );
+            write_binary( out_, nb_elements );
+            write_binary( out_, static_cast< gmsh_size_t >( gmsh_offset ) );
+            write_binary( out_, nb_elements );
+            const auto& vertices = geomodel_.mesh.vertices;
+            std::vector< gmsh_size_t > values;
+            gmsh_size_t first_tag{ gmsh_offset };
+            for( const auto& block : blocks )
+            {
+                save_block_header(
+                    block.entity, block.gmsh_type, block.elements.size() );
+                const auto& entity = geomodel_.mesh_entity( block.entity );
+                auto nb_vertices = nb_vertices_in_gmsh_element[block.gmsh_type];
+                const auto* vertex_order =
+                    vertices_in_elements[nb_vertices
+                                         + dimension( block.entity.type() )];
+                values.resize( ( nb_vertices + 1 ) * block.elements.size() );
+                parallel_for( static_cast< index_t >( block.elements.size() ),
+                    [&vertices, &block, &entity, &values, nb_vertices,
+                        vertex_order, first_tag]( index_t e ) {
+                        auto* element = &values[( nb_vertices + 1 ) * e];
+                        element[0] = first_tag + e;
+                        for( auto v : range( nb_vertices ) )
+                        {
+                            element[v + 1] =
+                                vertices.geomodel_vertex_id( block.entity,
+                                    entity.mesh_element_vertex_index(
+                                        { block.elements[e],
+                                            vertex_order[v] } ) )
+                                + gmsh_offset;
+                        }
+                    } );
+                write_binary( out_, values );
+                first_tag += block.elements.size();
+            }
+            out_ << EOL << "$EndElements" << EOL;
+        }
+
+    private:
+        const GeoModel3D& geomodel_;
+        std::ofstream out_;
+        const std::vector< MeshEntityType >& types_;
+    };
+
+    /*!
+     * @brief Reads the sections of a binary GMSH file mapped in memory
+     */
+    class MSHBinaryReader
+    {
+    public:
+        explicit MSHBinaryReader( const MemoryMappedFile& file )
+            : current_( file.data() ), end_( file.data() + file.size() )
+        {
+        }
+
+        bool eof() const
+        {
+            return current_ == end_;
+        }
+
+        /*!
+         * @brief Reads the next non empty line
+         */
+        std::string read_line()
+        {
+            std::string line;
+            while( line.empty() && !eof() )
+            {
+                const auto* line_end = std::find( current_, end_, '\n' );
+                line.assign( current_, line_end );
+                if( !line.empty() && line.back() == '\r' )
+                {
+                    line.pop_back();
+                }
+                current_ = line_end == end_ ? end_ : line_end + 1;
+            }
+            return line;
+        }
+
+        template < typename T >
+        T read()
+        {
+            T value;
+            std::memcpy( &value, read_data( sizeof( T ) ), sizeof( T ) );
+            return value;
+        }
+
+        std::vector< gmsh_int_t > read_tags()
+        {
+            std::vector< gmsh_int_t > tags( read< gmsh_size_t >() );
+            std::memcpy( tags.data(),
+                read_data( tags.size() * sizeof( gmsh_int_t ) ),
+                tags.size() * sizeof( gmsh_int_t ) );
+            return tags;
+        }
+
+        /*!
+         * @brief Gets the next \p size bytes of the file
+         */
+        const char* read_data( std::size_t size )
+        {
+            if( static_cast< std::size_t >( end_ - current_ ) < size )
+            {
+                throw RINGMeshException( "I/O", "Unexpected end of file" );
+            }
+            const auto* data = current_;
+            current_ += size;
+            return data;
+        }
+
+        void read_section_end( const std::string& section )
+        {
+            if( read_line() != end_of_section( section ) )
+            {
+                throw RINGMeshException( "I/O", "Missing ",
+                    end_of_section( section ), " in the GMSH file" );
+            }
+        }
+
+        void skip_section( const std::string& section )
+        {
+            const auto end_tag = end_of_section( section );
+            current_ =
+                std::search( current_, end_, end_tag.begin(), end_tag.end() );
+            read_section_end( section );
+        }
+
+    private:
+        std::string end_of_section( const std::string& section ) const
+        {
+            return "$End" + section.substr( 1 );
+        }
+
+    private:
+        const char* current_;
+        const char* end_;
+    };
+
+    /*!
+     * @brief Builds a GeoModel3D from a binary GMSH 4.1 file
+     * @details The GMSH entities are the mesh entities and the physical
+     * groups are the geological entities, as saved by MSHBinaryWriter.
+     * The surface and region meshes are built in parallel.
+     */
+    class GeoModelBuilderMSH final : public GeoModelBuilderFile< 3 >
+    {
+    public:
+        GeoModelBuilderMSH( GeoModel3D& geomodel, std::string filename )
+            : GeoModelBuilderFile< 3 >( geomodel, std::move( filename ) )
+        {
+        }
+
+    private:
+        struct ElementBlock
+        {
+            index_t gmsh_type;
+            index_t nb_elements;
+            // Element tags followed by their node tags
+            const char* data;
+
+            gmsh_size_t node( index_t element, index_t v ) const
+            {
+                auto nb_values = nb_vertices_in_gmsh_element[gmsh_type] + 1;
+                gmsh_size_t tag;
+                std::memcpy( &tag,
+                    data
+                        + ( element * nb_values + v + 1 )
+                              * sizeof( gmsh_size_t ),
+                    sizeof( gmsh_size_t ) );
+                return tag;
+            }
+        };
+
+        struct MSHEntity
+        {
+            vec3 point;
+            std::vector< gmsh_int_t > physical_tags;
+            std::vector< gmsh_int_t > bounding_tags;
+            std::vector< ElementBlock > blocks;
+        };
+
+        void load_file() final
+        {
+            MemoryMappedFile file{ filename() };
+            MSHBinaryReader reader{ file };
+            auto section = reader.read_line();
+            if( section != "$MeshFormat" )
+            {
+                throw RINGMeshException(
+                    "I/O", "The GMSH file should begin with $MeshFormat" );
+            }
+            read_mesh_format( reader );
+            while( !reader.eof() )
+            {
+                section = reader.read_line();
+                if( section == "$PhysicalNames" )
+                {
+                    read_physical_names( reader );
+                }
+                else if( section == "$Entities" )
+                {
+                    read_entities( reader );
+                }
+                else if( section == "$Nodes" )
+                {
+                    read_nodes( reader );
+                }
+                else if( section == "$Elements" )
+                {
+                    read_elements( reader );
+                }
+                else if( !section.empty() )
+                {
+                    reader.skip_section( section );
+                }
+            }
+            info.set_geomodel_name(
+                GEO::FileSystem::base_name( filename() ) );
+            build_mesh_entities();
+            build_geological_entities();
+        }
+
+        void read_mesh_format( MSHBinaryReader& reader )
+        {
+            std::vector< std::string > format;
+            GEO::String::split_string( reader.read_line(), ' ', format );
+            if( format.size() != 3 || format[0] != "4.1" || format[1] != "1"
+                || format[2] != std::to_string( sizeof( gmsh_size_t ) ) )
+            {
+                throw RINGMeshException(
+                    "I/O", "Only binary GMSH 4.1 files can be loaded" );
+            }
+            if( reader.read< gmsh_int_t >() != 1 )
+            {
+                throw RINGMeshException(
+                    "I/O", "The GMSH file has a different endianness" );
+            }
+            reader.read_section_end( "$MeshFormat" );
+        }
+
+        void read_physical_names( MSHBinaryReader& reader )
+        {
+            auto nb_names = GEO::String::to_uint( reader.read_line() );
+            for( auto n : range( nb_names ) )
+            {
+                ringmesh_unused( n );
+                auto line = reader.read_line();
+                auto name_begin = line.find( '"' );
+                auto name_end = line.rfind( '"' );
+                if( name_begin == std::string::npos || name_end == name_begin )
+                {
+                    throw RINGMeshException(
+                        "I/O", "Invalid physical name: ", line );
+                }
+                std::istringstream fields( line.substr( 0, name_begin ) );
+                index_t dimension;
+                gmsh_int_t tag;
+                fields >> dimension >> tag;
+                if( dimension < 4 )
+                {
+                    physical_names_[dimension][tag] = line.substr(
+                        name_begin + 1, name_end - name_begin - 1 );
+                }
+            }
+            reader.read_section_end( "$PhysicalNames" );
+        }
+
+        void read_entities( MSHBinaryReader& reader )
+        {
+            gmsh_size_t nb_entities[4];
+            for( auto& nb : nb_entities )
+            {
+                nb = reader.read< gmsh_size_t >();
+            }
+            for( auto dimension : range( 4 ) )
+            {
+                for( auto e : range( nb_entities[dimension] ) )
+                {
+                    auto tag = reader.read< gmsh_int_t >();
+                    MSHEntity entity;
+                    if( dimension == 0 )
+                    {
+                        entity.point = reader.read< vec3 >();
+                    }
+                    else
+                    {
+                        // Skip the bounding box
+                        reader.read_data( 2 * sizeof( vec3 ) );
+                    }
+                    entity.physical_tags = reader.read_tags();
+                    if( dimension != 0 )
+                    {
+                        entity.bounding_tags = reader.read_tags();
+                    }
+                    entity_indices_[dimension][tag] = e;
+                    entities_[dimension].push_back( std::move( entity ) );
+                }
+            }
+            reader.read_section_end( "$Entities" );
+        }
+
+        void read_nodes( MSHBinaryReader& reader )
+        {
+            auto nb_blocks = reader.read< gmsh_size_t >();
+            reader.read< gmsh_size_t >();
+            reader.read< gmsh_size_t >();
+            auto max_tag = reader.read< gmsh_size_t >();
+            nodes_.resize( max_tag + 1 );
+            for( auto b : range( nb_blocks ) )
+            {
+                ringmesh_unused( b );
+                reader.read< gmsh_int_t >();
+                reader.read< gmsh_int_t >();
+                if( reader.read< gmsh_int_t >() != 0 )
+                {
+                    throw RINGMeshException(
+                        "I/O", "Parametric GMSH nodes are not supported" );
+                }
+                auto nb_nodes =
+                    static_cast< index_t >( reader.read< gmsh_size_t >() );
+                const auto* tags =
+                    reader.read_data( nb_nodes * sizeof( gmsh_size_t ) );
+                const auto* points =
+                    reader.read_data( nb_nodes * sizeof( vec3 ) );
+                parallel_for(
+                    nb_nodes, [this, tags, points, max_tag]( index_t n ) {
+                        gmsh_size_t tag;
+                        std::memcpy( &tag, tags + n * sizeof( gmsh_size_t ),
+                            sizeof( gmsh_size_t ) );
+                        if( tag > max_tag )
+                        {
+                            throw RINGMeshException(
+                                "I/O", "Invalid GMSH node tag ", tag );
+                        }
+                        std::memcpy( &nodes_[tag], points + n * sizeof( vec3 ),
+                            sizeof( vec3 ) );
+                    } );
+            }
+            reader.read_section_end( "$Nodes" );
+        }
+
+        void read_elements( MSHBinaryReader& reader )
+        {
+            auto nb_blocks = reader.read< gmsh_size_t >();
+            reader.read< gmsh_size_t >();
+            reader.read< gmsh_size_t >();
+            reader.read< gmsh_size_t >();
+            for( auto b : range( nb_blocks ) )
+            {
+                ringmesh_unused( b );
+                auto dimension =
+                    static_cast< index_t >( reader.read< gmsh_int_t >() );
+                auto tag = reader.read< gmsh_int_t >();
+                auto type =
+                    static_cast< index_t >( reader.read< gmsh_int_t >() );
+                auto nb_elements =
+                    static_cast< index_t >( reader.read< gmsh_size_t >() );
+                if( type >= 16 || nb_vertices_in_gmsh_element[type] == 0 )
+                {
+                    throw RINGMeshException(
+                        "I/O", "Unsupported GMSH element type ", type );
+                }
+                const auto* data = reader.read_data(
+                    static_cast< std::size_t >( nb_elements )
+                    * ( nb_vertices_in_gmsh_element[type] + 1 )
+                    * sizeof( gmsh_size_t ) );
+                entity( dimension, tag )
+                    .blocks.push_back( { type, nb_elements, data } );
+            }
+            reader.read_section_end( "$Elements" );
+        }
+
+        MSHEntity& entity( index_t dimension, gmsh_int_t tag )
+        {
+            return entities_[dimension][entity_index( dimension, tag )];
+        }
+
+        index_t entity_index( index_t dimension, gmsh_int_t tag ) const
+        {
+            if( dimension < 4 )
+            {
+                auto it = entity_indices_[dimension].find( std::abs( tag ) );
+                if( it != entity_indices_[dimension].end() )
+                {
+                    return it->second;
+                }
+            }
+            throw RINGMeshException( "I/O", "Unknown GMSH entity ", tag,
+                " of dimension ", dimension );
+        }
+
+        const vec3& node( gmsh_size_t tag ) const
+        {
+            if( tag >= nodes_.size() )
+            {
+                throw RINGMeshException( "I/O", "Invalid GMSH node tag ", tag );
+            }
+            return nodes_[tag];
+        }
+
+        void build_mesh_entities()
+        {
+            const auto& types = geomodel_.entity_type_manager()
+                                    .mesh_entity_manager.mesh_entity_types();
+            for( auto dimension : range( 4 ) )
+            {
+                topology.create_mesh_entities( types[dimension],
+                    static_cast< index_t >( entities_[dimension].size() ) );
+            }
+            for( auto c : range( geomodel_.nb_corners() ) )
+            {
+                geometry.set_corner( c, entities_[0][c].point );
+            }
+            for( auto l : range( geomodel_.nb_lines() ) )
+            {
+                build_line( l );
+            }
+            auto nb_surfaces = geomodel_.nb_surfaces();
+            parallel_for(
+                nb_surfaces + geomodel_.nb_regions(), [this, nb_surfaces](
+                                                          index_t e ) {
+                    if( e < nb_surfaces )
+                    {
+                        build_surface( e );
+                    }
+                    else
+                    {
+                        build_region( e - nb_surfaces );
+                    }
+                } );
+            build_boundaries();
+        }
+
+        /*!
+         * @brief Builds a Line from its edges, given in the Line order
+         */
+        void build_line( index_t line_id )
+        {
+            std::vector< vec3 > vertices;
+            for( const auto& block : entities_[1][line_id].blocks )
+            {
+                for( auto e : range( block.nb_elements ) )
+                {
+                    if( vertices.empty() )
+                    {
+                        vertices.push_back( node( block.node( e, 0 ) ) );
+                    }
+                    vertices.push_back( node( block.node( e, 1 ) ) );
+                }
+            }
+            geometry.set_line( line_id, vertices );
+        }
+
+        /*!
+         * @brief Gets the mesh entity vertex indices of the element nodes
+         */
+        std::vector< index_t > element_vertices( const ElementBlock& block,
+            index_t element,
+            std::vector< vec3 >& points,
+            std::unordered_map< gmsh_size_t, index_t >& vertex_indices ) const
+        {
+            auto nb_vertices = nb_vertices_in_gmsh_element[block.gmsh_type];
+            std::vector< index_t > vertices( nb_vertices );
+            for( auto v : range( nb_vertices ) )
+            {
+                auto tag = block.node( element, v );
+                auto it = vertex_indices.emplace(
+                    tag, static_cast< index_t >( points.size() ) );
+                if( it.second )
+                {
+                    points.push_back( node( tag ) );
+                }
+                vertices[v] = it.first->second;
+            }
+            return vertices;
+        }
+
+        void build_surface( index_t surface_id )
+        {
+            std::vector< vec3 > points;
+            std::unordered_map< gmsh_size_t, index_t > vertex_indices;
+            std::vector< index_t > polygons;
+            std::vector< index_t > polygon_ptr{ 0 };
+            for( const auto& block : entities_[2][surface_id].blocks )
+            {
+                for( auto e : range( block.nb_elements ) )
+                {
+                    auto vertices =
+                        element_vertices( block, e, points, vertex_indices );
+                    polygons.insert(
+                        polygons.end(), vertices.begin(), vertices.end() );
+                    polygon_ptr.push_back(
+                        static_cast< index_t >( polygons.size() ) );
+                }
+            }
+            auto builder = geometry.create_surface_builder( surface_id );
+            builder->create_vertices( static_cast< index_t >( points.size() ) );
+            for( auto v : range( points.size() ) )
+            {
+                builder->set_vertex( v, points[v] );
+            }
+            builder->create_polygons( polygons, polygon_ptr );
+            builder->connect_polygons();
+        }
+
+        void build_region( index_t region_id )
+        {
+            std::vector< vec3 > points;
+            std::unordered_map< gmsh_size_t, index_t > vertex_indices;
+            const auto& blocks = entities_[3][region_id].blocks;
+            std::vector< std::vector< index_t > > cells( blocks.size() );
+            for( auto b : range( blocks.size() ) )
+            {
+                const auto& block = blocks[b];
+                if( block.gmsh_type >= 8
+                    || cell_type_of_gmsh_element[block.gmsh_type]
+                           == CellType::UNDEFINED )
+                {
+                    throw RINGMeshException( "I/O", "GMSH element type ",
+                        block.gmsh_type, " is not a cell" );
+                }
+                for( auto e : range( block.nb_elements ) )
+                {
+                    auto vertices =
+                        element_vertices( block, e, points, vertex_indices );
+                    cells[b].insert(
+                        cells[b].end(), vertices.begin(), vertices.end() );
+                }
+            }
+
+            auto builder = geometry.create_region_builder( region_id );
+            builder->create_vertices( static_cast< index_t >( points.size() ) );
+            for( auto v : range( points.size() ) )
+            {
+                builder->set_vertex( v, points[v] );
+            }
+            for( auto b : range( blocks.size() ) )
+            {
+                const auto& block = blocks[b];
+                auto nb_vertices = nb_vertices_in_gmsh_element[block.gmsh_type];
+                const auto* vertex_order =
+                    vertices_in_elements[nb_vertices + 3];
+                auto first_cell = builder->create_cells( block.nb_elements,
+                    cell_type_of_gmsh_element[block.gmsh_type] );
+                for( auto e : range( block.nb_elements ) )
+                {
+                    for( auto v : range( nb_vertices ) )
+                    {
+                        builder->set_cell_vertex(
+                            { first_cell + e, vertex_order[v] },
+                            cells[b][e * nb_vertices + v] );
+                    }
+                }
+            }
+            builder->connect_cells();
+        }
+
+        void build_boundaries()
+        {
+            for( auto l : range( geomodel_.nb_lines() ) )
+            {
+                for( auto tag : entities_[1][l].bounding_tags )
+                {
+                    topology.add_line_corner_boundary_relation(
+                        l, entity_index( 0, tag ) );
+                }
+            }
+            for( auto s : range( geomodel_.nb_surfaces() ) )
+            {
+                for( auto tag : entities_[2][s].bounding_tags )
+                {
+                    topology.add_surface_line_boundary_relation(
+                        s, entity_index( 1, tag ) );
+                }
+            }
+            for( auto r : range( geomodel_.nb_regions() ) )
+            {
+                for( auto tag : entities_[3][r].bounding_tags )
+                {
+                    topology.add_region_surface_boundary_relation(
+                        r, entity_index( 2, tag ), tag > 0 );
+                }
+            }
+        }
+
+        /*!
+         * @brief Finds the first registered geological entity type whose
+         * children are of the given mesh entity type
+         */
+        GeologicalEntityType parent_type( const MeshEntityType& type ) const
+        {
+            for( const auto& parent_type :
+                GeoModelGeologicalEntityFactory3D::list_creators() )
+            {
+                auto entity = GeoModelGeologicalEntityFactory3D::create(
+                    parent_type, geomodel_ );
+                if( entity->child_type_name() == type )
+                {
+                    return parent_type;
+                }
+            }
+            return ForbiddenGeologicalEntityType::type_name_static();
+        }
+
+        /*!
+         * @brief Creates the geological entities from the physical groups
+         * @details The physical groups of a dimension are the geological
+         * entities of the type whose children have this dimension.
+         */
+        void build_geological_entities()
+        {
+            const auto& types = geomodel_.entity_type_manager()
+                                    .mesh_entity_manager.mesh_entity_types();
+            for( auto dimension : range( 4 ) )
+            {
+                const auto type = parent_type( types[dimension] );
+                if( type == ForbiddenGeologicalEntityType::type_name_static() )
+                {
+                    continue;
+                }
+                std::map< gmsh_int_t, index_t > groups;
+                for( const auto& physical_name : physical_names_[dimension] )
+                {
+                    groups.emplace( physical_name.first, 0 );
+                }
+                for( const auto& entity : entities_[dimension] )
+                {
+                    for( auto tag : entity.physical_tags )
+                    {
+                        groups.emplace( tag, 0 );
+                    }
+                }
+                if( groups.empty() )
+                {
+                    continue;
+                }
+                auto nb_groups = static_cast< index_t >( groups.size() );
+                geology.create_geological_entities( type, nb_groups );
+                auto id = geomodel_.nb_geological_entities( type ) - nb_groups;
+                for( auto& group : groups )
+                {
+                    group.second = id++;
+                    auto name = physical_names_[dimension].find( group.first );
+                    if( name != physical_names_[dimension].end() )
+                    {
+                        info.set_geological_entity_name(
+                            { type, group.second }, name->second );
+                    }
+                }
+                for( auto e : range( entities_[dimension].size() ) )
+                {
+                    for( auto tag : entities_[dimension][e].physical_tags )
+                    {
+                        geology.add_parent_children_relation(
+                            { type, groups[tag] }, { types[dimension], e } );
+                    }
+                }
+            }
+        }
+
+    private:
+        std::map< gmsh_int_t, std::string > physical_names_[4];
+        std::map< gmsh_int_t, index_t > entity_indices_[4];
+        std::vector< MSHEntity > entities_[4];
+        std::vector< vec3 > nodes_;
+    };
+
     /*!
      * @brief Export for the GMSH format 2.2 which is described here:
      * http://gmsh.info/doc/texinfo/gmsh.html#MSH-ASCII-file-format
      * NB : Mesh entities are also exported
+     * The binary GMSH format 4.1 is used with "out:msh_binary=true",
+     * only this format can be loaded.
      */
-    class MSHIOHandler final : public GeoModelOutputHandler3D
+    class MSHIOHandler final : public GeoModelInputHandler3D,
+                               public GeoModelOutputHandler3D
     {
     public:
+        void load( const std::string& filename, GeoModel3D& geomodel ) final
+        {
+            GeoModelBuilderMSH builder{ geomodel, filename };
+            builder.build_geomodel();
+        }
+
         void save(
             const GeoModel3D& geomodel, const std::string& filename ) final
+        {
+            if( GEO::String::to_bool(
+                    output_option( "out:msh_binary", "false" ) ) )
+            {
+                MSHBinaryWriter writer{ geomodel, filename };
+                writer.save();
+            }
+            else
+            {
+                save_ascii( geomodel, filename );
+            }
+        }
+
+    private:
+        void save_ascii(
+            const GeoModel3D& geomodel, const std::string& filename )
         {
             std::ofstream out( filename.c_str() );
             out.precision( 16 );
@@ -103,11 +1153,11 @@ namespace
 
             out << "$Nodes" << EOL;
             out << geomodel.mesh.vertices.nb() << EOL;
-            for( auto v : range( geomodel.mesh.vertices.nb() ) )
-            {
-                out << v + gmsh_offset << SPACE
-                    << geomodel.mesh.vertices.vertex( v ) << EOL;
-            }
+            parallel_write_text( out, geomodel.mesh.vertices.nb(),
+                [&geomodel]( TextWriter& text, index_t v ) {
+                    text << v + gmsh_offset << SPACE
+                         << geomodel.mesh.vertices.vertex( v ) << EOL;
+                } );
             out << "$EndNodes" << EOL;
 
             out << "$Elements" << EOL;
@@ -130,49 +1180,64 @@ namespace
                         index_of_gmme_of_the_current_type );
                     const GeoModelMeshEntity< 3 >& cur_gmme =
                         geomodel.mesh_entity( cur_gmme_id );
-                    for( auto elem_in_cur_gmme :
-                        range( cur_gmme.nb_mesh_elements() ) )
-                    {
-                        index_t nb_vertices_in_cur_element =
-                            cur_gmme.nb_mesh_element_vertices(
-                                elem_in_cur_gmme );
-                        index_t gmsh_element_type = find_gmsh_element_type(
-                            nb_vertices_in_cur_element, gmme_type_index );
-                        out << element_index++ << SPACE << gmsh_element_type
-                            << SPACE << nb_of_tags << SPACE << physical_id
-                            << SPACE
-                            << index_of_gmme_of_the_current_type + gmsh_offset
-                            << SPACE /*<< nb_vertices_in_cur_element << SPACE*/;
-                        for( auto v_index_in_cur_element :
-                            range( nb_vertices_in_cur_element ) )
-                        {
-                            out << geomodel.mesh.vertices.geomodel_vertex_id(
-                                       cur_gmme_id,
-                                       cur_gmme.mesh_element_vertex_index(
-                                           ElementLocalVertex( elem_in_cur_gmme,
-                                               find_gmsh_element_local_vertex_id(
-                                                   nb_vertices_in_cur_element,
-                                                   gmme_type_index,
-                                                   v_index_in_cur_element ) ) ) )
-                                       + gmsh_offset
-                                << SPACE;
-                        }
-                        out << EOL;
-                    }
+                    parallel_write_text( out, cur_gmme.nb_mesh_elements(),
+                        [this, &geomodel, &cur_gmme, &cur_gmme_id,
+                            gmme_type_index, element_index,
+                            index_of_gmme_of_the_current_type](
+                            TextWriter& text, index_t elem_in_cur_gmme ) {
+                            write_element( geomodel, cur_gmme_id, cur_gmme,
+                                gmme_type_index,
+                                index_of_gmme_of_the_current_type,
+                                element_index + elem_in_cur_gmme,
+                                elem_in_cur_gmme, text );
+                        } );
+                    element_index += cur_gmme.nb_mesh_elements();
                 }
             }
             out << "$EndElements" << EOL;
             out << std::flush;
         }
 
-    private:
+        void write_element( const GeoModel3D& geomodel,
+            const gmme_id& cur_gmme_id,
+            const GeoModelMeshEntity3D& cur_gmme,
+            index_t gmme_type_index,
+            index_t index_of_gmme_of_the_current_type,
+            index_t element_index,
+            index_t elem_in_cur_gmme,
+            TextWriter& text ) const
+        {
+            index_t nb_vertices_in_cur_element =
+                cur_gmme.nb_mesh_element_vertices( elem_in_cur_gmme );
+            index_t gmsh_element_type = find_gmsh_element_type(
+                nb_vertices_in_cur_element, gmme_type_index );
+            text << element_index << SPACE << gmsh_element_type << SPACE
+                 << nb_of_tags << SPACE << physical_id << SPACE
+                 << index_of_gmme_of_the_current_type + gmsh_offset << SPACE;
+            for( auto v_index_in_cur_element :
+                range( nb_vertices_in_cur_element ) )
+            {
+                text << geomodel.mesh.vertices.geomodel_vertex_id(
+                            cur_gmme_id,
+                            cur_gmme.mesh_element_vertex_index(
+                                ElementLocalVertex( elem_in_cur_gmme,
+                                    find_gmsh_element_local_vertex_id(
+                                        nb_vertices_in_cur_element,
+                                        gmme_type_index,
+                                        v_index_in_cur_element ) ) ) )
+                            + gmsh_offset
+                     << SPACE;
+            }
+            text << EOL;
+        }
+
         /*!
          * @brief Find the gmsh type on an element using
          * the number of vertices and the mesh entity index
          * in which the element belong
          */
         index_t find_gmsh_element_type(
-            index_t nb_vertices, index_t mesh_entity_type_index )
+            index_t nb_vertices, index_t mesh_entity_type_index ) const
         {
             return element_type[nb_vertices + mesh_entity_type_index];
         }
@@ -184,7 +1249,7 @@ namespace
          */
         index_t find_gmsh_element_local_vertex_id( index_t nb_vertices,
             index_t mesh_entity_type_index,
-            index_t local_vertex_index )
+            index_t local_vertex_index ) const
         {
             return vertices_in_elements[nb_vertices + mesh_entity_type_index]
                                        [local_vertex_index];
@@ -60,12 +60,12 @@ namespace
                 << EOL;
             out << geomodel.mesh.vertices.nb() << " 3 0 0" << EOL;
             out << "# node index, node coordinates " << EOL;
-            for( auto p : range( geomodel.mesh.vertices.nb() ) )
-            {
-                const vec3& V = geomodel.mesh.vertices.vertex( p );
-                out << p << " "
-                    << " " << V.x << " " << V.y << " " << V.z << EOL;
-            }
+            parallel_write_text( out, geomodel.mesh.vertices.nb(),
+                [&geomodel]( TextWriter& text, index_t p ) {
+                    const vec3& V = geomodel.mesh.vertices.vertex( p );
+                    text << p << " "
+                         << " " << V.x << " " << V.y << " " << V.z << EOL;
+                } );
 
             /// 2. Write the triangles
             out << "# Part 2 - facet list" << EOL;
@@ -74,18 +74,19 @@ namespace
 
             for( const auto& surface : geomodel.surfaces() )
             {
-                for( auto p : range( surface.nb_mesh_elements() ) )
-                {
-                    out << surface.nb_mesh_element_vertices( p ) << " ";
-                    for( auto v :
-                        range( surface.nb_mesh_element_vertices( p ) ) )
-                    {
-                        out << geomodel.mesh.vertices.geomodel_vertex_id(
-                                   surface.gmme(), ElementLocalVertex( p, v ) )
-                            << " ";
-                    }
-                    out << EOL;
-                }
+                parallel_write_text( out, surface.nb_mesh_elements(),
+                    [&geomodel, &surface]( TextWriter& text, index_t p ) {
+                        text << surface.nb_mesh_element_vertices( p ) << " ";
+                        for( auto v :
+                            range( surface.nb_mesh_element_vertices( p ) ) )
+                        {
+                            text << geomodel.mesh.vertices.geomodel_vertex_id(
+                                        surface.gmme(),
+                                        ElementLocalVertex( p, v ) )
+                                 << " ";
+                        }
+                        text << EOL;
+                    } );
             }
 
             // Do not forget the stupid zeros at the end of the file
@@ -46,18 +46,18 @@ namespace
     }
 
     void save_normal(
-        const GeoModel3D& geomodel, index_t triangle_id, std::ostream& out )
+        const GeoModel3D& geomodel, index_t triangle_id, TextWriter& out )
     {
         out << "facet normal " << geomodel.mesh.polygons.normal( triangle_id )
             << EOL;
     }
 
-    void begin_triangle( std::ostream& out )
+    void begin_triangle( TextWriter& out )
     {
         out << "outer loop" << EOL;
     }
 
-    void end_triangle( std::ostream& out )
+    void end_triangle( TextWriter& out )
     {
         out << "endloop" << EOL;
 	out << "endfacet" << EOL;
@@ -66,7 +66,7 @@ namespace
     void save_triangle_vertex( const GeoModel3D& geomodel,
         index_t triangle_id,
         index_t local_vertex_id,
-        std::ostream& out )
+        TextWriter& out )
     {
         out << "vertex "
             << geomodel.mesh.vertices.vertex( geomodel.mesh.polygons.vertex(
@@ -75,7 +75,7 @@ namespace
     }
 
     void save_triangle(
-        const GeoModel3D& geomodel, index_t triangle_id, std::ostream& out )
+        const GeoModel3D& geomodel, index_t triangle_id, TextWriter& out )
     {
         save_normal( geomodel, triangle_id, out );
         begin_triangle( out );
@@ -88,10 +88,138 @@ namespace
 
     void save_triangles( const GeoModel3D& geomodel, std::ostream& out )
     {
-        for( auto triangle : range( geomodel.mesh.polygons.nb_triangle() ) )
+        parallel_write_text( out, geomodel.mesh.polygons.nb_triangle(),
+            [&geomodel]( TextWriter& text, index_t triangle ) {
+                save_triangle( geomodel, triangle, text );
+            },
+            17 );
+    }
+
+    // Size of the header of a binary STL file
+    const std::size_t STL_HEADER_SIZE = 80;
+    // Size of a triangle in a binary STL file: a normal, three vertices
+    // (12 floats) and a 2 bytes attribute
+    const std::size_t STL_TRIANGLE_SIZE = 50;
+
+    /*!
+     * @brief Copies a value in little endian, as required by the binary STL
+     * format
+     * @return the position after the copied value
+     */
+    template < typename T >
+    char* copy_little_endian( T value, char* buffer )
+    {
+        std::memcpy( buffer, &value, sizeof( T ) );
+        if( is_big_endian() )
+        {
+            std::reverse( buffer, buffer + sizeof( T ) );
+        }
+        return buffer + sizeof( T );
+    }
+
+    char* copy_binary_point( const vec3& point, char* buffer )
+    {
+        for( auto i : range( 3 ) )
+        {
+            buffer =
+                copy_little_endian( static_cast< float >( point[i] ), buffer );
+        }
+        return buffer;
+    }
+
+    /*!
+     * @brief Fills the 50 bytes of a triangle in a binary STL file
+     * @details The attribute bytes store the index of the triangle Surface
+     * if \p save_surface is true, 0 otherwise
+     */
+    void save_binary_triangle( const GeoModel3D& geomodel,
+        index_t triangle_id,
+        bool save_surface,
+        char* buffer )
+    {
+        const auto& polygons = geomodel.mesh.polygons;
+        buffer = copy_binary_point( polygons.normal( triangle_id ), buffer );
+        for( auto vertex : range( 3 ) )
         {
-            save_triangle( geomodel, triangle, out );
+            buffer = copy_binary_point(
+                geomodel.mesh.vertices.vertex( polygons.vertex(
+                    ElementLocalVertex( triangle_id, vertex ) ) ),
+                buffer );
         }
+        std::uint16_t attribute{ 0 };
+        if( save_surface )
+        {
+            attribute =
+                static_cast< std::uint16_t >( polygons.surface( triangle_id ) );
+        }
+        copy_little_endian( attribute, buffer );
+    }
+
+    /*!
+     * @brief Saves the triangles in blocks filled in parallel
+     * @details The Surface indices are only saved if they fit in the 2
+     * attribute bytes of the triangles
+     */
+    void save_binary_triangles( const GeoModel3D& geomodel, std::ostream& out )
+    {
+        const index_t max_nb_surfaces{
+            std::numeric_limits< std::uint16_t >::max() + 1
+        };
+        auto save_surface = geomodel.nb_surfaces() <= max_nb_surfaces;
+        if( !save_surface )
+        {
+            Logger::warn( "I/O", "The GeoModel has ", geomodel.nb_surfaces(),
+                " Surfaces, their indices cannot be saved in the 2 attribute ",
+                "bytes of the binary STL triangles. They are set to 0." );
+        }
+        const index_t block_size{ 65536 };
+        const auto nb_triangles = geomodel.mesh.polygons.nb_triangle();
+        std::vector< char > buffer;
+        for( index_t first = 0; first < nb_triangles; first += block_size )
+        {
+            auto nb_in_block = std::min( block_size, nb_triangles - first );
+            buffer.resize( nb_in_block * STL_TRIANGLE_SIZE );
+            auto* data = buffer.data();
+            parallel_for( nb_in_block,
+                [&geomodel, first, save_surface, data]( index_t t ) {
+                    save_binary_triangle( geomodel, first + t, save_surface,
+                        data + t * STL_TRIANGLE_SIZE );
+                } );
+            out.write( data, static_cast< std::streamsize >( buffer.size() ) );
+        }
+    }
+
+    /*!
+     * @brief Saves the geomodel in the binary STL format
+     * @details The header must not begin with "solid", otherwise the file
+     * could be read as an ASCII file.
+     */
+    void save_binary_stl(
+        const GeoModel3D& geomodel, const std::string& filename )
+    {
+        std::ofstream out( filename.c_str(), std::ios::binary );
+        std::string header{ "RINGMesh binary STL " + geomodel.name() };
+        header.resize( STL_HEADER_SIZE, ' ' );
+        out.write( header.data(), STL_HEADER_SIZE );
+
+        char nb_triangles[sizeof( std::uint32_t )];
+        copy_little_endian( static_cast< std::uint32_t >(
+                                geomodel.mesh.polygons.nb_triangle() ),
+            nb_triangles );
+        out.write( nb_triangles, sizeof( std::uint32_t ) );
+        save_binary_triangles( geomodel, out );
+        out << std::flush;
+    }
+
+    void save_ascii_stl(
+        const GeoModel3D& geomodel, const std::string& filename )
+    {
+        std::ofstream out( filename.c_str() );
+        out.precision( 17 );
+        save_header( geomodel, out );
+        save_triangles( geomodel, out );
+        save_footer( geomodel, out );
+        out << std::flush;
     }
 
     void check_stl_validity( const GeoModel3D& geomodel )
@@ -107,6 +235,7 @@ namespace
     /*!
      * STL is an (old) file format used in CAD software
      * This is the ASCII export for this format
+     * (the binary one is used with "out:stl_binary=true")
      * facet normal ni nj nk
      *   outer loop
      *      vertex v1x v1y v1z
@@ -122,12 +251,15 @@ namespace
             const GeoModel3D& geomodel, const std::string& filename ) final
         {
             check_stl_validity( geomodel );
-            std::ofstream out( filename.c_str() );
-            out.precision( 17 );
-            save_header( geomodel, out );
-            save_triangles( geomodel, out );
-            save_footer( geomodel, out );
-            out << std::flush;
+            if( GEO::String::to_bool(
+                    output_option( "out:stl_binary", "false" ) ) )
+            {
+                save_binary_stl( geomodel, filename );
+            }
+            else
+            {
+                save_ascii_stl( geomodel, filename );
+            }
         }
     };
 }
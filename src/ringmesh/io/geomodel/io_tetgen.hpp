@@ -51,10 +51,10 @@ namespace
 
             const GeoModelMesh3D& mesh = geomodel.mesh;
             node << mesh.vertices.nb() << " 3 0 0" << EOL;
-            for( auto v : range( mesh.vertices.nb() ) )
-            {
-                node << v << SPACE << mesh.vertices.vertex( v ) << EOL;
-            }
+            parallel_write_text( node, mesh.vertices.nb(),
+                [&mesh]( TextWriter& text, index_t v ) {
+                    text << v << SPACE << mesh.vertices.vertex( v ) << EOL;
+                } );
 
             std::ostringstream oss_ele;
             oss_ele << directory << "/" << file << ".ele";
@@ -68,35 +68,40 @@ namespace
             index_t nb_tet_exported = 0;
             for( auto m : range( geomodel.nb_regions() ) )
             {
-                for( auto tet : range( mesh.cells.nb_tet( m ) ) )
-                {
-                    index_t cell = mesh.cells.tet( m, tet );
-                    ele << nb_tet_exported << SPACE
-                        << mesh.cells.vertex( ElementLocalVertex( cell, 0 ) )
-                        << SPACE
-                        << mesh.cells.vertex( ElementLocalVertex( cell, 1 ) )
-                        << SPACE
-                        << mesh.cells.vertex( ElementLocalVertex( cell, 2 ) )
-                        << SPACE
-                        << mesh.cells.vertex( ElementLocalVertex( cell, 3 ) )
-                        << SPACE << m + 1 << EOL;
-                    neigh << nb_tet_exported;
-                    for( auto f : range( mesh.cells.nb_facets( tet ) ) )
-                    {
-                        neigh << SPACE;
-                        index_t adj = mesh.cells.adjacent( cell, f );
-                        if( adj == NO_ID )
+                parallel_write_text( ele, mesh.cells.nb_tet( m ),
+                    [&mesh, m, nb_tet_exported](
+                        TextWriter& text, index_t tet ) {
+                        index_t cell = mesh.cells.tet( m, tet );
+                        text << nb_tet_exported + tet;
+                        for( auto v : range( 4 ) )
                         {
-                            neigh << -1;
+                            text << SPACE
+                                 << mesh.cells.vertex(
+                                        ElementLocalVertex( cell, v ) );
                         }
-                        else
+                        text << SPACE << m + 1 << EOL;
+                    } );
+                parallel_write_text( neigh, mesh.cells.nb_tet( m ),
+                    [&mesh, m, nb_tet_exported](
+                        TextWriter& text, index_t tet ) {
+                        index_t cell = mesh.cells.tet( m, tet );
+                        text << nb_tet_exported + tet;
+                        for( auto f : range( mesh.cells.nb_facets( tet ) ) )
                         {
-                            neigh << adj;
+                            text << SPACE;
+                            index_t adj = mesh.cells.adjacent( cell, f );
+                            if( adj == NO_ID )
+                            {
+                                text << -1;
+                            }
+                            else
+                            {
+                                text << adj;
+                            }
                         }
-                    }
-                    neigh << EOL;
-                    nb_tet_exported++;
-                }
+                        text << EOL;
+                    } );
+                nb_tet_exported += mesh.cells.nb_tet( m );
             }
             ele << std::flush;
             neigh << std::flush;
@@ -73,6 +73,14 @@ namespace
             vertex_exported_id_.resize( mesh.vertices.nb(), NO_ID );
             atom_exported_id_.resize(
                 mesh.cells.nb_duplicated_vertices(), NO_ID );
+            // Cell facets on surfaces are computed on the first request,
+            // it must not happen during the parallel export of the cells
+            if( mesh.cells.nb() > 0 )
+            {
+                index_t polygon{ NO_ID };
+                bool side;
+                mesh.cells.is_cell_facet_on_surface( 0, 0, polygon, side );
+            }
             for( index_t r = 0; r < geomodel.nb_regions(); r++ )
             {
                 const auto& region = geomodel.region( r );
@@ -389,55 +397,57 @@ namespace
 
         void export_region_vertices( const Region3D& region )
         {
-            // Export not duplicated vertices
-            for( auto c : range( region.nb_mesh_elements() ) )
-            {
-                export_region_cell_vertices( region, c );
-            }
-        }
-
-        void export_region_cell_vertices( const Region3D& region, index_t c )
-        {
+            // Number the not duplicated vertices in the order of the cells,
+            // each one is exported with the first cell containing it
             const auto& mesh = geomodel_mesh( region );
-            auto cell = mesh.cells.cell( region.gmme().index(), c );
-            auto cell_center = mesh.cells.barycenter( cell );
-            for( auto v : range( mesh.cells.nb_vertices( cell ) ) )
+            std::vector< std::pair< index_t, index_t > > vertices_and_cells;
+            for( auto c : range( region.nb_mesh_elements() ) )
             {
-                export_region_cell_vertex( region, cell, v, cell_center );
+                auto cell = mesh.cells.cell( region.gmme().index(), c );
+                for( auto v : range( mesh.cells.nb_vertices( cell ) ) )
+                {
+                    if( mesh.cells.duplicated_corner_index( { cell, v } )
+                        != NO_ID )
+                    {
+                        continue;
+                    }
+                    auto vertex_id = mesh.cells.vertex( { cell, v } );
+                    if( vertex_exported_[vertex_id] )
+                    {
+                        continue;
+                    }
+                    vertex_exported_[vertex_id] = true;
+                    vertex_exported_id_[vertex_id] = nb_vertices_exported_++;
+                    vertices_and_cells.emplace_back( vertex_id, cell );
+                }
             }
-        }
 
-        void export_region_cell_vertex( const Region3D& region,
-            index_t cell,
-            index_t v,
-            const vec3& cell_center )
-        {
             ringmesh_assert( out_.is_open() );
-            const auto& mesh = geomodel_mesh( region );
-            auto atom_id = mesh.cells.duplicated_corner_index( { cell, v } );
-            if( atom_id == NO_ID )
-            {
-                auto vertex_id = mesh.cells.vertex( { cell, v } );
-                if( vertex_exported_[vertex_id] )
-                    return;
-                vertex_exported_[vertex_id] = true;
-                vertex_exported_id_[vertex_id] = nb_vertices_exported_;
-                // PVRTX keyword must be used instead of VRTX keyword because
-                // properties are not read by Gocad if it is VRTX keyword.
-                out_ << "PVRTX " << nb_vertices_exported_++ << " "
-                     << mesh.vertices.vertex( vertex_id );
-
-                /// Export of vertex attributes
-                export_region_cell_vertex_attributes(
-                    region, vertex_id, cell_center );
-                out_ << EOL;
-            }
+            region.cell_nn_search();
+            parallel_write_text( out_,
+                static_cast< index_t >( vertices_and_cells.size() ),
+                [this, &region, &mesh, &vertices_and_cells](
+                    TextWriter& text, index_t i ) {
+                    auto vertex_id = vertices_and_cells[i].first;
+                    auto cell = vertices_and_cells[i].second;
+                    // PVRTX keyword must be used instead of VRTX keyword
+                    // because properties are not read by Gocad if it is
+                    // VRTX keyword.
+                    text << "PVRTX " << vertex_exported_id_[vertex_id] << " "
+                         << mesh.vertices.vertex( vertex_id );
+
+                    /// Export of vertex attributes
+                    export_region_cell_vertex_attributes( region, vertex_id,
+                        mesh.cells.barycenter( cell ), text );
+                    text << EOL;
+                } );
         }
 
-        void export_region_cell_vertex_attributes(
-            const Region3D& region, index_t vertex_id, const vec3& cell_center )
+        void export_region_cell_vertex_attributes( const Region3D& region,
+            index_t vertex_id,
+            const vec3& cell_center,
+            TextWriter& text ) const
         {
-            ringmesh_assert( out_.is_open() );
             auto& reg_vertex_attr_mgr = region.vertex_attribute_manager();
             auto vertex_id_in_reg =
                 find_gmm_cell_in_gm_region( region, vertex_id, cell_center );
@@ -471,7 +481,7 @@ namespace
                     for( auto dim_itr :
                         range( vertex_attribute_dimensions_[attr_dbl_itr] ) )
                     {
-                        out_ << " "
+                        text << " "
                              << cur_attr[vertex_id_in_reg
                                              * vertex_attribute_dimensions_
                                                    [attr_dbl_itr]
@@ -481,7 +491,7 @@ namespace
                 else
                 {
                     write_no_data_value(
-                        vertex_attribute_dimensions_[attr_dbl_itr] );
+                        vertex_attribute_dimensions_[attr_dbl_itr], text );
                 }
             }
         }
@@ -531,17 +541,19 @@ namespace
             // Mark if a boundary is ending in the region
             mark_boundary_ending_in_region( region );
 
+            ringmesh_assert( out_.is_open() );
             const auto& mesh = geomodel_mesh( region );
-            for( auto c : range( region.nb_mesh_elements() ) )
-            {
-                out_ << "TETRA";
-                auto cell = mesh.cells.cell( region.gmme().index(), c );
-                export_tetra( region, cell );
-                out_ << EOL;
-                out_ << "# CTETRA " << region.name();
-                export_ctetra( region, c );
-                out_ << EOL;
-            }
+            region.cell_nn_search();
+            parallel_write_text( out_, region.nb_mesh_elements(),
+                [this, &region, &mesh]( TextWriter& text, index_t c ) {
+                    text << "TETRA";
+                    auto cell = mesh.cells.cell( region.gmme().index(), c );
+                    export_tetra( region, cell, text );
+                    text << EOL;
+                    text << "# CTETRA " << region.name();
+                    export_ctetra( region, c, text );
+                    text << EOL;
+                } );
         }
 
         void export_duplicated_vertices() const
@@ -583,16 +595,17 @@ namespace
             }
         }
 
-        void export_tetra( const Region3D& region, index_t cell )
+        void export_tetra(
+            const Region3D& region, index_t cell, TextWriter& text ) const
         {
-            export_tetra_coordinates( region, cell );
+            export_tetra_coordinates( region, cell, text );
             /// Export cell attributes
-            export_tetra_attributes( region, cell );
+            export_tetra_attributes( region, cell, text );
         }
 
-        void export_tetra_coordinates( const Region3D& region, index_t cell )
+        void export_tetra_coordinates(
+            const Region3D& region, index_t cell, TextWriter& text ) const
         {
-            ringmesh_assert( out_.is_open() );
             const auto& mesh = geomodel_mesh( region );
             for( auto v :
                 range( region.geomodel().mesh.cells.nb_vertices( cell ) ) )
@@ -602,18 +615,18 @@ namespace
                 if( atom_id == NO_ID )
                 {
                     auto vertex_id = mesh.cells.vertex( { cell, v } );
-                    out_ << " " << vertex_exported_id_[vertex_id];
+                    text << " " << vertex_exported_id_[vertex_id];
                 }
                 else
                 {
-                    out_ << " " << atom_exported_id_[atom_id];
+                    text << " " << atom_exported_id_[atom_id];
                 }
             }
         }
 
-        void export_tetra_attributes( const Region3D& region, index_t cell )
+        void export_tetra_attributes(
+            const Region3D& region, index_t cell, TextWriter& text ) const
         {
-            ringmesh_assert( out_.is_open() );
             auto& reg_cell_attr_mgr = region.cell_attribute_manager();
             const auto& mesh = geomodel_mesh( region );
             auto center = mesh.cells.barycenter( cell );
@@ -648,7 +661,7 @@ namespace
                     for( auto dim_itr :
                         range( cell_attribute_dimensions_[attr_dbl_itr] ) )
                     {
-                        out_
+                        text
                             << " "
                             << cur_attr[c_in_reg[0] * cell_attribute_dimensions_
                                                           [attr_dbl_itr]
@@ -658,32 +671,32 @@ namespace
                 else
                 {
                     write_no_data_value(
-                        cell_attribute_dimensions_[attr_dbl_itr] );
+                        cell_attribute_dimensions_[attr_dbl_itr], text );
                 }
             }
         }
 
-        void export_ctetra( const Region3D& region, index_t c )
+        void export_ctetra(
+            const Region3D& region, index_t c, TextWriter& text ) const
         {
-            ringmesh_assert( out_.is_open() );
             const auto& mesh = geomodel_mesh( region );
             for( auto f : range( mesh.cells.nb_facets( c ) ) )
             {
-                out_ << " ";
+                text << " ";
                 index_t polygon{ NO_ID };
                 bool side;
                 if( mesh.cells.is_cell_facet_on_surface( c, f, polygon, side ) )
                 {
                     index_t surface_id{ mesh.polygons.surface( polygon ) };
-                    side ? out_ << "+" : out_ << "-";
-                    out_ << region.geomodel()
+                    text << ( side ? "+" : "-" );
+                    text << region.geomodel()
                                 .surface( surface_id )
                                 .parent( 0 )
                                 .name();
                 }
                 else
                 {
-                    out_ << "none";
+                    text << "none";
                 }
             }
         }
@@ -739,11 +752,18 @@ namespace
         }
 
         void write_no_data_value( index_t nb )
+        {
+            TextWriter text;
+            write_no_data_value( nb, text );
+            text.write( out_ );
+        }
+
+        void write_no_data_value( index_t nb, TextWriter& text ) const
         {
             for( auto i : range( nb ) )
             {
                 ringmesh_unused( i );
-                out_ << " " << GEO::String::to_string( gocad_no_data_value_ );
+                text << " " << GEO::String::to_string( gocad_no_data_value_ );
             }
         }
 
@@ -66,67 +66,687 @@ namespace
         &pyramid_descriptor_vtk
     };
 
-    class VTKIOHandler final : public GeoModelOutputHandler3D
+    /*!
+     * @brief Type of the values of a VTK data array
+     */
+    struct VTKValueType
+    {
+        const char* xml_name;
+        const char* legacy_name;
+        std::size_t size;
+    };
+
+    const VTKValueType VTK_FLOAT64{ "Float64", "double", 8 };
+    const VTKValueType VTK_FLOAT32{ "Float32", "float", 4 };
+    const VTKValueType VTK_INT64{ "Int64", "vtktypeint64", 8 };
+    const VTKValueType VTK_UINT64{ "UInt64", "vtktypeuint64", 8 };
+    const VTKValueType VTK_INT32{ "Int32", "int", 4 };
+    const VTKValueType VTK_UINT32{ "UInt32", "unsigned_int", 4 };
+    const VTKValueType VTK_INT8{ "Int8", "char", 1 };
+    const VTKValueType VTK_UINT8{ "UInt8", "unsigned_char", 1 };
+
+    /// Size of the blocks compressed independently in .vtu files
+    const std::size_t VTU_BLOCK_SIZE{ 1 << 20 };
+
+    /// Number of bytes encoded in base64 by each task
+    const std::size_t BASE64_CHUNK_SIZE{ 3 << 18 };
+
+    /*!
+     * @brief Values of a VTK data array, in the byte order of the machine
+     */
+    struct VTKDataArray
+    {
+        VTKDataArray( std::string array_name,
+            const VTKValueType& value_type,
+            index_t nb_array_components,
+            index_t nb_tuples )
+            : name( std::move( array_name ) ),
+              type( value_type ),
+              nb_components( nb_array_components ),
+              values( type.size * nb_components * nb_tuples )
+        {
+        }
+
+        index_t nb_tuples() const
+        {
+            return static_cast< index_t >(
+                values.size() / ( type.size * nb_components ) );
+        }
+
+        template < typename T >
+        T* data()
+        {
+            ringmesh_assert( sizeof( T ) == type.size );
+            return reinterpret_cast< T* >( values.data() );
+        }
+
+        std::string name;
+        VTKValueType type;
+        index_t nb_components;
+        std::vector< char > values;
+    };
+
+    const RINGMesh2VTK& cell_descriptor_vtk(
+        const GeoModelMesh3D& mesh, index_t cell )
+    {
+        return *cell_type_to_cell_descriptor_vtk[to_underlying_type(
+            mesh.cells.type( cell ) )];
+    }
+
+    VTKDataArray vtk_points( const GeoModelMesh3D& mesh )
+    {
+        VTKDataArray points{ "Points", VTK_FLOAT64, 3, mesh.vertices.nb() };
+        auto* values = points.data< double >();
+        parallel_for( mesh.vertices.nb(), [&mesh, values]( index_t v ) {
+            const auto& vertex = mesh.vertices.vertex( v );
+            for( auto i : range( 3 ) )
+            {
+                values[3 * v + i] = vertex[i];
+            }
+        } );
+        return points;
+    }
+
+    /*!
+     * @brief Computes the index of the first vertex of each cell
+     * in the connectivity array
+     * @return the offsets of the cells, the last one being the total
+     * number of cell vertices
+     */
+    std::vector< index_t > cell_offsets( const GeoModelMesh3D& mesh )
+    {
+        std::vector< index_t > offsets( mesh.cells.nb() + 1, 0 );
+        for( auto c : range( mesh.cells.nb() ) )
+        {
+            offsets[c + 1] = offsets[c] + mesh.cells.nb_vertices( c );
+        }
+        return offsets;
+    }
+
+    template < typename INDEX >
+    void fill_vtu_cells( const GeoModelMesh3D& mesh,
+        const std::vector< index_t >& offsets,
+        VTKDataArray& connectivity,
+        VTKDataArray& cell_offsets )
+    {
+        auto* vertices = connectivity.data< INDEX >();
+        auto* ends = cell_offsets.data< INDEX >();
+        parallel_for( mesh.cells.nb(),
+            [&mesh, &offsets, vertices, ends]( index_t c ) {
+                const auto& descriptor = cell_descriptor_vtk( mesh, c );
+                for( auto v : range( mesh.cells.nb_vertices( c ) ) )
+                {
+                    vertices[offsets[c] + v] = static_cast< INDEX >(
+                        mesh.cells.vertex( { c, descriptor.vertices[v] } ) );
+                }
+                ends[c] = static_cast< INDEX >( offsets[c + 1] );
+            } );
+    }
+
+    VTKDataArray vtk_cell_types( const GeoModelMesh3D& mesh )
+    {
+        VTKDataArray types{ "types", VTK_UINT8, 1, mesh.cells.nb() };
+        auto* values = types.data< std::uint8_t >();
+        parallel_for( mesh.cells.nb(), [&mesh, values]( index_t c ) {
+            values[c] = static_cast< std::uint8_t >(
+                cell_descriptor_vtk( mesh, c ).entity_type );
+        } );
+        return types;
+    }
+
+    VTKDataArray vtk_cell_regions( const GeoModelMesh3D& mesh )
+    {
+        VTKDataArray regions{ "region", VTK_INT32, 1, mesh.cells.nb() };
+        auto* values = regions.data< std::int32_t >();
+        parallel_for( mesh.cells.nb(), [&mesh, values]( index_t c ) {
+            values[c] = static_cast< std::int32_t >( mesh.cells.region( c ) );
+        } );
+        return regions;
+    }
+
+    template < typename T >
+    bool match_attribute_type( const GEO::AttributeStore& store,
+        const VTKValueType& vtk_type,
+        index_t nb_values,
+        VTKValueType& type,
+        index_t& nb_components )
+    {
+        if( !store.elements_type_matches( typeid( T ).name() ) )
+        {
+            return false;
+        }
+        type = vtk_type;
+        nb_components = store.dimension() * nb_values;
+        return true;
+    }
+
+    bool vtk_attribute_type( const GEO::AttributeStore& store,
+        VTKValueType& type,
+        index_t& nb_components )
+    {
+        return match_attribute_type< double >(
+                   store, VTK_FLOAT64, 1, type, nb_components )
+               || match_attribute_type< float >(
+                      store, VTK_FLOAT32, 1, type, nb_components )
+               || match_attribute_type< vec3 >(
+                      store, VTK_FLOAT64, 3, type, nb_components )
+               || match_attribute_type< vec2 >(
+                      store, VTK_FLOAT64, 2, type, nb_components )
+               || match_attribute_type< GEO::Numeric::int32 >(
+                      store, VTK_INT32, 1, type, nb_components )
+               || match_attribute_type< GEO::Numeric::uint32 >(
+                      store, VTK_UINT32, 1, type, nb_components )
+               || match_attribute_type< GEO::Numeric::int64 >(
+                      store, VTK_INT64, 1, type, nb_components )
+               || match_attribute_type< GEO::Numeric::uint64 >(
+                      store, VTK_UINT64, 1, type, nb_components )
+               || match_attribute_type< GEO::Numeric::int8 >(
+                      store, VTK_INT8, 1, type, nb_components )
+               || match_attribute_type< char >(
+                      store, VTK_INT8, 1, type, nb_components )
+               || match_attribute_type< GEO::Numeric::uint8 >(
+                      store, VTK_UINT8, 1, type, nb_components );
+    }
+
+    /*!
+     * @brief Copies the attributes of GeoModelMesh elements
+     * @details The vertex coordinates and the attributes of unsupported
+     * types are skipped.
+     */
+    std::vector< VTKDataArray > vtk_attributes(
+        const GEO::AttributesManager& manager, index_t nb_elements )
+    {
+        GEO::vector< std::string > names;
+        manager.list_attribute_names( names );
+        std::vector< VTKDataArray > attributes;
+        for( const auto& name : names )
+        {
+            if( name == "point" )
+            {
+                continue;
+            }
+            const auto* store = manager.find_attribute_store( name );
+            ringmesh_assert( store != nullptr );
+            ringmesh_assert( store->size() == nb_elements );
+            VTKValueType type( VTK_FLOAT64 );
+            index_t nb_components{ 0 };
+            if( !vtk_attribute_type( *store, type, nb_components ) )
+            {
+                Logger::warn( "I/O", "Attribute ", name, " of type ",
+                    store->element_typeid_name(), " is not exported" );
+                continue;
+            }
+            attributes.emplace_back( name, type, nb_components, nb_elements );
+            auto& values = attributes.back().values;
+            std::memcpy( values.data(), store->data(), values.size() );
+        }
+        return attributes;
+    }
+
+    /*!
+     * @brief Encodes data in base64
+     * @details The data is encoded by chunks in parallel.
+     */
+    std::vector< char > encode_base64( const std::vector< char >& data )
+    {
+        static const char table[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::vector< char > encoded( ( data.size() + 2 ) / 3 * 4 );
+        auto nb_chunks = static_cast< index_t >(
+            ( data.size() + BASE64_CHUNK_SIZE - 1 ) / BASE64_CHUNK_SIZE );
+        parallel_for( nb_chunks, [&data, &encoded]( index_t chunk ) {
+            auto begin = chunk * BASE64_CHUNK_SIZE;
+            auto end = std::min( begin + BASE64_CHUNK_SIZE, data.size() );
+            auto* out = &encoded[begin / 3 * 4];
+            for( auto i = begin; i < end; i += 3 )
+            {
+                auto nb_bytes = std::min( end - i, std::size_t( 3 ) );
+                std::uint32_t triple{ 0 };
+                for( auto b : range( nb_bytes ) )
+                {
+                    triple |= static_cast< std::uint32_t >(
+                                  static_cast< unsigned char >( data[i + b] ) )
+                              << ( 16 - 8 * b );
+                }
+                *out++ = table[( triple >> 18 ) & 0x3F];
+                *out++ = table[( triple >> 12 ) & 0x3F];
+                *out++ = nb_bytes > 1 ? table[( triple >> 6 ) & 0x3F] : '=';
+                *out++ = nb_bytes > 2 ? table[triple & 0x3F] : '=';
+            }
+        } );
+        return encoded;
+    }
+
+    /*!
+     * @brief Compresses data with zlib by independent blocks
+     * @details The blocks are compressed in parallel.
+     * @param[in] data the data to compress
+     * @param[out] header the VTK compression header: number of blocks,
+     * block size, size of the last partial block and compressed size of
+     * each block
+     * @return the compressed blocks one after the other
+     */
+    std::vector< char > compress_vtu_blocks(
+        const std::vector< char >& data, std::vector< std::uint64_t >& header )
+    {
+        auto nb_blocks = static_cast< index_t >(
+            ( data.size() + VTU_BLOCK_SIZE - 1 ) / VTU_BLOCK_SIZE );
+        std::vector< std::vector< char > > blocks( nb_blocks );
+        parallel_for( nb_blocks, [&data, &blocks]( index_t block ) {
+            auto begin = block * VTU_BLOCK_SIZE;
+            auto size = std::min( VTU_BLOCK_SIZE, data.size() - begin );
+            auto compressed_size =
+                compressBound( static_cast< uLong >( size ) );
+            blocks[block].resize( compressed_size );
+            auto status = compress2(
+                reinterpret_cast< Bytef* >( blocks[block].data() ),
+                &compressed_size,
+                reinterpret_cast< const Bytef* >( data.data() + begin ),
+                static_cast< uLong >( size ), Z_BEST_SPEED );
+            if( status != Z_OK )
+            {
+                throw RINGMeshException(
+                    "I/O", "Failed to compress VTK data (zlib error ", status,
+                    ")" );
+            }
+            blocks[block].resize( compressed_size );
+        } );
+
+        header.assign( { nb_blocks, VTU_BLOCK_SIZE,
+            data.size() % VTU_BLOCK_SIZE } );
+        std::size_t total_size{ 0 };
+        for( const auto& block : blocks )
+        {
+            header.push_back( block.size() );
+            total_size += block.size();
+        }
+        std::vector< char > compressed;
+        compressed.reserve( total_size );
+        for( const auto& block : blocks )
+        {
+            compressed.insert( compressed.end(), block.begin(), block.end() );
+        }
+        return compressed;
+    }
+
+    std::string xml_escape( const std::string& text )
+    {
+        std::string escaped;
+        for( auto c : text )
+        {
+            switch( c )
+            {
+            case '&':
+                escaped += "&amp;";
+                break;
+            case '<':
+                escaped += "&lt;";
+                break;
+            case '>':
+                escaped += "&gt;";
+                break;
+            case '"':
+                escaped += "&quot;";
+                break;
+            default:
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+
+    /*!
+     * @brief Data arrays appended at the end of a .vtu file
+     */
+    class VTUAppendedData
     {
     public:
-        void save(
-            const GeoModel3D& geomodel, const std::string& filename ) final
+        VTUAppendedData( bool base64, bool compressed )
+            : base64_( base64 ), compressed_( compressed )
         {
-            std::ofstream out( filename.c_str() );
-            out.precision( 16 );
+        }
 
-            out << "# vtk DataFile Version 2.0" << EOL;
-            out << "Unstructured Grid" << EOL;
-            out << "ASCII" << EOL;
-            out << "DATASET UNSTRUCTURED_GRID" << EOL;
+        /*!
+         * @brief Encodes a data array and writes its description
+         * @param[in] array the data array, cleared once encoded
+         * @param[in] out the stream to write the DataArray element
+         */
+        void add( VTKDataArray& array, std::ostream& out )
+        {
+            out << "<DataArray type=\"" << array.type.xml_name << "\" Name=\""
+                << xml_escape( array.name ) << "\" NumberOfComponents=\""
+                << array.nb_components << "\" format=\"appended\" offset=\""
+                << size_ << "\"/>\n";
 
-            const auto& mesh = geomodel.mesh;
-            out << "POINTS " << mesh.vertices.nb() << " double" << EOL;
-            for( auto v : range( mesh.vertices.nb() ) )
+            std::vector< std::uint64_t > header;
+            std::vector< char > payload;
+            if( compressed_ )
             {
-                out << mesh.vertices.vertex( v ) << EOL;
+                payload = compress_vtu_blocks( array.values, header );
             }
-            out << EOL;
+            else
+            {
+                header.push_back( array.values.size() );
+                payload.swap( array.values );
+            }
+            std::vector< char >().swap( array.values );
+
+            std::vector< char > header_bytes( header.size()
+                                              * sizeof( std::uint64_t ) );
+            std::memcpy(
+                header_bytes.data(), header.data(), header_bytes.size() );
+            append( std::move( header_bytes ) );
+            append( std::move( payload ) );
+        }
+
+        void write( std::ostream& out ) const
+        {
+            out << "<AppendedData encoding=\""
+                << ( base64_ ? "base64" : "raw" ) << "\">\n_";
+            for( const auto& chunk : chunks_ )
+            {
+                out.write( chunk.data(),
+                    static_cast< std::streamsize >( chunk.size() ) );
+            }
+            out << "\n</AppendedData>\n";
+        }
+
+        const char* compressor() const
+        {
+            return compressed_ ? " compressor=\"vtkZLibDataCompressor\"" : "";
+        }
 
-            index_t total_corners = ( 4 + 1 ) * mesh.cells.nb_tet()
-                                    + ( 5 + 1 ) * mesh.cells.nb_pyramid()
-                                    + ( 6 + 1 ) * mesh.cells.nb_prism()
-                                    + ( 8 + 1 ) * mesh.cells.nb_hex();
-            out << "CELLS " << mesh.cells.nb_cells() << SPACE << total_corners
-                << EOL;
-            for( auto c : range( mesh.cells.nb() ) )
+    private:
+        void append( std::vector< char > bytes )
+        {
+            if( base64_ )
             {
-                out << mesh.cells.nb_vertices( c );
-                const auto& descriptor =
-                    *cell_type_to_cell_descriptor_vtk[to_underlying_type(
-                        mesh.cells.type( c ) )];
+                bytes = encode_base64( bytes );
+            }
+            size_ += bytes.size();
+            chunks_.push_back( std::move( bytes ) );
+        }
+
+    private:
+        bool base64_;
+        bool compressed_;
+        std::vector< std::vector< char > > chunks_;
+        std::size_t size_{ 0 };
+    };
+
+    /*!
+     * @brief Writes a data array in big endian, as required by the binary
+     * legacy VTK format
+     */
+    void write_big_endian( std::ostream& out, VTKDataArray& array )
+    {
+        if( !is_big_endian() && array.type.size > 1 )
+        {
+            auto value_size = array.type.size;
+            auto* values = array.values.data();
+            parallel_for(
+                static_cast< index_t >( array.values.size() / value_size ),
+                [values, value_size]( index_t i ) {
+                    std::reverse( values + i * value_size,
+                        values + ( i + 1 ) * value_size );
+                } );
+        }
+        out.write( array.values.data(),
+            static_cast< std::streamsize >( array.values.size() ) );
+        out << EOL;
+    }
+
+    std::string legacy_array_name( std::string name )
+    {
+        std::replace( name.begin(), name.end(), ' ', '_' );
+        return name;
+    }
+
+    void write_legacy_fields(
+        std::ostream& out, std::vector< VTKDataArray >& arrays )
+    {
+        out << "FIELD FieldData " << arrays.size() << EOL;
+        for( auto& array : arrays )
+        {
+            out << legacy_array_name( array.name ) << SPACE
+                << array.nb_components << SPACE << array.nb_tuples() << SPACE
+                << array.type.legacy_name << EOL;
+            write_big_endian( out, array );
+        }
+    }
+
+    void save_legacy_ascii_vtk(
+        const GeoModel3D& geomodel, const std::string& filename )
+    {
+        std::ofstream out( filename.c_str() );
+        out.precision( 16 );
+
+        out << "# vtk DataFile Version 2.0" << EOL;
+        out << "Unstructured Grid" << EOL;
+        out << "ASCII" << EOL;
+        out << "DATASET UNSTRUCTURED_GRID" << EOL;
+
+        const auto& mesh = geomodel.mesh;
+        out << "POINTS " << mesh.vertices.nb() << " double" << EOL;
+        parallel_write_text(
+            out, mesh.vertices.nb(), [&mesh]( TextWriter& text, index_t v ) {
+                text << mesh.vertices.vertex( v ) << EOL;
+            } );
+        out << EOL;
+
+        index_t total_corners = ( 4 + 1 ) * mesh.cells.nb_tet()
+                                + ( 5 + 1 ) * mesh.cells.nb_pyramid()
+                                + ( 6 + 1 ) * mesh.cells.nb_prism()
+                                + ( 8 + 1 ) * mesh.cells.nb_hex();
+        out << "CELLS " << mesh.cells.nb_cells() << SPACE << total_corners
+            << EOL;
+        parallel_write_text(
+            out, mesh.cells.nb(), [&mesh]( TextWriter& text, index_t c ) {
+                text << mesh.cells.nb_vertices( c );
+                const auto& descriptor = cell_descriptor_vtk( mesh, c );
                 for( auto v : range( mesh.cells.nb_vertices( c ) ) )
                 {
                     auto vertex_id = descriptor.vertices[v];
-                    out << SPACE << mesh.cells.vertex( { c, vertex_id } );
+                    text << SPACE << mesh.cells.vertex( { c, vertex_id } );
+                }
+                text << EOL;
+            } );
+
+        out << "CELL_TYPES " << mesh.cells.nb() << EOL;
+        parallel_write_text(
+            out, mesh.cells.nb(), [&mesh]( TextWriter& text, index_t c ) {
+                text << cell_descriptor_vtk( mesh, c ).entity_type << EOL;
+            } );
+        out << EOL;
+
+        out << "CELL_DATA " << mesh.cells.nb() << EOL;
+        out << "SCALARS region int 1" << EOL;
+        out << "LOOKUP_TABLE default" << EOL;
+        parallel_write_text(
+            out, mesh.cells.nb(), [&mesh]( TextWriter& text, index_t c ) {
+                text << mesh.cells.region( c ) << EOL;
+            } );
+        out << EOL;
+        out << std::flush;
+    }
+
+    void save_legacy_binary_vtk(
+        const GeoModel3D& geomodel, const std::string& filename )
+    {
+        std::ofstream out( filename.c_str(), std::ios::binary );
+        out << "# vtk DataFile Version 2.0" << EOL;
+        out << "Unstructured Grid" << EOL;
+        out << "BINARY" << EOL;
+        out << "DATASET UNSTRUCTURED_GRID" << EOL;
+
+        const auto& mesh = geomodel.mesh;
+        auto points = vtk_points( mesh );
+        out << "POINTS " << mesh.vertices.nb() << " double" << EOL;
+        write_big_endian( out, points );
+
+        const auto offsets = cell_offsets( mesh );
+        VTKDataArray cells{ "cells", VTK_INT32, 1,
+            mesh.cells.nb() + offsets.back() };
+        auto* cell_values = cells.data< std::int32_t >();
+        parallel_for( mesh.cells.nb(),
+            [&mesh, &offsets, cell_values]( index_t c ) {
+                const auto& descriptor = cell_descriptor_vtk( mesh, c );
+                auto* cell = cell_values + offsets[c] + c;
+                cell[0] =
+                    static_cast< std::int32_t >( mesh.cells.nb_vertices( c ) );
+                for( auto v : range( mesh.cells.nb_vertices( c ) ) )
+                {
+                    cell[v + 1] = static_cast< std::int32_t >(
+                        mesh.cells.vertex( { c, descriptor.vertices[v] } ) );
                 }
-                out << EOL;
+            } );
+        out << "CELLS " << mesh.cells.nb() << SPACE << cells.nb_tuples()
+            << EOL;
+        write_big_endian( out, cells );
+
+        auto types = vtk_cell_types( mesh );
+        VTKDataArray cell_types{ "types", VTK_INT32, 1, mesh.cells.nb() };
+        auto* type_values = cell_types.data< std::int32_t >();
+        const auto* types_in = types.data< std::uint8_t >();
+        parallel_for( mesh.cells.nb(), [type_values, types_in]( index_t c ) {
+            type_values[c] = types_in[c];
+        } );
+        out << "CELL_TYPES " << mesh.cells.nb() << EOL;
+        write_big_endian( out, cell_types );
+
+        std::vector< VTKDataArray > cell_data;
+        cell_data.push_back( vtk_cell_regions( mesh ) );
+        for( auto& attribute :
+            vtk_attributes( mesh.cells.attribute_manager(), mesh.cells.nb() ) )
+        {
+            cell_data.push_back( std::move( attribute ) );
+        }
+        out << "CELL_DATA " << mesh.cells.nb() << EOL;
+        write_legacy_fields( out, cell_data );
+
+        auto point_data = vtk_attributes(
+            mesh.vertices.attribute_manager(), mesh.vertices.nb() );
+        if( !point_data.empty() )
+        {
+            out << "POINT_DATA " << mesh.vertices.nb() << EOL;
+            write_legacy_fields( out, point_data );
+        }
+        out << std::flush;
+    }
+
+    class VTKIOHandler final : public GeoModelOutputHandler3D
+    {
+    public:
+        void save(
+            const GeoModel3D& geomodel, const std::string& filename ) final
+        {
+            if( GEO::String::to_bool(
+                    output_option( "out:vtk_binary", "false" ) ) )
+            {
+                save_legacy_binary_vtk( geomodel, filename );
             }
+            else
+            {
+                save_legacy_ascii_vtk( geomodel, filename );
+            }
+        }
+    };
 
-            out << "CELL_TYPES " << mesh.cells.nb() << EOL;
-            for( auto c : range( mesh.cells.nb() ) )
+    /*!
+     * @brief Export in the XML VTK format for unstructured grids (.vtu)
+     * @details The data arrays are appended in raw binary (or base64 with
+     * "out:vtu_encoding=base64"), compressed with zlib unless
+     * "out:vtu_compression=false".
+     * All the vertex and cell attributes of the GeoModelMesh are exported.
+     */
+    class VTUIOHandler final : public GeoModelOutputHandler3D
+    {
+    public:
+        void save(
+            const GeoModel3D& geomodel, const std::string& filename ) final
+        {
+            const auto encoding = output_option( "out:vtu_encoding", "raw" );
+            if( encoding != "raw" && encoding != "base64" )
             {
-                const auto& descriptor =
-                    *cell_type_to_cell_descriptor_vtk[to_underlying_type(
-                        mesh.cells.type( c ) )];
-                out << descriptor.entity_type << EOL;
+                throw RINGMeshException(
+                    "I/O", "Unknown .vtu encoding: ", encoding );
             }
-            out << EOL;
+            VTUAppendedData appended{ encoding == "base64",
+                GEO::String::to_bool(
+                    output_option( "out:vtu_compression", "true" ) ) };
 
-            out << "CELL_DATA " << mesh.cells.nb() << EOL;
-            out << "SCALARS region int 1" << EOL;
-            out << "LOOKUP_TABLE default" << EOL;
-            for( auto c : range( mesh.cells.nb() ) )
+            const auto& mesh = geomodel.mesh;
+            std::ostringstream arrays;
+            arrays << "<PointData>\n";
+            for( auto& attribute : vtk_attributes(
+                     mesh.vertices.attribute_manager(), mesh.vertices.nb() ) )
+            {
+                appended.add( attribute, arrays );
+            }
+            arrays << "</PointData>\n<CellData>\n";
+            auto regions = vtk_cell_regions( mesh );
+            appended.add( regions, arrays );
+            for( auto& attribute : vtk_attributes(
+                     mesh.cells.attribute_manager(), mesh.cells.nb() ) )
+            {
+                appended.add( attribute, arrays );
+            }
+            arrays << "</CellData>\n<Points>\n";
+            auto points = vtk_points( mesh );
+            appended.add( points, arrays );
+            arrays << "</Points>\n<Cells>\n";
+            add_cells( mesh, appended, arrays );
+            arrays << "</Cells>\n";
+
+            std::ofstream out( filename.c_str(), std::ios::binary );
+            if( !out )
+            {
+                throw RINGMeshException(
+                    "I/O", "Error when opening the file: ", filename );
+            }
+            out << "<?xml version=\"1.0\"?>\n";
+            out << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" "
+                << "byte_order=\""
+                << ( is_big_endian() ? "BigEndian" : "LittleEndian" )
+                << "\" header_type=\"UInt64\"" << appended.compressor()
+                << ">\n";
+            out << "<UnstructuredGrid>\n";
+            out << "<Piece NumberOfPoints=\"" << mesh.vertices.nb()
+                << "\" NumberOfCells=\"" << mesh.cells.nb() << "\">\n";
+            out << arrays.str();
+            out << "</Piece>\n</UnstructuredGrid>\n";
+            appended.write( out );
+            out << "</VTKFile>\n" << std::flush;
+        }
+
+    private:
+        void add_cells( const GeoModelMesh3D& mesh,
+            VTUAppendedData& appended,
+            std::ostream& out )
+        {
+            const auto offsets = cell_offsets( mesh );
+            const auto max_int32 = static_cast< index_t >(
+                std::numeric_limits< std::int32_t >::max() );
+            const auto& index_type =
+                offsets.back() > max_int32 ? VTK_INT64 : VTK_INT32;
+            VTKDataArray connectivity{ "connectivity", index_type, 1,
+                offsets.back() };
+            VTKDataArray cell_offsets{ "offsets", index_type, 1,
+                mesh.cells.nb() };
+            if( index_type.size == sizeof( std::int32_t ) )
+            {
+                fill_vtu_cells< std::int32_t >(
+                    mesh, offsets, connectivity, cell_offsets );
+            }
+            else
             {
-                out << mesh.cells.region( c ) << EOL;
+                fill_vtu_cells< std::int64_t >(
+                    mesh, offsets, connectivity, cell_offsets );
             }
-            out << EOL;
-            out << std::flush;
+            appended.add( connectivity, out );
+            appended.add( cell_offsets, out );
+            auto types = vtk_cell_types( mesh );
+            appended.add( types, out );
         }
     };
 }
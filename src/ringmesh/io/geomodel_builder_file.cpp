@@ -54,6 +54,13 @@ namespace RINGMesh
 
     template < index_t DIMENSION >
     void GeoModelBuilderFile< DIMENSION >::build_geomodel()
+    {
+        load_geomodel();
+        this->end_geomodel();
+    }
+
+    template < index_t DIMENSION >
+    void GeoModelBuilderFile< DIMENSION >::load_geomodel()
     {
         if( find_geomodel_dimension( filename_ ) != DIMENSION )
         {
@@ -61,7 +68,6 @@ namespace RINGMesh
                 "I/O", "Dimension of the GeoModel does not match the file" );
         }
         load_file();
-        this->end_geomodel();
     }
 
     template class io_api GeoModelBuilderFile< 2 >;
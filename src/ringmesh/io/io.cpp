@@ -126,6 +126,21 @@ namespace RINGMesh
         return handler->load_geomodel( filename, geomodel );
     }
 
+    template < index_t DIMENSION >
+    void geomodel_load_lazily(
+        GeoModel< DIMENSION >& geomodel, const std::string& filename )
+    {
+        if( !GEO::FileSystem::is_file( filename ) )
+        {
+            throw RINGMeshException( "I/O", "File does not exist: ", filename );
+        }
+        Logger::out( "I/O", "Loading file ", filename, " lazily..." );
+
+        auto handler =
+            GeoModelInputHandler< DIMENSION >::get_handler( filename );
+        handler->load_geomodel_lazily( filename, geomodel );
+    }
+
     template < index_t DIMENSION >
     void geomodel_save(
         const GeoModel< DIMENSION >& geomodel, const std::string& filename )
@@ -138,9 +153,13 @@ namespace RINGMesh
     }
 
     template bool io_api geomodel_load( GeoModel2D&, const std::string& );
+    template void io_api geomodel_load_lazily(
+        GeoModel2D&, const std::string& );
     template void io_api geomodel_save( const GeoModel2D&, const std::string& );
 
     template bool io_api geomodel_load( GeoModel3D&, const std::string& );
+    template void io_api geomodel_load_lazily(
+        GeoModel3D&, const std::string& );
     template void io_api geomodel_save( const GeoModel3D&, const std::string& );
 
 } // namespace RINGMesh
@@ -35,21 +35,32 @@
 
 #include <ringmesh/io/io.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <deque>
-#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <unordered_map>
 
 #include <tinyxml2.h>
+#include <zlib.h>
 
+#include <geogram/basic/attributes.h>
 #include <geogram/basic/command_line.h>
 #include <geogram/basic/file_system.h>
 
 #include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/memory_mapped_file.h>
 #include <ringmesh/basic/task_handler.h>
 #include <ringmesh/geomodel/builder/geomodel_builder.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_api.h>
 #include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity_loader.h>
 #include <ringmesh/geomodel/core/well.h>
 #include <ringmesh/geomodel/tools/geomodel_validity.h>
 #include <ringmesh/io/geomodel_adapter_resqml.h>
@@ -58,6 +69,7 @@
 #include <ringmesh/io/geomodel_builder_resqml.h>
 #endif
 
+#include <ringmesh/io/text_writer.h>
 #include <ringmesh/io/zip_file.h>
 
 #include <ringmesh/mesh/line_mesh.h>
@@ -75,12 +87,34 @@ namespace
 {
     using namespace RINGMesh;
 
+    bool is_big_endian()
+    {
+        const std::uint16_t value{ 1 };
+        return *reinterpret_cast< const unsigned char* >( &value ) == 0;
+    }
+
+    /*!
+     * @brief Gets an output option of the command line
+     * @details The "out" arguments are only declared by the applications,
+     * the default value is used otherwise.
+     */
+    std::string output_option(
+        const std::string& name, const std::string& default_value )
+    {
+        if( GEO::CmdLine::arg_is_declared( name ) )
+        {
+            return GEO::CmdLine::get_arg( name );
+        }
+        return default_value;
+    }
+
 #include "geomodel/io_abaqus.hpp"
 #include "geomodel/io_adeli.hpp"
 #include "geomodel/io_aster.hpp"
 #include "geomodel/io_csmp.hpp"
 #include "geomodel/io_feflow.hpp"
 #include "geomodel/io_gm.hpp"
+#include "geomodel/io_gmb.hpp"
 #include "geomodel/io_gprs.hpp"
 #include "geomodel/io_mfem.hpp"
 #include "geomodel/io_model3d.hpp"
@@ -122,6 +156,8 @@ namespace RINGMesh
     {
         GeoModelOutputHandlerFactory2D::register_creator< GeoModelHandlerGM2D >(
             "gm" );
+        GeoModelOutputHandlerFactory2D::register_creator<
+            GeoModelHandlerGMB2D >( "gmb" );
         GeoModelOutputHandlerFactory2D::register_creator< MFEMIOHandler2D >(
             "mfem" );
     }
@@ -131,6 +167,8 @@ namespace RINGMesh
     {
         GeoModelInputHandlerFactory2D::register_creator< GeoModelHandlerGM2D >(
             "gm" );
+        GeoModelInputHandlerFactory2D::register_creator< GeoModelHandlerGMB2D >(
+            "gmb" );
         GeoModelInputHandlerFactory2D::register_creator<
             StradivariusIOHandler >( "model" );
         GeoModelInputHandlerFactory2D::register_creator< SVGIOHandler >(
@@ -153,6 +191,8 @@ namespace RINGMesh
             "mail" );
         GeoModelOutputHandlerFactory3D::register_creator< VTKIOHandler >(
             "vtk" );
+        GeoModelOutputHandlerFactory3D::register_creator< VTUIOHandler >(
+            "vtu" );
         // todo GPRS export is not working for the moment [AB]
         //        GeoModelOutputHandlerFactory3D::register_creator<
         //        GPRSIOHandler >( "gprs" );
@@ -162,6 +202,8 @@ namespace RINGMesh
             "mfem" );
         GeoModelOutputHandlerFactory3D::register_creator< GeoModelHandlerGM3D >(
             "gm" );
+        GeoModelOutputHandlerFactory3D::register_creator<
+            GeoModelHandlerGMB3D >( "gmb" );
         GeoModelOutputHandlerFactory3D::register_creator< AbaqusIOHandler >(
             "inp" );
         GeoModelOutputHandlerFactory3D::register_creator< AdeliIOHandler >(
@@ -184,7 +226,11 @@ namespace RINGMesh
     {
         GeoModelInputHandlerFactory3D::register_creator< GeoModelHandlerGM3D >(
             "gm" );
+        GeoModelInputHandlerFactory3D::register_creator< GeoModelHandlerGMB3D >(
+            "gmb" );
         GeoModelInputHandlerFactory3D::register_creator< MLIOHandler >( "ml" );
+        GeoModelInputHandlerFactory3D::register_creator< MSHIOHandler >(
+            "msh" );
         GeoModelInputHandlerFactory3D::register_creator< TSolidIOHandler >(
             "so" );
 #ifdef RINGMESH_WITH_RESQML2
@@ -216,6 +262,15 @@ namespace RINGMesh
         return is_geomodel_valid( geomodel );
     }
 
+    template < index_t DIMENSION >
+    void GeoModelInputHandler< DIMENSION >::load_geomodel_lazily(
+        const std::string& filename, GeoModel< DIMENSION >& geomodel )
+    {
+        load_lazily( filename, geomodel );
+        Logger::out(
+            "I/O", " Loaded geomodel ", geomodel.name(), " from ", filename );
+    }
+
     /***************************************************************************/
 
     template < index_t DIMENSION >
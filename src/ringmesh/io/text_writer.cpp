@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/io/text_writer.h>
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <ostream>
+
+/*!
+ * @file Fast text formatting of numbers for ASCII exports
+ */
+
+namespace
+{
+    /// Integral doubles below this bound (2^53) are exactly represented
+    /// and have at most 16 digits
+    const double MAX_EXACT_INTEGER{ 9007199254740992. };
+} // namespace
+
+namespace RINGMesh
+{
+    TextWriter::TextWriter( int precision, bool scientific )
+        : precision_( precision ), scientific_( scientific )
+    {
+        buffer_.reserve( 1 << 16 );
+    }
+
+    template < typename UNSIGNED >
+    void TextWriter::write_unsigned( UNSIGNED value )
+    {
+        char digits[std::numeric_limits< UNSIGNED >::digits10 + 1];
+        auto end = digits + sizeof( digits );
+        auto begin = end;
+        do
+        {
+            *--begin = static_cast< char >( '0' + value % 10 );
+            value /= 10;
+        } while( value != 0 );
+        buffer_.append( begin, end );
+    }
+
+    template < typename SIGNED, typename UNSIGNED >
+    void TextWriter::write_signed( SIGNED value )
+    {
+        if( value < 0 )
+        {
+            buffer_.push_back( '-' );
+            // Computed in unsigned arithmetic to handle the minimum value
+            write_unsigned( UNSIGNED( 0 ) - static_cast< UNSIGNED >( value ) );
+        }
+        else
+        {
+            write_unsigned( static_cast< UNSIGNED >( value ) );
+        }
+    }
+
+    TextWriter& TextWriter::operator<<( double value )
+    {
+        // Integers of at most 16 digits are printed as is by %.16g
+        if( !scientific_ && precision_ >= 16 && value == std::floor( value )
+            && std::fabs( value ) < MAX_EXACT_INTEGER
+            && !( value == 0 && std::signbit( value ) ) )
+        {
+            write_signed< long long, unsigned long long >(
+                static_cast< long long >( value ) );
+            return *this;
+        }
+        char text[64];
+        auto size = std::snprintf( text, sizeof( text ),
+            scientific_ ? "%.*e" : "%.*g", precision_, value );
+        ringmesh_assert(
+            size > 0 && size < static_cast< int >( sizeof( text ) ) );
+        for( auto i : range( size ) )
+        {
+            // The C library may use the decimal point of the locale
+            if( text[i] == ',' )
+            {
+                text[i] = '.';
+            }
+        }
+        buffer_.append( text, static_cast< std::size_t >( size ) );
+        return *this;
+    }
+
+    TextWriter& TextWriter::operator<<( int value )
+    {
+        write_signed< int, unsigned int >( value );
+        return *this;
+    }
+
+    TextWriter& TextWriter::operator<<( unsigned int value )
+    {
+        write_unsigned( value );
+        return *this;
+    }
+
+    TextWriter& TextWriter::operator<<( long value )
+    {
+        write_signed< long, unsigned long >( value );
+        return *this;
+    }
+
+    TextWriter& TextWriter::operator<<( unsigned long value )
+    {
+        write_unsigned( value );
+        return *this;
+    }
+
+    TextWriter& TextWriter::operator<<( long long value )
+    {
+        write_signed< long long, unsigned long long >( value );
+        return *this;
+    }
+
+    TextWriter& TextWriter::operator<<( unsigned long long value )
+    {
+        write_unsigned( value );
+        return *this;
+    }
+
+    void TextWriter::write( std::ostream& out )
+    {
+        out.write(
+            buffer_.data(), static_cast< std::streamsize >( buffer_.size() ) );
+        buffer_.clear();
+    }
+} // namespace RINGMesh
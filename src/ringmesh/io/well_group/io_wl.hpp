@@ -37,6 +37,9 @@ namespace
 {
     class WLIOHandler final : public WellGroupIOHandler
     {
+        /// Number of wells read before being made conformal in parallel
+        static const index_t WELL_BATCH_SIZE = 1024;
+
     public:
         void load( const std::string& filename, WellGroup3D& wells ) final
         {
@@ -46,8 +49,9 @@ namespace
                 throw RINGMeshException( "I/O", "Could not open file" );
             }
 
-            auto mesh = LineMesh3D::create_mesh();
-            auto builder = LineMeshBuilder3D::create_builder( *mesh );
+            std::vector< std::vector< vec3 > > trajectories;
+            std::vector< std::string > names;
+            std::vector< vec3 > trajectory;
             std::string name;
             double z_sign = 1.0;
             vec3 vertex_ref;
@@ -74,7 +78,7 @@ namespace
                     vertex_ref[0] = in.field_as_double( 1 );
                     vertex_ref[1] = in.field_as_double( 2 );
                     vertex_ref[2] = z_sign * in.field_as_double( 3 );
-                    builder->create_vertex( vertex_ref );
+                    trajectory.push_back( vertex_ref );
                 }
                 else if( in.field_matches( 0, "PATH" ) )
                 {
@@ -84,16 +88,22 @@ namespace
                     vertex[2] = z_sign * in.field_as_double( 2 );
                     vertex[0] = in.field_as_double( 3 ) + vertex_ref[0];
                     vertex[1] = in.field_as_double( 4 ) + vertex_ref[1];
-                    index_t id = builder->create_vertex( vertex );
-                    builder->create_edge( id - 1, id );
+                    trajectory.push_back( vertex );
                 }
                 else if( in.field_matches( 0, "END" ) )
                 {
-                    wells.add_well( *mesh, name );
-                    mesh = LineMesh3D::create_mesh();
-                    builder = LineMeshBuilder3D::create_builder( *mesh );
+                    trajectories.push_back( std::move( trajectory ) );
+                    trajectory.clear();
+                    names.push_back( name );
+                    if( trajectories.size() == WELL_BATCH_SIZE )
+                    {
+                        wells.add_wells( trajectories, names );
+                        trajectories.clear();
+                        names.clear();
+                    }
                 }
             }
+            wells.add_wells( trajectories, names );
         }
         void save( const WellGroup3D& wells, const std::string& filename ) final
         {
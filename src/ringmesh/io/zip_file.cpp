@@ -35,8 +35,11 @@
 
 #include <ringmesh/io/zip_file.h>
 
+#include <algorithm>
 #include <fstream>
 
+#include <zlib.h>
+
 #include <minizip/unzip.h>
 #include <minizip/zip.h>
 
@@ -52,8 +55,138 @@
  * @author Arnaud Botella
  */
 
+namespace
+{
+    // zlib sizes are stored on 32 bits
+    const std::size_t ZLIB_CHUNK_SIZE{ 1u << 30 };
+
+    uInt chunk_size( std::size_t size )
+    {
+        return static_cast< uInt >( std::min( size, ZLIB_CHUNK_SIZE ) );
+    }
+
+    uint32_t compute_crc( const std::vector< char >& content )
+    {
+        auto crc = crc32( 0L, Z_NULL, 0 );
+        for( std::size_t start = 0; start < content.size();
+             start += ZLIB_CHUNK_SIZE )
+        {
+            crc = crc32( crc,
+                reinterpret_cast< const Bytef* >( &content[start] ),
+                chunk_size( content.size() - start ) );
+        }
+        // CRC-32 values fit in 32 bits whatever the size of uLong
+        return static_cast< uint32_t >( crc );
+    }
+} // namespace
+
 namespace RINGMesh
 {
+    CompressedFile compress_file_content( const std::vector< char >& content )
+    {
+        CompressedFile file;
+        file.method = Z_DEFLATED;
+        file.uncompressed_size = content.size();
+        file.crc = compute_crc( content );
+
+        z_stream stream;
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        // Negative window bits: raw deflate data, as stored in zip archives
+        if( deflateInit2( &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                -MAX_WBITS, 8, Z_DEFAULT_STRATEGY )
+            != Z_OK )
+        {
+            throw RINGMeshException( "ZipFile", "Could not initialize zlib" );
+        }
+        file.data.resize( std::max( content.size() / 2, std::size_t( 64 ) ) );
+        std::size_t input{ 0 };
+        std::size_t output{ 0 };
+        int flush{ Z_NO_FLUSH };
+        do
+        {
+            stream.next_in = reinterpret_cast< Bytef* >(
+                const_cast< char* >( content.data() ) + input );
+            stream.avail_in = chunk_size( content.size() - input );
+            input += stream.avail_in;
+            flush = input == content.size() ? Z_FINISH : Z_NO_FLUSH;
+            do
+            {
+                if( output == file.data.size() )
+                {
+                    file.data.resize( 2 * file.data.size() );
+                }
+                stream.next_out =
+                    reinterpret_cast< Bytef* >( &file.data[output] );
+                const auto available = chunk_size( file.data.size() - output );
+                stream.avail_out = available;
+                if( deflate( &stream, flush ) == Z_STREAM_ERROR )
+                {
+                    deflateEnd( &stream );
+                    throw RINGMeshException(
+                        "ZipFile", "Error while compressing data" );
+                }
+                output += available - stream.avail_out;
+            } while( stream.avail_out == 0 );
+        } while( flush != Z_FINISH );
+        deflateEnd( &stream );
+        file.data.resize( output );
+        return file;
+    }
+
+    std::vector< char > uncompress_file_content( const CompressedFile& file )
+    {
+        if( file.method == 0 )
+        {
+            return file.data;
+        }
+        if( file.method != Z_DEFLATED )
+        {
+            throw RINGMeshException(
+                "UnZipFile", "Unsupported compression method ", file.method );
+        }
+        z_stream stream;
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        stream.next_in = Z_NULL;
+        stream.avail_in = 0;
+        if( inflateInit2( &stream, -MAX_WBITS ) != Z_OK )
+        {
+            throw RINGMeshException( "UnZipFile", "Could not initialize zlib" );
+        }
+        std::vector< char > content( file.uncompressed_size );
+        std::size_t input{ 0 };
+        std::size_t output{ 0 };
+        int status{ Z_OK };
+        do
+        {
+            if( stream.avail_in == 0 )
+            {
+                stream.next_in = reinterpret_cast< Bytef* >(
+                    const_cast< char* >( file.data.data() ) + input );
+                stream.avail_in = chunk_size( file.data.size() - input );
+                input += stream.avail_in;
+            }
+            stream.next_out = reinterpret_cast< Bytef* >(
+                content.data() + output );
+            const auto available = chunk_size( content.size() - output );
+            stream.avail_out = available;
+            status = inflate( &stream, Z_NO_FLUSH );
+            output += available - stream.avail_out;
+        } while( status == Z_OK && ( stream.avail_in != 0
+                                       || input < file.data.size() ) );
+        inflateEnd( &stream );
+        if( status != Z_STREAM_END || output != content.size()
+            || compute_crc( content ) != file.crc )
+        {
+            throw RINGMeshException(
+                "UnZipFile", "Corrupted data in compressed file" );
+        }
+        return content;
+    }
+
     class ZipFile::Impl
     {
     public:
@@ -81,11 +214,33 @@ namespace RINGMesh
             file.seekg( 0, std::ios::beg );
             std::vector< char > buffer( size );
             file.read( &buffer[0], size );
-            zipOpenNewFileInZip( zip_file_, filename.c_str(), nullptr, nullptr,
-                0, nullptr, 0, nullptr, Z_DEFLATED, Z_DEFAULT_COMPRESSION );
-            zipWriteInFileInZip( zip_file_, size == 0 ? "" : &buffer[0], size );
-            zipCloseFileInZip( zip_file_ );
             file.close();
+            add_file( filename, buffer );
+        }
+
+        void add_file(
+            const std::string& filename, const std::vector< char >& content )
+        {
+            add_compressed_file( filename, compress_file_content( content ) );
+        }
+
+        void add_compressed_file(
+            const std::string& filename, const CompressedFile& file )
+        {
+            const auto zip64 = file.uncompressed_size >= 0xffffffff
+                               || file.data.size() >= 0xffffffff;
+            zipOpenNewFileInZip2_64( zip_file_, filename.c_str(), nullptr,
+                nullptr, 0, nullptr, 0, nullptr,
+                static_cast< uint16_t >( file.method ), Z_DEFAULT_COMPRESSION,
+                1, zip64 ? 1 : 0 );
+            for( std::size_t start = 0; start < file.data.size();
+                 start += ZLIB_CHUNK_SIZE )
+            {
+                zipWriteInFileInZip( zip_file_, &file.data[start],
+                    chunk_size( file.data.size() - start ) );
+            }
+            zipCloseFileInZipRaw64(
+                zip_file_, file.uncompressed_size, file.crc );
         }
 
     private:
@@ -101,6 +256,18 @@ namespace RINGMesh
         impl_->add_file( filename );
     }
 
+    void ZipFile::add_file(
+        const std::string& filename, const std::vector< char >& content )
+    {
+        impl_->add_file( filename, content );
+    }
+
+    void ZipFile::add_compressed_file(
+        const std::string& filename, const CompressedFile& file )
+    {
+        impl_->add_compressed_file( filename, file );
+    }
+
     class UnZipFile::Impl
     {
     public:
@@ -113,10 +280,6 @@ namespace RINGMesh
                 throw RINGMeshException(
                     "UnZipFile", "Could not read file ", filename );
             }
-            if( !GEO::FileSystem::is_directory( directory_to_unzip_ ) )
-            {
-                GEO::FileSystem::create_directory( directory_to_unzip_ );
-            }
         }
 
         ~Impl()
@@ -139,6 +302,98 @@ namespace RINGMesh
             }
         }
 
+        std::vector< char > get_file_content( const std::string& filename )
+        {
+            if( unzLocateFile( zip_file_, filename.c_str(), 0 ) != UNZ_OK )
+            {
+                throw RINGMeshException(
+                    "UnZipFile", "Could not find file ", filename );
+            }
+            return get_current_file_content();
+        }
+
+        std::vector< char > get_current_file_content()
+        {
+            unz_file_info64 file_info;
+            if( unzGetCurrentFileInfo64( zip_file_, &file_info, nullptr, 0,
+                    nullptr, 0, nullptr, 0 )
+                != UNZ_OK )
+            {
+                throw RINGMeshException(
+                    "UnZipFile", "Unable to get file information" );
+            }
+            if( unzOpenCurrentFile( zip_file_ ) != UNZ_OK )
+            {
+                throw RINGMeshException( "UnZipFile", "Could not open file" );
+            }
+            std::vector< char > content(
+                static_cast< std::size_t >( file_info.uncompressed_size ) );
+            std::size_t size{ 0 };
+            int error{ UNZ_OK };
+            do
+            {
+                if( size == content.size() )
+                {
+                    content.resize( size + READ_SIZE );
+                }
+                // minizip cannot read more than 64 KiB at once
+                const auto length =
+                    std::min( content.size() - size, std::size_t( READ_SIZE ) );
+                error = unzReadCurrentFile( zip_file_, &content[size],
+                    static_cast< unsigned int >( length ) );
+                if( error < 0 )
+                {
+                    unzCloseCurrentFile( zip_file_ );
+                    throw RINGMeshException(
+                        "UnZipFile", "Invalid error: ", error );
+                }
+                size += static_cast< std::size_t >( error );
+            } while( error > 0 );
+            unzCloseCurrentFile( zip_file_ );
+            content.resize( size );
+            return content;
+        }
+
+        CompressedFile get_current_compressed_file()
+        {
+            unz_file_info64 file_info;
+            if( unzGetCurrentFileInfo64( zip_file_, &file_info, nullptr, 0,
+                    nullptr, 0, nullptr, 0 )
+                != UNZ_OK )
+            {
+                throw RINGMeshException(
+                    "UnZipFile", "Unable to get file information" );
+            }
+            CompressedFile file;
+            if( unzOpenCurrentFile2( zip_file_, &file.method, nullptr, 1 )
+                != UNZ_OK )
+            {
+                throw RINGMeshException( "UnZipFile", "Could not open file" );
+            }
+            file.uncompressed_size =
+                static_cast< std::size_t >( file_info.uncompressed_size );
+            file.crc = file_info.crc;
+            file.data.resize(
+                static_cast< std::size_t >( file_info.compressed_size ) );
+            std::size_t size{ 0 };
+            while( size < file.data.size() )
+            {
+                const auto length = std::min(
+                    file.data.size() - size, std::size_t( UINT16_MAX ) );
+                auto read = unzReadCurrentFile( zip_file_, &file.data[size],
+                    static_cast< unsigned int >( length ) );
+                if( read <= 0 )
+                {
+                    unzCloseCurrentFile( zip_file_ );
+                    throw RINGMeshException(
+                        "UnZipFile", "Invalid error: ", read );
+                }
+                size += static_cast< std::size_t >( read );
+            }
+            unzCloseCurrentFile( zip_file_ );
+            return file;
+        }
+
         std::string get_current_file()
         {
             return unzip_current_file(
@@ -173,6 +428,10 @@ namespace RINGMesh
                 unzClose( uz );
                 throw RINGMeshException( "UnZipFile", "Could not open file" );
             }
+            if( !GEO::FileSystem::is_directory( directory_to_unzip_ ) )
+            {
+                GEO::FileSystem::create_directory( directory_to_unzip_ );
+            }
             const std::string unziped_file{ directory_to_unzip_ + "/"
                                             + filename };
             FILE* out{ fopen( unziped_file.c_str(), "wb" ) };
@@ -224,6 +483,22 @@ namespace RINGMesh
         return impl_->get_file( filename );
     }
 
+    std::vector< char > UnZipFile::get_file_content(
+        const std::string& filename )
+    {
+        return impl_->get_file_content( filename );
+    }
+
+    std::vector< char > UnZipFile::get_current_file_content()
+    {
+        return impl_->get_current_file_content();
+    }
+
+    CompressedFile UnZipFile::get_current_compressed_file()
+    {
+        return impl_->get_current_compressed_file();
+    }
+
     void UnZipFile::start_extract()
     {
         impl_->start_extract();
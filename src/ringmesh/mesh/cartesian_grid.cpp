@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/mesh/cartesian_grid.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include <ringmesh/basic/memory_mapped_file.h>
+
+/*!
+ * @file Binary file format of the Cartesian grids
+ */
+
+namespace
+{
+    using namespace RINGMesh;
+
+    /*
+     * Binary Cartesian grid file (.rgrid), in the byte order of the machine:
+     *  - a header: magic, version, dimension, number of attributes, number
+     *    of cells in each direction, origin and vectors of the grid frame,
+     *  - a table giving the name, type, offset and size of each attribute,
+     *  - the attribute values, aligned on RGRID_DATA_ALIGNMENT bytes so
+     *    that they can be mapped in memory.
+     * The unused directions of 2D grids are filled with zeros.
+     */
+    const char RGRID_MAGIC[8] = { 'R', 'I', 'N', 'G', 'G', 'R', 'I', 'D' };
+    const std::uint32_t RGRID_VERSION{ 1 };
+    const std::size_t RGRID_BLOCK_SIZE{ 64 };
+    const std::size_t RGRID_DATA_ALIGNMENT{ 4096 };
+    const std::size_t RGRID_NAME_SIZE{ 40 };
+    const std::size_t RGRID_TYPE_SIZE{ 8 };
+
+    struct RGridHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t dimension;
+        std::uint64_t nb_attributes;
+        std::uint64_t nb_cells[3];
+        double origin[3];
+        double vectors[3][3];
+        char padding[3 * RGRID_BLOCK_SIZE - 144];
+    };
+
+    struct RGridAttribute
+    {
+        char name[RGRID_NAME_SIZE];
+        char type[RGRID_TYPE_SIZE];
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    static_assert( sizeof( RGridHeader ) == 3 * RGRID_BLOCK_SIZE,
+        "RGridHeader should fill aligned blocks" );
+    static_assert( sizeof( RGridAttribute ) == RGRID_BLOCK_SIZE,
+        "RGridAttribute should fill an aligned block" );
+
+    std::uint64_t align_offset( std::uint64_t offset )
+    {
+        return ( offset + RGRID_DATA_ALIGNMENT - 1 ) / RGRID_DATA_ALIGNMENT
+               * RGRID_DATA_ALIGNMENT;
+    }
+
+    /*!
+     * @return the name of the type of the store values among the ones
+     * given by CartesianGridBase::type_to_string, or an empty string
+     */
+    std::string attribute_type_name( const GEO::AttributeStore& store )
+    {
+        if( store.elements_type_matches( typeid( index_t ).name() ) )
+        {
+            return "index_t";
+        }
+        if( store.elements_type_matches( typeid( int ).name() ) )
+        {
+            return "int";
+        }
+        if( store.elements_type_matches( typeid( float ).name() ) )
+        {
+            return "float";
+        }
+        if( store.elements_type_matches( typeid( double ).name() ) )
+        {
+            return "double";
+        }
+        return "";
+    }
+
+    template < typename T >
+    GEO::AttributeStore* create_mapped_attribute_store(
+        const std::string& filename,
+        const RGridAttribute& attribute,
+        index_t nb_cells )
+    {
+        if( attribute.size != nb_cells * sizeof( T ) )
+        {
+            throw RINGMeshException( "I/O", "Wrong size of the attribute ",
+                attribute.name, " in the file: ", filename );
+        }
+        return new MappedAttributeStore< T >( filename,
+            MemoryMappedFile::Mode::COPY_ON_WRITE,
+            static_cast< std::size_t >( attribute.offset ), nb_cells );
+    }
+
+    GEO::AttributeStore* create_mapped_attribute_store(
+        const std::string& filename,
+        const RGridAttribute& attribute,
+        const std::string& type,
+        index_t nb_cells )
+    {
+        if( type == "index_t" )
+        {
+            return create_mapped_attribute_store< index_t >(
+                filename, attribute, nb_cells );
+        }
+        if( type == "int" )
+        {
+            return create_mapped_attribute_store< int >(
+                filename, attribute, nb_cells );
+        }
+        if( type == "float" )
+        {
+            return create_mapped_attribute_store< float >(
+                filename, attribute, nb_cells );
+        }
+        return create_mapped_attribute_store< double >(
+            filename, attribute, nb_cells );
+    }
+
+    GEO::AttributeStore* create_attribute_store( const std::string& filename,
+        const RGridAttribute& attribute,
+        const std::string& type,
+        index_t nb_cells,
+        const char* file_data )
+    {
+        auto store =
+            GEO::AttributeStore::create_attribute_store_by_element_type_name(
+                type, 1 );
+        store->resize( nb_cells );
+        if( attribute.size != nb_cells * store->element_size() )
+        {
+            delete store;
+            throw RINGMeshException( "I/O", "Wrong size of the attribute ",
+                attribute.name, " in the file: ", filename );
+        }
+        std::memcpy( store->data(), file_data + attribute.offset,
+            static_cast< std::size_t >( attribute.size ) );
+        return store;
+    }
+} // namespace
+
+namespace RINGMesh
+{
+    template < index_t DIMENSION >
+    void save_cartesian_grid( const CartesianGridBase< DIMENSION >& grid,
+        const std::string& filename )
+    {
+        RGridHeader header;
+        std::memset( &header, 0, sizeof( RGridHeader ) );
+        std::memcpy( header.magic, RGRID_MAGIC, sizeof( RGRID_MAGIC ) );
+        header.version = RGRID_VERSION;
+        header.dimension = DIMENSION;
+        const auto& frame = grid.grid_vectors();
+        for( auto i : range( DIMENSION ) )
+        {
+            header.nb_cells[i] = grid.nb_cells_axis( i );
+            header.origin[i] = frame.origin()[i];
+            for( auto j : range( DIMENSION ) )
+            {
+                header.vectors[i][j] = frame[i][j];
+            }
+        }
+
+        const auto& manager = grid.attributes_manager();
+        GEO::vector< std::string > names;
+        manager.list_attribute_names( names );
+        std::vector< RGridAttribute > table;
+        std::vector< const GEO::AttributeStore* > stores;
+        for( const auto& name : names )
+        {
+            const auto* store = manager.find_attribute_store( name );
+            auto type = attribute_type_name( *store );
+            if( type.empty() || store->dimension() != 1 )
+            {
+                Logger::warn( "I/O", "Attribute ", name,
+                    " is not saved, its type is not supported" );
+                continue;
+            }
+            if( name.size() >= RGRID_NAME_SIZE )
+            {
+                throw RINGMeshException(
+                    "I/O", "Attribute name too long: ", name );
+            }
+            RGridAttribute attribute;
+            std::memset( &attribute, 0, sizeof( RGridAttribute ) );
+            std::memcpy( attribute.name, name.c_str(), name.size() );
+            std::memcpy( attribute.type, type.c_str(), type.size() );
+            attribute.size = static_cast< std::uint64_t >( grid.nb_cells() )
+                             * store->element_size();
+            table.push_back( attribute );
+            stores.push_back( store );
+        }
+        header.nb_attributes = table.size();
+
+        auto offset = align_offset(
+            sizeof( RGridHeader ) + table.size() * sizeof( RGridAttribute ) );
+        for( auto& attribute : table )
+        {
+            attribute.offset = offset;
+            offset = align_offset( offset + attribute.size );
+        }
+
+        std::ofstream out{ filename.c_str(), std::ios::binary };
+        if( !out )
+        {
+            throw RINGMeshException(
+                "I/O", "Error when opening the file: ", filename );
+        }
+        out.write( reinterpret_cast< const char* >( &header ),
+            sizeof( RGridHeader ) );
+        out.write( reinterpret_cast< const char* >( table.data() ),
+            static_cast< std::streamsize >(
+                table.size() * sizeof( RGridAttribute ) ) );
+        const std::vector< char > padding( RGRID_DATA_ALIGNMENT, 0 );
+        for( auto a : range( table.size() ) )
+        {
+            auto position = static_cast< std::uint64_t >( out.tellp() );
+            out.write( padding.data(),
+                static_cast< std::streamsize >(
+                    table[a].offset - position ) );
+            out.write( static_cast< const char* >( stores[a]->data() ),
+                static_cast< std::streamsize >( table[a].size ) );
+        }
+        if( !out )
+        {
+            throw RINGMeshException(
+                "I/O", "Error when writing the file: ", filename );
+        }
+    }
+
+    template < index_t DIMENSION >
+    void load_cartesian_grid( CartesianGridBase< DIMENSION >& grid,
+        const std::string& filename,
+        bool memory_mapped )
+    {
+        MemoryMappedFile file{ filename };
+        RGridHeader header;
+        if( file.size() < sizeof( RGridHeader ) )
+        {
+            throw RINGMeshException(
+                "I/O", "File too small to be a Cartesian grid: ", filename );
+        }
+        std::memcpy( &header, file.data(), sizeof( RGridHeader ) );
+        if( std::memcmp( header.magic, RGRID_MAGIC, sizeof( RGRID_MAGIC ) )
+                != 0
+            || header.version != RGRID_VERSION )
+        {
+            throw RINGMeshException(
+                "I/O", "Not a Cartesian grid file: ", filename );
+        }
+        if( header.dimension != DIMENSION )
+        {
+            throw RINGMeshException( "I/O", "The file ", filename,
+                " contains a grid of dimension ", header.dimension );
+        }
+        if( header.nb_attributes > ( file.size() - sizeof( RGridHeader ) )
+                                       / sizeof( RGridAttribute ) )
+        {
+            throw RINGMeshException(
+                "I/O", "Truncated Cartesian grid file: ", filename );
+        }
+
+        ivecn< DIMENSION > nb_cells;
+        Frame< DIMENSION > vectors;
+        vecn< DIMENSION > origin;
+        std::uint64_t nb_total_cells{ 1 };
+        for( auto i : range( DIMENSION ) )
+        {
+            if( header.nb_cells[i] >= NO_ID )
+            {
+                throw RINGMeshException( "I/O",
+                    "Too many cells in the grid of the file: ", filename );
+            }
+            nb_cells[i] = static_cast< index_t >( header.nb_cells[i] );
+            // Both factors are below NO_ID, the product cannot overflow
+            nb_total_cells *= header.nb_cells[i];
+            if( nb_total_cells >= NO_ID )
+            {
+                throw RINGMeshException( "I/O",
+                    "Too many cells in the grid of the file: ", filename );
+            }
+            origin[i] = header.origin[i];
+            for( auto j : range( DIMENSION ) )
+            {
+                vectors[i][j] = header.vectors[i][j];
+            }
+        }
+
+        grid.attributes_manager().clear( false, false );
+        CartesianGridBaseBuilder< DIMENSION > builder{ grid };
+        builder.initialise_grid( nb_cells,
+            ReferenceFrame< DIMENSION >{ origin, vectors } );
+
+        const auto* table = reinterpret_cast< const RGridAttribute* >(
+            file.data() + sizeof( RGridHeader ) );
+        for( auto a : range( header.nb_attributes ) )
+        {
+            auto attribute = table[a];
+            attribute.name[RGRID_NAME_SIZE - 1] = '\0';
+            std::string type{ attribute.type,
+                strnlen( attribute.type, RGRID_TYPE_SIZE ) };
+            if( type != "index_t" && type != "int" && type != "float"
+                && type != "double" )
+            {
+                throw RINGMeshException( "I/O", "Unknown type ", type,
+                    " of the attribute ", attribute.name );
+            }
+            if( attribute.offset > file.size()
+                || attribute.size > file.size() - attribute.offset )
+            {
+                throw RINGMeshException(
+                    "I/O", "Truncated Cartesian grid file: ", filename );
+            }
+            GEO::AttributeStore* store{ nullptr };
+            if( memory_mapped )
+            {
+                store = create_mapped_attribute_store(
+                    filename, attribute, type, grid.nb_cells() );
+            }
+            else
+            {
+                store = create_attribute_store( filename, attribute, type,
+                    grid.nb_cells(), file.data() );
+            }
+            grid.attributes_manager().bind_attribute_store(
+                attribute.name, store );
+        }
+    }
+
+    template void mesh_api save_cartesian_grid(
+        const CartesianGridBase2D&, const std::string& );
+    template void mesh_api load_cartesian_grid(
+        CartesianGridBase2D&, const std::string&, bool );
+
+    template void mesh_api save_cartesian_grid(
+        const CartesianGridBase3D&, const std::string& );
+    template void mesh_api load_cartesian_grid(
+        CartesianGridBase3D&, const std::string&, bool );
+} // namespace RINGMesh
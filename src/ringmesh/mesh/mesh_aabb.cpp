@@ -36,10 +36,15 @@
 #include <ringmesh/mesh/mesh_aabb.h>
 
 #include <algorithm>
+#include <functional>
 #include <numeric>
 
+#include <geogram/basic/geometry.h>
+
 #include <ringmesh/basic/geometry.h>
+#include <ringmesh/basic/task_handler.h>
 
+#include <ringmesh/mesh/cartesian_grid.h>
 #include <ringmesh/mesh/line_mesh.h>
 #include <ringmesh/mesh/mesh_index.h>
 #include <ringmesh/mesh/surface_mesh.h>
@@ -68,6 +73,15 @@ namespace
         const auto& p3 = M.vertex( M.cell_vertex( { cell, 3 } ) );
         return Position::point_inside_tetra( p, { p0, p1, p2, p3 } );
     }
+
+    /// Number of grid cells per mesh cell targeted by VolumeCellGrid
+    const double GRID_CELLS_PER_MESH_CELL = 1.;
+
+    /// Number of candidates above which VolumeCellGrid walks first
+    const index_t MAX_NB_CANDIDATES_TO_TEST = 32;
+
+    /// Maximal number of cells crossed by a walk in VolumeCellGrid
+    const index_t MAX_WALK_STEPS = 64;
 } // namespace
 
 /****************************************************************************/
@@ -258,10 +272,261 @@ namespace RINGMesh
         return result;
     }
 
+    template < index_t DIMENSION >
+    VolumeCellGrid< DIMENSION >::VolumeCellGrid(
+        const VolumeMesh< DIMENSION >& mesh )
+        : mesh_( mesh )
+    {
+        auto nb_cells = mesh.nb_cells();
+        std::vector< Box< DIMENSION > > cell_boxes( nb_cells );
+        parallel_for( nb_cells, [&mesh, &cell_boxes]( index_t c ) {
+            for( auto v : range( mesh.nb_cell_vertices( c ) ) )
+            {
+                cell_boxes[c].add_point(
+                    mesh.vertex( mesh.cell_vertex( { c, v } ) ) );
+            }
+        } );
+        for( const auto& box : cell_boxes )
+        {
+            bbox_.add_box( box );
+        }
+
+        // The grid cells are about cubic, a flat axis gets a single cell
+        vecn< DIMENSION > extent;
+        double volume{ 1 };
+        for( auto i : range( DIMENSION ) )
+        {
+            extent[i] = bbox_.initialized() ? bbox_.diagonal()[i] : 0.;
+            if( extent[i] <= 0. )
+            {
+                extent[i] = 1.;
+            }
+            volume *= extent[i];
+        }
+        auto nb_grid_cells_target =
+            std::max( nb_cells * GRID_CELLS_PER_MESH_CELL, 1. );
+        auto grid_cell_size = std::pow( volume / nb_grid_cells_target,
+            1. / static_cast< double >( DIMENSION ) );
+        ivecn< DIMENSION > nb_grid_cells;
+        ReferenceFrame< DIMENSION > frame;
+        for( auto i : range( DIMENSION ) )
+        {
+            nb_grid_cells[i] = static_cast< index_t >( std::max(
+                std::ceil( extent[i] / grid_cell_size ), 1. ) );
+            frame[i][i] = extent[i] / nb_grid_cells[i];
+        }
+        if( bbox_.initialized() )
+        {
+            frame.origin() = bbox_.min();
+        }
+        grid_.reset( new CartesianGrid< DIMENSION >( nb_grid_cells, frame ) );
+
+        std::vector< std::pair< sivecn< DIMENSION >, sivecn< DIMENSION > > >
+            cell_ranges( nb_cells );
+        parallel_for( nb_cells, [this, &cell_boxes, &cell_ranges]( index_t c ) {
+            cell_ranges[c] = { grid_cell_coords( cell_boxes[c].min() ),
+                grid_cell_coords( cell_boxes[c].max() ) };
+        } );
+        fill_rows( cell_ranges );
+    }
+
+    template < index_t DIMENSION >
+    void VolumeCellGrid< DIMENSION >::fill_rows(
+        const std::vector< std::pair< sivecn< DIMENSION >,
+            sivecn< DIMENSION > > >& cell_ranges )
+    {
+        // The rows are filled by slabs of constant third grid coordinate
+        // in parallel, the rows of a slab being contiguous.
+        auto nb_slabs = grid_->nb_cells_axis( 2 );
+        auto slab_size = grid_->nb_cells_axis( 0 ) * grid_->nb_cells_axis( 1 );
+        std::vector< std::vector< index_t > > slab_cells( nb_slabs );
+        for( auto c : range( cell_ranges.size() ) )
+        {
+            for( auto k = cell_ranges[c].first[2];
+                 k <= cell_ranges[c].second[2]; k++ )
+            {
+                slab_cells[static_cast< index_t >( k )].push_back( c );
+            }
+        }
+        auto for_each_slab_grid_cell = [this, &cell_ranges, &slab_cells](
+            index_t slab, const std::function< void( index_t, index_t ) >&
+                              action ) {
+            sivecn< DIMENSION > cur;
+            cur[2] = static_cast< signed_index_t >( slab );
+            for( auto c : slab_cells[slab] )
+            {
+                const auto& range_coords = cell_ranges[c];
+                for( cur[1] = range_coords.first[1];
+                     cur[1] <= range_coords.second[1]; cur[1]++ )
+                {
+                    for( cur[0] = range_coords.first[0];
+                         cur[0] <= range_coords.second[0]; cur[0]++ )
+                    {
+                        action( grid_->cell_offset( cur ), c );
+                    }
+                }
+            }
+        };
+
+        grid_cell_ptr_.assign( grid_->nb_cells() + 1, 0 );
+        parallel_for( nb_slabs, [this, &for_each_slab_grid_cell](
+                                    index_t slab ) {
+            for_each_slab_grid_cell( slab, [this]( index_t grid_cell,
+                                               index_t /*unused*/ ) {
+                grid_cell_ptr_[grid_cell + 1]++;
+            } );
+        } );
+        std::partial_sum( grid_cell_ptr_.begin(), grid_cell_ptr_.end(),
+            grid_cell_ptr_.begin() );
+
+        mesh_cells_.resize( grid_cell_ptr_.back() );
+        parallel_for( nb_slabs, [this, &for_each_slab_grid_cell, slab_size](
+                                    index_t slab ) {
+            auto first_grid_cell = slab * slab_size;
+            std::vector< index_t > cursors(
+                grid_cell_ptr_.begin() + first_grid_cell,
+                grid_cell_ptr_.begin() + first_grid_cell + slab_size );
+            for_each_slab_grid_cell( slab, [this, &cursors, first_grid_cell](
+                                               index_t grid_cell,
+                                               index_t cell ) {
+                mesh_cells_[cursors[grid_cell - first_grid_cell]++] = cell;
+            } );
+        } );
+
+        // The walks start from the first mesh cell of a row, it is chosen
+        // with the barycenter the closest to the grid cell center.
+        parallel_for( grid_->nb_cells(), [this]( index_t grid_cell ) {
+            auto nb_candidates = nb_mesh_cells( grid_cell );
+            if( nb_candidates <= MAX_NB_CANDIDATES_TO_TEST )
+            {
+                return;
+            }
+            auto coords = grid_->local_from_offset( grid_cell );
+            auto center = grid_->cell_corner_global_coords( coords );
+            for( auto i : range( DIMENSION ) )
+            {
+                center += 0.5 * grid_->grid_vectors()[i];
+            }
+            auto row = grid_cell_ptr_[grid_cell];
+            auto closest = row;
+            auto min_distance = max_float64();
+            for( auto i : range( row, row + nb_candidates ) )
+            {
+                auto distance =
+                    length2( mesh_.cell_barycenter( mesh_cells_[i] ) - center );
+                if( distance < min_distance )
+                {
+                    min_distance = distance;
+                    closest = i;
+                }
+            }
+            std::swap( mesh_cells_[row], mesh_cells_[closest] );
+        } );
+    }
+
+    template < index_t DIMENSION >
+    VolumeCellGrid< DIMENSION >::~VolumeCellGrid() = default;
+
+    template < index_t DIMENSION >
+    index_t VolumeCellGrid< DIMENSION >::containing_cell(
+        const vecn< DIMENSION >& query ) const
+    {
+        if( mesh_cells_.empty() || !bbox_.contains( query ) )
+        {
+            return NO_ID;
+        }
+        auto grid_cell = grid_->cell_offset( grid_cell_coords( query ) );
+        auto nb_candidates = nb_mesh_cells( grid_cell );
+        if( nb_candidates > MAX_NB_CANDIDATES_TO_TEST )
+        {
+            auto cell =
+                walk_to_containing_cell( query, mesh_cell( grid_cell, 0 ) );
+            if( cell != NO_ID )
+            {
+                return cell;
+            }
+        }
+        for( auto i : range( nb_candidates ) )
+        {
+            auto cell = mesh_cell( grid_cell, i );
+            if( mesh_cell_contains_point( mesh_, cell, query ) )
+            {
+                return cell;
+            }
+        }
+        return NO_ID;
+    }
+
+    template < index_t DIMENSION >
+    sivecn< DIMENSION > VolumeCellGrid< DIMENSION >::grid_cell_coords(
+        const vecn< DIMENSION >& point ) const
+    {
+        auto coords = grid_->containing_cell_from_global_point( point );
+        for( auto i : range( DIMENSION ) )
+        {
+            auto nb_grid_cells =
+                static_cast< signed_index_t >( grid_->nb_cells_axis( i ) );
+            coords[i] = std::min( std::max( coords[i], 0 ), nb_grid_cells - 1 );
+        }
+        return coords;
+    }
+
+    template < index_t DIMENSION >
+    index_t VolumeCellGrid< DIMENSION >::walk_to_containing_cell(
+        const vecn< DIMENSION >& query, index_t start_cell ) const
+    {
+        auto cell = start_cell;
+        for( auto step : range( MAX_WALK_STEPS ) )
+        {
+            ringmesh_unused( step );
+            std::array< vecn< DIMENSION >, 4 > vertices;
+            for( auto v : range( 4 ) )
+            {
+                vertices[v] = mesh_.vertex( mesh_.cell_vertex( { cell, v } ) );
+            }
+            auto volume = GEO::Geom::tetra_signed_volume(
+                vertices[0], vertices[1], vertices[2], vertices[3] );
+            if( volume == 0. )
+            {
+                return NO_ID;
+            }
+            // The point is replaced in turn for each vertex to get its
+            // barycentric coordinates, the facet opposite to the most
+            // negative one is crossed.
+            index_t exit_facet{ NO_ID };
+            double min_coordinate{ 0 };
+            for( auto f : range( 4 ) )
+            {
+                auto tetra = vertices;
+                tetra[f] = query;
+                auto coordinate = GEO::Geom::tetra_signed_volume(
+                                      tetra[0], tetra[1], tetra[2], tetra[3] )
+                                  / volume;
+                if( coordinate < min_coordinate )
+                {
+                    min_coordinate = coordinate;
+                    exit_facet = f;
+                }
+            }
+            if( exit_facet == NO_ID )
+            {
+                return mesh_cell_contains_point( mesh_, cell, query ) ? cell
+                                                                      : NO_ID;
+            }
+            cell = mesh_.cell_adjacent( { cell, exit_facet } );
+            if( cell == NO_ID )
+            {
+                return NO_ID;
+            }
+        }
+        return NO_ID;
+    }
+
     template class mesh_api LineAABBTree< 2 >;
     template class mesh_api SurfaceAABBTree< 2 >;
 
     template class mesh_api LineAABBTree< 3 >;
     template class mesh_api SurfaceAABBTree< 3 >;
     template class mesh_api VolumeAABBTree< 3 >;
+    template class mesh_api VolumeCellGrid< 3 >;
 } // namespace RINGMesh
@@ -62,6 +62,14 @@ namespace RINGMesh
         return *vertex_nn_search_.get();
     }
 
+    template < index_t DIMENSION >
+    void MeshBase< DIMENSION >::save_mesh( std::vector< char >& buffer ) const
+    {
+        ringmesh_unused( buffer );
+        throw RINGMeshException(
+            "I/O", "This mesh cannot be saved in a memory buffer" );
+    }
+
     template class mesh_api MeshBase< 2 >;
     template class mesh_api MeshBase< 3 >;
 
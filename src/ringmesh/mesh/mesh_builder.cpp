@@ -213,6 +213,16 @@ namespace RINGMesh
         clear_vertex_linked_objects();
     }
 
+    template < index_t DIMENSION >
+    void MeshBaseBuilder< DIMENSION >::load_mesh(
+        const char* data, std::size_t size )
+    {
+        ringmesh_unused( data );
+        ringmesh_unused( size );
+        throw RINGMeshException(
+            "I/O", "This mesh cannot be loaded from a memory buffer" );
+    }
+
     template < index_t DIMENSION >
     void MeshBaseBuilder< DIMENSION >::clear(
         bool keep_attributes, bool keep_memory )
@@ -396,6 +406,12 @@ namespace RINGMesh
         volume_mesh_.cell_aabb_.reset();
     }
 
+    template < index_t DIMENSION >
+    void VolumeMeshBuilder< DIMENSION >::delete_cell_grid()
+    {
+        volume_mesh_.cell_grid_.reset();
+    }
+
     template class mesh_api MeshBaseBuilder< 2 >;
     template class mesh_api PointSetMeshBuilder< 2 >;
     template class mesh_api LineMeshBuilder< 2 >;
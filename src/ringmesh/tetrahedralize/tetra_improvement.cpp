@@ -0,0 +1,574 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/tetrahedralize/tetra_improvement.h>
+
+#include <array>
+
+#include <geogram/basic/attributes.h>
+
+#include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/nn_search.h>
+#include <ringmesh/basic/task_handler.h>
+
+#include <ringmesh/geomodel/builder/geomodel_builder.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/core/well.h>
+
+#include <ringmesh/mesh/mesh_index.h>
+
+/*!
+ * @file Implementation of the local improvement of tetrahedral meshes
+ */
+
+namespace
+{
+    using namespace RINGMesh;
+
+    using Tet = std::array< index_t, 4 >;
+
+    bool tet_contains( const Tet& tet, index_t vertex )
+    {
+        return std::find( tet.begin(), tet.end(), vertex ) != tet.end();
+    }
+
+    /*!
+     * @brief Improvement of the tetrahedral mesh of one Region.
+     * @details The region mesh is copied in local arrays, so that several
+     * regions can be processed concurrently. The result is written back
+     * in the GeoModel by write_region_mesh().
+     */
+    class RegionTetImprover
+    {
+        ringmesh_disable_copy_and_move( RegionTetImprover );
+
+    public:
+        RegionTetImprover( const Region3D& region,
+            const std::string& quality_attribute_name,
+            double min_quality,
+            const TetQuality& quality )
+            : region_( region ),
+              min_quality_( min_quality ),
+              quality_( quality )
+        {
+            copy_region_mesh( quality_attribute_name );
+            lock_boundary_vertices();
+        }
+
+        index_t improve( index_t nb_iterations )
+        {
+            if( tets_.empty() )
+            {
+                return 0;
+            }
+            build_vertex_to_tets();
+            index_t nb_modifications{ 0 };
+            for( auto iteration : range( nb_iterations ) )
+            {
+                ringmesh_unused( iteration );
+                auto nb_flips = flip_bad_tets();
+                auto nb_moves = smooth_bad_tet_vertices();
+                nb_modifications += nb_flips + nb_moves;
+                if( nb_flips + nb_moves == 0 )
+                {
+                    break;
+                }
+            }
+            return nb_modifications;
+        }
+
+        void write_region_mesh( GeoModelBuilder3D& builder ) const
+        {
+            std::vector< index_t > tets;
+            tets.reserve( 4 * tets_.size() );
+            for( auto t : range( tets_.size() ) )
+            {
+                if( alive_[t] )
+                {
+                    tets.insert( tets.end(), tets_[t].begin(), tets_[t].end() );
+                }
+            }
+            builder.geometry.set_region_geometry(
+                region_.index(), points_, tets );
+            builder.geometry.compute_region_adjacencies( region_.index() );
+        }
+
+    private:
+        void copy_region_mesh( const std::string& quality_attribute_name )
+        {
+            if( !region_.cell_attribute_manager().is_defined(
+                    quality_attribute_name ) )
+            {
+                throw RINGMeshException( "TetraGen", "Region ",
+                    region_.index(), " has no cell attribute ",
+                    quality_attribute_name );
+            }
+            GEO::Attribute< double > quality_attribute(
+                region_.cell_attribute_manager(), quality_attribute_name );
+
+            points_.resize( region_.nb_vertices() );
+            for( auto v : range( region_.nb_vertices() ) )
+            {
+                points_[v] = region_.vertex( v );
+            }
+            auto nb_tets = region_.nb_mesh_elements();
+            tets_.resize( nb_tets );
+            qualities_.resize( nb_tets );
+            alive_.resize( nb_tets, true );
+            for( auto t : range( nb_tets ) )
+            {
+                ringmesh_assert( region_.nb_mesh_element_vertices( t ) == 4 );
+                for( auto v : range( 4 ) )
+                {
+                    tets_[t][v] = region_.mesh_element_vertex_index( { t, v } );
+                }
+                qualities_[t] = quality_attribute[t];
+            }
+            if( nb_tets != 0 )
+            {
+                orientation_ = signed_volume( tets_.front() ) > 0 ? 1. : -1.;
+            }
+        }
+
+        /*!
+         * Locks the vertices on the region boundary facets, and the ones
+         * colocated with the boundary surfaces (to preserve internal
+         * boundaries) and with the wells.
+         */
+        void lock_boundary_vertices()
+        {
+            locked_.resize( points_.size(), false );
+            const auto& nn_search = region_.vertex_nn_search();
+            auto epsilon = region_.geomodel().epsilon();
+            auto lock_colocated_vertices = [this, &nn_search, epsilon](
+                const vec3& point ) {
+                for( auto v : nn_search.get_neighbors( point, epsilon ) )
+                {
+                    locked_[v] = true;
+                }
+            };
+            for( auto s : range( region_.nb_boundaries() ) )
+            {
+                const auto& surface = region_.boundary( s );
+                for( auto v : range( surface.nb_vertices() ) )
+                {
+                    lock_colocated_vertices( surface.vertex( v ) );
+                }
+            }
+            const auto* wells = region_.geomodel().wells();
+            if( wells != nullptr )
+            {
+                std::vector< Edge3D > well_edges;
+                wells->get_region_edges( region_.index(), well_edges );
+                for( const auto& edge : well_edges )
+                {
+                    lock_colocated_vertices( edge.vertex( 0 ) );
+                    lock_colocated_vertices( edge.vertex( 1 ) );
+                }
+            }
+            for( auto t : range( region_.nb_mesh_elements() ) )
+            {
+                for( auto f : range( 4 ) )
+                {
+                    if( region_.cell_adjacent_index( t, f ) == NO_ID )
+                    {
+                        for( auto v : range( 3 ) )
+                        {
+                            locked_[region_.cell_facet_vertex_index(
+                                t, f, v )] = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        void build_vertex_to_tets()
+        {
+            vertex_to_tets_.assign( points_.size(), {} );
+            for( auto t : range( tets_.size() ) )
+            {
+                for( auto v : tets_[t] )
+                {
+                    vertex_to_tets_[v].push_back( t );
+                }
+            }
+        }
+
+        double signed_volume( const Tet& tet ) const
+        {
+            return GEO::Geom::tetra_signed_volume( points_[tet[0]],
+                points_[tet[1]], points_[tet[2]], points_[tet[3]] );
+        }
+
+        bool is_well_oriented( const Tet& tet ) const
+        {
+            return orientation_ * signed_volume( tet ) > 0;
+        }
+
+        double compute_quality( const Tet& tet ) const
+        {
+            return quality_( points_[tet[0]], points_[tet[1]],
+                points_[tet[2]], points_[tet[3]] );
+        }
+
+        /*!
+         * Gets the alive tetrahedra containing all the given vertices
+         */
+        std::vector< index_t > tets_around(
+            const std::vector< index_t >& vertices ) const
+        {
+            std::vector< index_t > result;
+            for( auto t : vertex_to_tets_[vertices.front()] )
+            {
+                bool contains_all{ true };
+                for( auto v : vertices )
+                {
+                    contains_all = contains_all && tet_contains( tets_[t], v );
+                }
+                if( contains_all )
+                {
+                    result.push_back( t );
+                }
+            }
+            return result;
+        }
+
+        /*!
+         * Replaces the tetrahedra \p old_tets by \p new_tets if it improves
+         * the minimum quality and if all the new tetrahedra are valid.
+         */
+        bool replace_tets( const std::vector< index_t >& old_tets,
+            const std::vector< Tet >& new_tets )
+        {
+            double old_min{ max_float64() };
+            for( auto t : old_tets )
+            {
+                old_min = std::min( old_min, qualities_[t] );
+            }
+            std::vector< double > new_qualities;
+            new_qualities.reserve( new_tets.size() );
+            for( const auto& tet : new_tets )
+            {
+                if( !is_well_oriented( tet ) )
+                {
+                    return false;
+                }
+                new_qualities.push_back( compute_quality( tet ) );
+                if( new_qualities.back() <= old_min )
+                {
+                    return false;
+                }
+            }
+
+            for( auto t : old_tets )
+            {
+                alive_[t] = false;
+                for( auto v : tets_[t] )
+                {
+                    auto& v_tets = vertex_to_tets_[v];
+                    v_tets.erase( std::find( v_tets.begin(), v_tets.end(), t ) );
+                }
+            }
+            for( auto i : range( new_tets.size() ) )
+            {
+                auto t = static_cast< index_t >( tets_.size() );
+                tets_.push_back( new_tets[i] );
+                qualities_.push_back( new_qualities[i] );
+                alive_.push_back( true );
+                for( auto v : new_tets[i] )
+                {
+                    vertex_to_tets_[v].push_back( t );
+                }
+            }
+            return true;
+        }
+
+        /*!
+         * 2-3 flip: the facet of \p tet opposite to \p vertex and the
+         * adjacent tetrahedron are replaced by 3 tetrahedra sharing the edge
+         * joining the two opposite vertices.
+         */
+        bool flip_facet( index_t tet, index_t vertex )
+        {
+            auto d = tets_[tet][vertex];
+            std::array< index_t, 3 > facet;
+            index_t count{ 0 };
+            for( auto v : range( 4 ) )
+            {
+                if( v != vertex )
+                {
+                    facet[count++] = tets_[tet][v];
+                }
+            }
+            if( locked_[facet[0]] && locked_[facet[1]] && locked_[facet[2]] )
+            {
+                return false;
+            }
+            if( !is_well_oriented( { { facet[0], facet[1], facet[2], d } } ) )
+            {
+                std::swap( facet[0], facet[1] );
+            }
+            auto facet_tets = tets_around( { facet[0], facet[1], facet[2] } );
+            if( facet_tets.size() != 2 )
+            {
+                return false;
+            }
+            auto adjacent = facet_tets[0] == tet ? facet_tets[1] : facet_tets[0];
+            index_t e{ NO_ID };
+            for( auto v : tets_[adjacent] )
+            {
+                if( !contains( facet, v ) )
+                {
+                    e = v;
+                }
+            }
+            ringmesh_assert( e != NO_ID );
+            return replace_tets( { tet, adjacent },
+                { { { facet[0], facet[1], e, d } },
+                    { { facet[1], facet[2], e, d } },
+                    { { facet[2], facet[0], e, d } } } );
+        }
+
+        /*!
+         * 3-2 flip: the 3 tetrahedra around the edge are replaced by 2
+         * tetrahedra sharing the facet made by the 3 other vertices.
+         */
+        bool flip_edge( index_t a, index_t b )
+        {
+            if( locked_[a] && locked_[b] )
+            {
+                return false;
+            }
+            auto edge_tets = tets_around( { a, b } );
+            if( edge_tets.size() != 3 )
+            {
+                return false;
+            }
+            std::vector< index_t > ring;
+            for( auto t : edge_tets )
+            {
+                for( auto v : tets_[t] )
+                {
+                    if( v != a && v != b && !contains( ring, v ) )
+                    {
+                        ring.push_back( v );
+                    }
+                }
+            }
+            if( ring.size() != 3 )
+            {
+                // The edge is on the region boundary
+                return false;
+            }
+            if( !is_well_oriented( { { ring[0], ring[1], ring[2], a } } ) )
+            {
+                std::swap( ring[0], ring[1] );
+            }
+            return replace_tets( edge_tets,
+                { { { ring[0], ring[1], ring[2], a } },
+                    { { ring[1], ring[0], ring[2], b } } } );
+        }
+
+        bool flip_bad_tet( index_t tet )
+        {
+            for( auto v : range( 4 ) )
+            {
+                if( flip_facet( tet, v ) )
+                {
+                    return true;
+                }
+            }
+            for( auto v0 : range( 3 ) )
+            {
+                for( auto v1 : range( v0 + 1, 4 ) )
+                {
+                    if( flip_edge( tets_[tet][v0], tets_[tet][v1] ) )
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        index_t flip_bad_tets()
+        {
+            index_t nb_flips{ 0 };
+            auto nb_tets = static_cast< index_t >( tets_.size() );
+            for( auto t : range( nb_tets ) )
+            {
+                if( alive_[t] && qualities_[t] < min_quality_
+                    && flip_bad_tet( t ) )
+                {
+                    nb_flips++;
+                }
+            }
+            return nb_flips;
+        }
+
+        /*!
+         * Moves the vertex to the barycenter of its neighbors if it increases
+         * the minimum quality of the tetrahedra around it.
+         */
+        bool smooth_vertex( index_t vertex )
+        {
+            const auto& around = vertex_to_tets_[vertex];
+            vec3 barycenter;
+            index_t nb_neighbors{ 0 };
+            double old_min{ max_float64() };
+            for( auto t : around )
+            {
+                old_min = std::min( old_min, qualities_[t] );
+                for( auto v : tets_[t] )
+                {
+                    if( v != vertex )
+                    {
+                        barycenter += points_[v];
+                        nb_neighbors++;
+                    }
+                }
+            }
+            if( nb_neighbors == 0 )
+            {
+                return false;
+            }
+            const auto old_point = points_[vertex];
+            points_[vertex] = barycenter / static_cast< double >( nb_neighbors );
+            std::vector< double > new_qualities;
+            new_qualities.reserve( around.size() );
+            for( auto t : around )
+            {
+                if( !is_well_oriented( tets_[t] ) )
+                {
+                    break;
+                }
+                new_qualities.push_back( compute_quality( tets_[t] ) );
+                if( new_qualities.back() <= old_min )
+                {
+                    break;
+                }
+            }
+            if( new_qualities.size() != around.size() )
+            {
+                points_[vertex] = old_point;
+                return false;
+            }
+            for( auto i : range( around.size() ) )
+            {
+                qualities_[around[i]] = new_qualities[i];
+            }
+            return true;
+        }
+
+        index_t smooth_bad_tet_vertices()
+        {
+            std::vector< bool > to_smooth( points_.size(), false );
+            for( auto t : range( tets_.size() ) )
+            {
+                if( alive_[t] && qualities_[t] < min_quality_ )
+                {
+                    for( auto v : tets_[t] )
+                    {
+                        to_smooth[v] = !locked_[v];
+                    }
+                }
+            }
+            index_t nb_moves{ 0 };
+            for( auto v : range( points_.size() ) )
+            {
+                if( to_smooth[v] && smooth_vertex( v ) )
+                {
+                    nb_moves++;
+                }
+            }
+            return nb_moves;
+        }
+
+    private:
+        const Region3D& region_;
+        double min_quality_;
+        const TetQuality& quality_;
+        double orientation_{ 1. };
+
+        std::vector< vec3 > points_;
+        std::vector< Tet > tets_;
+        std::vector< double > qualities_;
+        std::vector< bool > alive_;
+        std::vector< bool > locked_;
+        std::vector< std::vector< index_t > > vertex_to_tets_;
+    };
+} // namespace
+
+namespace RINGMesh
+{
+    index_t improve_tetrahedra_quality( GeoModel3D& geomodel,
+        const std::string& quality_attribute_name,
+        double min_quality,
+        const TetQuality& quality,
+        index_t nb_iterations )
+    {
+        std::vector< std::unique_ptr< RegionTetImprover > > improvers(
+            geomodel.nb_regions() );
+        std::vector< index_t > nb_modifications( geomodel.nb_regions(), 0 );
+        for( const auto& region : geomodel.regions() )
+        {
+            improvers[region.index()].reset( new RegionTetImprover(
+                region, quality_attribute_name, min_quality, quality ) );
+        }
+        parallel_for( geomodel.nb_regions(),
+            [&improvers, &nb_modifications, nb_iterations]( index_t r ) {
+                nb_modifications[r] = improvers[r]->improve( nb_iterations );
+            } );
+
+        GeoModelBuilder3D builder( geomodel );
+        index_t total_nb_modifications{ 0 };
+        for( auto r : range( geomodel.nb_regions() ) )
+        {
+            if( nb_modifications[r] != 0 )
+            {
+                improvers[r]->write_region_mesh( builder );
+                total_nb_modifications += nb_modifications[r];
+            }
+        }
+        if( total_nb_modifications != 0 )
+        {
+            // The GeoModelMesh should be updated, just erase everything
+            // and it will be re-computed during its next access.
+            geomodel.mesh.vertices.clear();
+        }
+        return total_nb_modifications;
+    }
+} // namespace RINGMesh
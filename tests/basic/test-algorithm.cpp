@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <functional>
+#include <random>
+
+#include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/logger.h>
+
+/*!
+ * @file Tests the sorting functions of ringmesh/basic/algorithm.h
+ */
+
+using namespace RINGMesh;
+
+namespace
+{
+    /// Large enough to be split between several threads
+    const index_t NB_VALUES = 8 * PARALLEL_SORT_MIN_CHUNK_SIZE + 17;
+
+    std::vector< index_t > random_values( index_t size, index_t max_value )
+    {
+        std::mt19937 generator( 42 );
+        std::uniform_int_distribution< index_t > distribution( 0, max_value );
+        std::vector< index_t > values( size );
+        for( auto& value : values )
+        {
+            value = distribution( generator );
+        }
+        return values;
+    }
+
+    void test_indirect_sort()
+    {
+        std::vector< double > input{ 3., 1., 2., 1., 0. };
+        std::vector< index_t > output{ 0, 1, 2, 3, 4 };
+        indirect_sort( input, output );
+        if( input != std::vector< double >{ 0., 1., 1., 2., 3. }
+            || output != std::vector< index_t >{ 4, 1, 3, 2, 0 } )
+        {
+            throw RINGMeshException( "TEST", "Error in indirect_sort" );
+        }
+
+        auto keys = random_values( NB_VALUES, 1000 );
+        std::vector< index_t > indices( keys.size() );
+        std::iota( indices.begin(), indices.end(), 0 );
+        auto original_keys = keys;
+        parallel_indirect_sort( keys, indices );
+        for( auto i : range( 1, NB_VALUES ) )
+        {
+            if( keys[i - 1] > keys[i]
+                || original_keys[indices[i]] != keys[i]
+                || ( keys[i - 1] == keys[i] && indices[i - 1] > indices[i] ) )
+            {
+                throw RINGMeshException(
+                    "TEST", "Error in parallel_indirect_sort" );
+            }
+        }
+    }
+
+    void test_sort()
+    {
+        auto values = random_values( NB_VALUES, NB_VALUES );
+        auto result = values;
+        std::sort( values.begin(), values.end() );
+        parallel_sort( result );
+        if( result != values )
+        {
+            throw RINGMeshException( "TEST", "Error in parallel_sort" );
+        }
+
+        std::sort( values.begin(), values.end(), std::greater< index_t >() );
+        parallel_sort( result, std::greater< index_t >() );
+        if( result != values )
+        {
+            throw RINGMeshException(
+                "TEST", "Error in parallel_sort with comparator" );
+        }
+    }
+
+    void test_sort_unique()
+    {
+        auto values = random_values( NB_VALUES, 1000 );
+        auto result = values;
+        sort_unique( values );
+        parallel_sort_unique( result );
+        if( result != values || values.size() != 1001 )
+        {
+            throw RINGMeshException( "TEST", "Error in parallel_sort_unique" );
+        }
+
+        std::vector< index_t > reversed{ 1, 3, 3, 2, 1, 0 };
+        sort_unique( reversed, std::greater< index_t >() );
+        if( reversed != std::vector< index_t >{ 3, 2, 1, 0 } )
+        {
+            throw RINGMeshException(
+                "TEST", "Error in sort_unique with comparator" );
+        }
+    }
+} // namespace
+
+int main()
+{
+    try
+    {
+        Logger::out( "TEST", "Test sorting algorithms" );
+        test_indirect_sort();
+        test_sort();
+        test_sort_unique();
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
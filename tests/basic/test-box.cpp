@@ -182,6 +182,37 @@ void test_boxes()
         throw RINGMeshException( "TEST", "Error in box contains" );
     }
 
+    // Check segment overlap
+    if( !A.segment_overlap( { 2, 2, 0 }, { 2, 2, 4 } ) )
+    {
+        throw RINGMeshException(
+            "TEST", "Error in box segment overlap (axis-parallel)" );
+    }
+    if( A.segment_overlap( { 4, 0, 2 }, { 4, 4, 2 } ) )
+    {
+        throw RINGMeshException(
+            "TEST", "Error in box segment overlap (axis-parallel miss)" );
+    }
+    if( A.segment_overlap( pt0, { 0.5, 0.5, 0.5 } ) )
+    {
+        throw RINGMeshException( "TEST", "Error in box segment overlap (miss)" );
+    }
+    if( A.segment_overlap( { 0, 4, 2 }, { 4, 3.5, 2 } ) )
+    {
+        throw RINGMeshException(
+            "TEST", "Error in box segment overlap (oblique miss)" );
+    }
+    if( !A.segment_overlap( { 3, 2, 2 }, { 5, 2, 2 } ) )
+    {
+        throw RINGMeshException(
+            "TEST", "Error in box segment overlap (touching a face)" );
+    }
+    if( !A.segment_overlap( pt0, pt4 ) )
+    {
+        throw RINGMeshException(
+            "TEST", "Error in box segment overlap (crossing)" );
+    }
+
     // Check signed distance
     if( A.signed_distance( pt2 ) != -1 )
     {
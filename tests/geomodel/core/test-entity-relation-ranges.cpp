@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <ringmesh/basic/algorithm.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_geological_entity.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/io/io.h>
+
+/*!
+ * @file Test the ranges over the relations between GeoModel entities
+ * against the indexed accessors
+ */
+
+using namespace RINGMesh;
+
+/*!
+ * @brief Checks that a relation range visits the same entities, in the
+ * same order, as the indexed accessor
+ * @return the number of visited entities
+ */
+template < typename RANGE, typename ACCESSOR, typename ID >
+index_t check_relation_range( const RANGE& relations,
+    index_t nb_relations,
+    const ACCESSOR& relation,
+    const std::string& relation_name,
+    const ID& entity_id )
+{
+    index_t i{ 0 };
+    for( const auto& id : relations )
+    {
+        if( i >= nb_relations || !( id == relation( i ) ) )
+        {
+            throw RINGMeshException( "TEST", "Wrong ", relation_name, " ", i,
+                " in the range of ", entity_id );
+        }
+        i++;
+    }
+    if( i != nb_relations )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of ", relation_name,
+            " in the range of ", entity_id, ": ", i, " instead of ",
+            nb_relations );
+    }
+    return i;
+}
+
+void test_mesh_entity_ranges( const GeoModel3D& geomodel )
+{
+    index_t nb_boundaries{ 0 };
+    index_t nb_incident_entities{ 0 };
+    index_t nb_parents{ 0 };
+    for( const auto& type : geomodel.entity_type_manager()
+                                .mesh_entity_manager.mesh_entity_types() )
+    {
+        for( auto e : range( geomodel.nb_mesh_entities( type ) ) )
+        {
+            const auto& entity = geomodel.mesh_entity( type, e );
+            const auto& name = entity.gmme();
+            nb_boundaries += check_relation_range( entity.boundary_gmmes(),
+                entity.nb_boundaries(),
+                [&entity]( index_t i ) { return entity.boundary_gmme( i ); },
+                "boundary", name );
+            nb_incident_entities +=
+                check_relation_range( entity.incident_entity_gmmes(),
+                    entity.nb_incident_entities(),
+                    [&entity]( index_t i ) {
+                        return entity.incident_entity_gmme( i );
+                    },
+                    "incident entity", name );
+            nb_parents += check_relation_range( entity.parent_gmges(),
+                entity.nb_parents(),
+                [&entity]( index_t i ) { return entity.parent_gmge( i ); },
+                "parent", name );
+        }
+    }
+    if( nb_boundaries == 0 || nb_boundaries != nb_incident_entities
+        || nb_parents == 0 )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of relations: ",
+            nb_boundaries, " boundaries, ", nb_incident_entities,
+            " incident entities and ", nb_parents, " parents" );
+    }
+}
+
+void test_geological_entity_ranges( const GeoModel3D& geomodel )
+{
+    const auto& manager =
+        geomodel.entity_type_manager().geological_entity_manager;
+    index_t nb_children{ 0 };
+    for( auto t : range( manager.nb_geological_entity_types() ) )
+    {
+        const auto& type = manager.geological_entity_type( t );
+        for( auto e : range( geomodel.nb_geological_entities( type ) ) )
+        {
+            const auto& entity = geomodel.geological_entity( type, e );
+            nb_children += check_relation_range( entity.child_gmmes(),
+                entity.nb_children(),
+                [&entity]( index_t i ) { return entity.child_gmme( i ); },
+                "child", entity.gmge() );
+        }
+    }
+    if( nb_children == 0 )
+    {
+        throw RINGMeshException( "TEST", "No child relation in the GeoModel" );
+    }
+}
+
+int main()
+{
+    try
+    {
+        Logger::out( "TEST", "Ranges over GeoModel entity relations" );
+
+        GeoModel3D geomodel;
+        geomodel_load( geomodel, ringmesh_test_data_path + "modelA6.ml" );
+        test_mesh_entity_ranges( geomodel );
+        test_geological_entity_ranges( geomodel );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <algorithm>
+#include <future>
+
+#include <ringmesh/basic/logger.h>
+
+#include <ringmesh/geomodel/core/entity_type.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+
+/*!
+ * @file Test the registration of the entity type names
+ */
+
+using namespace RINGMesh;
+
+void test_type_ids()
+{
+    Logger::out( "TEST", "Test entity type ids" );
+    if( MeshEntityType().id() != 0
+        || MeshEntityType().string() != "No_entity_type" )
+    {
+        throw RINGMeshException(
+            "TEST", "The default entity type should have the id 0" );
+    }
+    MeshEntityType beta{ "Test_type_beta" };
+    MeshEntityType alpha{ "Test_type_alpha" };
+    if( alpha.string() != "Test_type_alpha" || alpha == beta )
+    {
+        throw RINGMeshException( "TEST", "Wrong registered type names" );
+    }
+    GeologicalEntityType alpha_again{ "Test_type_alpha" };
+    if( alpha_again.id() != alpha.id() || MeshEntityType{ "Test_type_beta" }
+                                              != beta )
+    {
+        throw RINGMeshException(
+            "TEST", "A type name should keep the same id" );
+    }
+    if( Corner3D::type_name_static().id()
+        != MeshEntityType{ "Corner" }.id() )
+    {
+        throw RINGMeshException(
+            "TEST", "The Corner type should keep the same id" );
+    }
+
+    // beta was registered first, the types are still sorted by name
+    if( !( alpha < beta ) || beta < alpha || alpha < alpha )
+    {
+        throw RINGMeshException( "TEST", "Wrong ordering of the types" );
+    }
+    gmme_id alpha_0{ alpha, 0 };
+    gmme_id alpha_1{ alpha, 1 };
+    gmme_id beta_0{ beta, 0 };
+    if( !( alpha_0 < alpha_1 ) || !( alpha_1 < beta_0 ) || beta_0 < alpha_1
+        || !( alpha_0 == gmme_id( alpha, 0 ) ) )
+    {
+        throw RINGMeshException( "TEST", "Wrong ordering of the gmme_id" );
+    }
+}
+
+void test_concurrent_registration()
+{
+    Logger::out( "TEST", "Test concurrent registration of entity types" );
+    const index_t nb_names{ 200 };
+    const index_t nb_threads{ 8 };
+    auto name = []( index_t n ) {
+        return "Test_type_thread_" + std::to_string( n );
+    };
+    std::vector< std::future< std::vector< index_t > > > futures;
+    for( auto t : range( nb_threads ) )
+    {
+        futures.emplace_back( std::async( std::launch::async, [&name, t] {
+            std::vector< index_t > ids( nb_names );
+            for( auto i : range( nb_names ) )
+            {
+                // Each thread registers the names in a different order
+                auto n = ( i + t * nb_names / nb_threads ) % nb_names;
+                MeshEntityType type{ name( n ) };
+                if( type.string() != name( n ) )
+                {
+                    throw RINGMeshException(
+                        "TEST", "Wrong name of the type ", name( n ) );
+                }
+                ids[n] = type.id();
+            }
+            return ids;
+        } ) );
+    }
+    std::vector< std::vector< index_t > > thread_ids;
+    for( auto& future : futures )
+    {
+        thread_ids.push_back( future.get() );
+    }
+    for( auto n : range( nb_names ) )
+    {
+        MeshEntityType type{ name( n ) };
+        for( const auto& ids : thread_ids )
+        {
+            if( ids[n] != type.id() )
+            {
+                throw RINGMeshException( "TEST",
+                    "The threads got different ids for ", name( n ) );
+            }
+        }
+        if( EntityTypeRegistry::name( type.id() ) != name( n ) )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong registered name of ", name( n ) );
+        }
+    }
+    std::vector< index_t > ids( thread_ids.front() );
+    std::sort( ids.begin(), ids.end() );
+    if( std::unique( ids.begin(), ids.end() ) != ids.end() )
+    {
+        throw RINGMeshException(
+            "TEST", "Different type names were given the same id" );
+    }
+}
+
+int main()
+{
+    try
+    {
+        test_type_ids();
+        test_concurrent_registration();
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <fstream>
+#include <set>
+
+#include <geogram/basic/command_line.h>
+
+#include <ringmesh/basic/box.h>
+#include <ringmesh/basic/command_line.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/well.h>
+#include <ringmesh/geomodel/tools/geomodel_tools.h>
+#include <ringmesh/io/io.h>
+#include <ringmesh/mesh/mesh_aabb.h>
+
+/*!
+ * @file Test the wells of a GeoModel
+ */
+
+using namespace RINGMesh;
+
+Box3D geomodel_box( const GeoModel3D& geomodel )
+{
+    Box3D box;
+    for( auto v : range( geomodel.mesh.vertices.nb() ) )
+    {
+        box.add_point( geomodel.mesh.vertices.vertex( v ) );
+    }
+    return box;
+}
+
+/*!
+ * Oblique trajectories going down through the GeoModel box, starting on
+ * a regular grid below its top
+ */
+std::vector< std::vector< vec3 > > create_trajectories(
+    const GeoModel3D& geomodel )
+{
+    const index_t nb_trajectories_per_axis{ 5 };
+    const index_t nb_vertices{ 50 };
+    auto box = geomodel_box( geomodel );
+    auto size = box.max() - box.min();
+    std::vector< std::vector< vec3 > > trajectories;
+    for( auto i : range( nb_trajectories_per_axis ) )
+    {
+        for( auto j : range( nb_trajectories_per_axis ) )
+        {
+            vec3 top{ box.min().x + size.x * ( 0.13 + 0.17 * i ),
+                box.min().y + size.y * ( 0.11 + 0.19 * j ),
+                box.max().z - size.z * 0.031 };
+            vec3 bottom{ top.x + size.x * 0.071, top.y - size.y * 0.053,
+                box.min().z + size.z * 0.027 };
+            std::vector< vec3 > trajectory;
+            for( auto v : range( nb_vertices ) )
+            {
+                auto ratio = static_cast< double >( v ) / ( nb_vertices - 1 );
+                trajectory.push_back( top + ( bottom - top ) * ratio );
+            }
+            trajectories.push_back( std::move( trajectory ) );
+        }
+    }
+    return trajectories;
+}
+
+void test_locate_well_trajectories( const GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Locate well trajectories" );
+    auto trajectories = create_trajectories( geomodel );
+    auto locations = locate_well_trajectories( geomodel, trajectories );
+    if( locations.size() != trajectories.size() )
+    {
+        throw RINGMeshException(
+            "TEST", "Wrong number of located trajectories" );
+    }
+    const auto& cells = geomodel.mesh.cells;
+    index_t nb_located{ 0 };
+    for( auto t : range( trajectories.size() ) )
+    {
+        if( locations[t].size() != trajectories[t].size() )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong number of located vertices" );
+        }
+        for( auto v : range( trajectories[t].size() ) )
+        {
+            auto cell = cells.aabb().containing_cell( trajectories[t][v] );
+            const auto& location = locations[t][v];
+            if( location.cell != cell )
+            {
+                throw RINGMeshException( "TEST", "Wrong cell of vertex ", v,
+                    " of trajectory ", t, ": ", location.cell, " instead of ",
+                    cell );
+            }
+            auto region = cell == NO_ID ? NO_ID : cells.region( cell );
+            if( location.region != region )
+            {
+                throw RINGMeshException( "TEST", "Wrong region of vertex ", v,
+                    " of trajectory ", t );
+            }
+            if( cell != NO_ID )
+            {
+                nb_located++;
+            }
+        }
+    }
+    if( nb_located == 0 )
+    {
+        throw RINGMeshException( "TEST", "No well vertex in the GeoModel" );
+    }
+    Logger::out( "TEST", nb_located, " well vertices located" );
+}
+
+/*!
+ * The first edge of a part does not cross any surface, it is in the
+ * region of the part.
+ */
+void check_well_part_regions(
+    const GeoModel3D& geomodel, const Well3D& well )
+{
+    for( auto p : range( well.nb_parts() ) )
+    {
+        const auto& part = well.part( p );
+        if( part.nb_edges() == 0 )
+        {
+            throw RINGMeshException(
+                "TEST", "Empty part in well ", well.name() );
+        }
+        auto barycenter = ( part.vertex( 0 ) + part.vertex( 1 ) ) / 2.;
+        auto cell = geomodel.mesh.cells.aabb().containing_cell( barycenter );
+        if( cell == NO_ID )
+        {
+            throw RINGMeshException( "TEST", "Part ", p, " of well ",
+                well.name(), " is outside the GeoModel" );
+        }
+        auto region = geomodel.mesh.cells.region( cell );
+        if( well.part_region_id( p ) != region )
+        {
+            throw RINGMeshException( "TEST", "Part ", p, " of well ",
+                well.name(), " is in region ", region, " instead of ",
+                well.part_region_id( p ) );
+        }
+    }
+}
+
+void test_well_part_regions( GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Well part regions" );
+    auto trajectories = create_trajectories( geomodel );
+    std::vector< std::string > names;
+    for( auto t : range( trajectories.size() ) )
+    {
+        names.push_back( "well_" + std::to_string( t ) );
+    }
+    WellGroup3D wells;
+    wells.set_geomodel( &geomodel );
+    wells.add_wells( trajectories, names );
+    if( wells.nb_wells() != trajectories.size() )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of wells" );
+    }
+    std::set< index_t > part_regions;
+    for( auto w : range( wells.nb_wells() ) )
+    {
+        const auto& well = wells.well( w );
+        check_well_part_regions( geomodel, well );
+        for( auto p : range( well.nb_parts() ) )
+        {
+            part_regions.insert( well.part_region_id( p ) );
+        }
+    }
+    if( part_regions.size() < 2 )
+    {
+        throw RINGMeshException( "TEST", "All well parts are in one region" );
+    }
+    Logger::out( "TEST", "Well parts in ", part_regions.size(), " regions" );
+}
+
+/*!
+ * Writes the trajectories in a .wl file, the well \p duplicate has the
+ * name of the previous well
+ */
+std::string write_wl_file(
+    const std::vector< std::vector< vec3 > >& trajectories, index_t duplicate )
+{
+    auto file_name = ringmesh_test_output_path + "wells.wl";
+    std::ofstream out( file_name.c_str() );
+    out.precision( 17 );
+    for( auto t : range( trajectories.size() ) )
+    {
+        const auto& trajectory = trajectories[t];
+        auto name = t == duplicate ? t - 1 : t;
+        const auto& ref = trajectory.front();
+        out << "GOCAD Well 1" << std::endl;
+        out << "HEADER {" << std::endl;
+        out << "name: well_" << name << std::endl;
+        out << "}" << std::endl;
+        out << "WREF " << ref.x << " " << ref.y << " " << ref.z << std::endl;
+        for( auto v : range( 1, trajectory.size() ) )
+        {
+            const auto& vertex = trajectory[v];
+            out << "PATH " << v << " " << vertex.z << " " << vertex.x - ref.x
+                << " " << vertex.y - ref.y << std::endl;
+        }
+        out << "END" << std::endl;
+    }
+    return file_name;
+}
+
+void test_load_wl_file( GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Load wells from a .wl file" );
+    auto trajectories = create_trajectories( geomodel );
+    const index_t duplicate{ 3 };
+    auto file_name = write_wl_file( trajectories, duplicate );
+
+    WellGroup3D wells;
+    wells.set_geomodel( &geomodel );
+    well_load( file_name, wells );
+    if( wells.nb_wells() != trajectories.size() - 1 )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of wells: ",
+            wells.nb_wells(), " instead of ", trajectories.size() - 1 );
+    }
+    for( auto w : range( wells.nb_wells() ) )
+    {
+        const auto& well = wells.well( w );
+        auto t = w < duplicate ? w : w + 1;
+        if( well.name() != "well_" + std::to_string( t ) )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong name of well ", w, ": ", well.name() );
+        }
+        // A well without branch has one part between its two ends
+        if( well.nb_parts() != 1 || well.nb_corners() != 2 )
+        {
+            throw RINGMeshException( "TEST", "Well ", well.name(), " has ",
+                well.nb_parts(), " parts and ", well.nb_corners(),
+                " corners" );
+        }
+        // The part may go from either end of the trajectory
+        const auto& part = well.part( 0 );
+        const auto& first = part.vertex( 0 );
+        const auto& last = part.vertex( part.nb_vertices() - 1 );
+        const auto& top = trajectories[t].front();
+        const auto& bottom = trajectories[t].back();
+        auto epsilon = geomodel.epsilon();
+        if( !( length( first - top ) < epsilon
+                 && length( last - bottom ) < epsilon )
+            && !( length( first - bottom ) < epsilon
+                    && length( last - top ) < epsilon ) )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong ends of well ", well.name() );
+        }
+        check_well_part_regions( geomodel, well );
+    }
+}
+
+int main()
+{
+    try
+    {
+        CmdLine::import_arg_group( "global" );
+        GEO::CmdLine::set_arg( "algo:tet", "TetGen" );
+
+        std::string file_name( ringmesh_test_data_path );
+        file_name += "modelA6.ml";
+
+        // Check only model geometry
+        GEO::CmdLine::set_arg( "validity:do_not_check", "tG" );
+
+        GeoModel3D geomodel;
+        bool loaded_model_is_valid = geomodel_load( geomodel, file_name );
+        if( !loaded_model_is_valid )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Failed when building model ", geomodel.name(),
+                ": the model geometry is not valid." );
+        }
+
+#ifdef RINGMESH_WITH_TETGEN
+        tetrahedralize( geomodel, NO_ID, false );
+        test_locate_well_trajectories( geomodel );
+        test_well_part_regions( geomodel );
+        test_load_wl_file( geomodel );
+#endif
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
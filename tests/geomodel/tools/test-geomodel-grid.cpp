@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <geogram/basic/command_line.h>
+
+#include <ringmesh/basic/box.h>
+#include <ringmesh/basic/command_line.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/tools/geomodel_grid.h>
+#include <ringmesh/geomodel/tools/geomodel_tools.h>
+#include <ringmesh/io/io.h>
+#include <ringmesh/mesh/cartesian_grid.h>
+#include <ringmesh/mesh/mesh_aabb.h>
+
+/*!
+ * @file Test the rasterization of the GeoModel regions on a Cartesian grid
+ */
+
+using namespace RINGMesh;
+
+/*!
+ * Frame of a grid with \p nb_cells covering the GeoModel
+ */
+ReferenceFrame3D grid_frame( const GeoModel3D& geomodel, const ivec3& nb_cells )
+{
+    Box3D box;
+    for( auto v : range( geomodel.mesh.vertices.nb() ) )
+    {
+        box.add_point( geomodel.mesh.vertices.vertex( v ) );
+    }
+    auto diagonal = box.diagonal();
+    vec3 spacing;
+    for( auto i : range( 3 ) )
+    {
+        spacing[i] = diagonal[i] / nb_cells[i];
+    }
+    return { box.min(), { { spacing.x, 0., 0. }, { 0., spacing.y, 0. },
+                            { 0., 0., spacing.z } } };
+}
+
+void test_rasterize_regions( const GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Rasterize regions" );
+    ivec3 nb_cells{ 23, 19, 17 };
+    CartesianGrid3D grid{ nb_cells, grid_frame( geomodel, nb_cells ) };
+    rasterize_regions( geomodel, grid, true );
+
+    GEO::Attribute< index_t > regions( grid.attributes_manager(), "region" );
+    GEO::Attribute< index_t > cells( grid.attributes_manager(), "cell" );
+    const auto& mesh_cells = geomodel.mesh.cells;
+    index_t nb_inside{ 0 };
+    for( auto c : range( grid.nb_cells() ) )
+    {
+        auto center =
+            grid.cell_corner_global_coords( grid.local_from_offset( c ) );
+        for( auto i : range( 3 ) )
+        {
+            center += grid.grid_vectors()[i] * 0.5;
+        }
+        auto cell = mesh_cells.aabb().containing_cell( center );
+        auto region = cell == NO_ID ? NO_ID : mesh_cells.region( cell );
+        if( regions[c] != region )
+        {
+            throw RINGMeshException( "TEST", "Grid cell ", c, " is in region ",
+                regions[c], " instead of ", region );
+        }
+        if( cells[c] != cell )
+        {
+            throw RINGMeshException( "TEST", "Grid cell ", c,
+                " has a wrong containing cell" );
+        }
+        if( region != NO_ID )
+        {
+            nb_inside++;
+        }
+    }
+    if( nb_inside == 0 )
+    {
+        throw RINGMeshException( "TEST", "No grid cell in the GeoModel" );
+    }
+    Logger::out( "TEST", nb_inside, " grid cells in the GeoModel" );
+}
+
+int main()
+{
+    try
+    {
+        CmdLine::import_arg_group( "global" );
+        GEO::CmdLine::set_arg( "algo:tet", "TetGen" );
+
+        std::string file_name( ringmesh_test_data_path );
+        file_name += "modelA6.ml";
+
+        // Check only model geometry
+        GEO::CmdLine::set_arg( "validity:do_not_check", "tG" );
+
+        GeoModel3D geomodel;
+        bool loaded_model_is_valid = geomodel_load( geomodel, file_name );
+        if( !loaded_model_is_valid )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Failed when building model ", geomodel.name(),
+                ": the model geometry is not valid." );
+        }
+
+#ifdef RINGMESH_WITH_TETGEN
+        tetrahedralize( geomodel, NO_ID, false );
+        test_rasterize_regions( geomodel );
+#endif
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <array>
+
+#include <geogram/basic/attributes.h>
+
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/mesh_quality.h>
+
+#include <ringmesh/io/io.h>
+
+/*!
+ * @file Test the tetrahedron quality kernels and the quality statistics
+ */
+
+using namespace RINGMesh;
+
+namespace
+{
+    const std::array< MeshQualityMode, 4 > quality_modes{ {
+        INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS,
+        INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH, VOLUME_BY_SUM_SQUARE_EDGE,
+        MIN_SOLID_ANGLE } };
+
+    const std::array< std::string, 4 > quality_names{ {
+        "INSPHERE_RADIUS_BY_CIRCUMSPHERE_RADIUS",
+        "INSPHERE_RADIUS_BY_MAX_EDGE_LENGTH", "VOLUME_BY_SUM_SQUARE_EDGE",
+        "MIN_SOLID_ANGLE" } };
+} // namespace
+
+void check_quality( MeshQualityMode mode,
+    const vec3& v0,
+    const vec3& v1,
+    const vec3& v2,
+    const vec3& v3,
+    double expected_quality )
+{
+    auto quality = tetrahedron_quality( mode, v0, v1, v2, v3 );
+    if( std::fabs( quality - expected_quality ) > global_epsilon )
+    {
+        throw RINGMeshException( "TEST", "Quality ", quality, " of mode ",
+            static_cast< index_t >( mode ), " should be ", expected_quality );
+    }
+}
+
+void test_tetrahedron_quality()
+{
+    Logger::out( "TEST", "Test tetrahedron quality" );
+    const vec3 r0( 1, 1, 1 );
+    const vec3 r1( 1, -1, -1 );
+    const vec3 r2( -1, 1, -1 );
+    const vec3 r3( -1, -1, 1 );
+
+    const vec3 f0( 0, 0, 0 );
+    const vec3 f1( 1, 0, 0 );
+    const vec3 f2( 0, 1, 0 );
+    const vec3 f3( 0.3, 0.4, 0 );
+
+    for( auto mode : quality_modes )
+    {
+        check_quality( mode, r0, r1, r2, r3, 1 );
+        check_quality( mode, r0, r2, r1, r3, 1 );
+        check_quality( mode, f0, f1, f2, f3, 0 );
+        check_quality( mode, f0, f0, f2, f3, 0 );
+    }
+}
+
+void test_quality_statistics( const GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Test quality statistics" );
+    const index_t nb_bins{ 7 };
+    for( auto m : range( quality_modes.size() ) )
+    {
+        auto stats = compute_prop_tet_mesh_quality(
+            quality_modes[m], geomodel, nb_bins );
+        if( stats.histogram.size() != nb_bins )
+        {
+            throw RINGMeshException( "TEST", "Wrong number of bins" );
+        }
+
+        std::vector< index_t > histogram( nb_bins, 0 );
+        double min_quality{ max_float64() };
+        double max_quality{ -max_float64() };
+        double sum_quality{ 0 };
+        index_t nb_cells{ 0 };
+        for( const auto& region : geomodel.regions() )
+        {
+            GEO::Attribute< double > quality(
+                region.cell_attribute_manager(), quality_names[m] );
+            for( auto c : range( region.nb_mesh_elements() ) )
+            {
+                if( quality[c] < 0 || quality[c] > 1 + global_epsilon )
+                {
+                    throw RINGMeshException(
+                        "TEST", "Quality out of [0,1]: ", quality[c] );
+                }
+                auto bin = std::min(
+                    static_cast< index_t >( quality[c] * nb_bins ),
+                    nb_bins - 1 );
+                histogram[bin]++;
+                min_quality = std::min( min_quality, quality[c] );
+                max_quality = std::max( max_quality, quality[c] );
+                sum_quality += quality[c];
+                nb_cells++;
+            }
+        }
+
+        if( stats.nb_cells != nb_cells || histogram != stats.histogram )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong quality histogram of ", quality_names[m] );
+        }
+        if( stats.min_quality != min_quality
+            || stats.max_quality != max_quality
+            || std::fabs( stats.mean_quality - sum_quality / nb_cells )
+                   > global_epsilon )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong quality statistics of ", quality_names[m] );
+        }
+    }
+
+    bool thrown{ false };
+    try
+    {
+        compute_prop_tet_mesh_quality( MIN_SOLID_ANGLE, geomodel, 0 );
+    }
+    catch( const RINGMeshException& )
+    {
+        thrown = true;
+    }
+    if( !thrown )
+    {
+        throw RINGMeshException(
+            "TEST", "A quality histogram without bin should be rejected" );
+    }
+}
+
+int main()
+{
+    using namespace RINGMesh;
+
+    try
+    {
+        test_tetrahedron_quality();
+
+        std::string input_model_file_name =
+            ringmesh_test_data_path + "unit_cube_volume_meshed.gm";
+        GeoModel3D geomodel;
+        bool loaded_model_is_valid =
+            geomodel_load( geomodel, input_model_file_name );
+        if( !loaded_model_is_valid )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Failed when loading model ", geomodel.name() );
+        }
+        test_quality_statistics( geomodel );
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
@@ -34,8 +34,11 @@
 
 #include <ringmesh/ringmesh_tests_config.h>
 
+#include <geogram/basic/command_line.h>
+#include <geogram/basic/file_system.h>
 #include <geogram/basic/line_stream.h>
 
+#include <ringmesh/basic/command_line.h>
 #include <ringmesh/geomodel/core/geomodel.h>
 #include <ringmesh/geomodel/core/geomodel_geological_entity.h>
 #include <ringmesh/geomodel/tools/geomodel_validity.h>
@@ -165,8 +168,55 @@ void process_extension( const std::string& extension )
         std::string file{ in.field( 0 ) };
         GeoModel< DIMENSION > geomodel;
         load_input_geomodel( geomodel, file );
-        check_geomodel( geomodel, load_reference_info( file + ".txt" ) );
+        const auto reference = load_reference_info( file + ".txt" );
+        check_geomodel( geomodel, reference );
         Logger::out( "TEST", "Import GeoModel from ", file, " OK" );
+
+        if( extension == "gm" )
+        {
+            GeoModel< DIMENSION > lazy_geomodel;
+            geomodel_load_lazily(
+                lazy_geomodel, ringmesh_test_data_path + file );
+            check_geomodel( lazy_geomodel, reference );
+            Logger::out( "TEST", "Lazy import GeoModel from ", file, " OK" );
+        }
+    }
+}
+
+/*!
+ * @brief Checks a format saved by RINGMesh without reference files
+ * @details The .gm files are saved in this format, loaded back and compared
+ * with the .gm references.
+ */
+template < index_t DIMENSION >
+void process_round_trip_extension( const std::string& extension )
+{
+    std::string info{ ringmesh_test_load_path + "gm"
+                      + std::to_string( DIMENSION ) + "d.txt" };
+    GEO::LineInput in{ info };
+    if( !in.OK() )
+    {
+        throw RINGMeshException( "TEST", "Failed to load file: ", info );
+    }
+    while( !in.eof() && in.get_line() )
+    {
+        in.get_fields();
+        std::string file{ in.field( 0 ) };
+        GeoModel< DIMENSION > geomodel;
+        load_input_geomodel( geomodel, file );
+        auto saved_file = ringmesh_test_output_path
+                          + GEO::FileSystem::base_name( file ) + "."
+                          + extension;
+        geomodel_save( geomodel, saved_file );
+
+        GeoModel< DIMENSION > saved_geomodel;
+        if( !geomodel_load( saved_geomodel, saved_file ) )
+        {
+            throw RINGMeshException( "RINGMesh Test", "Failed when loading ",
+                saved_file, ": the loaded model is not valid." );
+        }
+        check_geomodel( saved_geomodel, load_reference_info( file + ".txt" ) );
+        Logger::out( "TEST", "Import GeoModel from ", saved_file, " OK" );
     }
 }
 
@@ -177,7 +227,14 @@ void test_input_geomodels()
     auto extensions = GeoModelInputHandlerFactory< DIMENSION >::list_creators();
     for( const auto& extension : extensions )
     {
-        process_extension< DIMENSION >( extension );
+        if( extension == "gmb" || extension == "msh" )
+        {
+            process_round_trip_extension< DIMENSION >( extension );
+        }
+        else
+        {
+            process_extension< DIMENSION >( extension );
+        }
     }
 }
 
@@ -186,6 +243,8 @@ int main()
     try
     {
         Logger::out( "TEST", "Import GeoModel files" );
+        CmdLine::import_arg_group( "out" );
+        GEO::CmdLine::set_arg( "out:msh_binary", true );
         test_input_geomodels< 2 >();
         test_input_geomodels< 3 >();
     }
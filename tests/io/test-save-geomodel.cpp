@@ -35,11 +35,21 @@
 
 #include <ringmesh/ringmesh_tests_config.h>
 
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <zlib.h>
+
+#include <geogram/basic/attributes.h>
 #include <geogram/basic/command_line.h>
 #include <geogram/basic/line_stream.h>
 
 #include <ringmesh/basic/algorithm.h>
+#include <ringmesh/basic/command_line.h>
 #include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/mesh/mesh_index.h>
 
 #include <ringmesh/io/io.h>
 
@@ -226,6 +236,583 @@ void check_output_by_model(
     }
 }
 
+std::vector< char > read_file_content( const std::string& filename )
+{
+    std::ifstream in( filename.c_str(), std::ios::binary );
+    if( !in )
+    {
+        throw RINGMeshException( "TEST", "Failed to open file: ", filename );
+    }
+    return { std::istreambuf_iterator< char >( in ),
+        std::istreambuf_iterator< char >() };
+}
+
+/*!
+ * @brief Reads the \p i-th value of type \p T of a data array
+ */
+template < typename T >
+T array_value( const std::vector< char >& values, std::size_t i )
+{
+    if( ( i + 1 ) * sizeof( T ) > values.size() )
+    {
+        throw RINGMeshException( "TEST", "VTK data array is too short" );
+    }
+    T value;
+    std::memcpy( &value, values.data() + i * sizeof( T ), sizeof( T ) );
+    return value;
+}
+
+/*!
+ * @brief VTK cell type of each RINGMesh CellType: tetrahedron,
+ * hexahedron, prism and pyramid
+ */
+const std::int32_t VTK_CELL_TYPES[4] = { 10, 12, 13, 14 };
+
+/*!
+ * @brief Adds a vertex and a cell attribute to the GeoModelMesh so that
+ * the export of the attributes is checked
+ */
+void add_vtk_test_attributes( const GeoModel3D& geomodel )
+{
+    const auto& mesh = geomodel.mesh;
+    GEO::Attribute< double > vertex_attribute(
+        mesh.vertices.attribute_manager(), "vertex value" );
+    for( auto v : range( mesh.vertices.nb() ) )
+    {
+        vertex_attribute[v] = mesh.vertices.vertex( v ).x + 0.5;
+    }
+    GEO::Attribute< int > cell_attribute(
+        mesh.cells.attribute_manager(), "cell value" );
+    for( auto c : range( mesh.cells.nb() ) )
+    {
+        cell_attribute[c] = static_cast< int >( c ) - 1;
+    }
+}
+
+void check_vtk_points(
+    const GeoModelMesh3D& mesh, const std::vector< char >& points )
+{
+    if( points.size() != 3 * sizeof( double ) * mesh.vertices.nb() )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of VTK points" );
+    }
+    for( auto v : range( mesh.vertices.nb() ) )
+    {
+        const auto& vertex = mesh.vertices.vertex( v );
+        for( auto i : range( 3 ) )
+        {
+            if( array_value< double >( points, 3 * v + i ) != vertex[i] )
+            {
+                throw RINGMeshException(
+                    "TEST", "Wrong VTK point ", v, ": ", vertex );
+            }
+        }
+    }
+}
+
+/*!
+ * @brief Checks the vertices of a VTK cell, whatever their order
+ * @param[in] vertices the values of the VTK cell array
+ * @param[in] first the position of the first cell vertex in \p vertices
+ */
+void check_vtk_cell( const GeoModelMesh3D& mesh,
+    index_t cell,
+    const std::vector< char >& vertices,
+    std::size_t first )
+{
+    std::vector< index_t > expected;
+    std::vector< index_t > read;
+    for( auto v : range( mesh.cells.nb_vertices( cell ) ) )
+    {
+        expected.push_back( mesh.cells.vertex( { cell, v } ) );
+        read.push_back( static_cast< index_t >(
+            array_value< std::int32_t >( vertices, first + v ) ) );
+    }
+    std::sort( expected.begin(), expected.end() );
+    std::sort( read.begin(), read.end() );
+    if( expected != read )
+    {
+        throw RINGMeshException( "TEST", "Wrong vertices for VTK cell ", cell );
+    }
+}
+
+/*!
+ * @brief Checks the cell types, the regions and the attributes of a VTK
+ * file, VTK cell types are given as \p TYPE values
+ */
+template < typename TYPE >
+void check_vtk_cell_and_vertex_data( const GeoModelMesh3D& mesh,
+    const std::vector< char >& types,
+    const std::vector< char >& regions,
+    const std::vector< char >& cell_values,
+    const std::vector< char >& vertex_values )
+{
+    for( auto c : range( mesh.cells.nb() ) )
+    {
+        auto type = to_underlying_type( mesh.cells.type( c ) );
+        if( static_cast< std::int32_t >( array_value< TYPE >( types, c ) )
+            != VTK_CELL_TYPES[type] )
+        {
+            throw RINGMeshException( "TEST", "Wrong type for VTK cell ", c );
+        }
+        if( array_value< std::int32_t >( regions, c )
+            != static_cast< std::int32_t >( mesh.cells.region( c ) ) )
+        {
+            throw RINGMeshException( "TEST", "Wrong region for VTK cell ", c );
+        }
+        if( array_value< std::int32_t >( cell_values, c )
+            != static_cast< std::int32_t >( c ) - 1 )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong attribute value for VTK cell ", c );
+        }
+    }
+    for( auto v : range( mesh.vertices.nb() ) )
+    {
+        if( array_value< double >( vertex_values, v )
+            != mesh.vertices.vertex( v ).x + 0.5 )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong attribute value for VTK vertex ", v );
+        }
+    }
+}
+
+std::string xml_attribute( const std::string& element, const std::string& name )
+{
+    auto key = " " + name + "=\"";
+    auto begin = element.find( key );
+    if( begin == std::string::npos )
+    {
+        throw RINGMeshException(
+            "TEST", "Missing XML attribute ", name, " in ", element );
+    }
+    begin += key.size();
+    return element.substr( begin, element.find( '"', begin ) - begin );
+}
+
+std::vector< char > decode_base64( const char* data, std::size_t nb_chars )
+{
+    static const std::string table{
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"
+    };
+    std::vector< char > decoded;
+    decoded.reserve( nb_chars / 4 * 3 );
+    std::uint32_t bits{ 0 };
+    index_t nb_bits{ 0 };
+    for( std::size_t i = 0; i < nb_chars && data[i] != '='; i++ )
+    {
+        auto value = table.find( data[i] );
+        if( value == std::string::npos )
+        {
+            throw RINGMeshException( "TEST", "Invalid base64 character" );
+        }
+        bits = ( bits << 6 ) | static_cast< std::uint32_t >( value );
+        nb_bits += 6;
+        if( nb_bits >= 8 )
+        {
+            nb_bits -= 8;
+            decoded.push_back( static_cast< char >( ( bits >> nb_bits ) & 0xFF ) );
+        }
+    }
+    return decoded;
+}
+
+/*!
+ * @brief Reader of the .vtu files written by RINGMesh: data arrays
+ * appended in raw binary or base64, compressed with zlib or not
+ */
+class VTUFile
+{
+public:
+    explicit VTUFile( const std::string& filename )
+        : content_( read_file_content( filename ) )
+    {
+        const std::string appended_tag{ "<AppendedData" };
+        auto appended = std::search( content_.begin(), content_.end(),
+            appended_tag.begin(), appended_tag.end() );
+        auto data = std::find( appended, content_.end(), '_' );
+        if( data == content_.end() )
+        {
+            throw RINGMeshException(
+                "TEST", "No appended data in file: ", filename );
+        }
+        xml_.assign( content_.begin(), data );
+        appended_ = static_cast< std::size_t >( data - content_.begin() ) + 1;
+        base64_ =
+            xml_attribute( element( "<AppendedData" ), "encoding" ) == "base64";
+        compressed_ = xml_.find( "compressor=" ) != std::string::npos;
+    }
+
+    index_t piece_value( const std::string& name ) const
+    {
+        return static_cast< index_t >(
+            std::stoul( xml_attribute( element( "<Piece" ), name ) ) );
+    }
+
+    /*!
+     * @brief Decodes a data array
+     * @return the array values in the byte order of the file
+     */
+    std::vector< char > array( const std::string& name,
+        const std::string& type,
+        index_t nb_components ) const
+    {
+        auto data_array = element( "<DataArray type=\"" + type + "\" Name=\""
+                                   + name + "\"" );
+        if( xml_attribute( data_array, "NumberOfComponents" )
+            != std::to_string( nb_components ) )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong number of components for VTU array ", name );
+        }
+        auto position = appended_
+                        + static_cast< std::size_t >( std::stoull(
+                              xml_attribute( data_array, "offset" ) ) );
+        if( !compressed_ )
+        {
+            auto nb_bytes = array_value< std::uint64_t >(
+                next_bytes( position, sizeof( std::uint64_t ) ), 0 );
+            return next_bytes(
+                position, static_cast< std::size_t >( nb_bytes ) );
+        }
+        auto first_value = position;
+        auto nb_blocks = array_value< std::uint64_t >(
+            next_bytes( first_value, sizeof( std::uint64_t ) ), 0 );
+        auto header = next_bytes( position,
+            static_cast< std::size_t >( 3 + nb_blocks )
+                * sizeof( std::uint64_t ) );
+        auto block_size = array_value< std::uint64_t >( header, 1 );
+        auto last_block_size = array_value< std::uint64_t >( header, 2 );
+        std::size_t compressed_size{ 0 };
+        for( auto b : range( nb_blocks ) )
+        {
+            compressed_size += array_value< std::uint64_t >( header, 3 + b );
+        }
+        auto compressed = next_bytes( position, compressed_size );
+        std::vector< char > values;
+        std::size_t block_start{ 0 };
+        for( auto b : range( nb_blocks ) )
+        {
+            auto size = b + 1 == nb_blocks && last_block_size != 0
+                            ? last_block_size
+                            : block_size;
+            auto start = values.size();
+            values.resize( start + size );
+            auto uncompressed_size = static_cast< uLongf >( size );
+            auto block_compressed_size = static_cast< uLong >(
+                array_value< std::uint64_t >( header, 3 + b ) );
+            if( uncompress( reinterpret_cast< Bytef* >( &values[start] ),
+                    &uncompressed_size,
+                    reinterpret_cast< const Bytef* >(
+                        &compressed[block_start] ),
+                    block_compressed_size )
+                    != Z_OK
+                || uncompressed_size != size )
+            {
+                throw RINGMeshException(
+                    "TEST", "Failed to uncompress VTU array ", name );
+            }
+            block_start += block_compressed_size;
+        }
+        return values;
+    }
+
+private:
+    std::string element( const std::string& begin ) const
+    {
+        auto start = xml_.find( begin );
+        if( start == std::string::npos )
+        {
+            throw RINGMeshException( "TEST", "Missing VTU element ", begin );
+        }
+        return xml_.substr( start, xml_.find( '>', start ) - start );
+    }
+
+    /*!
+     * @brief Reads the next bytes of the appended data
+     * @details In base64, each header and each payload is encoded on its
+     * own, so the bytes to read start a new base64 sequence.
+     */
+    std::vector< char > next_bytes(
+        std::size_t& position, std::size_t nb_bytes ) const
+    {
+        auto nb_chars = base64_ ? ( nb_bytes + 2 ) / 3 * 4 : nb_bytes;
+        if( position + nb_chars > content_.size() )
+        {
+            throw RINGMeshException( "TEST", "VTU appended data is too short" );
+        }
+        std::vector< char > bytes;
+        if( base64_ )
+        {
+            bytes = decode_base64( &content_[position], nb_chars );
+            bytes.resize( nb_bytes );
+        }
+        else
+        {
+            bytes.assign( content_.data() + position,
+                content_.data() + position + nb_bytes );
+        }
+        position += nb_chars;
+        return bytes;
+    }
+
+private:
+    std::vector< char > content_;
+    std::string xml_;
+    std::size_t appended_{ 0 };
+    bool base64_{ false };
+    bool compressed_{ false };
+};
+
+void check_vtu_file( const GeoModel3D& geomodel, const std::string& filename )
+{
+    const auto& mesh = geomodel.mesh;
+    VTUFile file{ filename };
+    if( file.piece_value( "NumberOfPoints" ) != mesh.vertices.nb()
+        || file.piece_value( "NumberOfCells" ) != mesh.cells.nb() )
+    {
+        throw RINGMeshException(
+            "TEST", "Wrong number of points or cells in ", filename );
+    }
+    check_vtk_points( mesh, file.array( "Points", "Float64", 3 ) );
+
+    auto connectivity = file.array( "connectivity", "Int32", 1 );
+    auto offsets = file.array( "offsets", "Int32", 1 );
+    std::size_t offset{ 0 };
+    for( auto c : range( mesh.cells.nb() ) )
+    {
+        check_vtk_cell( mesh, c, connectivity, offset );
+        offset += mesh.cells.nb_vertices( c );
+        if( static_cast< std::size_t >(
+                array_value< std::int32_t >( offsets, c ) )
+            != offset )
+        {
+            throw RINGMeshException( "TEST", "Wrong VTU offset for cell ", c );
+        }
+    }
+    check_vtk_cell_and_vertex_data< std::uint8_t >( mesh,
+        file.array( "types", "UInt8", 1 ), file.array( "region", "Int32", 1 ),
+        file.array( "cell value", "Int32", 1 ),
+        file.array( "vertex value", "Float64", 1 ) );
+}
+
+/*!
+ * @brief Saves a GeoModel in .vtu with each encoding and compression and
+ * reads the files back
+ */
+void check_vtu_outputs( const GeoModel3D& geomodel )
+{
+    add_vtk_test_attributes( geomodel );
+    for( const std::string encoding : { "raw", "base64" } )
+    {
+        for( auto compression : { false, true } )
+        {
+            GEO::CmdLine::set_arg( "out:vtu_encoding", encoding );
+            GEO::CmdLine::set_arg( "out:vtu_compression", compression );
+            auto filename = ringmesh_test_output_path + "geomodel3d_"
+                            + encoding + ( compression ? "_zlib" : "" )
+                            + ".vtu";
+            geomodel_save( geomodel, filename );
+            check_vtu_file( geomodel, filename );
+        }
+    }
+    GEO::CmdLine::set_arg( "out:vtu_encoding", "raw" );
+    GEO::CmdLine::set_arg( "out:vtu_compression", true );
+}
+
+/*!
+ * @brief Reader of the legacy binary VTK files: text lines and big endian
+ * data blocks
+ */
+class LegacyVTKFile
+{
+public:
+    explicit LegacyVTKFile( const std::string& filename )
+        : content_( read_file_content( filename ) )
+    {
+    }
+
+    std::vector< std::string > line()
+    {
+        auto end = std::find(
+            content_.begin() + static_cast< std::ptrdiff_t >( position_ ),
+            content_.end(), '\n' );
+        std::string text{
+            content_.begin() + static_cast< std::ptrdiff_t >( position_ ), end
+        };
+        position_ = static_cast< std::size_t >( end - content_.begin() ) + 1;
+        std::vector< std::string > fields;
+        std::istringstream in( text );
+        std::string field;
+        while( in >> field )
+        {
+            fields.push_back( field );
+        }
+        return fields;
+    }
+
+    std::vector< std::string > line(
+        const std::string& keyword, index_t nb_fields )
+    {
+        auto fields = line();
+        if( fields.size() != nb_fields || fields[0] != keyword )
+        {
+            throw RINGMeshException(
+                "TEST", "Expected ", keyword, " in the legacy VTK file" );
+        }
+        return fields;
+    }
+
+    /*!
+     * @brief Reads a big endian data block followed by an end of line
+     * @return the values in the native byte order
+     */
+    std::vector< char > values( std::size_t nb_values, std::size_t value_size )
+    {
+        auto nb_bytes = nb_values * value_size;
+        if( position_ + nb_bytes + 1 > content_.size()
+            || content_[position_ + nb_bytes] != '\n' )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong data block in the legacy VTK file" );
+        }
+        std::vector< char > values( content_.data() + position_,
+            content_.data() + position_ + nb_bytes );
+        position_ += nb_bytes + 1;
+        const std::uint16_t one{ 1 };
+        if( *reinterpret_cast< const char* >( &one ) == 1 )
+        {
+            for( auto i : range( nb_values ) )
+            {
+                std::reverse( values.data() + i * value_size,
+                    values.data() + ( i + 1 ) * value_size );
+            }
+        }
+        return values;
+    }
+
+    /*!
+     * @brief Reads the arrays of a FIELD block
+     * @return the values of each array, by name
+     */
+    std::map< std::string, std::vector< char > > field_data(
+        index_t nb_tuples )
+    {
+        auto nb_arrays = std::stoul( line( "FIELD", 3 )[2] );
+        std::map< std::string, std::vector< char > > arrays;
+        for( auto a : range( nb_arrays ) )
+        {
+            ringmesh_unused( a );
+            auto fields = line();
+            if( fields.size() != 4 || std::stoul( fields[2] ) != nb_tuples )
+            {
+                throw RINGMeshException(
+                    "TEST", "Wrong array in the legacy VTK file" );
+            }
+            auto nb_components = std::stoul( fields[1] );
+            arrays[fields[0]] = values( nb_components * nb_tuples,
+                fields[3] == "double" ? sizeof( double )
+                                      : sizeof( std::int32_t ) );
+        }
+        return arrays;
+    }
+
+private:
+    std::vector< char > content_;
+    std::size_t position_{ 0 };
+};
+
+void check_binary_vtk_file(
+    const GeoModel3D& geomodel, const std::string& filename )
+{
+    const auto& mesh = geomodel.mesh;
+    LegacyVTKFile file{ filename };
+    for( const std::string header : { "#", "Unstructured", "BINARY" } )
+    {
+        if( file.line()[0] != header )
+        {
+            throw RINGMeshException( "TEST", "Wrong legacy VTK header" );
+        }
+    }
+    file.line( "DATASET", 2 );
+    if( std::stoul( file.line( "POINTS", 3 )[1] ) != mesh.vertices.nb() )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of VTK points" );
+    }
+    check_vtk_points( mesh, file.values( 3 * mesh.vertices.nb(), 8 ) );
+
+    auto cell_fields = file.line( "CELLS", 3 );
+    if( std::stoul( cell_fields[1] ) != mesh.cells.nb() )
+    {
+        throw RINGMeshException( "TEST", "Wrong number of VTK cells" );
+    }
+    auto cells = file.values( std::stoul( cell_fields[2] ), 4 );
+    std::size_t position{ 0 };
+    for( auto c : range( mesh.cells.nb() ) )
+    {
+        if( static_cast< index_t >(
+                array_value< std::int32_t >( cells, position ) )
+            != mesh.cells.nb_vertices( c ) )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong number of vertices for VTK cell ", c );
+        }
+        check_vtk_cell( mesh, c, cells, position + 1 );
+        position += mesh.cells.nb_vertices( c ) + 1;
+    }
+    if( position * 4 != cells.size() )
+    {
+        throw RINGMeshException( "TEST", "Wrong size of the VTK cells" );
+    }
+
+    file.line( "CELL_TYPES", 2 );
+    auto types = file.values( mesh.cells.nb(), 4 );
+    file.line( "CELL_DATA", 2 );
+    auto cell_data = file.field_data( mesh.cells.nb() );
+    file.line( "POINT_DATA", 2 );
+    auto point_data = file.field_data( mesh.vertices.nb() );
+    check_vtk_cell_and_vertex_data< std::int32_t >( mesh, types,
+        cell_data["region"], cell_data["cell_value"],
+        point_data["vertex_value"] );
+}
+
+void check_binary_vtk_output( const GeoModel3D& geomodel )
+{
+    add_vtk_test_attributes( geomodel );
+    GEO::CmdLine::set_arg( "out:vtk_binary", true );
+    auto filename = ringmesh_test_output_path + "geomodel3d_binary.vtk";
+    geomodel_save( geomodel, filename );
+    GEO::CmdLine::set_arg( "out:vtk_binary", false );
+    check_binary_vtk_file( geomodel, filename );
+}
+
+/*!
+ * @brief Checks the binary outputs of the VTK formats, which cannot be
+ * compared with template text files
+ */
+template < index_t DIMENSION >
+void check_binary_outputs(
+    const GeoModel< DIMENSION >& geomodel, const std::string& extension )
+{
+    ringmesh_unused( geomodel );
+    ringmesh_unused( extension );
+}
+
+template <>
+void check_binary_outputs(
+    const GeoModel3D& geomodel, const std::string& extension )
+{
+    if( extension == "vtu" )
+    {
+        check_vtu_outputs( geomodel );
+    }
+    else if( extension == "vtk" )
+    {
+        check_binary_vtk_output( geomodel );
+    }
+}
+
 template < index_t DIMENSION >
 void io_geomodel( GeoModel< DIMENSION >& geomodel,
     const std::string& geomodel_file,
@@ -319,7 +906,7 @@ void process_extension( const std::string& extension )
     io_geomodel< DIMENSION >(
         geomodel, ringmesh_test_data_path + in.field( 0 ), extension );
 
-    if( extension == "epc" )
+    if( extension == "epc" || extension == "gmb" )
     {
         check_output_by_model< DIMENSION >( geomodel, extension );
     }
@@ -327,6 +914,7 @@ void process_extension( const std::string& extension )
     {
         check_output_by_file( in );
     }
+    check_binary_outputs( geomodel, extension );
     Logger::out( "TEST", "Format ", extension, " OK" );
 }
 
@@ -342,6 +930,152 @@ void test_output_geomodel()
     }
 }
 
+/*!
+ * @brief Reads an unsigned integer of \p nb_bytes bytes stored in little
+ * endian
+ */
+std::uint32_t read_little_endian( const char* data, index_t nb_bytes )
+{
+    std::uint32_t value{ 0 };
+    for( auto b : range( nb_bytes ) )
+    {
+        value |= static_cast< std::uint32_t >(
+                     static_cast< unsigned char >( data[b] ) )
+                 << ( 8 * b );
+    }
+    return value;
+}
+
+float read_little_endian_float( const char* data )
+{
+    auto bits = read_little_endian( data, 4 );
+    float value;
+    std::memcpy( &value, &bits, sizeof( float ) );
+    return value;
+}
+
+void check_binary_stl_point( const char* data, const vec3& point )
+{
+    for( auto i : range( 3 ) )
+    {
+        if( read_little_endian_float( data + 4 * i )
+            != static_cast< float >( point[i] ) )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong point in the binary STL file: ", point );
+        }
+    }
+}
+
+/*!
+ * @brief Saves a GeoModel in the binary STL format and reads the file back
+ */
+void test_binary_stl()
+{
+    Logger::out( "TEST", "Save GeoModel3D in binary STL" );
+    GeoModel3D geomodel;
+    geomodel_load(
+        geomodel, ringmesh_test_data_path + "modelA1_volume_meshed.gm" );
+    GEO::CmdLine::set_arg( "out:stl_binary", true );
+    auto filename = ringmesh_test_output_path + "geomodel3d_binary.stl";
+    geomodel_save( geomodel, filename );
+    GEO::CmdLine::set_arg( "out:stl_binary", false );
+
+    auto content = read_file_content( filename );
+    const auto& polygons = geomodel.mesh.polygons;
+    const index_t header_size{ 80 };
+    const index_t triangle_size{ 50 };
+    if( content.size() != header_size + 4 + polygons.nb() * triangle_size )
+    {
+        throw RINGMeshException(
+            "TEST", "Wrong size of the binary STL file: ", content.size() );
+    }
+    if( std::string( content.data(), 5 ) == "solid" )
+    {
+        throw RINGMeshException(
+            "TEST", "The binary STL header should not begin with solid" );
+    }
+    if( read_little_endian( content.data() + header_size, 4 )
+        != polygons.nb() )
+    {
+        throw RINGMeshException(
+            "TEST", "Wrong number of triangles in the binary STL file" );
+    }
+    for( auto t : range( polygons.nb() ) )
+    {
+        const auto* triangle =
+            content.data() + header_size + 4 + t * triangle_size;
+        check_binary_stl_point( triangle, polygons.normal( t ) );
+        for( auto v : range( 3 ) )
+        {
+            check_binary_stl_point( triangle + 12 * ( v + 1 ),
+                geomodel.mesh.vertices.vertex(
+                    polygons.vertex( ElementLocalVertex( t, v ) ) ) );
+        }
+        if( read_little_endian( triangle + 48, 2 ) != polygons.surface( t ) )
+        {
+            throw RINGMeshException( "TEST",
+                "Wrong Surface of the triangle ", t,
+                " in the binary STL file" );
+        }
+    }
+    Logger::out( "TEST", "Format binary stl OK" );
+}
+
+/*!
+ * @brief Saves a GeoModel3D in a .gmb file, checks the GeoModelMesh vertices
+ * read back and that the file is rejected when its byte order differs
+ */
+void test_gmb_byte_order()
+{
+    Logger::out( "TEST", "Save GeoModel3D in gmb and swap its byte order" );
+    GeoModel3D geomodel;
+    geomodel_load(
+        geomodel, ringmesh_test_data_path + "modelA1_volume_meshed.gm" );
+    auto filename = ringmesh_test_output_path + "geomodel3d_byte_order.gmb";
+    geomodel_save( geomodel, filename );
+
+    GeoModel3D loaded_geomodel;
+    geomodel_load( loaded_geomodel, filename );
+    const auto& vertices = geomodel.mesh.vertices;
+    const auto& loaded_vertices = loaded_geomodel.mesh.vertices;
+    if( loaded_vertices.nb() != vertices.nb() )
+    {
+        throw RINGMeshException(
+            "TEST", "Wrong number of GeoModelMesh vertices in the gmb file" );
+    }
+    for( auto v : range( vertices.nb() ) )
+    {
+        if( loaded_vertices.vertex( v ) != vertices.vertex( v ) )
+        {
+            throw RINGMeshException(
+                "TEST", "Wrong GeoModelMesh vertex ", v, " in the gmb file" );
+        }
+    }
+
+    // The byte order marker follows the 8 characters of the magic
+    auto content = read_file_content( filename );
+    std::reverse( content.begin() + 8, content.begin() + 12 );
+    auto swapped_filename =
+        ringmesh_test_output_path + "geomodel3d_swapped_byte_order.gmb";
+    std::ofstream out( swapped_filename.c_str(), std::ios::binary );
+    out.write(
+        content.data(), static_cast< std::streamsize >( content.size() ) );
+    out.close();
+    try
+    {
+        GeoModel3D swapped_geomodel;
+        geomodel_load( swapped_geomodel, swapped_filename );
+    }
+    catch( const RINGMeshException& )
+    {
+        Logger::out( "TEST", "Format gmb byte order OK" );
+        return;
+    }
+    throw RINGMeshException(
+        "TEST", "A gmb file with another byte order was loaded" );
+}
+
 int main()
 {
     using namespace RINGMesh;
@@ -349,8 +1083,11 @@ int main()
     try
     {
         GEO::CmdLine::set_arg( "validity:do_not_check", "A" );
+        CmdLine::import_arg_group( "out" );
         test_output_geomodel< 2 >();
         test_output_geomodel< 3 >();
+        test_binary_stl();
+        test_gmb_byte_order();
     }
     catch( const RINGMeshException& e )
     {
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include <ringmesh/basic/logger.h>
+#include <ringmesh/io/io.h>
+#include <ringmesh/io/text_writer.h>
+
+/*!
+ * @file Tests the formatting of numbers by TextWriter
+ */
+
+using namespace RINGMesh;
+
+namespace
+{
+    template < typename T >
+    void check_value( const T& value, int precision, bool scientific )
+    {
+        std::ostringstream stream;
+        stream.precision( precision );
+        if( scientific )
+        {
+            stream << std::scientific;
+        }
+        stream << value;
+        TextWriter text{ precision, scientific };
+        text << value;
+        if( text.str() != stream.str() )
+        {
+            throw RINGMeshException( "TEST", "Wrong text for ", stream.str(),
+                ": ", text.str() );
+        }
+    }
+
+    void test_doubles()
+    {
+        Logger::out( "TEST", "Test floating point values" );
+        std::vector< double > values{ 0., -0., 1., -1., 0.1, -0.5, 1. / 3.,
+            2. / 3., 123456789.123456789, 1e15, 1e16, 1e17, 9007199254740991.,
+            9007199254740992., -9007199254740993., 1e-5, 1.5e-300, 1e300,
+            std::numeric_limits< double >::max(),
+            std::numeric_limits< double >::min(),
+            std::numeric_limits< double >::denorm_min(),
+            std::numeric_limits< double >::infinity(),
+            -std::numeric_limits< double >::infinity() };
+        double value{ 0.7 };
+        for( auto i : range( 1000 ) )
+        {
+            value = std::fmod( value * 7919.123 + i, 1e6 ) - 5e5;
+            values.push_back( value );
+            values.push_back( value * 1e-9 );
+            values.push_back( std::floor( value ) );
+        }
+        for( auto value : values )
+        {
+            for( auto precision : { 6, 16, 17 } )
+            {
+                check_value( value, precision, false );
+                check_value( value, precision, true );
+            }
+            if( value == 0
+                || ( std::fabs( value ) > 1e-30 && std::fabs( value ) < 1e30 ) )
+            {
+                check_value( static_cast< float >( value ), 16, false );
+            }
+        }
+        check_value( vec3( 1.5, -2, 1e-20 ), 16, false );
+    }
+
+    void test_integers()
+    {
+        Logger::out( "TEST", "Test integer values" );
+        for( auto value : { 0, 1, -1, 10, -99, 123456,
+                 std::numeric_limits< int >::max(),
+                 std::numeric_limits< int >::min() } )
+        {
+            check_value( value, 16, false );
+            check_value( static_cast< long long >( value ), 16, false );
+        }
+        check_value( std::numeric_limits< index_t >::max(), 16, false );
+        check_value( std::numeric_limits< long long >::min(), 16, false );
+        check_value(
+            std::numeric_limits< unsigned long long >::max(), 16, false );
+        check_value( std::numeric_limits< std::size_t >::max(), 16, false );
+        check_value( 'a', 16, false );
+    }
+
+    void test_parallel_write()
+    {
+        Logger::out( "TEST", "Test parallel writing" );
+        index_t nb_elements{ 100000 };
+        std::ostringstream sequential;
+        sequential.precision( 16 );
+        for( auto i : range( nb_elements ) )
+        {
+            sequential << i << SPACE << i / 7. << EOL;
+        }
+        std::ostringstream parallel;
+        parallel_write_text(
+            parallel, nb_elements, []( TextWriter& text, index_t i ) {
+                text << i << SPACE << i / 7. << EOL;
+            } );
+        if( parallel.str() != sequential.str() )
+        {
+            throw RINGMeshException( "TEST", "Wrong text written in parallel" );
+        }
+    }
+} // namespace
+
+int main()
+{
+    try
+    {
+        Logger::out( "TEST", "Test TextWriter" );
+        test_doubles();
+        test_integers();
+        test_parallel_write();
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}
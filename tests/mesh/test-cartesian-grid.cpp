@@ -35,6 +35,9 @@
 
 #include <ringmesh/ringmesh_tests_config.h>
 
+#include <algorithm>
+#include <cstdio>
+
 #include <ringmesh/basic/geometry.h>
 #include <ringmesh/basic/logger.h>
 #include <ringmesh/mesh/cartesian_grid.h>
@@ -338,6 +341,99 @@ void test_cartesian_grid_exception()
     }
 }
 
+void test_cartesian_grid_files()
+{
+    vec3 origin{ 100, 200, -4 };
+    vec3 x{ 1, 2, -1 };
+    vec3 y{ 2, 1, 4 };
+    vec3 z{ 3, -2, -1 };
+
+    Frame3D frame{ x, y, z };
+    ReferenceFrame3D reference_frame{ origin, frame };
+    ivec3 grid_dimensions{ 10, 8, 9 };
+    CartesianGrid3D cartesiangrid{ grid_dimensions, reference_frame };
+
+    std::vector< double > dvalues( cartesiangrid.nb_cells() );
+    std::vector< index_t > uvalues( cartesiangrid.nb_cells() );
+    for( auto i : range( cartesiangrid.nb_cells() ) )
+    {
+        dvalues[i] = 0.5 * i;
+        uvalues[i] = 2 * i;
+    }
+    std::string dname{ "d_mapped" };
+    std::string uname{ "u_index" };
+    std::string mapped_filename{ ringmesh_test_output_path
+                                 + "cartesian_grid_values.bin" };
+    std::remove( mapped_filename.c_str() );
+    cartesiangrid.add_mapped_attribute< double >( dname, mapped_filename );
+    cartesiangrid.set_attribute_values< double >( dname, dvalues.data() );
+    cartesiangrid.add_attribute< index_t >( uname );
+    cartesiangrid.set_attribute_values< index_t >( uname, uvalues.data() );
+
+    std::vector< index_t > read_uvalues( cartesiangrid.nb_cells() );
+    cartesiangrid.get_attribute_values< index_t >(
+        uname, read_uvalues.data() );
+    const auto* mapped_values =
+        cartesiangrid.attribute_values< double >( dname );
+    if( read_uvalues != uvalues
+        || !std::equal( dvalues.begin(), dvalues.end(), mapped_values ) )
+    {
+        throw RINGMeshException( "Test", "Error in bulk attribute values." );
+    }
+    bool exception_is_thrown{ false };
+    try
+    {
+        cartesiangrid.attribute_values< float >( dname );
+    }
+    catch( const RINGMeshException& e )
+    {
+        exception_is_thrown = true;
+        Logger::out( "Test", "Exception \"", e.what(), "\" is well thrown." );
+    }
+    if( !exception_is_thrown )
+    {
+        throw RINGMeshException(
+            "Test", "Exception attribute type mismatch is not thrown" );
+    }
+
+    std::string filename{ ringmesh_test_output_path + "cartesian_grid.rgrid" };
+    cartesiangrid.save_mesh( filename );
+    for( auto memory_mapped : { false, true } )
+    {
+        CartesianGrid3D loaded_grid;
+        CartesianGridBuilder3D builder{ loaded_grid };
+        builder.load_mesh( filename, memory_mapped );
+        if( loaded_grid.nb_cells_vector() != grid_dimensions
+            || !inexact_equal(
+                   loaded_grid.grid_vectors(), reference_frame, 1e-7 )
+            || loaded_grid.grid_cage().size() != 6 )
+        {
+            throw RINGMeshException(
+                "Test", "Error in loaded grid geometry." );
+        }
+        const auto* loaded_dvalues =
+            loaded_grid.attribute_values< double >( dname );
+        const auto* loaded_uvalues =
+            loaded_grid.attribute_values< index_t >( uname );
+        if( !std::equal( dvalues.begin(), dvalues.end(), loaded_dvalues )
+            || !std::equal( uvalues.begin(), uvalues.end(), loaded_uvalues ) )
+        {
+            throw RINGMeshException(
+                "Test", "Error in loaded attribute values." );
+        }
+        // Mapped values are copied on write, the file is unchanged
+        loaded_grid.attribute_values< double >( dname )[0] = -1.;
+    }
+    CartesianGrid3D loaded_grid;
+    CartesianGridBuilder3D builder{ loaded_grid };
+    builder.load_mesh( filename, true );
+    if( loaded_grid.attribute_values< double >( dname )[0] != dvalues[0] )
+    {
+        throw RINGMeshException(
+            "Test", "Error mapped file modified by the loaded grid." );
+    }
+}
+
 int main()
 {
     using namespace RINGMesh;
@@ -352,6 +448,8 @@ int main()
         Logger::out( "TEST", "Cartesian grids : OK" );
         test_cartesian_grid_exception();
         Logger::out( "TEST", "Grid exceptions : OK" );
+        test_cartesian_grid_files();
+        Logger::out( "TEST", "Grid files : OK" );
     }
     catch( const std::exception& e )
     {
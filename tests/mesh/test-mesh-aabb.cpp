@@ -340,6 +340,30 @@ void test_locate_cell_on_3D_mesh( const VolumeMesh< DIMENSION >& mesh )
     }
 }
 
+template < index_t DIMENSION >
+void test_locate_cell_with_grid_on_3D_mesh(
+    const VolumeMesh< DIMENSION >& mesh )
+{
+    const VolumeCellGrid< DIMENSION >& grid = mesh.cell_grid();
+    for( index_t c : range( mesh.nb_cells() ) )
+    {
+        vecn< DIMENSION > barycenter = mesh.cell_barycenter( c );
+        index_t containing_cell = grid.containing_cell( barycenter );
+        if( containing_cell != c )
+        {
+            throw RINGMeshException(
+                "TEST", "Not the correct cell found with the grid" );
+        }
+    }
+    vecn< DIMENSION > outside_point;
+    outside_point[0] = -1;
+    if( grid.containing_cell( outside_point ) != NO_ID )
+    {
+        throw RINGMeshException(
+            "TEST", "A cell is found with the grid outside the mesh" );
+    }
+}
+
 template < index_t DIMENSION >
 void test_VolumeAABB()
 {
@@ -355,6 +379,7 @@ void test_VolumeAABB()
     auto mesh_tet = VolumeMesh< DIMENSION >::create_mesh();
     decompose_in_tet( *mesh_hex, *mesh_tet, size );
     test_locate_cell_on_3D_mesh( *mesh_tet );
+    test_locate_cell_with_grid_on_3D_mesh( *mesh_tet );
 }
 
 template < index_t DIMENSION >
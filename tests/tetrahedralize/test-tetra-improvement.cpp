@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2012-2018, Association Scientifique pour la Geologie et ses
+ * Applications (ASGA). All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of ASGA nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL ASGA BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *     http://www.ring-team.org
+ *
+ *     RING Project
+ *     Ecole Nationale Superieure de Geologie - GeoRessources
+ *     2 Rue du Doyen Marcel Roubault - TSA 70605
+ *     54518 VANDOEUVRE-LES-NANCY
+ *     FRANCE
+ */
+
+
+#include <ringmesh/ringmesh_tests_config.h>
+
+#include <geogram/basic/command_line.h>
+
+#include <ringmesh/basic/command_line.h>
+#include <ringmesh/geomodel/core/geomodel.h>
+#include <ringmesh/geomodel/core/geomodel_mesh_entity.h>
+#include <ringmesh/geomodel/tools/geomodel_tools.h>
+#include <ringmesh/geomodel/tools/geomodel_validity.h>
+#include <ringmesh/geomodel/tools/mesh_quality.h>
+#include <ringmesh/io/io.h>
+#include <ringmesh/tetrahedralize/tetra_improvement.h>
+
+/*!
+ * @file Test the local improvement of the region tetrahedral meshes
+ */
+
+using namespace RINGMesh;
+
+/*!
+ * Vertices of each region lying on a boundary facet of the region mesh,
+ * with their coordinates.
+ */
+using BoundaryVertices =
+    std::vector< std::vector< std::pair< index_t, vec3 > > >;
+
+BoundaryVertices get_boundary_vertices( const GeoModel3D& geomodel )
+{
+    BoundaryVertices boundary_vertices( geomodel.nb_regions() );
+    for( const auto& region : geomodel.regions() )
+    {
+        std::vector< bool > on_boundary( region.nb_vertices(), false );
+        for( auto t : range( region.nb_mesh_elements() ) )
+        {
+            for( auto f : range( 4 ) )
+            {
+                if( region.cell_adjacent_index( t, f ) == NO_ID )
+                {
+                    for( auto v : range( 3 ) )
+                    {
+                        on_boundary[region.cell_facet_vertex_index(
+                            t, f, v )] = true;
+                    }
+                }
+            }
+        }
+        for( auto v : range( region.nb_vertices() ) )
+        {
+            if( on_boundary[v] )
+            {
+                boundary_vertices[region.index()].emplace_back(
+                    v, region.vertex( v ) );
+            }
+        }
+    }
+    return boundary_vertices;
+}
+
+void check_boundary_vertices(
+    const GeoModel3D& geomodel, const BoundaryVertices& boundary_vertices )
+{
+    for( const auto& region : geomodel.regions() )
+    {
+        for( const auto& vertex : boundary_vertices[region.index()] )
+        {
+            if( vertex.first >= region.nb_vertices()
+                || region.vertex( vertex.first ) != vertex.second )
+            {
+                throw RINGMeshException( "RINGMesh Test", "Boundary vertex ",
+                    vertex.first, " of Region ", region.index(),
+                    " has been moved" );
+            }
+        }
+    }
+}
+
+void test_improve_tetrahedra_quality( GeoModel3D& geomodel )
+{
+    Logger::out( "TEST", "Test tetrahedral mesh improvement" );
+    const auto mode = MIN_SOLID_ANGLE;
+    const double min_quality{ 0.3 };
+    auto stats_before = compute_prop_tet_mesh_quality( mode, geomodel );
+    auto boundary_vertices = get_boundary_vertices( geomodel );
+
+    auto nb_modifications = improve_tetrahedra_quality( geomodel,
+        "MIN_SOLID_ANGLE", min_quality,
+        [mode]( const vec3& v0, const vec3& v1, const vec3& v2,
+            const vec3& v3 ) {
+            return tetrahedron_quality( mode, v0, v1, v2, v3 );
+        } );
+    if( stats_before.min_quality < min_quality && nb_modifications == 0 )
+    {
+        throw RINGMeshException(
+            "RINGMesh Test", "No modification of the poor tetrahedra" );
+    }
+
+    auto stats_after = compute_prop_tet_mesh_quality( mode, geomodel );
+    Logger::out( "TEST", nb_modifications, " modifications, minimum quality ",
+        stats_before.min_quality, " -> ", stats_after.min_quality );
+    if( stats_after.min_quality < stats_before.min_quality )
+    {
+        throw RINGMeshException( "RINGMesh Test",
+            "The minimum quality decreased from ", stats_before.min_quality,
+            " to ", stats_after.min_quality );
+    }
+    check_boundary_vertices( geomodel, boundary_vertices );
+
+    ValidityCheckMode checks{ ValidityCheckMode::GEOMETRY };
+    if( !is_geomodel_valid( geomodel, checks ) )
+    {
+        throw RINGMeshException( "RINGMesh Test", "Improved model ",
+            geomodel.name(), " is not valid" );
+    }
+}
+
+int main()
+{
+    using namespace RINGMesh;
+
+    try
+    {
+        CmdLine::import_arg_group( "global" );
+        GEO::CmdLine::set_arg( "algo:tet", "TetGen" );
+
+        std::string file_name( ringmesh_test_data_path );
+        file_name += "modelA6.ml";
+
+        // Check only model geometry
+        GEO::CmdLine::set_arg( "validity:do_not_check", "tG" );
+
+        GeoModel3D geomodel;
+        bool loaded_model_is_valid = geomodel_load( geomodel, file_name );
+        if( !loaded_model_is_valid )
+        {
+            throw RINGMeshException( "RINGMesh Test",
+                "Failed when building model ", geomodel.name(),
+                ": the model geometry is not valid." );
+        }
+
+#ifdef RINGMESH_WITH_TETGEN
+        tetrahedralize( geomodel, NO_ID, false );
+        test_improve_tetrahedra_quality( geomodel );
+#endif
+    }
+    catch( const RINGMeshException& e )
+    {
+        Logger::err( e.category(), e.what() );
+        return 1;
+    }
+    catch( const std::exception& e )
+    {
+        Logger::err( "Exception", e.what() );
+        return 1;
+    }
+    Logger::out( "TEST", "SUCCESS" );
+    return 0;
+}